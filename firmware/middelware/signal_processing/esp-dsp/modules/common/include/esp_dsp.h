@@ -28,21 +28,42 @@ extern "C"
 #include "dsps_dotprod.h"
 #include "dsps_math.h"
 #include "dsps_fir.h"
+#include "dsps_fir_gen.h"
+#include "dsps_resample.h"
+#include "dsps_lms.h"
+#include "dsps_cic.h"
 #include "dsps_biquad.h"
 #include "dsps_biquad_gen.h"
+#include "dsps_biquad_design.h"
 #include "dsps_wind.h"
 #include "dsps_conv.h"
+#include "dsps_fconv.h"
 #include "dsps_corr.h"
+#include "dsps_fcorr.h"
+#include "dsps_yin.h"
+#include "dsps_smooth.h"
+#include "dsps_stat.h"
+#include "dsps_qrs.h"
+#include "dsps_hilbert.h"
 
 #include "dsps_d_gen.h"
 #include "dsps_h_gen.h"
 #include "dsps_tone_gen.h"
+#include "dsps_nco.h"
+#include "dsps_noise_gen.h"
 #include "dsps_snr.h"
 #include "dsps_sfdr.h"
 
 #include "dsps_fft2r.h"
 #include "dsps_fft4r.h"
+#include "dsps_goertzel.h"
+#include "dsps_peak.h"
+#include "dsps_czt.h"
+#include "dsps_fftn.h"
+#include "dsps_fft2r_plan.h"
+#include "dsps_spectrum.h"
 #include "dsps_dct.h"
+#include "dsps_dwt.h"
 
 // Matrix operations
 #include "dspm_matrix.h"
@@ -0,0 +1,338 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fconv.h"
+#include "dsps_conv.h"
+#include "dsps_fft2r.h"
+#include "dsps_dotprod.h"
+#include "dsp_common.h"
+#include <string.h>
+#include <math.h>
+#include <malloc.h>
+
+// Amount of samples for timing of the direct form in DSPS_FCONV_AUTO mode
+#define DSPS_FCONV_DIRECT_BENCH_LEN 32
+
+// Select the FFT length with the lowest cost per output sample.
+// Two segments are processed by one pair of complex FFTs of length N (forward and inverse),
+// so the cost of 2*(N - M + 1) outputs is about 2*N*log2(N) butterflies plus N complex products.
+static int dsps_fconv_select_len(int kernel_len, int max_len)
+{
+    int best_len = 0;
+    float best_cost = 0;
+    for (int n = 4, pow = 2; n <= max_len; n <<= 1, pow++) {
+        if (n < 2 * kernel_len) {
+            continue;
+        }
+        float cost = (float)n * (pow + 2) / (n - kernel_len + 1);
+        if ((best_len == 0) || (cost < best_cost)) {
+            best_len = n;
+            best_cost = cost;
+        }
+    }
+    return best_len;
+}
+
+// Circular convolution of two real segments a and b with the kernel.
+// The segments are packed to the real and imaginary part of work, the result
+// is returned in the same way: real part - a*kernel, imaginary part - b*kernel.
+// The inverse FFT is calculated as conj(FFT(conj(X)))/N, the 1/N scale is stored in kernel_fft.
+static void dsps_fconv_block_f32(fconv_f32_t *fconv)
+{
+    float *work = fconv->work;
+    const float *kf = fconv->kernel_fft;
+    int n = fconv->fft_len;
+
+    dsps_fft2r_fc32(work, n);
+    // Both spectra are in bit reversed order
+    for (int i = 0; i < n; i++) {
+        float re = work[i * 2 + 0];
+        float im = work[i * 2 + 1];
+        work[i * 2 + 0] = re * kf[i * 2 + 0] - im * kf[i * 2 + 1];
+        work[i * 2 + 1] = -(re * kf[i * 2 + 1] + im * kf[i * 2 + 0]);
+    }
+    dsps_bit_rev_fc32(work, n);
+    dsps_fft2r_fc32(work, n);
+    dsps_bit_rev_fc32(work, n);
+}
+
+// Load a segment of len samples to the real (part = 0) or imaginary (part = 1) part of the work buffer
+// from [history, input] starting at position start. Rest of the segment is filled with zeros.
+static void dsps_fconv_load_f32(fconv_f32_t *fconv, int part, const float *history, int hist_len, const float *input, int start, int len)
+{
+    float *work = fconv->work + part;
+    int i = 0;
+    for (; (i < len) && (start + i < hist_len); i++) {
+        work[i * 2] = history[start + i];
+    }
+    for (; i < len; i++) {
+        work[i * 2] = input[start + i - hist_len];
+    }
+    for (; i < fconv->fft_len; i++) {
+        work[i * 2] = 0;
+    }
+}
+
+// Overlap-save over [history, input]: each segment contains kernel_len - 1 previous samples and step new samples
+static void dsps_fconv_segments_f32(fconv_f32_t *fconv, const float *history, const float *input, float *output, int len)
+{
+    int hist_len = fconv->kernel_len - 1;
+    int step = fconv->step;
+    float *work = fconv->work;
+
+    for (int pos = 0; pos < len;) {
+        int na = len - pos;
+        na = (na > step) ? step : na;
+        int nb = len - pos - na;
+        nb = (nb > step) ? step : nb;
+
+        dsps_fconv_load_f32(fconv, 0, history, hist_len, input, pos, hist_len + na);
+        dsps_fconv_load_f32(fconv, 1, history, hist_len, input, pos + na, (nb > 0) ? hist_len + nb : 0);
+        dsps_fconv_block_f32(fconv);
+
+        // First kernel_len - 1 outputs of every segment are aliased and dropped
+        for (int i = 0; i < na; i++) {
+            output[pos + i] = work[(hist_len + i) * 2 + 0];
+        }
+        for (int i = 0; i < nb; i++) {
+            output[pos + na + i] = -work[(hist_len + i) * 2 + 1];
+        }
+        pos += na + nb;
+    }
+}
+
+// Streaming FIR by overlap-save, the history is kept in the delay line
+static void dsps_fconv_fft_f32(fconv_f32_t *fconv, const float *input, float *output, int len)
+{
+    int hist_len = fconv->kernel_len - 1;
+    dsps_fconv_segments_f32(fconv, fconv->delay, input, output, len);
+
+    // Keep last kernel_len - 1 samples of [history, input]
+    if (len >= hist_len) {
+        memcpy(fconv->delay, &input[len - hist_len], hist_len * sizeof(float));
+    } else {
+        memmove(fconv->delay, &fconv->delay[len], (hist_len - len) * sizeof(float));
+        memcpy(&fconv->delay[hist_len - len], input, len * sizeof(float));
+    }
+}
+
+// Streaming FIR in direct form. Every sample is written twice to the delay line,
+// so the last kernel_len samples are always continuous: delay[pos] is the newest one.
+static void dsps_fconv_direct_f32(fconv_f32_t *fconv, const float *input, float *output, int len)
+{
+    int m = fconv->kernel_len;
+    float *delay = fconv->delay;
+
+    for (int i = 0; i < len; i++) {
+        fconv->pos--;
+        if (fconv->pos < 0) {
+            fconv->pos = m - 1;
+        }
+        delay[fconv->pos] = input[i];
+        delay[fconv->pos + m] = input[i];
+        dsps_dotprod_f32(fconv->kernel, &delay[fconv->pos], &output[i], m);
+    }
+}
+
+esp_err_t dsps_fconv_init_f32(fconv_f32_t *fconv, const float *kernel, int kernel_len, int fft_len, dsps_fconv_mode_t mode)
+{
+    if ((fconv == NULL) || (kernel == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (kernel_len <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    memset(fconv, 0, sizeof(fconv_f32_t));
+    fconv->kernel = kernel;
+    fconv->kernel_len = kernel_len;
+
+    if ((fft_len != 0) && ((dsp_is_power_of_two(fft_len) == false) || (fft_len < 2 * kernel_len))) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (mode == DSPS_FCONV_AUTO) {
+        // Without FFT tables or with a kernel too long for them only the direct form is possible
+        if ((dsps_fft2r_initialized == 0) || (fft_len > dsps_fft_w_table_size)
+                || ((fft_len == 0) && (dsps_fconv_select_len(kernel_len, dsps_fft_w_table_size) == 0))) {
+            mode = DSPS_FCONV_DIRECT;
+        }
+    }
+
+    if (mode != DSPS_FCONV_DIRECT) {
+        if (dsps_fft2r_initialized == 0) {
+            return ESP_ERR_DSP_UNINITIALIZED;
+        }
+        if (fft_len == 0) {
+            fft_len = dsps_fconv_select_len(kernel_len, dsps_fft_w_table_size);
+            if (fft_len == 0) {
+                return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+            }
+        }
+        if (fft_len > dsps_fft_w_table_size) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        fconv->fft_len = fft_len;
+        fconv->step = fft_len - kernel_len + 1;
+        fconv->kernel_fft = (float *)memalign(16, 2 * fft_len * sizeof(float));
+        fconv->work = (float *)memalign(16, 2 * fft_len * sizeof(float));
+        if ((fconv->kernel_fft == NULL) || (fconv->work == NULL)) {
+            dsps_fconv_free_f32(fconv);
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        float scale = 1.0f / fft_len;
+        for (int i = 0; i < fft_len; i++) {
+            fconv->kernel_fft[i * 2 + 0] = (i < kernel_len) ? kernel[i] * scale : 0;
+            fconv->kernel_fft[i * 2 + 1] = 0;
+        }
+        dsps_fft2r_fc32(fconv->kernel_fft, fft_len);
+    }
+
+    // The delay line is shared: history of the overlap-save or double delay line of the direct form
+    fconv->delay = (float *)calloc(2 * kernel_len, sizeof(float));
+    if (fconv->delay == NULL) {
+        dsps_fconv_free_f32(fconv);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    fconv->direct = (mode == DSPS_FCONV_DIRECT);
+    if (mode == DSPS_FCONV_AUTO) {
+        // Time both methods on zero input, that keeps the delay line cleared
+        float *bench = fconv->work;
+        memset(bench, 0, 2 * fft_len * sizeof(float));
+        uint32_t start = dsp_get_cpu_cycle_count();
+        dsps_fconv_direct_f32(fconv, bench, bench, DSPS_FCONV_DIRECT_BENCH_LEN);
+        uint32_t end = dsp_get_cpu_cycle_count();
+        fconv->cycles_direct = (float)(end - start) / DSPS_FCONV_DIRECT_BENCH_LEN;
+
+        start = dsp_get_cpu_cycle_count();
+        dsps_fconv_block_f32(fconv);
+        end = dsp_get_cpu_cycle_count();
+        fconv->cycles_fft = (float)(end - start) / (2 * fconv->step);
+        fconv->pos = 0;
+
+        if (fconv->cycles_direct <= fconv->cycles_fft) {
+            fconv->direct = 1;
+        }
+    }
+    if (fconv->direct) {
+        // FFT buffers are not used anymore
+        free(fconv->kernel_fft);
+        free(fconv->work);
+        fconv->kernel_fft = NULL;
+        fconv->work = NULL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fconv_f32(fconv_f32_t *fconv, const float *input, float *output, int len)
+{
+    if ((fconv == NULL) || (fconv->delay == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (fconv->direct) {
+        dsps_fconv_direct_f32(fconv, input, output, len);
+    } else {
+        dsps_fconv_fft_f32(fconv, input, output, len);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fconv_conv_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *convout)
+{
+    if ((fconv == NULL) || (fconv->delay == NULL) || (signal == NULL) || (convout == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (siglen <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (fconv->direct) {
+        return dsps_conv_f32(signal, siglen, fconv->kernel, fconv->kernel_len, convout);
+    }
+
+    // Overlap-add: every segment of step samples gives fft_len outputs without aliasing
+    int out_len = siglen + fconv->kernel_len - 1;
+    int step = fconv->step;
+    int n = fconv->fft_len;
+    float *work = fconv->work;
+    memset(convout, 0, out_len * sizeof(float));
+
+    for (int pos = 0; pos < siglen; pos += 2 * step) {
+        int na = siglen - pos;
+        na = (na > step) ? step : na;
+        int nb = siglen - pos - na;
+        nb = (nb > step) ? step : nb;
+
+        dsps_fconv_load_f32(fconv, 0, NULL, 0, signal, pos, na);
+        dsps_fconv_load_f32(fconv, 1, NULL, 0, signal, pos + na, nb);
+        dsps_fconv_block_f32(fconv);
+
+        int len_a = out_len - pos;
+        len_a = (len_a > n) ? n : len_a;
+        for (int i = 0; i < len_a; i++) {
+            convout[pos + i] += work[i * 2 + 0];
+        }
+        if (nb > 0) {
+            int len_b = out_len - pos - na;
+            len_b = (len_b > n) ? n : len_b;
+            for (int i = 0; i < len_b; i++) {
+                convout[pos + na + i] -= work[i * 2 + 1];
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fconv_valid_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *output)
+{
+    if ((fconv == NULL) || (fconv->delay == NULL) || (signal == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    int m = fconv->kernel_len;
+    if (siglen < m) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int len = siglen - m + 1;
+    if (fconv->direct) {
+        const float *kernel = fconv->kernel;
+        for (int n = 0; n < len; n++) {
+            float acc = 0;
+            for (int k = 0; k < m; k++) {
+                acc += kernel[k] * signal[n + m - 1 - k];
+            }
+            output[n] = acc;
+        }
+    } else {
+        // First kernel_len - 1 samples of the signal are the history of the overlap-save
+        dsps_fconv_segments_f32(fconv, signal, &signal[m - 1], output, len);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fconv_free_f32(fconv_f32_t *fconv)
+{
+    if (fconv == NULL) {
+        return ESP_OK;
+    }
+    free(fconv->kernel_fft);
+    free(fconv->work);
+    free(fconv->delay);
+    free(fconv->kernel_buff);
+    fconv->kernel_fft = NULL;
+    fconv->work = NULL;
+    fconv->delay = NULL;
+    fconv->kernel_buff = NULL;
+    return ESP_OK;
+}
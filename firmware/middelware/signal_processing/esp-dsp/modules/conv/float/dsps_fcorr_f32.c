@@ -0,0 +1,91 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fcorr.h"
+#include <malloc.h>
+
+esp_err_t dsps_fcorr_init_f32(fconv_f32_t *fconv, const float *pattern, int patlen, int fft_len, dsps_fconv_mode_t mode)
+{
+    if ((fconv == NULL) || (pattern == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (patlen <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    float *reversed = (float *)malloc(patlen * sizeof(float));
+    if (reversed == NULL) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    for (int i = 0; i < patlen; i++) {
+        reversed[i] = pattern[patlen - 1 - i];
+    }
+    esp_err_t ret = dsps_fconv_init_f32(fconv, reversed, patlen, fft_len, mode);
+    if (ret != ESP_OK) {
+        free(reversed);
+        return ret;
+    }
+    fconv->kernel_buff = reversed;
+    return ESP_OK;
+}
+
+esp_err_t dsps_fcorr_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *dest, float *lag)
+{
+    esp_err_t ret = dsps_fconv_valid_f32(fconv, signal, siglen, dest);
+    if ((ret == ESP_OK) && (lag != NULL)) {
+        ret = dsps_corr_peak_f32(dest, siglen - fconv->kernel_len + 1, lag, NULL);
+    }
+    return ret;
+}
+
+esp_err_t dsps_fccorr_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *corrvout, float *lag)
+{
+    esp_err_t ret = dsps_fconv_conv_f32(fconv, signal, siglen, corrvout);
+    if ((ret == ESP_OK) && (lag != NULL)) {
+        ret = dsps_corr_peak_f32(corrvout, siglen + fconv->kernel_len - 1, lag, NULL);
+        *lag -= fconv->kernel_len - 1;
+    }
+    return ret;
+}
+
+esp_err_t dsps_corr_peak_f32(const float *data, int len, float *position, float *value)
+{
+    if ((data == NULL) || (position == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int index = 0;
+    for (int i = 1; i < len; i++) {
+        if (data[i] > data[index]) {
+            index = i;
+        }
+    }
+    float delta = 0;
+    float peak = data[index];
+    if ((index > 0) && (index < len - 1)) {
+        float ym = data[index - 1];
+        float yp = data[index + 1];
+        float den = ym - 2 * peak + yp;
+        if (den < 0) {
+            delta = 0.5f * (ym - yp) / den;
+            peak = peak - 0.25f * (ym - yp) * delta;
+        }
+    }
+    *position = index + delta;
+    if (value != NULL) {
+        *value = peak;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,143 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_yin.h"
+#include <string.h>
+
+esp_err_t dsps_yin_init_f32(yin_f32_t *yin, float *buff, int tau_min, int tau_max, int win, int hop, float threshold)
+{
+    if ((yin == NULL) || (buff == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((tau_min < 2) || (tau_max <= tau_min) || (hop <= 0) || (win < hop) || (win % hop)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((threshold <= 0) || (threshold >= 1)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int lags = tau_max + 1;
+    yin->n_blocks = win / hop;
+    memset(buff, 0, ((yin->n_blocks + 1) * lags + tau_max + hop) * sizeof(float));
+    yin->blocks = buff;
+    yin->diff = yin->blocks + yin->n_blocks * lags;
+    yin->hist = yin->diff + lags;
+    yin->threshold = threshold;
+    yin->tau_min = tau_min;
+    yin->tau_max = tau_max;
+    yin->win = win;
+    yin->hop = hop;
+    yin->block = 0;
+    yin->count = 0;
+    yin->filled = 0;
+    return ESP_OK;
+}
+
+// Estimate the period from the difference function of the window, returns confidence
+static float dsps_yin_estimate(yin_f32_t *yin, float *period)
+{
+    int lags = yin->tau_max + 1;
+    float *diff = yin->diff;
+    // Window sum of the blocks and the cumulative mean normalization
+    float cum = 0;
+    diff[0] = 1;
+    for (int tau = 1; tau < lags; tau++) {
+        float d = 0;
+        for (int b = 0; b < yin->n_blocks; b++) {
+            d += yin->blocks[b * lags + tau];
+        }
+        cum += d;
+        diff[tau] = (cum > 0) ? d * tau / cum : 1;
+    }
+    // First minimum below the threshold, or the global minimum
+    int best = yin->tau_min;
+    for (int tau = yin->tau_min; tau <= yin->tau_max; tau++) {
+        if (diff[tau] < yin->threshold) {
+            while ((tau < yin->tau_max) && (diff[tau + 1] < diff[tau])) {
+                tau++;
+            }
+            best = tau;
+            break;
+        }
+        if (diff[tau] < diff[best]) {
+            best = tau;
+        }
+    }
+    // Parabolic interpolation of the minimum
+    float p = best;
+    float val = diff[best];
+    if ((best > yin->tau_min) && (best < yin->tau_max)) {
+        float a = diff[best - 1];
+        float b = diff[best];
+        float c = diff[best + 1];
+        float den = a - 2 * b + c;
+        if (den > 0) {
+            float delta = 0.5f * (a - c) / den;
+            p += delta;
+            val = b - 0.25f * (a - c) * delta;
+        }
+    }
+    *period = p;
+    float conf = 1 - val;
+    return (conf < 0) ? 0 : ((conf > 1) ? 1 : conf);
+}
+
+int dsps_yin_f32(yin_f32_t *yin, const float *input, int len, float *period, float *confidence, int max_frames)
+{
+    int lags = yin->tau_max + 1;
+    int frames = 0;
+    // The current block starts after tau_max samples of history
+    float *cur = yin->hist + yin->tau_max;
+    for (int i = 0; i < len; i++) {
+        cur[yin->count++] = input[i];
+        if (yin->filled < yin->win + yin->tau_max) {
+            yin->filled++;
+        }
+        if (yin->count < yin->hop) {
+            continue;
+        }
+        yin->count = 0;
+        // Partial sums of the block: sum((x[k] - x[k - tau])^2)
+        float *blk = &yin->blocks[yin->block * lags];
+        blk[0] = 0;
+        for (int tau = 1; tau < lags; tau++) {
+            const float *old = cur - tau;
+            float acc = 0;
+            for (int k = 0; k < yin->hop; k++) {
+                float e = cur[k] - old[k];
+                acc += e * e;
+            }
+            blk[tau] = acc;
+        }
+        memmove(yin->hist, yin->hist + yin->hop, yin->tau_max * sizeof(float));
+        if (yin->filled >= yin->win + yin->tau_max) {
+            float p;
+            float conf = dsps_yin_estimate(yin, &p);
+            if (frames < max_frames) {
+                if (period != NULL) {
+                    period[frames] = p;
+                }
+                if (confidence != NULL) {
+                    confidence[frames] = conf;
+                }
+                frames++;
+            }
+        }
+        // The oldest block is replaced by the next one
+        yin->block++;
+        if (yin->block >= yin->n_blocks) {
+            yin->block = 0;
+        }
+    }
+    return frames;
+}
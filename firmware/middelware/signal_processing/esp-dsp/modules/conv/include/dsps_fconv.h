@@ -0,0 +1,147 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fconv_H_
+#define _dsps_fconv_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Mode of the fast convolution
+ */
+typedef enum dsps_fconv_mode_e {
+    DSPS_FCONV_AUTO = 0,    /*!< Measure both methods in init and use the faster one. Direct form if FFT is not possible.*/
+    DSPS_FCONV_FFT = 1,     /*!< Always use FFT (overlap-save/overlap-add).*/
+    DSPS_FCONV_DIRECT = 2,  /*!< Always use direct form.*/
+} dsps_fconv_mode_t;
+
+/**
+ * @brief Data struct of f32 fast convolution
+ *
+ * This structure is used by a convolution internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_fconv_init_f32(...) function.
+ */
+typedef struct fconv_f32_s {
+    const float *kernel;    /*!< Pointer to the kernel.*/
+    float  *kernel_fft;     /*!< FFT of the kernel scaled by 1/fft_len, in bit reversed order. Length of 2*fft_len.*/
+    float  *work;           /*!< Complex work buffer. Length of 2*fft_len.*/
+    float  *kernel_buff;    /*!< Internal copy of the kernel, allocated by dsps_fcorr_init_f32(...), or NULL.*/
+    float  *delay;          /*!< Input history: kernel_len - 1 samples for FFT, double delay line of 2*kernel_len for direct form.*/
+    int     kernel_len;     /*!< Length of the kernel.*/
+    int     fft_len;        /*!< Length of the FFT.*/
+    int     step;           /*!< New samples per FFT segment: fft_len - kernel_len + 1.*/
+    int     pos;            /*!< Position in the direct form delay line.*/
+    int     direct;         /*!< Direct form is used.*/
+    float   cycles_fft;     /*!< Measured cycles per output sample with FFT. 0 if not measured.*/
+    float   cycles_direct;  /*!< Measured cycles per output sample with direct form. 0 if not measured.*/
+} fconv_f32_t;
+
+/**
+ * @brief   initialize structure for fast convolution
+ *
+ * Function precalculates the FFT of the kernel and allocates the buffers.
+ * The FFT tables must be initialized before by dsps_fft2r_init_fc32(...) with size not less than the FFT length.
+ * With fft_len = 0 the FFT length is selected by a cost model N*(log2(N) + 2)/(N - kernel_len + 1),
+ * within the size of the initialized FFT table.
+ * In DSPS_FCONV_AUTO mode both methods are timed on a zero block and the faster one is used,
+ * so short kernels fall back to the direct form. The direct form is used as well, if the FFT tables
+ * are not initialized or the kernel is too long for them.
+ * Buffers must be released by dsps_fconv_free_f32(...)
+ *
+ * @param fconv: pointer to the convolution structure, that must be preallocated
+ * @param kernel: convolution kernel (FIR filter coefficients). Must stay valid while the structure is used
+ * @param kernel_len: length of the kernel
+ * @param fft_len: length of the FFT (power of two, at least 2*kernel_len) or 0 for automatic selection
+ * @param mode: convolution method
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fconv_init_f32(fconv_f32_t *fconv, const float *kernel, int kernel_len, int fft_len, dsps_fconv_mode_t mode);
+
+/**
+ * @brief   Streaming FIR filter by fast convolution (overlap-save)
+ *
+ * Function calculates output[n] = sum(kernel[k] * input[n - k]), the history of the input
+ * is kept in the structure, so the signal could be processed by blocks of any length.
+ * Two segments are transformed at once as real and imaginary part of one complex FFT.
+ *
+ * @param fconv: pointer to the convolution structure, that must be initialized before
+ * @param input: input array
+ * @param output: output array. Length of len
+ * @param len: length of input and output arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fconv_f32(fconv_f32_t *fconv, const float *input, float *output, int len);
+
+/**
+ * @brief   Full convolution by fast convolution (overlap-add)
+ *
+ * Function gives the same result as dsps_conv_f32(signal, siglen, kernel, kernel_len, convout).
+ * The history of the streaming filter is not used and not modified.
+ *
+ * @param fconv: pointer to the convolution structure, that must be initialized before
+ * @param signal: input array with signal
+ * @param siglen: length of the input signal
+ * @param convout: output array with convolution result length of (siglen + kernel_len - 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fconv_conv_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *convout);
+
+/**
+ * @brief   Valid part of convolution by fast convolution
+ *
+ * Function calculates only outputs, where the kernel fully overlaps the signal:
+ * output[n] = sum(kernel[k] * signal[n + kernel_len - 1 - k]), n = 0..siglen - kernel_len.
+ * The history of the streaming filter is not used and not modified.
+ *
+ * @param fconv: pointer to the convolution structure, that must be initialized before
+ * @param signal: input array with signal
+ * @param siglen: length of the input signal, not less than kernel length
+ * @param output: output array. Length of (siglen - kernel_len + 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fconv_valid_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *output);
+
+/**
+ * @brief   support arrays freeing function
+ *
+ * @param fconv: pointer to the convolution structure, that must be initialized before
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t dsps_fconv_free_f32(fconv_f32_t *fconv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fconv_H_
@@ -0,0 +1,105 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fcorr_H_
+#define _dsps_fcorr_H_
+
+#include "dsp_err.h"
+#include "dsps_fconv.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief   initialize structure for fast correlation
+ *
+ * Correlation is calculated as fast convolution with the reversed pattern, so the
+ * same structure, FFT tables and buffers are used as for dsps_fconv_xxx functions.
+ * The pattern is copied, the copy is released by dsps_fconv_free_f32(...)
+ *
+ * @param fconv: pointer to the convolution structure, that must be preallocated
+ * @param pattern: correlation pattern
+ * @param patlen: length of the pattern
+ * @param fft_len: length of the FFT or 0 for automatic selection. See dsps_fconv_init_f32(...)
+ * @param mode: correlation method. See dsps_fconv_init_f32(...)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fcorr_init_f32(fconv_f32_t *fconv, const float *pattern, int patlen, int fft_len, dsps_fconv_mode_t mode);
+
+/**
+ * @brief   Correlation with pattern by FFT
+ *
+ * Function gives the same result as dsps_corr_f32(signal, siglen, pattern, patlen, dest):
+ * dest[n] = sum(signal[n + m] * pattern[m]), n = 0..siglen - patlen.
+ *
+ * @param fconv: pointer to the structure, initialized by dsps_fcorr_init_f32(...)
+ * @param signal: input array with signal
+ * @param siglen: length of the signal, not less than patlen
+ * @param dest: output array. Length of (siglen - patlen + 1)
+ * @param lag: position of the pattern in the signal with maximum correlation, refined by
+ *             parabolic interpolation. Could be NULL
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fcorr_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *dest, float *lag);
+
+/**
+ * @brief   Cross correlation by FFT
+ *
+ * Function gives the same result as dsps_ccorr_f32(signal, siglen, pattern, patlen, corrvout)
+ * for siglen >= patlen: corrvout[n] = sum(signal[k + n - (patlen - 1)] * pattern[k]).
+ *
+ * @param fconv: pointer to the structure, initialized by dsps_fcorr_init_f32(...)
+ * @param signal: input array with signal
+ * @param siglen: length of the signal
+ * @param corrvout: output array. Length of (siglen + patlen - 1)
+ * @param lag: shift of the signal against the pattern with maximum correlation
+ *             (corrvout index - (patlen - 1)), refined by parabolic interpolation.
+ *             Positive value means that the pattern is delayed in the signal. Could be NULL
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fccorr_f32(fconv_f32_t *fconv, const float *signal, int siglen, float *corrvout, float *lag);
+
+/**
+ * @brief   Position of maximum with sub-sample refinement
+ *
+ * Function finds the maximum of the array and fits parabola through the maximum and
+ * its neighbours. The vertex of the parabola is returned.
+ *
+ * @param[in] data: input array, for example result of correlation
+ * @param len: length of the array
+ * @param position: fractional index of the maximum
+ * @param value: interpolated value of the maximum. Could be NULL
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_corr_peak_f32(const float *data, int len, float *position, float *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fcorr_H_
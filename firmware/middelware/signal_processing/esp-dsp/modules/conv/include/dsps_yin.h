@@ -0,0 +1,95 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_yin_H_
+#define _dsps_yin_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 streaming period estimator
+ *
+ * This structure is used by the estimator internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_yin_init_f32(...) function.
+ */
+typedef struct yin_f32_s {
+    float  *hist;       /*!< Last tau_max samples before the current block and the samples of the current block.*/
+    float  *blocks;     /*!< Partial sums of the difference function of the last win/hop blocks. tau_max + 1 lags per block.*/
+    float  *diff;       /*!< Difference function of the window, normalized by the cumulative mean. Lags 0..tau_max.*/
+    float   threshold;  /*!< Absolute threshold of the normalized difference.*/
+    int     tau_min;    /*!< Minimum lag, samples.*/
+    int     tau_max;    /*!< Maximum lag, samples.*/
+    int     win;        /*!< Length of the integration window, samples.*/
+    int     hop;        /*!< Amount of samples between estimations.*/
+    int     n_blocks;   /*!< Amount of blocks in the window: win/hop.*/
+    int     block;      /*!< Current block.*/
+    int     count;      /*!< Amount of samples in the current block.*/
+    int     filled;     /*!< Amount of received samples, saturated to win + tau_max.*/
+} yin_f32_t;
+
+/**
+ * @brief   initialize structure for streaming period estimator
+ *
+ * @param yin: pointer to the estimator structure, that must be preallocated
+ * @param buff: working buffer. Length of (win/hop + 1)*(tau_max + 1) + tau_max + hop
+ * @param tau_min: minimum period, samples. Not less than 2
+ * @param tau_max: maximum period, samples
+ * @param win: length of the integration window, multiple of hop. Typically 1..2 of tau_max
+ * @param hop: amount of samples between estimations
+ * @param threshold: threshold of the normalized difference, typically 0.1..0.2
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_yin_init_f32(yin_f32_t *yin, float *buff, int tau_min, int tau_max, int win, int hop, float threshold);
+
+/**
+ * @brief   Streaming period estimator (YIN)
+ *
+ * Fundamental period of a periodic signal by the YIN method: difference function
+ * d(tau) = sum((x[k] - x[k - tau])^2) over the last win samples, normalized by its cumulative mean,
+ * the first minimum below the threshold (or the global minimum) in the range tau_min..tau_max
+ * and parabolic interpolation of the minimum.
+ * The difference function is updated incrementally: when hop samples are received, the partial sums
+ * of the block are calculated for all lags, and the window sum is the sum of win/hop blocks.
+ * The cost is (hop + win/hop + 5)*tau_max per estimation, instead of win*tau_max for the direct
+ * calculation. The partial sums are exact, so the rounding errors do not accumulate.
+ * An estimation is made every hop samples, after win + tau_max samples are received.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param yin: pointer to the estimator structure, that must be initialized before
+ * @param[in] input: input array
+ * @param len: length of input array
+ * @param period: estimated periods in samples, with fractional part. Could be NULL
+ * @param confidence: confidence of the estimations: 1 - normalized difference at the period, 0..1.
+ *                    Values above 1 - threshold mean a periodic signal. Could be NULL
+ * @param max_frames: length of period and confidence arrays. If more estimations are made, they are lost
+ *
+ * @return
+ *      - amount of estimations made in the block
+ */
+int dsps_yin_f32(yin_f32_t *yin, const float *input, int len, float *period, float *confidence, int max_frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_yin_H_
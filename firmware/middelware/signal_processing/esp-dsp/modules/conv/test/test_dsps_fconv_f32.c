@@ -0,0 +1,171 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fconv.h"
+#include "dsps_conv.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fconv_f32";
+
+#define SIG_LEN     1000
+#define KERN_MAX    512
+#define BENCH_LEN   2048
+
+static float signal[BENCH_LEN];
+static float kernel[KERN_MAX];
+static float out_ref[BENCH_LEN + KERN_MAX];
+static float out_test[BENCH_LEN + KERN_MAX];
+
+static void fill_random(float *data, int len)
+{
+    for (int i = 0; i < len; i++) {
+        data[i] = (float)rand() / RAND_MAX * 2 - 1;
+    }
+}
+
+static float max_error(const float *a, const float *b, int len)
+{
+    float err = 0;
+    for (int i = 0; i < len; i++) {
+        float e = fabsf(a[i] - b[i]);
+        err = (e > err) ? e : err;
+    }
+    return err;
+}
+
+TEST_CASE("dsps_fconv_f32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    fill_random(signal, SIG_LEN);
+
+    const int kern_lens[] = {1, 7, 100, 257};
+    const int fft_lens[] = {0, 1024};
+    for (int k = 0; k < sizeof(kern_lens) / sizeof(int); k++) {
+        int m = kern_lens[k];
+        fill_random(kernel, m);
+        dsps_conv_f32_ansi(signal, SIG_LEN, kernel, m, out_ref);
+
+        for (int f = 0; f < sizeof(fft_lens) / sizeof(int); f++) {
+            for (int mode = DSPS_FCONV_FFT; mode <= DSPS_FCONV_DIRECT; mode++) {
+                fconv_f32_t fconv;
+                TEST_ESP_OK(dsps_fconv_init_f32(&fconv, kernel, m, fft_lens[f], (dsps_fconv_mode_t)mode));
+
+                // Full convolution by overlap-add
+                TEST_ESP_OK(dsps_fconv_conv_f32(&fconv, signal, SIG_LEN, out_test));
+                float err = max_error(out_ref, out_test, SIG_LEN + m - 1);
+                ESP_LOGI(TAG, "kernel %i, fft %i, mode %i: conv error %e", m, fconv.fft_len, mode, err);
+                TEST_ASSERT_LESS_THAN(100, (int)(1000000 * err / sqrtf(m)));
+
+                // Streaming by blocks of random length is equal to the head of the full convolution
+                int pos = 0;
+                while (pos < SIG_LEN) {
+                    int len = rand() % 300;
+                    len = (pos + len > SIG_LEN) ? SIG_LEN - pos : len;
+                    TEST_ESP_OK(dsps_fconv_f32(&fconv, &signal[pos], &out_test[pos], len));
+                    pos += len;
+                }
+                err = max_error(out_ref, out_test, SIG_LEN);
+                ESP_LOGI(TAG, "kernel %i, fft %i, mode %i: stream error %e", m, fconv.fft_len, mode, err);
+                TEST_ASSERT_LESS_THAN(100, (int)(1000000 * err / sqrtf(m)));
+                dsps_fconv_free_f32(&fconv);
+            }
+        }
+    }
+
+    fconv_f32_t fconv;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fconv_init_f32(&fconv, kernel, 100, 128, DSPS_FCONV_FFT));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fconv_init_f32(&fconv, kernel, 100, 300, DSPS_FCONV_FFT));
+    dsps_fft2r_deinit_fc32();
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fconv_init_f32(&fconv, kernel, 100, 0, DSPS_FCONV_FFT));
+}
+
+TEST_CASE("dsps_fconv_f32 automatic fallback to direct form", "[dsps]")
+{
+    fill_random(signal, SIG_LEN);
+    fill_random(kernel, KERN_MAX);
+    dsps_conv_f32_ansi(signal, SIG_LEN, kernel, KERN_MAX, out_ref);
+
+    // FFT tables are not initialized, then the kernel is too long for the initialized table
+    for (int i = 0; i < 2; i++) {
+        dsps_fft2r_deinit_fc32();
+        if (i == 1) {
+            TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, 512));
+        }
+        fconv_f32_t fconv;
+        TEST_ESP_OK(dsps_fconv_init_f32(&fconv, kernel, KERN_MAX, 0, DSPS_FCONV_AUTO));
+        TEST_ASSERT_EQUAL(1, fconv.direct);
+        TEST_ESP_OK(dsps_fconv_f32(&fconv, signal, out_test, SIG_LEN));
+        float err = max_error(out_ref, out_test, SIG_LEN);
+        ESP_LOGI(TAG, "fallback %i: stream error %e", i, err);
+        TEST_ASSERT_LESS_THAN(100, (int)(1000000 * err / sqrtf(KERN_MAX)));
+        dsps_fconv_free_f32(&fconv);
+        // FFT mode reports the error
+        esp_err_t expected = (i == 0) ? ESP_ERR_DSP_UNINITIALIZED : ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        TEST_ASSERT_EQUAL(expected, dsps_fconv_init_f32(&fconv, kernel, KERN_MAX, 0, DSPS_FCONV_FFT));
+    }
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_fconv_f32 benchmark", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    fill_random(signal, BENCH_LEN);
+    fill_random(kernel, KERN_MAX);
+
+    int crossover = 0;
+    float fft_cycles = 0;
+    float direct_cycles = 0;
+    for (int m = 4; m <= KERN_MAX; m <<= 1) {
+        fconv_f32_t fft;
+        fconv_f32_t direct;
+        fconv_f32_t automatic;
+        TEST_ESP_OK(dsps_fconv_init_f32(&fft, kernel, m, 0, DSPS_FCONV_FFT));
+        TEST_ESP_OK(dsps_fconv_init_f32(&direct, kernel, m, 0, DSPS_FCONV_DIRECT));
+        TEST_ESP_OK(dsps_fconv_init_f32(&automatic, kernel, m, 0, DSPS_FCONV_AUTO));
+
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_fconv_f32(&fft, signal, out_test, BENCH_LEN);
+        unsigned int end_b = dsp_get_cpu_cycle_count();
+        fft_cycles = (float)(end_b - start_b) / BENCH_LEN;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fconv_f32(&direct, signal, out_ref, BENCH_LEN);
+        end_b = dsp_get_cpu_cycle_count();
+        direct_cycles = (float)(end_b - start_b) / BENCH_LEN;
+
+        if ((crossover == 0) && (fft_cycles < direct_cycles)) {
+            crossover = m;
+        }
+        ESP_LOGI(TAG, "kernel %3i: fft %4i: %8.2f, direct: %8.2f cycles per sample, auto selected %s (%.2f/%.2f)",
+                 m, fft.fft_len, fft_cycles, direct_cycles, automatic.direct ? "direct" : "fft",
+                 automatic.cycles_fft, automatic.cycles_direct);
+        dsps_fconv_free_f32(&fft);
+        dsps_fconv_free_f32(&direct);
+        dsps_fconv_free_f32(&automatic);
+    }
+    ESP_LOGI(TAG, "FFT is faster from kernel length %i", crossover);
+    dsps_fft2r_deinit_fc32();
+
+    ESP_LOGI(TAG, "Longest kernel: FFT speedup %.2f", direct_cycles / fft_cycles);
+    TEST_ASSERT_EXEC_IN_RANGE(2, KERN_MAX * 2, (int)fft_cycles);
+}
@@ -0,0 +1,168 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fcorr.h"
+#include "dsps_corr.h"
+#include "dsps_ccorr.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fcorr_f32";
+
+#define SIG_LEN     1024
+#define PAT_MAX     512
+
+static float signal[SIG_LEN];
+static float pattern[PAT_MAX];
+static float out_ref[SIG_LEN + PAT_MAX];
+static float out_test[SIG_LEN + PAT_MAX];
+
+static void fill_random(float *data, int len)
+{
+    for (int i = 0; i < len; i++) {
+        data[i] = (float)rand() / RAND_MAX * 2 - 1;
+    }
+}
+
+static float max_error(const float *a, const float *b, int len)
+{
+    float err = 0;
+    for (int i = 0; i < len; i++) {
+        float e = fabsf(a[i] - b[i]);
+        err = (e > err) ? e : err;
+    }
+    return err;
+}
+
+// Hann windowed tone burst, t in samples
+static float burst(float t, int len)
+{
+    if ((t < 0) || (t > len - 1)) {
+        return 0;
+    }
+    return 0.5f * (1 - cosf(2 * M_PI * t / (len - 1))) * sinf(2 * M_PI * 0.1f * t);
+}
+
+TEST_CASE("dsps_fcorr_f32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    fill_random(signal, SIG_LEN);
+
+    const int pat_lens[] = {5, 64, 300};
+    for (int p = 0; p < sizeof(pat_lens) / sizeof(int); p++) {
+        int m = pat_lens[p];
+        fill_random(pattern, m);
+        for (int mode = DSPS_FCONV_FFT; mode <= DSPS_FCONV_DIRECT; mode++) {
+            fconv_f32_t fcorr;
+            TEST_ESP_OK(dsps_fcorr_init_f32(&fcorr, pattern, m, 0, (dsps_fconv_mode_t)mode));
+
+            dsps_corr_f32_ansi(signal, SIG_LEN, pattern, m, out_ref);
+            TEST_ESP_OK(dsps_fcorr_f32(&fcorr, signal, SIG_LEN, out_test, NULL));
+            float err_corr = max_error(out_ref, out_test, SIG_LEN - m + 1);
+
+            dsps_ccorr_f32_ansi(signal, SIG_LEN, pattern, m, out_ref);
+            TEST_ESP_OK(dsps_fccorr_f32(&fcorr, signal, SIG_LEN, out_test, NULL));
+            float err_ccorr = max_error(out_ref, out_test, SIG_LEN + m - 1);
+
+            ESP_LOGI(TAG, "pattern %i, mode %i: corr error %e, ccorr error %e", m, mode, err_corr, err_ccorr);
+            TEST_ASSERT_LESS_THAN(100, (int)(1000000 * err_corr / sqrtf(m)));
+            TEST_ASSERT_LESS_THAN(100, (int)(1000000 * err_ccorr / sqrtf(m)));
+            dsps_fconv_free_f32(&fcorr);
+        }
+    }
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_fcorr_f32 lag estimation", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    const int m = 64;
+    for (int i = 0; i < m; i++) {
+        pattern[i] = burst(i, m);
+    }
+    const float delays[] = {0, 10.25f, 123.4f, 500.5f, 900.8f};
+    for (int d = 0; d < sizeof(delays) / sizeof(float); d++) {
+        // Echo with fractional delay and noise
+        for (int i = 0; i < SIG_LEN; i++) {
+            signal[i] = 0.5f * burst(i - delays[d], m) + 0.01f * ((float)rand() / RAND_MAX - 0.5f);
+        }
+        fconv_f32_t fcorr;
+        TEST_ESP_OK(dsps_fcorr_init_f32(&fcorr, pattern, m, 0, DSPS_FCONV_FFT));
+        float lag_valid = 0;
+        float lag_full = 0;
+        TEST_ESP_OK(dsps_fcorr_f32(&fcorr, signal, SIG_LEN, out_test, &lag_valid));
+        TEST_ESP_OK(dsps_fccorr_f32(&fcorr, signal, SIG_LEN, out_test, &lag_full));
+        ESP_LOGI(TAG, "delay %f: lag %f (valid), %f (full)", delays[d], lag_valid, lag_full);
+        TEST_ASSERT_FLOAT_WITHIN(0.15, delays[d], lag_valid);
+        TEST_ASSERT_FLOAT_WITHIN(0.15, delays[d], lag_full);
+        dsps_fconv_free_f32(&fcorr);
+    }
+
+    float pos = 0;
+    float val = 0;
+    const float parabola[] = {0, 1, 3, 4, 3.5f, 1};
+    TEST_ESP_OK(dsps_corr_peak_f32(parabola, 6, &pos, &val));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 3 + 0.5f * (3 - 3.5f) / (3 - 8 + 3.5f), pos);
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_fcorr_f32 benchmark", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    fill_random(signal, SIG_LEN);
+    fill_random(pattern, PAT_MAX);
+
+    unsigned int direct_cycles = 0;
+    unsigned int fft_cycles = 0;
+    for (int m = 16; m <= PAT_MAX; m <<= 1) {
+        fconv_f32_t fcorr;
+        TEST_ESP_OK(dsps_fcorr_init_f32(&fcorr, pattern, m, 0, DSPS_FCONV_FFT));
+
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_corr_f32(signal, SIG_LEN, pattern, m, out_ref);
+        unsigned int end_b = dsp_get_cpu_cycle_count();
+        direct_cycles = end_b - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fcorr_f32(&fcorr, signal, SIG_LEN, out_test, NULL);
+        end_b = dsp_get_cpu_cycle_count();
+        fft_cycles = end_b - start_b;
+
+        unsigned int start_c = dsp_get_cpu_cycle_count();
+        dsps_ccorr_f32(signal, SIG_LEN, pattern, m, out_ref);
+        unsigned int end_c = dsp_get_cpu_cycle_count();
+        unsigned int direct_full = end_c - start_c;
+
+        start_c = dsp_get_cpu_cycle_count();
+        dsps_fccorr_f32(&fcorr, signal, SIG_LEN, out_test, NULL);
+        end_c = dsp_get_cpu_cycle_count();
+        unsigned int fft_full = end_c - start_c;
+
+        ESP_LOGI(TAG, "signal %i, pattern %3i, fft %4i: corr %8i / %8i, ccorr %8i / %8i cycles (direct / fft)",
+                 SIG_LEN, m, fcorr.fft_len, direct_cycles, fft_cycles, direct_full, fft_full);
+        dsps_fconv_free_f32(&fcorr);
+    }
+    dsps_fft2r_deinit_fc32();
+
+    ESP_LOGI(TAG, "Longest pattern: FFT speedup %.2f", (float)direct_cycles / fft_cycles);
+    TEST_ASSERT_EXEC_IN_RANGE(2, SIG_LEN * PAT_MAX, fft_cycles);
+}
@@ -0,0 +1,156 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_yin.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_yin_f32";
+
+#define SIG_LEN     4000
+#define TAU_MIN     10
+#define TAU_MAX     200
+#define WIN         256
+#define HOP         64
+#define MAX_FRAMES  (SIG_LEN / HOP)
+
+static float x[SIG_LEN];
+static float buff[(WIN / HOP + 1) * (TAU_MAX + 1) + TAU_MAX + HOP];
+static float period[MAX_FRAMES];
+static float confidence[MAX_FRAMES];
+static float diff_ref[TAU_MAX + 1];
+
+// Direct calculation of the normalized difference function of the window ending at sample end
+static void yin_ref(const float *sig, int end, int win, int tau_max)
+{
+    float cum = 0;
+    diff_ref[0] = 1;
+    for (int tau = 1; tau <= tau_max; tau++) {
+        float d = 0;
+        for (int k = end - win + 1; k <= end; k++) {
+            float e = sig[k] - sig[k - tau];
+            d += e * e;
+        }
+        cum += d;
+        diff_ref[tau] = d * tau / cum;
+    }
+}
+
+TEST_CASE("dsps_yin_f32 functionality", "[dsps]")
+{
+    // Pulse like signal: the second harmonic is stronger than the fundamental
+    const float periods[] = {23.7f, 57.2f, 150.5f};
+    for (int p = 0; p < sizeof(periods) / sizeof(float); p++) {
+        for (int i = 0; i < SIG_LEN; i++) {
+            float ph = 2 * M_PI * i / periods[p];
+            x[i] = 0.5f * sinf(ph) + sinf(2 * ph + 0.3f) + 0.3f * sinf(3 * ph + 1) + 0.01f * ((float)rand() / RAND_MAX - 0.5f);
+        }
+        yin_f32_t yin;
+        TEST_ESP_OK(dsps_yin_init_f32(&yin, buff, TAU_MIN, TAU_MAX, WIN, HOP, 0.15f));
+        // Blocks of random length
+        int pos = 0;
+        int n = 0;
+        while (pos < SIG_LEN) {
+            int block = rand() % 200;
+            block = (block > SIG_LEN - pos) ? SIG_LEN - pos : block;
+            n += dsps_yin_f32(&yin, &x[pos], block, &period[n], &confidence[n], MAX_FRAMES - n);
+            pos += block;
+        }
+        TEST_ASSERT_EQUAL(SIG_LEN / HOP - (WIN + TAU_MAX + HOP - 1) / HOP + 1, n);
+        float max_err = 0;
+        for (int i = 0; i < n; i++) {
+            float err = fabsf(period[i] - periods[p]);
+            max_err = (err > max_err) ? err : max_err;
+            TEST_ASSERT_GREATER_THAN(900, (int)(1000 * confidence[i]));
+        }
+        ESP_LOGI(TAG, "period %.1f: %i estimations, max error %f, confidence %f", periods[p], n, max_err, confidence[n - 1]);
+        TEST_ASSERT_LESS_THAN(50, (int)(1000 * max_err));
+
+        // Incremental difference function is equal to the direct one for the last window
+        int end = (SIG_LEN / HOP) * HOP - 1;
+        yin_ref(x, end, WIN, TAU_MAX);
+        float diff_err = 0;
+        for (int tau = 1; tau <= TAU_MAX; tau++) {
+            float err = fabsf(diff_ref[tau] - yin.diff[tau]);
+            diff_err = (err > diff_err) ? err : diff_err;
+        }
+        ESP_LOGI(TAG, "difference function error %e", diff_err);
+        TEST_ASSERT_LESS_THAN(10, (int)(100000 * diff_err));
+    }
+
+    yin_f32_t yin;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_yin_init_f32(&yin, buff, TAU_MIN, TAU_MAX, 100, HOP, 0.15f));
+}
+
+TEST_CASE("dsps_yin_f32 noise and period change", "[dsps]")
+{
+    yin_f32_t yin;
+    // Noise has low confidence
+    for (int i = 0; i < SIG_LEN; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    TEST_ESP_OK(dsps_yin_init_f32(&yin, buff, TAU_MIN, TAU_MAX, WIN, HOP, 0.15f));
+    int n = dsps_yin_f32(&yin, x, SIG_LEN, period, confidence, MAX_FRAMES);
+    float max_conf = 0;
+    for (int i = 0; i < n; i++) {
+        max_conf = (confidence[i] > max_conf) ? confidence[i] : max_conf;
+    }
+    ESP_LOGI(TAG, "noise: max confidence %f", max_conf);
+    TEST_ASSERT_LESS_THAN(700, (int)(1000 * max_conf));
+
+    // Period changes from 40 to 90 samples in the middle of the signal
+    float ph = 0;
+    for (int i = 0; i < SIG_LEN; i++) {
+        ph += 2 * M_PI / ((i < SIG_LEN / 2) ? 40 : 90);
+        x[i] = sinf(ph) + 0.4f * sinf(2 * ph);
+    }
+    TEST_ESP_OK(dsps_yin_init_f32(&yin, buff, TAU_MIN, TAU_MAX, WIN, HOP, 0.15f));
+    n = dsps_yin_f32(&yin, x, SIG_LEN, period, confidence, MAX_FRAMES);
+    ESP_LOGI(TAG, "period change: first %f, last %f", period[0], period[n - 1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 40, period[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 90, period[n - 1]);
+}
+
+TEST_CASE("dsps_yin_f32 benchmark", "[dsps]")
+{
+    for (int i = 0; i < SIG_LEN; i++) {
+        x[i] = sinf(2 * M_PI * i / 57.2f);
+    }
+    yin_f32_t yin;
+    TEST_ESP_OK(dsps_yin_init_f32(&yin, buff, TAU_MIN, TAU_MAX, WIN, HOP, 0.15f));
+    const int frames = 16;
+    const int start = 8 * HOP;
+    dsps_yin_f32(&yin, x, start, period, confidence, MAX_FRAMES);
+    // Frame: hop samples and one estimation
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    int n = dsps_yin_f32(&yin, &x[start], frames * HOP, period, confidence, MAX_FRAMES);
+    unsigned int cycles = (dsp_get_cpu_cycle_count() - start_b) / frames;
+    TEST_ASSERT_EQUAL(frames, n);
+
+    start_b = dsp_get_cpu_cycle_count();
+    for (int f = 0; f < frames; f++) {
+        yin_ref(x, start + (f + 1) * HOP - 1, WIN, TAU_MAX);
+    }
+    unsigned int cycles_direct = (dsp_get_cpu_cycle_count() - start_b) / frames;
+    ESP_LOGI(TAG, "window %i, lags %i, hop %i: incremental %i cycles per frame, direct difference function %i cycles",
+             WIN, TAU_MAX, HOP, cycles, cycles_direct);
+    TEST_ASSERT_EXEC_IN_RANGE(HOP * TAU_MAX / 2, 50 * HOP * TAU_MAX, cycles);
+}
@@ -0,0 +1,74 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_dwt_common.h"
+#include <math.h>
+
+// Lifting coefficients in Q16
+#define DWT_Q   16
+
+// One lifting step of the level with rounding: y[i] += sign*round(c[0]*x[i - 1] + c[1]*x[i] + c[2]*x[i + 1]).
+// The x component is not changed by the step, so the inverse step subtracts exactly the same value.
+static void dsps_dwt_lift_s32(int32_t *data, int n, int stride, const dwt_lifting_t *lift, int step, int sign)
+{
+    int target = lift->target[step];
+    int32_t c[3];
+    for (int k = 0; k < 3; k++) {
+        c[k] = (int32_t)lroundf(lift->coeffs[step][k] * (1 << DWT_Q));
+    }
+    int32_t *y = data + target * stride;
+    const int32_t *x = data + (1 - target) * stride;
+    int inc = 2 * stride;
+    for (int i = 0; i < n; i++) {
+        int im = i - 1;
+        int ip = i + 1;
+        if ((i == 0) || (i == n - 1)) {
+            im = dsps_dwt_ext(im, n, !target, lift->periodic);
+            ip = dsps_dwt_ext(ip, n, !target, lift->periodic);
+        }
+        int64_t acc = (int64_t)c[0] * x[im * inc] + (int64_t)c[1] * x[i * inc] + (int64_t)c[2] * x[ip * inc];
+        int32_t delta = (int32_t)((acc + (1 << (DWT_Q - 1))) >> DWT_Q);
+        y[i * inc] += sign * delta;
+    }
+}
+
+esp_err_t dsps_dwt_s32(int32_t *data, int len, int levels, dsps_dwt_wavelet_t wavelet)
+{
+    const dwt_lifting_t *lift = dsps_dwt_lifting(wavelet);
+    esp_err_t ret = dsps_dwt_check(data, len, levels, lift);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int l = 0; l < levels; l++) {
+        for (int s = 0; s < lift->n_steps; s++) {
+            dsps_dwt_lift_s32(data, len >> (l + 1), 1 << l, lift, s, 1);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_idwt_s32(int32_t *data, int len, int levels, dsps_dwt_wavelet_t wavelet)
+{
+    const dwt_lifting_t *lift = dsps_dwt_lifting(wavelet);
+    esp_err_t ret = dsps_dwt_check(data, len, levels, lift);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int l = levels - 1; l >= 0; l--) {
+        for (int s = lift->n_steps - 1; s >= 0; s--) {
+            dsps_dwt_lift_s32(data, len >> (l + 1), 1 << l, lift, s, -1);
+        }
+    }
+    return ESP_OK;
+}
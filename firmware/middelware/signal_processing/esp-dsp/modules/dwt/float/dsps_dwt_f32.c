@@ -0,0 +1,133 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_dwt_common.h"
+#include <math.h>
+
+#define SQRT2   1.41421356f
+#define SQRT3   1.73205081f
+
+static const dwt_lifting_t dsps_dwt_haar = {
+    .n_steps = 2, .periodic = 1,
+    .target = {1, 0},
+    .coeffs = {{0, -1, 0}, {0, 0.5f, 0}},
+    .scale_s = SQRT2, .scale_d = 1 / SQRT2,
+};
+
+static const dwt_lifting_t dsps_dwt_cdf53 = {
+    .n_steps = 2, .periodic = 0,
+    .target = {1, 0},
+    .coeffs = {{0, -0.5f, -0.5f}, {0.25f, 0.25f, 0}},
+    .scale_s = SQRT2, .scale_d = 1 / SQRT2,
+};
+
+static const dwt_lifting_t dsps_dwt_cdf97 = {
+    .n_steps = 4, .periodic = 0,
+    .target = {1, 0, 1, 0},
+    .coeffs = {
+        {0, -1.586134342f, -1.586134342f},
+        {-0.05298011854f, -0.05298011854f, 0},
+        {0, 0.8829110762f, 0.8829110762f},
+        {0.4435068522f, 0.4435068522f, 0},
+    },
+    .scale_s = 1.149604398f, .scale_d = 1 / 1.149604398f,
+};
+
+// Daubechies, Sweldens: Factoring wavelet transforms into lifting steps
+static const dwt_lifting_t dsps_dwt_d4 = {
+    .n_steps = 3, .periodic = 1,
+    .target = {0, 1, 0},
+    .coeffs = {{0, SQRT3, 0}, {-(SQRT3 - 2) / 4, -SQRT3 / 4, 0}, {0, 0, -1}},
+    .scale_s = (SQRT3 - 1) / SQRT2, .scale_d = (SQRT3 + 1) / SQRT2,
+};
+
+const dwt_lifting_t *dsps_dwt_lifting(dsps_dwt_wavelet_t wavelet)
+{
+    switch (wavelet) {
+    case DSPS_DWT_HAAR:
+        return &dsps_dwt_haar;
+    case DSPS_DWT_CDF53:
+        return &dsps_dwt_cdf53;
+    case DSPS_DWT_CDF97:
+        return &dsps_dwt_cdf97;
+    case DSPS_DWT_D4:
+        return &dsps_dwt_d4;
+    default:
+        return NULL;
+    }
+}
+
+// One lifting step of the level: y[i] += sign*(c[0]*x[i - 1] + c[1]*x[i] + c[2]*x[i + 1])
+static void dsps_dwt_lift_f32(float *data, int n, int stride, const dwt_lifting_t *lift, int step, float sign)
+{
+    int target = lift->target[step];
+    const float *c = lift->coeffs[step];
+    float *y = data + target * stride;
+    const float *x = data + (1 - target) * stride;
+    int inc = 2 * stride;
+    for (int i = 0; i < n; i++) {
+        int im = i - 1;
+        int ip = i + 1;
+        if ((i == 0) || (i == n - 1)) {
+            im = dsps_dwt_ext(im, n, !target, lift->periodic);
+            ip = dsps_dwt_ext(ip, n, !target, lift->periodic);
+        }
+        y[i * inc] += sign * (c[0] * x[im * inc] + c[1] * x[i * inc] + c[2] * x[ip * inc]);
+    }
+}
+
+static void dsps_dwt_scale_f32(float *data, int n, int stride, float scale_s, float scale_d)
+{
+    int inc = 2 * stride;
+    for (int i = 0; i < n; i++) {
+        data[i * inc] *= scale_s;
+        data[i * inc + stride] *= scale_d;
+    }
+}
+
+esp_err_t dsps_dwt_f32(float *data, int len, int levels, dsps_dwt_wavelet_t wavelet)
+{
+    const dwt_lifting_t *lift = dsps_dwt_lifting(wavelet);
+    esp_err_t ret = dsps_dwt_check(data, len, levels, lift);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int l = 0; l < levels; l++) {
+        int stride = 1 << l;
+        int n = len >> (l + 1);
+        for (int s = 0; s < lift->n_steps; s++) {
+            dsps_dwt_lift_f32(data, n, stride, lift, s, 1);
+        }
+        dsps_dwt_scale_f32(data, n, stride, lift->scale_s, lift->scale_d);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_idwt_f32(float *data, int len, int levels, dsps_dwt_wavelet_t wavelet)
+{
+    const dwt_lifting_t *lift = dsps_dwt_lifting(wavelet);
+    esp_err_t ret = dsps_dwt_check(data, len, levels, lift);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int l = levels - 1; l >= 0; l--) {
+        int stride = 1 << l;
+        int n = len >> (l + 1);
+        dsps_dwt_scale_f32(data, n, stride, 1 / lift->scale_s, 1 / lift->scale_d);
+        for (int s = lift->n_steps - 1; s >= 0; s--) {
+            dsps_dwt_lift_f32(data, n, stride, lift, s, -1);
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,118 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_dwt_common.h"
+#include <math.h>
+
+esp_err_t dsps_dwt_threshold_f32(float *data, int len, int levels, float thr, dsps_dwt_thr_t mode)
+{
+    if (data == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    esp_err_t ret = dsps_dwt_check_len(len, levels);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Approximation coefficients are at multiples of 2^levels
+    int mask = (1 << levels) - 1;
+    for (int i = 0; i < len; i++) {
+        if ((i & mask) == 0) {
+            continue;
+        }
+        float x = data[i];
+        if (fabsf(x) <= thr) {
+            data[i] = 0;
+        } else if (mode == DSPS_DWT_THR_SOFT) {
+            data[i] = (x > 0) ? x - thr : x + thr;
+        }
+    }
+    return ESP_OK;
+}
+
+// k-th smallest item by quickselect, the array is reordered
+static float dsps_dwt_select_f32(float *data, int len, int k)
+{
+    int lo = 0;
+    int hi = len - 1;
+    while (lo < hi) {
+        float pivot = data[(lo + hi) / 2];
+        int i = lo;
+        int j = hi;
+        while (i <= j) {
+            while (data[i] < pivot) {
+                i++;
+            }
+            while (data[j] > pivot) {
+                j--;
+            }
+            if (i <= j) {
+                float t = data[i];
+                data[i] = data[j];
+                data[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return data[k];
+}
+
+esp_err_t dsps_dwt_universal_thr_f32(const float *data, int len, float *work, float *thr)
+{
+    if ((data == NULL) || (work == NULL) || (thr == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 2) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    // The finest detail coefficients are at odd positions
+    int n = len / 2;
+    for (int i = 0; i < n; i++) {
+        work[i] = fabsf(data[2 * i + 1]);
+    }
+    float median = dsps_dwt_select_f32(work, n, n / 2);
+    if ((n & 1) == 0) {
+        // Lower middle item is the maximum of the lower half
+        float lower = work[0];
+        for (int i = 1; i < n / 2; i++) {
+            lower = (work[i] > lower) ? work[i] : lower;
+        }
+        median = 0.5f * (median + lower);
+    }
+    float sigma = median / 0.6745f;
+    *thr = sigma * sqrtf(2 * logf((float)len));
+    return ESP_OK;
+}
+
+esp_err_t dsps_dwt_denoise_f32(float *data, int len, int levels, dsps_dwt_wavelet_t wavelet, dsps_dwt_thr_t mode, float *work)
+{
+    esp_err_t ret = dsps_dwt_f32(data, len, levels, wavelet);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    float thr;
+    ret = dsps_dwt_universal_thr_f32(data, len, work, &thr);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    dsps_dwt_threshold_f32(data, len, levels, thr, mode);
+    return dsps_idwt_f32(data, len, levels, wavelet);
+}
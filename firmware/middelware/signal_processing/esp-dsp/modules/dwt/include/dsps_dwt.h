@@ -0,0 +1,178 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_dwt_H_
+#define _dsps_dwt_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_DWT_MAX_STEPS  4   /*!< Maximum amount of lifting steps of a wavelet.*/
+
+/**
+ * @brief Wavelet of the lifting scheme transform
+ */
+typedef enum dsps_dwt_wavelet_e {
+    DSPS_DWT_HAAR = 0,      /*!< Haar wavelet.*/
+    DSPS_DWT_CDF53,         /*!< Cohen-Daubechies-Feauveau 5/3 biorthogonal wavelet (LeGall, lossless JPEG 2000).*/
+    DSPS_DWT_CDF97,         /*!< Cohen-Daubechies-Feauveau 9/7 biorthogonal wavelet (lossy JPEG 2000).*/
+    DSPS_DWT_D4,            /*!< Daubechies orthogonal wavelet with 4 coefficients (db2).*/
+} dsps_dwt_wavelet_t;
+
+/**
+ * @brief Thresholding mode of wavelet coefficients
+ */
+typedef enum dsps_dwt_thr_e {
+    DSPS_DWT_THR_HARD = 0,  /*!< Coefficients below the threshold are set to zero, others are kept.*/
+    DSPS_DWT_THR_SOFT,      /*!< Coefficients below the threshold are set to zero, others are shrunk by the threshold.*/
+} dsps_dwt_thr_t;
+
+/**
+ * @brief Lifting steps of a wavelet
+ *
+ * Every step updates one polyphase component (s - even samples, d - odd samples) of the level
+ * by the weighted sum of three neighbours of the other component: y[i] += c[0]*x[i - 1] + c[1]*x[i] + c[2]*x[i + 1].
+ * This structure is used by the transforms internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ */
+typedef struct dwt_lifting_s {
+    int     n_steps;                        /*!< Amount of lifting steps.*/
+    int     periodic;                       /*!< Boundary extension: 1 - periodic, 0 - symmetric.*/
+    int     target[DSPS_DWT_MAX_STEPS];     /*!< Updated component of the step: 0 - s, 1 - d.*/
+    float   coeffs[DSPS_DWT_MAX_STEPS][3];  /*!< Weights of x[i - 1], x[i], x[i + 1] of the step.*/
+    float   scale_s;                        /*!< Normalization of the s component (float transform only).*/
+    float   scale_d;                        /*!< Normalization of the d component (float transform only).*/
+} dwt_lifting_t;
+
+/**
+ * @brief   Lifting steps of the wavelet
+ *
+ * @param wavelet: wavelet
+ *
+ * @return
+ *      - pointer to the lifting steps, or NULL for unknown wavelet
+ */
+const dwt_lifting_t *dsps_dwt_lifting(dsps_dwt_wavelet_t wavelet);
+
+/**@{*/
+/**
+ * @brief   Discrete wavelet transform
+ *
+ * Multi level wavelet transform by the lifting scheme, in place.
+ * The coefficients are stored interleaved (in-place layout): after the transform of L levels
+ * the approximation coefficient k is data[k*2^L] and the detail coefficient k of the
+ * level l (1 - finest) is data[(2*k + 1)*2^(l - 1)].
+ * Haar and D4 are orthonormal with periodic extension of the signal, CDF wavelets use symmetric
+ * extension and are normalized to DC gain of sqrt(2) per level.
+ * The s32 transform is integer to integer: every lifting step is rounded, the normalization is
+ * skipped, so the inverse transform reconstructs the input exactly. The coefficients grow up
+ * to about 2 bits per level, the input must have enough headroom (for example 16 bit data).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param data: input/output array
+ * @param len: length of data array, multiple of 2^levels
+ * @param levels: amount of decomposition levels
+ * @param wavelet: wavelet
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dwt_f32(float *data, int len, int levels, dsps_dwt_wavelet_t wavelet);
+esp_err_t dsps_dwt_s32(int32_t *data, int len, int levels, dsps_dwt_wavelet_t wavelet);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   Inverse discrete wavelet transform
+ *
+ * Inverse of dsps_dwt_xxx(...) with the same parameters, in place.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param data: input/output array
+ * @param len: length of data array, multiple of 2^levels
+ * @param levels: amount of decomposition levels
+ * @param wavelet: wavelet
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_idwt_f32(float *data, int len, int levels, dsps_dwt_wavelet_t wavelet);
+esp_err_t dsps_idwt_s32(int32_t *data, int len, int levels, dsps_dwt_wavelet_t wavelet);
+/**@}*/
+
+/**
+ * @brief   Threshold of wavelet detail coefficients
+ *
+ * Function applies the threshold to all detail coefficients of the transform by dsps_dwt_f32(...),
+ * the approximation coefficients are kept.
+ *
+ * @param data: wavelet coefficients
+ * @param len: length of data array, multiple of 2^levels
+ * @param levels: amount of decomposition levels of the transform
+ * @param thr: threshold
+ * @param mode: hard or soft threshold
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dwt_threshold_f32(float *data, int len, int levels, float thr, dsps_dwt_thr_t mode);
+
+/**
+ * @brief   Universal threshold
+ *
+ * Donoho-Johnstone universal threshold sigma*sqrt(2*ln(len)), with the noise level estimated from
+ * the finest detail coefficients: sigma = median(|d|)/0.6745.
+ * The estimation is exact for orthonormal wavelets (Haar, D4) and close for CDF wavelets.
+ *
+ * @param data: wavelet coefficients
+ * @param len: length of data array
+ * @param work: working buffer. Length of len/2
+ * @param[out] thr: threshold
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dwt_universal_thr_f32(const float *data, int len, float *work, float *thr);
+
+/**
+ * @brief   Wavelet denoising
+ *
+ * Forward transform, universal threshold of the detail coefficients and inverse transform, in place.
+ *
+ * @param data: input/output array
+ * @param len: length of data array, multiple of 2^levels
+ * @param levels: amount of decomposition levels
+ * @param wavelet: wavelet
+ * @param mode: hard or soft threshold
+ * @param work: working buffer. Length of len/2
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dwt_denoise_f32(float *data, int len, int levels, dsps_dwt_wavelet_t wavelet, dsps_dwt_thr_t mode, float *work);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_dwt_H_
@@ -0,0 +1,54 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_dwt_common_H_
+#define _dsps_dwt_common_H_
+
+#include "dsps_dwt.h"
+
+// Internal helpers of the f32 and s32 transforms
+
+// Index of the neighbour k of the component (is_d - odd samples) with n items, outside of the level
+static inline int dsps_dwt_ext(int k, int n, int is_d, int periodic)
+{
+    if (periodic) {
+        return (k + n) % n;
+    }
+    // Whole sample symmetric extension of the level signal
+    if (k < 0) {
+        k = is_d ? -k - 1 : -k;
+    } else if (k >= n) {
+        k = is_d ? 2 * n - 2 - k : 2 * n - 1 - k;
+    }
+    return (k < 0) ? 0 : ((k >= n) ? n - 1 : k);
+}
+
+// Length must be a multiple of 2^levels, so each level has the same amount of s and d coefficients
+static inline esp_err_t dsps_dwt_check_len(int len, int levels)
+{
+    if ((len <= 0) || (levels <= 0) || (levels > 30) || (len % (1 << levels))) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    return ESP_OK;
+}
+
+static inline esp_err_t dsps_dwt_check(const void *data, int len, int levels, const dwt_lifting_t *lift)
+{
+    if ((data == NULL) || (lift == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    return dsps_dwt_check_len(len, levels);
+}
+
+#endif // _dsps_dwt_common_H_
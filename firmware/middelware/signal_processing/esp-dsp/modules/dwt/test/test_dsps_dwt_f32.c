@@ -0,0 +1,165 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_dwt.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_dwt_f32";
+
+#define SIG_LEN     1024
+
+static float x[SIG_LEN];
+static float y[SIG_LEN];
+static float clean[SIG_LEN];
+static float work[SIG_LEN / 2];
+
+static const char *wavelet_names[] = {"Haar", "CDF 5/3", "CDF 9/7", "D4"};
+
+static float gauss_noise(void)
+{
+    float u1 = ((float)rand() + 1) / ((float)RAND_MAX + 2);
+    float u2 = (float)rand() / RAND_MAX;
+    return sqrtf(-2 * logf(u1)) * cosf(2 * M_PI * u2);
+}
+
+TEST_CASE("dsps_dwt_f32 perfect reconstruction", "[dsps]")
+{
+    const int levels[] = {1, 3, 10};
+    for (int w = DSPS_DWT_HAAR; w <= DSPS_DWT_D4; w++) {
+        for (int l = 0; l < sizeof(levels) / sizeof(int); l++) {
+            float energy_x = 0;
+            float energy_y = 0;
+            for (int i = 0; i < SIG_LEN; i++) {
+                x[i] = (float)rand() / RAND_MAX * 2 - 1;
+                y[i] = x[i];
+                energy_x += x[i] * x[i];
+            }
+            TEST_ESP_OK(dsps_dwt_f32(y, SIG_LEN, levels[l], (dsps_dwt_wavelet_t)w));
+            for (int i = 0; i < SIG_LEN; i++) {
+                energy_y += y[i] * y[i];
+            }
+            TEST_ESP_OK(dsps_idwt_f32(y, SIG_LEN, levels[l], (dsps_dwt_wavelet_t)w));
+            float err = 0;
+            for (int i = 0; i < SIG_LEN; i++) {
+                float e = fabsf(x[i] - y[i]);
+                err = (e > err) ? e : err;
+            }
+            ESP_LOGI(TAG, "%s, %i levels: error %e, energy ratio %f", wavelet_names[w], levels[l], err, energy_y / energy_x);
+            TEST_ASSERT_LESS_THAN(10, (int)(1000000 * err));
+            // Orthonormal transforms keep the energy
+            if ((w == DSPS_DWT_HAAR) || (w == DSPS_DWT_D4)) {
+                TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1, energy_y / energy_x);
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_dwt_f32(y, 100, 3, DSPS_DWT_HAAR));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_dwt_f32(y, SIG_LEN, 3, (dsps_dwt_wavelet_t)10));
+}
+
+TEST_CASE("dsps_dwt_f32 vanishing moments", "[dsps]")
+{
+    // Detail coefficients of a polynomial of the order less than the amount of
+    // vanishing moments are zero, except of the boundary of the periodic wavelets
+    const int moments[] = {1, 2, 4, 2};
+    for (int w = DSPS_DWT_HAAR; w <= DSPS_DWT_D4; w++) {
+        int p = moments[w] - 1;
+        for (int i = 0; i < SIG_LEN; i++) {
+            float t = (float)i / SIG_LEN;
+            y[i] = 1 + (p >= 1 ? t : 0) + (p >= 3 ? t * t - t * t * t : 0);
+        }
+        TEST_ESP_OK(dsps_dwt_f32(y, SIG_LEN, 1, (dsps_dwt_wavelet_t)w));
+        float max_d = 0;
+        for (int i = 2; i < SIG_LEN / 2 - 2; i++) {
+            max_d = (fabsf(y[2 * i + 1]) > max_d) ? fabsf(y[2 * i + 1]) : max_d;
+        }
+        ESP_LOGI(TAG, "%s: max detail of polynomial of order %i: %e", wavelet_names[w], p, max_d);
+        TEST_ASSERT_LESS_THAN(10, (int)(1000000 * max_d));
+    }
+}
+
+TEST_CASE("dsps_dwt_denoise_f32 functionality", "[dsps]")
+{
+    const float sigma = 0.1f;
+    srand(60);
+    for (int w = DSPS_DWT_HAAR; w <= DSPS_DWT_D4; w++) {
+        for (int mode = DSPS_DWT_THR_HARD; mode <= DSPS_DWT_THR_SOFT; mode++) {
+            float mse_noisy = 0;
+            float mse_denoised = 0;
+            for (int i = 0; i < SIG_LEN; i++) {
+                float t = (float)i / SIG_LEN;
+                // Smooth signal with a step
+                clean[i] = sinf(2 * M_PI * 3 * t) + ((t > 0.6f) ? 0.5f : 0);
+                x[i] = clean[i] + sigma * gauss_noise();
+                mse_noisy += (x[i] - clean[i]) * (x[i] - clean[i]);
+            }
+            float thr;
+            memcpy(y, x, sizeof(y));
+            TEST_ESP_OK(dsps_dwt_f32(y, SIG_LEN, 5, (dsps_dwt_wavelet_t)w));
+            TEST_ESP_OK(dsps_dwt_universal_thr_f32(y, SIG_LEN, work, &thr));
+            TEST_ESP_OK(dsps_dwt_denoise_f32(x, SIG_LEN, 5, (dsps_dwt_wavelet_t)w, (dsps_dwt_thr_t)mode, work));
+            for (int i = 0; i < SIG_LEN; i++) {
+                mse_denoised += (x[i] - clean[i]) * (x[i] - clean[i]);
+            }
+            float gain = mse_noisy / mse_denoised;
+            ESP_LOGI(TAG, "%s, mode %i: threshold %f (expected %f), noise reduced %.1f times",
+                     wavelet_names[w], mode, thr, sigma * sqrtf(2 * logf(SIG_LEN)), gain);
+            if ((w == DSPS_DWT_HAAR) || (w == DSPS_DWT_D4)) {
+                TEST_ASSERT_FLOAT_WITHIN(0.1f * sigma * sqrtf(2 * logf(SIG_LEN)), sigma * sqrtf(2 * logf(SIG_LEN)), thr);
+            }
+            // Haar approximates a smooth signal by steps, the others are much better
+            TEST_ASSERT_GREATER_THAN((w == DSPS_DWT_HAAR) ? 10 : 30, (int)(10 * gain));
+        }
+    }
+}
+
+TEST_CASE("dsps_dwt_threshold_f32 functionality", "[dsps]")
+{
+    float data[8] = {5, -3, 0.5f, 2, -0.5f, 1, -2, 0.2f};
+    const float hard[8] = {5, -3, 0, 2, -0.5f, 0, -2, 0};
+    const float soft[8] = {5, -2, 0, 1, -0.5f, 0, -1, 0};
+    float tmp[8];
+    memcpy(tmp, data, sizeof(tmp));
+    TEST_ESP_OK(dsps_dwt_threshold_f32(tmp, 8, 2, 1, DSPS_DWT_THR_HARD));
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, hard[i], tmp[i]);
+    }
+    TEST_ESP_OK(dsps_dwt_threshold_f32(data, 8, 2, 1, DSPS_DWT_THR_SOFT));
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, soft[i], data[i]);
+    }
+    // Length must be a multiple of 2^levels as for the transform
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_dwt_threshold_f32(data, 6, 2, 1, DSPS_DWT_THR_HARD));
+}
+
+TEST_CASE("dsps_dwt_f32 benchmark", "[dsps]")
+{
+    for (int w = DSPS_DWT_HAAR; w <= DSPS_DWT_D4; w++) {
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_dwt_f32(y, SIG_LEN, 5, (dsps_dwt_wavelet_t)w);
+        unsigned int cycles_fwd = dsp_get_cpu_cycle_count() - start_b;
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_idwt_f32(y, SIG_LEN, 5, (dsps_dwt_wavelet_t)w);
+        unsigned int cycles_inv = dsp_get_cpu_cycle_count() - start_b;
+        ESP_LOGI(TAG, "%s, %i samples, 5 levels: forward %i cycles, inverse %i cycles", wavelet_names[w], SIG_LEN, cycles_fwd, cycles_inv);
+        TEST_ASSERT_EXEC_IN_RANGE(SIG_LEN, 200 * SIG_LEN, cycles_fwd);
+    }
+}
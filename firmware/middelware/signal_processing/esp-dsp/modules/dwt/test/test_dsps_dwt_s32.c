@@ -0,0 +1,90 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_dwt.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_dwt_s32";
+
+#define SIG_LEN     1024
+
+static int32_t x[SIG_LEN];
+static int32_t y[SIG_LEN];
+
+TEST_CASE("dsps_dwt_s32 perfect reconstruction", "[dsps]")
+{
+    const int levels[] = {1, 4, 10};
+    for (int w = DSPS_DWT_HAAR; w <= DSPS_DWT_D4; w++) {
+        for (int l = 0; l < sizeof(levels) / sizeof(int); l++) {
+            for (int i = 0; i < SIG_LEN; i++) {
+                x[i] = (rand() % 65536) - 32768;
+                y[i] = x[i];
+            }
+            TEST_ESP_OK(dsps_dwt_s32(y, SIG_LEN, levels[l], (dsps_dwt_wavelet_t)w));
+            int32_t max_coeff = 0;
+            for (int i = 0; i < SIG_LEN; i++) {
+                max_coeff = (abs(y[i]) > max_coeff) ? abs(y[i]) : max_coeff;
+            }
+            TEST_ESP_OK(dsps_idwt_s32(y, SIG_LEN, levels[l], (dsps_dwt_wavelet_t)w));
+            ESP_LOGI(TAG, "wavelet %i, %i levels: max coefficient %li", w, levels[l], (long)max_coeff);
+            for (int i = 0; i < SIG_LEN; i++) {
+                TEST_ASSERT_EQUAL_INT32(x[i], y[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("dsps_dwt_s32 compression", "[dsps]")
+{
+    // Detail coefficients of a smooth 12 bit signal are small: most of them fit to 3 bits
+    for (int i = 0; i < SIG_LEN; i++) {
+        x[i] = (int32_t)(2048 + 1500 * sinf(2 * M_PI * 5 * i / SIG_LEN));
+        y[i] = x[i];
+    }
+    TEST_ESP_OK(dsps_dwt_s32(y, SIG_LEN, 5, DSPS_DWT_CDF53));
+    int small = 0;
+    for (int i = 0; i < SIG_LEN; i++) {
+        if ((i % 32) && (abs(y[i]) <= 2)) {
+            small++;
+        }
+    }
+    ESP_LOGI(TAG, "CDF 5/3: %i of %i detail coefficients in range -2..2", small, SIG_LEN - SIG_LEN / 32);
+    TEST_ASSERT_GREATER_THAN((SIG_LEN - SIG_LEN / 32) * 2 / 3, small);
+    TEST_ESP_OK(dsps_idwt_s32(y, SIG_LEN, 5, DSPS_DWT_CDF53));
+    for (int i = 0; i < SIG_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(x[i], y[i]);
+    }
+}
+
+TEST_CASE("dsps_dwt_s32 benchmark", "[dsps]")
+{
+    for (int w = DSPS_DWT_HAAR; w <= DSPS_DWT_D4; w++) {
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_dwt_s32(y, SIG_LEN, 5, (dsps_dwt_wavelet_t)w);
+        unsigned int cycles_fwd = dsp_get_cpu_cycle_count() - start_b;
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_idwt_s32(y, SIG_LEN, 5, (dsps_dwt_wavelet_t)w);
+        unsigned int cycles_inv = dsp_get_cpu_cycle_count() - start_b;
+        ESP_LOGI(TAG, "wavelet %i, %i samples, 5 levels: forward %i cycles, inverse %i cycles", w, SIG_LEN, cycles_fwd, cycles_inv);
+        TEST_ASSERT_EXEC_IN_RANGE(SIG_LEN, 200 * SIG_LEN, cycles_fwd);
+    }
+}
@@ -0,0 +1,144 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_spectrum.h"
+#include "dsp_common.h"
+#include "dsps_fastmath.h"
+
+// alpha and beta with the minimal peak error, Q15
+#define MAG_ALPHA       31471
+#define MAG_BETA        13036
+#define CORDIC_ITER     8
+// 1/prod(sqrt(1 + 2^(-2*i))), i = 0..CORDIC_ITER - 1, Q15
+#define CORDIC_GAIN     19898
+// 100*20*log10(2)/2048, Q16: 0.01 dB from log2 in Q11
+#define DB_PER_LOG2     19266
+
+esp_err_t dsps_spectrum_prep_sc16(const uint16_t *input, const int16_t *window, int16_t *data, int len, int *exp)
+{
+    if ((input == NULL) || (data == NULL) || (exp == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (!dsp_is_power_of_two(len)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    uint32_t sum = 0;
+    for (int i = 0; i < len; i++) {
+        sum += input[i];
+    }
+    int32_t mean = (sum + len / 2) / len;
+    int32_t max = 0;
+    for (int i = 0; i < len; i++) {
+        int32_t v = input[i] - mean;
+        v = (v < 0) ? -v : v;
+        max = (v > max) ? v : max;
+    }
+    // Shift to 15 bits: the butterflies of dsps_fft2r_sc16 scale by 1/2, so the magnitude does not grow
+    int shift = 0;
+    if (max >= (1 << 15)) {
+        while ((max >> -shift) >= (1 << 15)) {
+            shift--;
+        }
+    } else if (max > 0) {
+        while ((max << shift) < (1 << 14)) {
+            shift++;
+        }
+    }
+    for (int i = 0; i < len; i++) {
+        int32_t v = input[i] - mean;
+        v = (shift >= 0) ? v * (1 << shift) : v >> -shift;
+        if (window != NULL) {
+            v = (v * window[i] + (1 << 14)) >> 15;
+        }
+        data[i * 2 + 0] = v;
+        data[i * 2 + 1] = 0;
+    }
+    *exp = dsp_power_of_two(len) - shift;
+    return ESP_OK;
+}
+
+esp_err_t dsps_mag_sc16(const int16_t *data, uint16_t *mag, int len, dsps_mag_method_t method)
+{
+    if ((data == NULL) || (mag == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    switch (method) {
+    case DSPS_MAG_AMAX_BMIN:
+        for (int i = 0; i < len; i++) {
+            int32_t re = data[i * 2 + 0];
+            int32_t im = data[i * 2 + 1];
+            re = (re < 0) ? -re : re;
+            im = (im < 0) ? -im : im;
+            int32_t mx = (re > im) ? re : im;
+            int32_t mn = (re > im) ? im : re;
+            mag[i] = (MAG_ALPHA * mx + MAG_BETA * mn + (1 << 14)) >> 15;
+        }
+        break;
+    case DSPS_MAG_CORDIC:
+        for (int i = 0; i < len; i++) {
+            int32_t x = data[i * 2 + 0];
+            int32_t y = data[i * 2 + 1];
+            // First quadrant, 8 bits of fraction
+            x = ((x < 0) ? -x : x) << 8;
+            y = ((y < 0) ? -y : y) << 8;
+            for (int k = 0; k < CORDIC_ITER; k++) {
+                int32_t xs = x >> k;
+                if (y >= 0) {
+                    x += y >> k;
+                    y -= xs;
+                } else {
+                    x -= y >> k;
+                    y += xs;
+                }
+            }
+            x = (x + (1 << 7)) >> 8;
+            mag[i] = (x * CORDIC_GAIN + (1 << 14)) >> 15;
+        }
+        break;
+    case DSPS_MAG_ISQRT:
+        for (int i = 0; i < len; i++) {
+            int32_t re = data[i * 2 + 0];
+            int32_t im = data[i * 2 + 1];
+            mag[i] = dsps_isqrt_u32((uint32_t)(re * re) + (uint32_t)(im * im));
+        }
+        break;
+    default:
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_mag_db_sc16(const uint16_t *mag, int16_t *db, int len, int exp)
+{
+    if ((mag == NULL) || (db == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    for (int i = 0; i < len; i++) {
+        uint32_t m = mag[i];
+        if (m == 0) {
+            db[i] = INT16_MIN;
+            continue;
+        }
+        // log2 in Q11
+        int32_t lg = exp * (1 << 11) + ((dsps_log2_u32(m) + (1 << 4)) >> 5);
+        db[i] = (lg * DB_PER_LOG2 + (1 << 15)) >> 16;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,253 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_czt.h"
+#include "dsps_fft2r.h"
+#include "dsps_fir_gen.h"
+#include "dsps_wind.h"
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+// Inverse FFT by the forward one: ifft(x) = conj(fft(conj(x)))/N, the scale and conj are applied by the caller
+static esp_err_t dsps_czt_fft(float *data, int len)
+{
+    esp_err_t ret = dsps_fft2r_fc32(data, len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return dsps_bit_rev_fc32(data, len);
+}
+
+static esp_err_t dsps_czt_layout(czt_f32_t *czt, float *buff, int N, int M)
+{
+    if ((czt == NULL) || (buff == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((N <= 0) || (M <= 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int fft_len = 1;
+    while (fft_len < N + M - 1) {
+        fft_len <<= 1;
+    }
+    czt->N = N;
+    czt->M = M;
+    czt->fft_len = fft_len;
+    czt->pre = buff;
+    czt->post = czt->pre + 2 * N;
+    czt->filter = czt->post + 2 * M;
+    czt->work = czt->filter + 2 * fft_len;
+    memset(czt->filter, 0, 2 * fft_len * sizeof(float));
+    return ESP_OK;
+}
+
+// Position of the chirp filter for lags -(N - 1)..(M - 1), negative lags at the end of the circular buffer
+static inline int dsps_czt_filter_pos(czt_f32_t *czt, int m)
+{
+    return (m >= 0) ? m : czt->fft_len + m;
+}
+
+static inline void dsps_czt_set(float *c, double ph, float scale)
+{
+    c[0] = cos(ph) * scale;
+    c[1] = sin(ph) * scale;
+}
+
+esp_err_t dsps_czt_init_f32(czt_f32_t *czt, float *buff, int N, int M, float f_start, float f_step)
+{
+    esp_err_t ret = dsps_czt_layout(czt, buff, N, M);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Phases are reduced in double precision: n^2 grows fast
+    for (int n = 0; n < N; n++) {
+        dsps_czt_set(&czt->pre[n * 2], -M_PI * fmod(2.0 * f_start * n + (double)f_step * n * n, 2.0), 1);
+    }
+    for (int k = 0; k < M; k++) {
+        dsps_czt_set(&czt->post[k * 2], -M_PI * fmod((double)f_step * k * k, 2.0), 1.0f / czt->fft_len);
+    }
+    for (int m = -(N - 1); m < M; m++) {
+        dsps_czt_set(&czt->filter[dsps_czt_filter_pos(czt, m) * 2], M_PI * fmod((double)f_step * m * m, 2.0), 1);
+    }
+    return dsps_czt_fft(czt->filter, czt->fft_len);
+}
+
+esp_err_t dsps_czt_init_dft_f32(czt_f32_t *czt, float *buff, int N)
+{
+    esp_err_t ret = dsps_czt_layout(czt, buff, N, N);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Step 1/N is not exact in float: the phase pi*n^2/N is reduced by n^2 mod 2*N
+    int64_t period = 2 * (int64_t)N;
+    for (int n = 0; n < N; n++) {
+        double ph = M_PI * (double)(((int64_t)n * n) % period) / N;
+        dsps_czt_set(&czt->pre[n * 2], -ph, 1);
+        dsps_czt_set(&czt->post[n * 2], -ph, 1.0f / czt->fft_len);
+    }
+    for (int m = -(N - 1); m < N; m++) {
+        double ph = M_PI * (double)(((int64_t)m * m) % period) / N;
+        dsps_czt_set(&czt->filter[dsps_czt_filter_pos(czt, m) * 2], ph, 1);
+    }
+    return dsps_czt_fft(czt->filter, czt->fft_len);
+}
+
+static esp_err_t dsps_czt_run(czt_f32_t *czt, const float *input, int cplx, float *output)
+{
+    if ((czt == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    float *w = czt->work;
+    const float *pre = czt->pre;
+    // Input with the chirp, conjugated for the inverse FFT later
+    if (cplx) {
+        for (int n = 0; n < czt->N; n++) {
+            float re = input[n * 2 + 0];
+            float im = input[n * 2 + 1];
+            w[n * 2 + 0] = re * pre[n * 2 + 0] - im * pre[n * 2 + 1];
+            w[n * 2 + 1] = re * pre[n * 2 + 1] + im * pre[n * 2 + 0];
+        }
+    } else {
+        for (int n = 0; n < czt->N; n++) {
+            w[n * 2 + 0] = input[n] * pre[n * 2 + 0];
+            w[n * 2 + 1] = input[n] * pre[n * 2 + 1];
+        }
+    }
+    memset(&w[czt->N * 2], 0, 2 * (czt->fft_len - czt->N) * sizeof(float));
+    esp_err_t ret = dsps_czt_fft(w, czt->fft_len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Convolution: product of the spectra, conjugated for the inverse FFT
+    const float *f = czt->filter;
+    for (int i = 0; i < czt->fft_len; i++) {
+        float re = w[i * 2 + 0] * f[i * 2 + 0] - w[i * 2 + 1] * f[i * 2 + 1];
+        float im = w[i * 2 + 0] * f[i * 2 + 1] + w[i * 2 + 1] * f[i * 2 + 0];
+        w[i * 2 + 0] = re;
+        w[i * 2 + 1] = -im;
+    }
+    ret = dsps_czt_fft(w, czt->fft_len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Conjugate back and apply the output chirp with 1/fft_len
+    const float *post = czt->post;
+    for (int k = 0; k < czt->M; k++) {
+        float re = w[k * 2 + 0];
+        float im = -w[k * 2 + 1];
+        output[k * 2 + 0] = re * post[k * 2 + 0] - im * post[k * 2 + 1];
+        output[k * 2 + 1] = re * post[k * 2 + 1] + im * post[k * 2 + 0];
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_czt_f32(czt_f32_t *czt, const float *input, float *output)
+{
+    return dsps_czt_run(czt, input, 0, output);
+}
+
+esp_err_t dsps_czt_fc32(czt_f32_t *czt, const float *input, float *output)
+{
+    return dsps_czt_run(czt, input, 1, output);
+}
+
+esp_err_t dsps_zoom_fft_init_f32(zoom_fft_f32_t *zoom, float *buff, float f_center, int decim, int fir_len, int fft_len)
+{
+    if ((zoom == NULL) || (buff == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((decim <= 0) || (fir_len <= 0) || (fft_len < 2) || (fft_len & (fft_len - 1))) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((f_center < 0) || (f_center > 0.5f)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    float *coeffs = buff;
+    float *delay_re = coeffs + fir_len;
+    float *delay_im = delay_re + fir_len;
+    zoom->mix_re = delay_im + fir_len;
+    zoom->mix_im = zoom->mix_re + decim;
+    zoom->window = zoom->mix_im + decim;
+    zoom->decim = decim;
+    zoom->fft_len = fft_len;
+
+    // Kaiser window for 80 dB of attenuation
+    const float beta = 0.1102f * (80 - 8.7f);
+    esp_err_t ret = dsps_fir_gen_lpf_f32(coeffs, fir_len, 0.5f / decim, beta, 1);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = dsps_fird_init_f32(&zoom->fir_re, coeffs, delay_re, fir_len, decim);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = dsps_fird_init_f32(&zoom->fir_im, coeffs, delay_im, fir_len, decim);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    dsps_wind_hann_f32(zoom->window, fft_len);
+    float sum = 0;
+    for (int i = 0; i < fft_len; i++) {
+        sum += zoom->window[i];
+    }
+    zoom->scale = 2 / sum;
+    zoom->osc_re = 1;
+    zoom->osc_im = 0;
+    zoom->rot_re = cosf(2 * M_PI * f_center);
+    zoom->rot_im = -sinf(2 * M_PI * f_center);
+    return ESP_OK;
+}
+
+esp_err_t dsps_zoom_fft_f32(zoom_fft_f32_t *zoom, const float *input, float *output)
+{
+    if ((zoom == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    float osc_re = zoom->osc_re;
+    float osc_im = zoom->osc_im;
+    for (int i = 0; i < zoom->fft_len; i++) {
+        // Mix decim samples to 0 and decimate them to one complex sample
+        for (int k = 0; k < zoom->decim; k++) {
+            float x = *input++;
+            zoom->mix_re[k] = x * osc_re;
+            zoom->mix_im[k] = x * osc_im;
+            float re = osc_re * zoom->rot_re - osc_im * zoom->rot_im;
+            osc_im = osc_re * zoom->rot_im + osc_im * zoom->rot_re;
+            osc_re = re;
+        }
+        // Keep the amplitude of the oscillator: first order correction of the rounding
+        float g = 1.5f - 0.5f * (osc_re * osc_re + osc_im * osc_im);
+        osc_re *= g;
+        osc_im *= g;
+        dsps_fird_f32(&zoom->fir_re, zoom->mix_re, &output[i * 2 + 0], 1);
+        dsps_fird_f32(&zoom->fir_im, zoom->mix_im, &output[i * 2 + 1], 1);
+        output[i * 2 + 0] *= zoom->window[i] * zoom->scale;
+        output[i * 2 + 1] *= zoom->window[i] * zoom->scale;
+    }
+    zoom->osc_re = osc_re;
+    zoom->osc_im = osc_im;
+    esp_err_t ret = dsps_czt_fft(output, zoom->fft_len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Negative frequencies first
+    int half = zoom->fft_len / 2;
+    for (int i = 0; i < half * 2; i++) {
+        float t = output[i];
+        output[i] = output[i + half * 2];
+        output[i + half * 2] = t;
+    }
+    return ESP_OK;
+}
@@ -125,7 +125,8 @@ esp_err_t dsps_fft2r_fc32_ansi_(float *data, int N, float *w)
     if (!dsp_is_power_of_two(N)) {
         return ESP_ERR_DSP_INVALID_LENGTH;
     }
-    if (!dsps_fft2r_initialized) {
+    // Tables of FFT plans do not require the global init
+    if ((w == NULL) || ((w == dsps_fft_w_table_fc32) && !dsps_fft2r_initialized)) {
         return ESP_ERR_DSP_UNINITIALIZED;
     }
 
@@ -0,0 +1,139 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fft2r_plan.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include <string.h>
+
+static int dsps_fft2r_plan_bits(int N)
+{
+    int bits = 0;
+    while ((1 << bits) < N) {
+        bits++;
+    }
+    return bits;
+}
+
+// Amount of pairs i < bitrev(i), rounded up to even for the optimized bit reverse
+static int dsps_fft2r_plan_rev_size(int N)
+{
+    int bits = dsps_fft2r_plan_bits(N);
+    int pairs = (N - (1 << ((bits + 1) / 2))) / 2;
+    return (pairs + 1) & ~1;
+}
+
+static int dsps_fft2r_plan_check(int N)
+{
+    return (N >= 2) && (N <= DSPS_FFT2R_PLAN_MAX_SIZE) && dsp_is_power_of_two(N);
+}
+
+esp_err_t dsps_fft2r_plan_cost_fc32(int N, int shared, fft2r_plan_cost_t *cost)
+{
+    if (cost == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (!dsps_fft2r_plan_check(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int rev_size = dsps_fft2r_plan_rev_size(N);
+    cost->buff_len = (shared ? 0 : N) + rev_size;
+    cost->mem_bytes = cost->buff_len * sizeof(float);
+    cost->trig = shared ? 0 : N;
+    cost->init_ops = (shared ? 0 : 2 * N) + 2 * rev_size;
+    cost->butterflies = N / 2 * dsps_fft2r_plan_bits(N);
+    cost->swaps = rev_size;
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft2r_plan_init_fc32(fft2r_plan_fc32_t *plan, float *buff, int N, const fft2r_plan_fc32_t *shared)
+{
+    if (plan == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (!dsps_fft2r_plan_check(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((shared != NULL) && (shared->w_size < N)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if ((shared != NULL) && (shared->N == N)) {
+        *plan = *shared;
+        return ESP_OK;
+    }
+    if (buff == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    plan->N = N;
+    if (shared != NULL) {
+        plan->w = shared->w;
+        plan->w_size = shared->w_size;
+        plan->rev_tab = (uint16_t *)buff;
+    } else {
+        esp_err_t ret = dsps_gen_w_r2_fc32(buff, N);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        ret = dsps_bit_rev_fc32_ansi(buff, N >> 1);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        plan->w = buff;
+        plan->w_size = N;
+        plan->rev_tab = (uint16_t *)&buff[N];
+    }
+
+    int bits = dsps_fft2r_plan_bits(N);
+    int count = 0;
+    for (int i = 1; i < N - 1; i++) {
+        int j = 0;
+        for (int b = 0; b < bits; b++) {
+            j |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        if (i < j) {
+            plan->rev_tab[count * 2 + 0] = i * 2 * sizeof(float);
+            plan->rev_tab[count * 2 + 1] = j * 2 * sizeof(float);
+            count++;
+        }
+    }
+    plan->rev_size = dsps_fft2r_plan_rev_size(N);
+    // Swap of the element 0 with itself to make the amount of pairs even
+    for (; count < plan->rev_size; count++) {
+        plan->rev_tab[count * 2 + 0] = 0;
+        plan->rev_tab[count * 2 + 1] = 0;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft2r_plan_fc32(const fft2r_plan_fc32_t *plan, float *data)
+{
+    if ((plan == NULL) || (data == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    esp_err_t ret;
+#if (dsps_fft2r_fc32_aes3_enabled == 1)
+    ret = dsps_fft2r_fc32_aes3_(data, plan->N, plan->w);
+#elif (dsps_fft2r_fc32_ae32_enabled == 1)
+    ret = dsps_fft2r_fc32_ae32_(data, plan->N, plan->w);
+#else
+    ret = dsps_fft2r_fc32_ansi_(data, plan->N, plan->w);
+#endif
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (plan->rev_size > 0) {
+        ret = dsps_bit_rev_lookup_fc32(data, plan->rev_size, plan->rev_tab);
+    }
+    return ret;
+}
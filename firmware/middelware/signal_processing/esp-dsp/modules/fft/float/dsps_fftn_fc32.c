@@ -0,0 +1,245 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fftn.h"
+#include <string.h>
+#include <math.h>
+
+// Factorization of N to radix stages, 0 if N has other prime factors
+static int dsps_fftn_factorize(int N, int *factors)
+{
+    int count = 0;
+    const int radix[] = {4, 2, 3, 5};
+    for (int r = 0; r < (int)(sizeof(radix) / sizeof(radix[0])); r++) {
+        while ((N % radix[r]) == 0) {
+            if (count >= DSPS_FFTN_MAX_FACTORS) {
+                return 0;
+            }
+            factors[count++] = radix[r];
+            N /= radix[r];
+        }
+    }
+    return (N == 1) ? count : 0;
+}
+
+static int dsps_fftn_pow2(int N)
+{
+    int L = 1;
+    while (L < 2 * N - 1) {
+        L <<= 1;
+    }
+    return L;
+}
+
+int dsps_fftn_buff_len_fc32(int N)
+{
+    int factors[DSPS_FFTN_MAX_FACTORS];
+    if ((N <= 1) || dsps_fftn_factorize(N, factors)) {
+        return 4 * N;
+    }
+    return 6 * N + 4 * dsps_fftn_pow2(N);
+}
+
+esp_err_t dsps_fftn_init_fc32(fftn_f32_t *plan, float *buff, int N)
+{
+    if ((plan == NULL) || (buff == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (N <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    plan->N = N;
+    plan->n_factors = dsps_fftn_factorize(N, plan->factors);
+    if ((plan->n_factors > 0) || (N == 1)) {
+        plan->twiddle = buff;
+        plan->work = buff + 2 * N;
+        for (int i = 0; i < N; i++) {
+            double ph = -2 * M_PI * i / N;
+            plan->twiddle[i * 2 + 0] = cos(ph);
+            plan->twiddle[i * 2 + 1] = sin(ph);
+        }
+        return ESP_OK;
+    }
+    plan->twiddle = NULL;
+    plan->work = buff;
+    return dsps_czt_init_dft_f32(&plan->czt, buff + 2 * N, N);
+}
+
+// Stockham stages: x[q + s*(j + r*m)] -> y[q + s*(p*j + k)], with twiddle exp(-j*2*pi*j*k/n) for output k.
+// n - length of the sub transforms, s - their amount (stride), m = n/p, tw_step = N/n
+static inline void dsps_fftn_twiddle(float *y, const float *tw, int idx, float re, float im)
+{
+    y[0] = re * tw[idx * 2 + 0] - im * tw[idx * 2 + 1];
+    y[1] = re * tw[idx * 2 + 1] + im * tw[idx * 2 + 0];
+}
+
+static void dsps_fftn_radix2(const float *x, float *y, int n, int s, const float *tw, int tw_step)
+{
+    int m = n / 2;
+    for (int j = 0; j < m; j++) {
+        int w1 = j * tw_step;
+        for (int q = 0; q < s; q++) {
+            const float *a0 = &x[(q + s * j) * 2];
+            const float *a1 = &x[(q + s * (j + m)) * 2];
+            float *b = &y[(q + s * 2 * j) * 2];
+            b[0] = a0[0] + a1[0];
+            b[1] = a0[1] + a1[1];
+            dsps_fftn_twiddle(&b[s * 2], tw, w1, a0[0] - a1[0], a0[1] - a1[1]);
+        }
+    }
+}
+
+static void dsps_fftn_radix4(const float *x, float *y, int n, int s, const float *tw, int tw_step)
+{
+    int m = n / 4;
+    for (int j = 0; j < m; j++) {
+        int w1 = j * tw_step;
+        for (int q = 0; q < s; q++) {
+            const float *a0 = &x[(q + s * j) * 2];
+            const float *a1 = &x[(q + s * (j + m)) * 2];
+            const float *a2 = &x[(q + s * (j + 2 * m)) * 2];
+            const float *a3 = &x[(q + s * (j + 3 * m)) * 2];
+            float *b = &y[(q + s * 4 * j) * 2];
+            float s02_re = a0[0] + a2[0];
+            float s02_im = a0[1] + a2[1];
+            float d02_re = a0[0] - a2[0];
+            float d02_im = a0[1] - a2[1];
+            float s13_re = a1[0] + a3[0];
+            float s13_im = a1[1] + a3[1];
+            float d13_re = a1[0] - a3[0];
+            float d13_im = a1[1] - a3[1];
+            b[0] = s02_re + s13_re;
+            b[1] = s02_im + s13_im;
+            // b1 = d02 - j*d13, b2 = s02 - s13, b3 = d02 + j*d13
+            dsps_fftn_twiddle(&b[s * 2], tw, w1, d02_re + d13_im, d02_im - d13_re);
+            dsps_fftn_twiddle(&b[s * 4], tw, 2 * w1, s02_re - s13_re, s02_im - s13_im);
+            dsps_fftn_twiddle(&b[s * 6], tw, 3 * w1, d02_re - d13_im, d02_im + d13_re);
+        }
+    }
+}
+
+static void dsps_fftn_radix3(const float *x, float *y, int n, int s, const float *tw, int tw_step)
+{
+    const float c = 0.86602540378f; // sin(2*pi/3)
+    int m = n / 3;
+    for (int j = 0; j < m; j++) {
+        int w1 = j * tw_step;
+        for (int q = 0; q < s; q++) {
+            const float *a0 = &x[(q + s * j) * 2];
+            const float *a1 = &x[(q + s * (j + m)) * 2];
+            const float *a2 = &x[(q + s * (j + 2 * m)) * 2];
+            float *b = &y[(q + s * 3 * j) * 2];
+            float t_re = a1[0] + a2[0];
+            float t_im = a1[1] + a2[1];
+            float m_re = a0[0] - 0.5f * t_re;
+            float m_im = a0[1] - 0.5f * t_im;
+            // -j*sin(2*pi/3)*(a1 - a2)
+            float r_re = c * (a1[1] - a2[1]);
+            float r_im = -c * (a1[0] - a2[0]);
+            b[0] = a0[0] + t_re;
+            b[1] = a0[1] + t_im;
+            dsps_fftn_twiddle(&b[s * 2], tw, w1, m_re + r_re, m_im + r_im);
+            dsps_fftn_twiddle(&b[s * 4], tw, 2 * w1, m_re - r_re, m_im - r_im);
+        }
+    }
+}
+
+static void dsps_fftn_radix5(const float *x, float *y, int n, int s, const float *tw, int tw_step)
+{
+    const float c1 = 0.30901699437f;    // cos(2*pi/5)
+    const float c2 = -0.80901699437f;   // cos(4*pi/5)
+    const float s1 = 0.95105651630f;    // sin(2*pi/5)
+    const float s2 = 0.58778525229f;    // sin(4*pi/5)
+    int m = n / 5;
+    for (int j = 0; j < m; j++) {
+        int w1 = j * tw_step;
+        for (int q = 0; q < s; q++) {
+            const float *a0 = &x[(q + s * j) * 2];
+            const float *a1 = &x[(q + s * (j + m)) * 2];
+            const float *a2 = &x[(q + s * (j + 2 * m)) * 2];
+            const float *a3 = &x[(q + s * (j + 3 * m)) * 2];
+            const float *a4 = &x[(q + s * (j + 4 * m)) * 2];
+            float *b = &y[(q + s * 5 * j) * 2];
+            float t1_re = a1[0] + a4[0];
+            float t1_im = a1[1] + a4[1];
+            float t2_re = a2[0] + a3[0];
+            float t2_im = a2[1] + a3[1];
+            float t3_re = a1[0] - a4[0];
+            float t3_im = a1[1] - a4[1];
+            float t4_re = a2[0] - a3[0];
+            float t4_im = a2[1] - a3[1];
+            float m1_re = a0[0] + c1 * t1_re + c2 * t2_re;
+            float m1_im = a0[1] + c1 * t1_im + c2 * t2_im;
+            float m2_re = a0[0] + c2 * t1_re + c1 * t2_re;
+            float m2_im = a0[1] + c2 * t1_im + c1 * t2_im;
+            // -j*(s1*t3 + s2*t4) and -j*(s2*t3 - s1*t4)
+            float r1_re = s1 * t3_im + s2 * t4_im;
+            float r1_im = -(s1 * t3_re + s2 * t4_re);
+            float r2_re = s2 * t3_im - s1 * t4_im;
+            float r2_im = -(s2 * t3_re - s1 * t4_re);
+            b[0] = a0[0] + t1_re + t2_re;
+            b[1] = a0[1] + t1_im + t2_im;
+            dsps_fftn_twiddle(&b[s * 2], tw, w1, m1_re + r1_re, m1_im + r1_im);
+            dsps_fftn_twiddle(&b[s * 4], tw, 2 * w1, m2_re + r2_re, m2_im + r2_im);
+            dsps_fftn_twiddle(&b[s * 6], tw, 3 * w1, m2_re - r2_re, m2_im - r2_im);
+            dsps_fftn_twiddle(&b[s * 8], tw, 4 * w1, m1_re - r1_re, m1_im - r1_im);
+        }
+    }
+}
+
+esp_err_t dsps_fftn_fc32(fftn_f32_t *plan, float *data)
+{
+    if ((plan == NULL) || (data == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    int N = plan->N;
+    if ((plan->n_factors == 0) && (N > 1)) {
+        esp_err_t ret = dsps_czt_fc32(&plan->czt, data, plan->work);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        memcpy(data, plan->work, 2 * N * sizeof(float));
+        return ESP_OK;
+    }
+    float *x = data;
+    float *y = plan->work;
+    int n = N;
+    int s = 1;
+    for (int f = 0; f < plan->n_factors; f++) {
+        int p = plan->factors[f];
+        switch (p) {
+        case 4:
+            dsps_fftn_radix4(x, y, n, s, plan->twiddle, N / n);
+            break;
+        case 2:
+            dsps_fftn_radix2(x, y, n, s, plan->twiddle, N / n);
+            break;
+        case 3:
+            dsps_fftn_radix3(x, y, n, s, plan->twiddle, N / n);
+            break;
+        default:
+            dsps_fftn_radix5(x, y, n, s, plan->twiddle, N / n);
+            break;
+        }
+        n /= p;
+        s *= p;
+        float *t = x;
+        x = y;
+        y = t;
+    }
+    if (x != data) {
+        memcpy(data, x, 2 * N * sizeof(float));
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,250 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_goertzel.h"
+#include <string.h>
+#include <math.h>
+
+#define GOERTZEL_COEFFS 6
+
+static esp_err_t dsps_goertzel_gen_coeffs(float *coeffs, const float *freqs, int n_tones, int len)
+{
+    for (int t = 0; t < n_tones; t++) {
+        if ((freqs[t] < 0) || (freqs[t] > 0.5f)) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+    }
+    for (int t = 0; t < n_tones; t++) {
+        float *c = &coeffs[t * GOERTZEL_COEFFS];
+        // Phase of the last sample could be large: double precision
+        double w = 2 * M_PI * freqs[t];
+        // Reinsch coefficient: -4*sin(w/2)^2 = 2*cos(w) - 2 below fs/4, 4*cos(w/2)^2 = 2*cos(w) + 2 above
+        c[0] = (cos(w) >= 0) ? -4 * sin(w / 2) * sin(w / 2) : 4 * cos(w / 2) * cos(w / 2);
+        c[1] = cos(w);
+        c[2] = sin(w);
+        c[3] = cos(w * (len - 1));
+        c[4] = sin(w * (len - 1));
+        c[5] = ((freqs[t] == 0) || (freqs[t] == 0.5f)) ? 1.0f / len : 2.0f / len;
+    }
+    return ESP_OK;
+}
+
+// Goertzel recursion s[n] = x[n] + 2*cos(w)*s[n - 1] - s[n - 2] in the Reinsch form:
+// d[n] = s[n] -/+ s[n - 1] is updated with the small coefficient, so the precision is kept near 0 and fs/2.
+// With sign = +1 below fs/4 and -1 above: d[n] = sign*d[n - 1] + x[n] + coeff*s[n - 1], s[n] = d[n] + sign*s[n - 1]
+static inline void dsps_goertzel_run(const float *c, const float *x, int len, float *state)
+{
+    float coeff = c[0];
+    float sign = (c[1] >= 0) ? 1 : -1;
+    float s = state[0];
+    float d = state[1];
+    for (int k = 0; k < len; k++) {
+        d = sign * d + x[k] + coeff * s;
+        s = d + sign * s;
+    }
+    state[0] = s;
+    state[1] = d;
+}
+
+// Two tones in one pass: the recursions are independent, so the latency of one is hidden by the other
+static inline void dsps_goertzel_run2(const float *c1, const float *c2, const float *x, int len, float *state1, float *state2)
+{
+    float coeff1 = c1[0];
+    float coeff2 = c2[0];
+    float sign1 = (c1[1] >= 0) ? 1 : -1;
+    float sign2 = (c2[1] >= 0) ? 1 : -1;
+    float s1 = state1[0];
+    float d1 = state1[1];
+    float s2 = state2[0];
+    float d2 = state2[1];
+    for (int k = 0; k < len; k++) {
+        float xk = x[k];
+        d1 = sign1 * d1 + xk + coeff1 * s1;
+        d2 = sign2 * d2 + xk + coeff2 * s2;
+        s1 = d1 + sign1 * s1;
+        s2 = d2 + sign2 * s2;
+    }
+    state1[0] = s1;
+    state1[1] = d1;
+    state2[0] = s2;
+    state2[1] = d2;
+}
+
+// Complex DFT from the state of the recursion
+static inline void dsps_goertzel_result(const float *c, const float *state, float *re, float *im)
+{
+    // y = s[n] - exp(-j*w)*s[n - 1], X = y*exp(-j*w*(len - 1))
+    float s1 = state[0];
+    float d = state[1];
+    float yr;
+    float yi;
+    if (c[1] >= 0) {
+        yr = -0.5f * c[0] * s1 + c[1] * d;
+        yi = c[2] * (s1 - d);
+    } else {
+        yr = 0.5f * c[0] * s1 - c[1] * d;
+        yi = c[2] * (d - s1);
+    }
+    *re = yr * c[3] + yi * c[4];
+    *im = yi * c[3] - yr * c[4];
+}
+
+static inline void dsps_goertzel_output(const float *c, float re, float im, float *mag, float *phase)
+{
+    if (mag != NULL) {
+        *mag = sqrtf(re * re + im * im) * c[5];
+    }
+    if (phase != NULL) {
+        *phase = atan2f(im, re);
+    }
+}
+
+esp_err_t dsps_goertzel_init_f32(goertzel_f32_t *g, float *buff, const float *freqs, int n_tones, int len)
+{
+    if ((g == NULL) || (buff == NULL) || (freqs == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((n_tones <= 0) || (len <= 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    g->coeffs = buff;
+    g->state = buff + GOERTZEL_COEFFS * n_tones;
+    g->n_tones = n_tones;
+    g->len = len;
+    g->count = 0;
+    memset(g->state, 0, 2 * n_tones * sizeof(float));
+    return dsps_goertzel_gen_coeffs(g->coeffs, freqs, n_tones, len);
+}
+
+int dsps_goertzel_f32(goertzel_f32_t *g, const float *input, int len, float *mag, float *phase, int max_blocks)
+{
+    int blocks = 0;
+    int i = 0;
+    while (i < len) {
+        // Samples up to the end of the current block
+        int chunk = g->len - g->count;
+        chunk = (chunk > len - i) ? len - i : chunk;
+        const float *x = &input[i];
+        int t = 0;
+        for (; t + 1 < g->n_tones; t += 2) {
+            dsps_goertzel_run2(&g->coeffs[t * GOERTZEL_COEFFS], &g->coeffs[(t + 1) * GOERTZEL_COEFFS], x, chunk,
+                               &g->state[t * 2], &g->state[(t + 1) * 2]);
+        }
+        if (t < g->n_tones) {
+            dsps_goertzel_run(&g->coeffs[t * GOERTZEL_COEFFS], x, chunk, &g->state[t * 2]);
+        }
+        i += chunk;
+        g->count += chunk;
+        if (g->count < g->len) {
+            break;
+        }
+        g->count = 0;
+        for (int t = 0; t < g->n_tones; t++) {
+            if (blocks < max_blocks) {
+                const float *c = &g->coeffs[t * GOERTZEL_COEFFS];
+                float re, im;
+                dsps_goertzel_result(c, &g->state[t * 2], &re, &im);
+                dsps_goertzel_output(c, re, im,
+                                     (mag != NULL) ? &mag[blocks * g->n_tones + t] : NULL,
+                                     (phase != NULL) ? &phase[blocks * g->n_tones + t] : NULL);
+            }
+            g->state[t * 2 + 0] = 0;
+            g->state[t * 2 + 1] = 0;
+        }
+        blocks += (blocks < max_blocks);
+    }
+    return blocks;
+}
+
+esp_err_t dsps_sdft_init_f32(sdft_f32_t *sd, float *buff, const float *freqs, int n_tones, int len)
+{
+    if ((sd == NULL) || (buff == NULL) || (freqs == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((n_tones <= 0) || (len <= 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    sd->coeffs = buff;
+    sd->x = buff + GOERTZEL_COEFFS * n_tones;
+    sd->delay = sd->x + 2 * n_tones;
+    sd->n_tones = n_tones;
+    sd->len = len;
+    sd->pos = 0;
+    sd->filled = 0;
+    memset(sd->x, 0, (2 * n_tones + len) * sizeof(float));
+    return dsps_goertzel_gen_coeffs(sd->coeffs, freqs, n_tones, len);
+}
+
+esp_err_t dsps_sdft_f32(sdft_f32_t *sd, const float *input, int len)
+{
+    if ((sd == NULL) || (input == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int i = 0;
+    while (i < len) {
+        // Samples up to the end of the delay line, so the old samples are contiguous
+        int chunk = sd->len - sd->pos;
+        chunk = (chunk > len - i) ? len - i : chunk;
+        const float *x_new = &input[i];
+        const float *x_old = &sd->delay[sd->pos];
+        for (int t = 0; t < sd->n_tones; t++) {
+            const float *c = &sd->coeffs[t * GOERTZEL_COEFFS];
+            float cw = c[1];
+            float sw = c[2];
+            float cl = c[3];
+            float sl = c[4];
+            float re = sd->x[t * 2 + 0];
+            float im = sd->x[t * 2 + 1];
+            for (int k = 0; k < chunk; k++) {
+                float d = re - x_old[k];
+                float xn = x_new[k];
+                re = cw * d - sw * im + xn * cl;
+                im = sw * d + cw * im - xn * sl;
+            }
+            sd->x[t * 2 + 0] = re;
+            sd->x[t * 2 + 1] = im;
+        }
+        memcpy(&sd->delay[sd->pos], x_new, chunk * sizeof(float));
+        i += chunk;
+        sd->pos += chunk;
+        if (sd->pos < sd->len) {
+            break;
+        }
+        // The delay line contains the window in order: recalculate the DFT
+        sd->pos = 0;
+        sd->filled = 1;
+        for (int t = 0; t < sd->n_tones; t++) {
+            const float *c = &sd->coeffs[t * GOERTZEL_COEFFS];
+            float state[2] = {0, 0};
+            dsps_goertzel_run(c, sd->delay, sd->len, state);
+            dsps_goertzel_result(c, state, &sd->x[t * 2 + 0], &sd->x[t * 2 + 1]);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_sdft_get_f32(const sdft_f32_t *sd, float *mag, float *phase)
+{
+    if (sd == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int t = 0; t < sd->n_tones; t++) {
+        dsps_goertzel_output(&sd->coeffs[t * GOERTZEL_COEFFS], sd->x[t * 2 + 0], sd->x[t * 2 + 1],
+                             (mag != NULL) ? &mag[t] : NULL, (phase != NULL) ? &phase[t] : NULL);
+    }
+    return ESP_OK;
+}
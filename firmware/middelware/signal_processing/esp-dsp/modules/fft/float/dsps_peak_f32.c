@@ -0,0 +1,258 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_peak.h"
+#include <math.h>
+
+// Insert the local maximum at bin k with value v into the list sorted by value, largest first
+static void dsps_peak_insert(dsps_peak_t *peaks, int *count, int max_peaks, int k, float v)
+{
+    int n = *count;
+    if ((n == max_peaks) && (v <= peaks[n - 1].mag)) {
+        return;
+    }
+    int i = (n < max_peaks) ? n : n - 1;
+    while ((i > 0) && (peaks[i - 1].mag < v)) {
+        peaks[i] = peaks[i - 1];
+        i--;
+    }
+    peaks[i].bin = k;
+    peaks[i].mag = v;
+    peaks[i].harmonic = 0;
+    *count = (n < max_peaks) ? n + 1 : n;
+}
+
+static inline float dsps_peak_clamp(float delta)
+{
+    return (delta > 0.5f) ? 0.5f : ((delta < -0.5f) ? -0.5f : delta);
+}
+
+// Vertex of the parabola through (-1, a), (0, b), (1, c)
+static inline float dsps_peak_parabola(float a, float b, float c, float *peak)
+{
+    float den = a - 2 * b + c;
+    float delta = (den != 0) ? dsps_peak_clamp(0.5f * (a - c) / den) : 0;
+    *peak = b - 0.25f * (a - c) * delta;
+    return delta;
+}
+
+int dsps_peak_find_f32(const float *mag, int len, dsps_peak_t *peaks, int max_peaks, float min_mag, dsps_peak_interp_t interp)
+{
+    if ((mag == NULL) || (peaks == NULL) || (max_peaks <= 0)) {
+        return 0;
+    }
+    int count = 0;
+    for (int k = 1; k < len - 1; k++) {
+        float v = mag[k];
+        if ((v > min_mag) && (v > mag[k - 1]) && (v >= mag[k + 1])) {
+            dsps_peak_insert(peaks, &count, max_peaks, k, v);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        int k = (int)peaks[i].bin;
+        float a = mag[k - 1];
+        float b = mag[k];
+        float c = mag[k + 1];
+        float peak = b;
+        float delta = 0;
+        if (interp == DSPS_PEAK_QUADRATIC) {
+            delta = dsps_peak_parabola(a, b, c, &peak);
+        } else if (interp == DSPS_PEAK_GAUSSIAN) {
+            // Bins with zero magnitude are limited to a small fraction of the peak
+            const float min_ratio = 1e-10f;
+            a = logf(fmaxf(a, b * min_ratio));
+            c = logf(fmaxf(c, b * min_ratio));
+            delta = dsps_peak_parabola(a, logf(b), c, &peak);
+            peak = expf(peak);
+        }
+        peaks[i].bin = k + delta;
+        peaks[i].mag = peak;
+    }
+    return count;
+}
+
+int dsps_peak_find_fc32(const float *spectrum, int len, int fft_len, dsps_peak_t *peaks, int max_peaks, float min_mag,
+                        dsps_peak_window_t window)
+{
+    if ((spectrum == NULL) || (peaks == NULL) || (max_peaks <= 0) || (fft_len <= 0)) {
+        return 0;
+    }
+    // Search in squared magnitudes
+    int count = 0;
+    float min_sq = (min_mag > 0) ? min_mag * min_mag : 0;
+    float prev = spectrum[0] * spectrum[0] + spectrum[1] * spectrum[1];
+    float cur = (len > 1) ? spectrum[2] * spectrum[2] + spectrum[3] * spectrum[3] : 0;
+    for (int k = 1; k < len - 1; k++) {
+        float next = spectrum[k * 2 + 2] * spectrum[k * 2 + 2] + spectrum[k * 2 + 3] * spectrum[k * 2 + 3];
+        if ((cur > min_sq) && (cur > prev) && (cur >= next)) {
+            dsps_peak_insert(peaks, &count, max_peaks, k, cur);
+        }
+        prev = cur;
+        cur = next;
+    }
+    float scale;
+    if (window == DSPS_PEAK_WIN_HANN) {
+        scale = 2;
+    } else {
+        float x = M_PI / fft_len;
+        scale = tanf(x) / x;
+    }
+    for (int i = 0; i < count; i++) {
+        int k = (int)peaks[i].bin;
+        const float *a = &spectrum[(k - 1) * 2];
+        const float *b = &spectrum[k * 2];
+        const float *c = &spectrum[(k + 1) * 2];
+        // (a - c)/(2*b - a - c)
+        float num_re = a[0] - c[0];
+        float num_im = a[1] - c[1];
+        float den_re = 2 * b[0] - a[0] - c[0];
+        float den_im = 2 * b[1] - a[1] - c[1];
+        float den = den_re * den_re + den_im * den_im;
+        float delta = (den > 0) ? dsps_peak_clamp(scale * (num_re * den_re + num_im * den_im) / den) : 0;
+        float ma = sqrtf(a[0] * a[0] + a[1] * a[1]);
+        float mb = sqrtf(peaks[i].mag);
+        float mc = sqrtf(c[0] * c[0] + c[1] * c[1]);
+        // Magnitude from the parabola at the estimated position
+        peaks[i].mag = mb + 0.5f * delta * (mc - ma) + 0.5f * delta * delta * (ma - 2 * mb + mc);
+        peaks[i].bin = k + delta;
+    }
+    return count;
+}
+
+// Sum of magnitudes of the peaks, that are harmonics of f0
+static float dsps_peak_harmonic_score(const dsps_peak_t *peaks, int n_peaks, int max_harmonic, float tol, float f0)
+{
+    float score = 0;
+    for (int j = 0; j < n_peaks; j++) {
+        float r = peaks[j].bin / f0;
+        int n = (int)roundf(r);
+        if ((n >= 1) && (n <= max_harmonic) && (fabsf(r - n) <= tol * n)) {
+            score += peaks[j].mag;
+        }
+    }
+    return score;
+}
+
+esp_err_t dsps_peak_harmonics_f32(dsps_peak_t *peaks, int n_peaks, int max_harmonic, float tol, float *f0)
+{
+    if ((peaks == NULL) || (f0 == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (n_peaks <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((max_harmonic < 1) || (max_harmonic > 32) || (tol <= 0) || (tol >= 0.5f)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    // Scores of all candidates, the best score first
+    float best = 0;
+    for (int i = 0; i < n_peaks; i++) {
+        for (int h = 1; h <= max_harmonic; h++) {
+            float f = peaks[i].bin / h;
+            if (f >= 1) {
+                best = fmaxf(best, dsps_peak_harmonic_score(peaks, n_peaks, max_harmonic, tol, f));
+            }
+        }
+    }
+    // The highest candidate close to the best score: subharmonics explain the same peaks
+    const float score_ratio = 0.9f;
+    float f_best = 0;
+    for (int i = 0; i < n_peaks; i++) {
+        for (int h = 1; h <= max_harmonic; h++) {
+            float f = peaks[i].bin / h;
+            if ((f >= 1) && (f > f_best) &&
+                    (dsps_peak_harmonic_score(peaks, n_peaks, max_harmonic, tol, f) >= score_ratio * best)) {
+                f_best = f;
+            }
+        }
+    }
+    if (f_best == 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    // Weighted least squares fit of f0 to the positions of the harmonics
+    float num = 0;
+    float den = 0;
+    for (int j = 0; j < n_peaks; j++) {
+        float r = peaks[j].bin / f_best;
+        int n = (int)roundf(r);
+        if ((n >= 1) && (n <= max_harmonic) && (fabsf(r - n) <= tol * n)) {
+            peaks[j].harmonic = n;
+            num += peaks[j].mag * n * peaks[j].bin;
+            den += peaks[j].mag * n * n;
+        } else {
+            peaks[j].harmonic = 0;
+        }
+    }
+    *f0 = (den > 0) ? num / den : f_best;
+    return ESP_OK;
+}
+
+esp_err_t dsps_peak_track_init_f32(peak_track_f32_t *tr, float max_jump, float hysteresis, float alpha, int hold)
+{
+    if (tr == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((max_jump <= 0) || (hysteresis < 1) || (alpha <= 0) || (alpha > 1) || (hold < 0)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    tr->bin = 0;
+    tr->mag = 0;
+    tr->max_jump = max_jump;
+    tr->hysteresis = hysteresis;
+    tr->alpha = alpha;
+    tr->hold = hold;
+    tr->miss = 0;
+    tr->valid = 0;
+    return ESP_OK;
+}
+
+int dsps_peak_track_f32(peak_track_f32_t *tr, const dsps_peak_t *peaks, int n_peaks, float *bin)
+{
+    // The largest peak and the largest peak close to the track
+    const dsps_peak_t *strongest = NULL;
+    const dsps_peak_t *match = NULL;
+    for (int i = 0; i < n_peaks; i++) {
+        const dsps_peak_t *p = &peaks[i];
+        if ((strongest == NULL) || (p->mag > strongest->mag)) {
+            strongest = p;
+        }
+        if (tr->valid && (fabsf(p->bin - tr->bin) <= tr->max_jump) && ((match == NULL) || (p->mag > match->mag))) {
+            match = p;
+        }
+    }
+    const dsps_peak_t *start = NULL;
+    if (match != NULL) {
+        if ((strongest != match) && (strongest->mag > tr->hysteresis * match->mag)) {
+            start = strongest;
+        } else {
+            tr->bin += tr->alpha * (match->bin - tr->bin);
+            tr->mag = match->mag;
+            tr->miss = 0;
+        }
+    } else if (!tr->valid || (++tr->miss > tr->hold)) {
+        // A new track starts from the largest peak, without smoothing
+        start = strongest;
+        tr->valid = 0;
+    }
+    if (start != NULL) {
+        tr->bin = start->bin;
+        tr->mag = start->mag;
+        tr->miss = 0;
+        tr->valid = 1;
+    }
+    if (tr->valid && (bin != NULL)) {
+        *bin = tr->bin;
+    }
+    return tr->valid;
+}
@@ -0,0 +1,176 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_czt_H_
+#define _dsps_czt_H_
+
+#include "dsp_err.h"
+#include "dsps_fir.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 chirp-Z transform
+ *
+ * This structure is used by the transform internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_czt_init_f32(...) function.
+ */
+typedef struct czt_f32_s {
+    float  *pre;        /*!< Chirp of the input: exp(-j*2*pi*(f_start*n + f_step*n^2/2)). Length of 2*N.*/
+    float  *post;       /*!< Chirp of the output: exp(-j*pi*f_step*k^2)/fft_len. Length of 2*M.*/
+    float  *filter;     /*!< FFT of the chirp filter exp(j*pi*f_step*m^2). Length of 2*fft_len.*/
+    float  *work;       /*!< Buffer for the convolution. Length of 2*fft_len.*/
+    int     N;          /*!< Length of the input.*/
+    int     M;          /*!< Amount of output bins.*/
+    int     fft_len;    /*!< Length of the FFT: power of 2, not less than N + M - 1.*/
+} czt_f32_t;
+
+/**
+ * @brief Data struct of f32 zoom FFT
+ *
+ * This structure is used by the transform internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_zoom_fft_init_f32(...) function.
+ */
+typedef struct zoom_fft_f32_s {
+    fir_f32_t fir_re;   /*!< Decimation filter of the real part.*/
+    fir_f32_t fir_im;   /*!< Decimation filter of the imaginary part.*/
+    float  *mix_re;     /*!< Mixed real part of one output sample. Length of decim.*/
+    float  *mix_im;     /*!< Mixed imaginary part of one output sample. Length of decim.*/
+    float  *window;     /*!< Hann window of the FFT. Length of fft_len.*/
+    float   osc_re;     /*!< Real part of the local oscillator.*/
+    float   osc_im;     /*!< Imaginary part of the local oscillator.*/
+    float   rot_re;     /*!< Real part of the oscillator step: cos(2*pi*f_center).*/
+    float   rot_im;     /*!< Imaginary part of the oscillator step: -sin(2*pi*f_center).*/
+    float   scale;      /*!< Scale of the result: 2/sum(window).*/
+    int     decim;      /*!< Decimation factor.*/
+    int     fft_len;    /*!< Length of the FFT.*/
+} zoom_fft_f32_t;
+
+/**
+ * @brief   initialize structure for chirp-Z transform
+ *
+ * Function calculates the chirps and the FFT of the chirp filter.
+ * FFT tables must be initialized by dsps_fft2r_init_fc32(...) for the length of the transform
+ * (power of 2 not less than N + M - 1) before this function and dsps_czt_fxx(...) are called.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param czt: pointer to the transform structure, that must be preallocated
+ * @param buff: working buffer. Length of 2*(N + M) + 4*fft_len, where fft_len is power of 2 not less than N + M - 1
+ * @param N: length of the input, any value
+ * @param M: amount of output bins, any value
+ * @param f_start: frequency of the first bin, normalized to sample frequency. Could be negative
+ * @param f_step: step between bins, normalized to sample frequency. Could be much less than 1/N
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_czt_init_f32(czt_f32_t *czt, float *buff, int N, int M, float f_start, float f_step);
+
+/**
+ * @brief   initialize structure for chirp-Z transform equal to DFT
+ *
+ * Same as dsps_czt_init_f32(czt, buff, N, N, 0, 1.0f/N), but the chirp phases pi*n^2/N are
+ * reduced exactly by n^2 mod 2*N, so there is no error of 1/N rounded to float.
+ * Used for FFT of lengths with large prime factors.
+ *
+ * @param czt: pointer to the transform structure, that must be preallocated
+ * @param buff: working buffer. Length of 4*N + 4*fft_len, where fft_len is power of 2 not less than 2*N - 1
+ * @param N: length of the DFT
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_czt_init_dft_f32(czt_f32_t *czt, float *buff, int N);
+
+/**@{*/
+/**
+ * @brief   Chirp-Z transform
+ *
+ * Function calculates M bins of the DTFT X[k] = sum(x[n]*exp(-j*2*pi*(f_start + k*f_step)*n)) over
+ * an arbitrary frequency span by the Bluestein algorithm: the product n*k is written as
+ * (n^2 + k^2 - (k - n)^2)/2, so the transform is a convolution with a chirp, calculated by two
+ * FFTs of fft_len. Compared to a long FFT with the same bin step, only the needed bins
+ * are calculated and the length of the input is not limited to power of 2.
+ * The result is equal to the DFT for f_start = 0, f_step = 1/N and M = N.
+ * The implementation use ANSI C and the optimized dsps_fft2r_fc32 for the FFTs.
+ *
+ * @param czt: pointer to the transform structure, that must be initialized before
+ * @param[in] input: input array. N real values (_f32) or N re,im pairs (_fc32)
+ * @param output: result bins. M re,im pairs
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_czt_f32(czt_f32_t *czt, const float *input, float *output);
+esp_err_t dsps_czt_fc32(czt_f32_t *czt, const float *input, float *output);
+/**@}*/
+
+/**
+ * @brief   initialize structure for zoom FFT
+ *
+ * Function generates the decimation filter (Kaiser windowed sinc with cut off at the edge of
+ * the zoomed band and 80 dB attenuation) and the window of the FFT.
+ * FFT tables must be initialized by dsps_fft2r_init_fc32(...) for fft_len before dsps_zoom_fft_f32(...) is called.
+ *
+ * @param zoom: pointer to the transform structure, that must be preallocated
+ * @param buff: working buffer. Length of 3*fir_len + 2*decim + fft_len.
+ *              For ESP32S3 the buffer must be aligned to 16 and fir_len must be divisible by 4
+ * @param f_center: center frequency of the zoomed band, normalized to sample frequency, 0..0.5
+ * @param decim: decimation factor. The zoomed band is 1/decim of the sample frequency
+ * @param fir_len: length of the decimation filter, for example 8*decim
+ * @param fft_len: length of the FFT, power of 2
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_zoom_fft_init_f32(zoom_fft_f32_t *zoom, float *buff, float f_center, int decim, int fir_len, int fft_len);
+
+/**
+ * @brief   Zoom FFT
+ *
+ * Spectrum of the band of width fs/decim around f_center with the bin step fs/(decim*fft_len):
+ * the signal is mixed to 0 by a complex oscillator, filtered and decimated by dsps_fird_f32,
+ * and the decimated complex signal is transformed by FFT of fft_len with Hann window.
+ * The resolution is the same as for FFT of decim*fft_len samples, but the memory and the FFT
+ * are decim times smaller. The state is kept between calls, so blocks of a stream are continuous,
+ * the first block contains the transient of the filter.
+ * Bins close to the edges of the band are attenuated by the decimation filter.
+ * The implementation use ANSI C and the optimized dsps_fird_f32 and dsps_fft2r_fc32.
+ *
+ * @param zoom: pointer to the transform structure, that must be initialized before
+ * @param[in] input: input array. Length of decim*fft_len
+ * @param output: result bins: fft_len re,im pairs for frequencies
+ *                f_center + (k - fft_len/2)/(decim*fft_len), k = 0..fft_len - 1.
+ *                Magnitude of a bin is the amplitude of a real cosine at the bin frequency
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_zoom_fft_f32(zoom_fft_f32_t *zoom, const float *input, float *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_czt_H_
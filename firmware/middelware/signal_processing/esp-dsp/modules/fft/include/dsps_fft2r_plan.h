@@ -0,0 +1,118 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fft2r_plan_H_
+#define _dsps_fft2r_plan_H_
+
+#include <stdint.h>
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_FFT2R_PLAN_MAX_SIZE    8192    /*!< Maximum length of the plan, limited by 16 bit offsets of the bit reverse table.*/
+
+/**
+ * @brief Data struct of f32 radix 2 FFT plan
+ *
+ * This structure is used by the FFT internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_fft2r_plan_init_fc32(...) function.
+ * After init the plan is only read, so one plan could be used by several tasks at the same time.
+ */
+typedef struct fft2r_plan_fc32_s {
+    int     N;          /*!< Length of the FFT.*/
+    float  *w;          /*!< Bit reversed table of sin/cos, own or of the shared plan. Length of at least N.*/
+    int     w_size;     /*!< Length of the FFT the table is generated for. Plans up to this length could share it.*/
+    uint16_t *rev_tab;  /*!< Pairs of byte offsets of the elements to swap, as for dsps_bit_rev_lookup_fc32(...).*/
+    int     rev_size;   /*!< Amount of pairs in rev_tab, even.*/
+} fft2r_plan_fc32_t;
+
+/**
+ * @brief Cost of the FFT plan
+ */
+typedef struct fft2r_plan_cost_s {
+    int     buff_len;   /*!< Length of the buffer for dsps_fft2r_plan_init_fc32(...), floats.*/
+    int     mem_bytes;  /*!< Memory of the tables, bytes.*/
+    int     trig;       /*!< Amount of sinf/cosf calls at init.*/
+    int     init_ops;   /*!< Amount of elements written to the tables at init.*/
+    int     butterflies;/*!< Amount of radix 2 butterflies of one transform: 4 multiplications and 6 additions each.*/
+    int     swaps;      /*!< Amount of complex swaps of the bit reverse of one transform.*/
+} fft2r_plan_cost_t;
+
+/**
+ * @brief   Cost of the FFT plan
+ *
+ * Function returns the memory and amount of operations of dsps_fft2r_plan_init_fc32(...) and of one
+ * transform, without the creation of the plan, to select the sizes and the sharing of the tables.
+ *
+ * @param N: length of the FFT
+ * @param shared: 0 - the plan generates own table, 1 - the plan uses the table of other plan
+ *                of larger length (buffer is not required for the same length)
+ * @param cost: result cost
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft2r_plan_cost_fc32(int N, int shared, fft2r_plan_cost_t *cost);
+
+/**
+ * @brief   initialize radix 2 FFT plan
+ *
+ * Function prepares the sin/cos table and the bit reverse table of the plan, independent from
+ * the global tables of dsps_fft2r_init_fc32(...). Plans of different lengths could be used at the same time.
+ * The sin/cos table is stored in the bit reversed order, so the first N/2 complex values of the table
+ * for length M are equal to the table for length N < M (the table for M with stride M/N in the natural order).
+ * If shared is not NULL, the plan uses the table of the shared plan, that must be not shorter than N
+ * and must exist while the plan is used. If shared has the same length, the bit reverse table is shared too.
+ * For ESP32-S3 the buffer must be aligned to 16 bytes.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param plan: pointer to the plan structure, that must be preallocated
+ * @param buff: buffer for the tables. Length of buff_len of dsps_fft2r_plan_cost_fc32(...).
+ *              Could be NULL if the length is 0
+ * @param N: length of the FFT, power of 2 from 2 to DSPS_FFT2R_PLAN_MAX_SIZE
+ * @param shared: plan with the sin/cos table to use, or NULL to generate own table
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft2r_plan_init_fc32(fft2r_plan_fc32_t *plan, float *buff, int N, const fft2r_plan_fc32_t *shared);
+
+/**
+ * @brief   Complex FFT by the plan
+ *
+ * In place complex FFT of radix 2 with bit reverse of the result, as dsps_fft2r_fc32(...) and
+ * dsps_bit_rev_fc32(...) with the tables of the plan. The function does not change the plan and
+ * global data, so it is re-entrant.
+ * The optimized FFT and bit reverse are used on ESP32 and ESP32-S3.
+ *
+ * @param[in] plan: pointer to the plan structure, that must be initialized before
+ * @param[inout] data: input/output complex array. An elements located: Re[0], Im[0], ... Re[N-1], Im[N-1]
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft2r_plan_fc32(const fft2r_plan_fc32_t *plan, float *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fft2r_plan_H_
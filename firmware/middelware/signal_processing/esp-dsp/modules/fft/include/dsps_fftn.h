@@ -0,0 +1,100 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fftn_H_
+#define _dsps_fftn_H_
+
+#include "dsp_err.h"
+#include "dsps_czt.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_FFTN_MAX_FACTORS   16  /*!< Maximum amount of radix stages.*/
+
+/**
+ * @brief Data struct of f32 FFT plan of any length
+ *
+ * This structure is used by the FFT internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_fftn_init_fc32(...) function.
+ */
+typedef struct fftn_f32_s {
+    int     N;          /*!< Length of the FFT.*/
+    int     n_factors;  /*!< Amount of radix stages, 0 for Bluestein algorithm.*/
+    int     factors[DSPS_FFTN_MAX_FACTORS]; /*!< Radix of every stage: 4, 2, 3 or 5.*/
+    float  *twiddle;    /*!< Twiddle factors exp(-j*2*pi*i/N). Length of 2*N. Mixed radix only.*/
+    float  *work;       /*!< Buffer for the stages or the result of Bluestein algorithm. Length of 2*N.*/
+    czt_f32_t czt;      /*!< Chirp-Z transform for Bluestein algorithm.*/
+} fftn_f32_t;
+
+/**
+ * @brief   Length of the working buffer of FFT plan
+ *
+ * @param N: length of the FFT
+ *
+ * @return
+ *      - length of the buffer for dsps_fftn_init_fc32(...), floats.
+ *        4*N if N has only factors 2, 3 and 5, otherwise 6*N + 4*L, where L is power of 2 not less than 2*N - 1
+ */
+int dsps_fftn_buff_len_fc32(int N);
+
+/**
+ * @brief   initialize FFT plan of any length
+ *
+ * Function factorizes N to radix 4, 2, 3 and 5 stages and calculates the twiddle factors.
+ * If N has other prime factors, the plan uses the Bluestein algorithm (dsps_czt_fc32(...)) and
+ * FFT tables must be initialized by dsps_fft2r_init_fc32(...) for power of 2 not less than 2*N - 1
+ * before this function and dsps_fftn_fc32(...) are called.
+ * The plan could be reused for any amount of transforms of the same length.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param plan: pointer to the plan structure, that must be preallocated
+ * @param buff: working buffer. Length of dsps_fftn_buff_len_fc32(N)
+ * @param N: length of the FFT
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fftn_init_fc32(fftn_f32_t *plan, float *buff, int N);
+
+/**
+ * @brief   Complex FFT of any length
+ *
+ * In place complex FFT of length N, as dsps_fft2r_fc32(...) for lengths that are not power of 2:
+ * for example 231 samples of a record or 1000 samples of 1 second at 1 kHz, without padding
+ * to a power of 2 and the change of the bin step.
+ * Lengths with factors 2, 3 and 5 are calculated by the mixed radix Stockham algorithm, that keeps
+ * the natural order of the bins, other lengths by the Bluestein algorithm with power of 2 FFTs.
+ * The result is in natural order: dsps_bit_rev_fc32(...) must not be called.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param plan: pointer to the plan structure, that must be initialized before
+ * @param data: input/output complex array. An element with index i is at data[i*2 + 0] (re) and data[i*2 + 1] (im).
+ *              Length of 2*N
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fftn_fc32(fftn_f32_t *plan, float *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fftn_H_
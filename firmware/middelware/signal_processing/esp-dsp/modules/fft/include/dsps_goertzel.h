@@ -0,0 +1,154 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_goertzel_H_
+#define _dsps_goertzel_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 Goertzel detector bank
+ *
+ * This structure is used by the detector internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_goertzel_init_f32(...) function.
+ */
+typedef struct goertzel_f32_s {
+    float  *coeffs;     /*!< Per tone: Reinsch coefficient, cos(w), sin(w), cos(w*(len - 1)), sin(w*(len - 1)), amplitude scale.*/
+    float  *state;      /*!< Per tone: s[n] and d[n] of the recursion in the Reinsch form.*/
+    int     n_tones;    /*!< Amount of tones.*/
+    int     len;        /*!< Length of the block.*/
+    int     count;      /*!< Amount of samples in the current block.*/
+} goertzel_f32_t;
+
+/**
+ * @brief Data struct of f32 sliding DFT detector bank
+ *
+ * This structure is used by the detector internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_sdft_init_f32(...) function.
+ */
+typedef struct sdft_f32_s {
+    float  *delay;      /*!< Last len samples (circular buffer).*/
+    float  *coeffs;     /*!< Per tone: Reinsch coefficient, cos(w), sin(w), cos(w*(len - 1)), sin(w*(len - 1)), amplitude scale.*/
+    float  *x;          /*!< Per tone: real and imaginary part of the DFT of the window.*/
+    int     n_tones;    /*!< Amount of tones.*/
+    int     len;        /*!< Length of the window.*/
+    int     pos;        /*!< Position of the oldest sample in the delay line.*/
+    int     filled;     /*!< 1 when the delay line is full.*/
+} sdft_f32_t;
+
+/**
+ * @brief   initialize structure for Goertzel detector bank
+ *
+ * @param g: pointer to the detector structure, that must be preallocated
+ * @param buff: working buffer. Length of 8*n_tones
+ * @param freqs: frequencies of the tones, normalized to sample frequency, 0..0.5. Could be non integer bins
+ * @param n_tones: amount of tones
+ * @param len: length of the block
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_goertzel_init_f32(goertzel_f32_t *g, float *buff, const float *freqs, int n_tones, int len);
+
+/**
+ * @brief   Goertzel detector bank
+ *
+ * DFT of blocks of len samples at arbitrary frequencies by the generalized Goertzel algorithm:
+ * three multiply-add operations per sample and tone, and the complex result is
+ * calculated once per block with the phase correction of non integer bins.
+ * The recursion is calculated in the Reinsch form, with the coefficient -4*sin(w/2)^2 (or 4*cos(w/2)^2
+ * above fs/4) instead of 2*cos(w), so the precision is not lost for tones near DC and fs/2.
+ * The result is equal to the DFT sum(x[n]*exp(-j*w*n)) over the block.
+ * Two tones are processed in one pass. For less than about log2(len)/2 tones it is faster than FFT of the block.
+ * The input could be passed in chunks of any length, the results are written when a block is completed.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param g: pointer to the detector structure, that must be initialized before
+ * @param[in] input: input array
+ * @param len: length of input array
+ * @param mag: amplitudes of the tones: 2*|X|/len (|X|/len for frequencies 0 and 0.5).
+ *             n_tones values per block. Could be NULL
+ * @param phase: phases of the tones relative to the first sample of the block, radians.
+ *               n_tones values per block. Could be NULL
+ * @param max_blocks: amount of blocks in mag and phase arrays. If more blocks are completed, results are lost
+ *
+ * @return
+ *      - amount of completed blocks
+ */
+int dsps_goertzel_f32(goertzel_f32_t *g, const float *input, int len, float *mag, float *phase, int max_blocks);
+
+/**
+ * @brief   initialize structure for sliding DFT detector bank
+ *
+ * @param sd: pointer to the detector structure, that must be preallocated
+ * @param buff: working buffer. Length of len + 8*n_tones
+ * @param freqs: frequencies of the tones, normalized to sample frequency, 0..0.5. Could be non integer bins
+ * @param n_tones: amount of tones
+ * @param len: length of the window
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sdft_init_f32(sdft_f32_t *sd, float *buff, const float *freqs, int n_tones, int len);
+
+/**
+ * @brief   Sliding DFT detector bank
+ *
+ * DFT of the last len samples at arbitrary frequencies, updated for every sample by the recursion
+ * X[n] = exp(j*w)*(X[n - 1] - x[n - len]) + x[n]*exp(-j*w*(len - 1)): one complex multiplication
+ * per sample and tone, independent of the window length. For non integer bins the second
+ * twiddle factor keeps the result equal to the DFT of the window.
+ * The recursion is marginally stable, so the rounding errors would accumulate: every len samples
+ * the DFT is recalculated from the delay line by the Goertzel algorithm, that doubles the cost
+ * on average but keeps the error of one window for any duration of the stream.
+ * Until len samples are received, the missing samples are zeros.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param sd: pointer to the detector structure, that must be initialized before
+ * @param[in] input: input array
+ * @param len: length of input array
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sdft_f32(sdft_f32_t *sd, const float *input, int len);
+
+/**
+ * @brief   Result of sliding DFT detector bank
+ *
+ * @param[in] sd: pointer to the detector structure
+ * @param mag: amplitudes of the tones: 2*|X|/len (|X|/len for frequencies 0 and 0.5). Length of n_tones. Could be NULL
+ * @param phase: phases of the tones relative to the oldest sample of the window, radians. Length of n_tones. Could be NULL
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sdft_get_f32(const sdft_f32_t *sd, float *mag, float *phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_goertzel_H_
@@ -0,0 +1,178 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_peak_H_
+#define _dsps_peak_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Interpolation of the peak position between the bins of a magnitude spectrum
+ */
+typedef enum dsps_peak_interp_e {
+    DSPS_PEAK_NONE = 0,         /*!< Center of the maximal bin.*/
+    DSPS_PEAK_QUADRATIC = 1,    /*!< Parabola through the magnitudes of three bins.*/
+    DSPS_PEAK_GAUSSIAN = 2,     /*!< Parabola through the logarithms of the magnitudes. Best for Hann and Gaussian windows.*/
+} dsps_peak_interp_t;
+
+/**
+ * @brief Window of the signal, for interpolation of the complex spectrum
+ */
+typedef enum dsps_peak_window_e {
+    DSPS_PEAK_WIN_RECT = 0,     /*!< Rectangular window (no window).*/
+    DSPS_PEAK_WIN_HANN = 1,     /*!< Hann window, as FFTMagnitude.*/
+} dsps_peak_window_t;
+
+/**
+ * @brief Spectral peak
+ */
+typedef struct dsps_peak_s {
+    float   bin;        /*!< Position of the peak in bins, with fractional part. Frequency is bin*fs/N.*/
+    float   mag;        /*!< Interpolated magnitude of the peak.*/
+    int     harmonic;   /*!< Harmonic number set by dsps_peak_harmonics_f32(...), 0 - not a harmonic.*/
+} dsps_peak_t;
+
+/**
+ * @brief Data struct of dominant frequency tracker
+ *
+ * This structure is used by the tracker internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_peak_track_init_f32(...) function.
+ */
+typedef struct peak_track_f32_s {
+    float   bin;        /*!< Tracked position, bins.*/
+    float   mag;        /*!< Magnitude of the tracked peak.*/
+    float   max_jump;   /*!< Maximum change of the position between frames, bins.*/
+    float   hysteresis; /*!< Ratio of magnitudes for switching to another peak.*/
+    float   alpha;      /*!< Smoothing of the position, 0..1. 1 - no smoothing.*/
+    int     hold;       /*!< Amount of frames to keep the track without a matching peak.*/
+    int     miss;       /*!< Amount of frames without a matching peak.*/
+    int     valid;      /*!< 1 if a peak is tracked.*/
+} peak_track_f32_t;
+
+/**
+ * @brief   Find peaks of magnitude spectrum
+ *
+ * Function finds up to max_peaks largest local maxima of the magnitude spectrum (for example
+ * the output of FFTMagnitude) above min_mag, and interpolates the position and magnitude of
+ * every peak from three bins around it, so the frequency is not limited to the bin centers.
+ * The peaks are sorted by magnitude, largest first. The first and last bins are not peaks.
+ * The cost is O(len) for a small max_peaks.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] mag: magnitude spectrum
+ * @param len: length of mag array
+ * @param peaks: result peaks. Length of max_peaks
+ * @param max_peaks: maximum amount of peaks
+ * @param min_mag: minimum magnitude of a peak
+ * @param interp: interpolation method
+ *
+ * @return
+ *      - amount of found peaks
+ */
+int dsps_peak_find_f32(const float *mag, int len, dsps_peak_t *peaks, int max_peaks, float min_mag, dsps_peak_interp_t interp);
+
+/**
+ * @brief   Find peaks of complex spectrum
+ *
+ * Same as dsps_peak_find_f32(...) for complex spectrum (for example FFT after dsps_bit_rev_fc32 and
+ * dsps_cplx2reC_fc32), with the Jacobsen estimator of the position:
+ * delta = scale*Re((X[k - 1] - X[k + 1])/(2*X[k] - X[k - 1] - X[k + 1])), where scale is
+ * tan(pi/N)/(pi/N) for the rectangular window (Candan correction) and 2 for the Hann window.
+ * The estimator uses the phase, so it is more accurate than the interpolation of the magnitudes,
+ * and it is unbiased for the rectangular window. The magnitude is interpolated by a parabola.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] spectrum: complex spectrum. re,im pairs. Length of 2*len
+ * @param len: amount of complex bins to search, for example N/2
+ * @param fft_len: length of the FFT, N
+ * @param peaks: result peaks. Length of max_peaks
+ * @param max_peaks: maximum amount of peaks
+ * @param min_mag: minimum magnitude |X| of a peak
+ * @param window: window of the signal
+ *
+ * @return
+ *      - amount of found peaks
+ */
+int dsps_peak_find_fc32(const float *spectrum, int len, int fft_len, dsps_peak_t *peaks, int max_peaks, float min_mag,
+                        dsps_peak_window_t window);
+
+/**
+ * @brief   Group peaks to harmonics
+ *
+ * Function finds the fundamental frequency f0 that explains the largest sum of magnitudes of
+ * the peaks as its harmonics 1..max_harmonic, with relative tolerance tol of the position.
+ * Candidates are the peaks divided by 1..max_harmonic. Of candidates with about the same score
+ * the highest one is selected, so a subharmonic is not reported.
+ * The harmonic number of every peak is set, 0 for peaks that are not harmonics of f0.
+ * The fundamental could be missing from the peaks.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param peaks: peaks found by dsps_peak_find_xxx(...). The harmonic field is updated
+ * @param n_peaks: amount of peaks
+ * @param max_harmonic: maximum harmonic number, 1..32
+ * @param tol: relative tolerance of the harmonic position, for example 0.02
+ * @param f0: result fundamental frequency, bins
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if there are no peaks
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_peak_harmonics_f32(dsps_peak_t *peaks, int n_peaks, int max_harmonic, float tol, float *f0);
+
+/**
+ * @brief   initialize structure for dominant frequency tracker
+ *
+ * @param tr: pointer to the tracker structure, that must be preallocated
+ * @param max_jump: maximum change of the frequency between frames, bins
+ * @param hysteresis: another peak must be larger than the tracked one by this ratio to take over, >= 1
+ * @param alpha: smoothing of the frequency, 0..1. 1 - no smoothing
+ * @param hold: amount of frames to keep the frequency when the tracked peak is missing
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_peak_track_init_f32(peak_track_f32_t *tr, float max_jump, float hysteresis, float alpha, int hold);
+
+/**
+ * @brief   Dominant frequency tracker
+ *
+ * Function follows the dominant peak from frame to frame: the largest peak within max_jump of
+ * the tracked frequency continues the track and smooths it, another peak takes over only if it is
+ * larger by the hysteresis ratio or the track is missing for more than hold frames.
+ * So a short interference or a dropout does not make the frequency jump.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param tr: pointer to the tracker structure, that must be initialized before
+ * @param[in] peaks: peaks of the frame found by dsps_peak_find_xxx(...)
+ * @param n_peaks: amount of peaks
+ * @param bin: tracked frequency, bins. Unchanged if nothing is tracked
+ *
+ * @return
+ *      - 1 if a frequency is tracked, 0 otherwise
+ */
+int dsps_peak_track_f32(peak_track_f32_t *tr, const dsps_peak_t *peaks, int n_peaks, float *bin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_peak_H_
@@ -0,0 +1,99 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_spectrum_H_
+#define _dsps_spectrum_H_
+
+#include <stdint.h>
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Method of the magnitude calculation
+ */
+typedef enum dsps_mag_method_e {
+    DSPS_MAG_AMAX_BMIN = 0, /*!< alpha*max(|re|, |im|) + beta*min(|re|, |im|), error up to 4%.*/
+    DSPS_MAG_CORDIC = 1,    /*!< CORDIC vectoring, 8 iterations, error about 0.01%.*/
+    DSPS_MAG_ISQRT = 2,     /*!< Integer square root of re^2 + im^2, error up to 1 LSB.*/
+} dsps_mag_method_t;
+
+/**
+ * @brief   Prepare ADC samples for sc16 FFT
+ *
+ * Function removes the mean of the samples, multiplies them by the window and stores them
+ * to the real part of the complex array for dsps_fft2r_sc16(...). The block is shifted to the
+ * full scale of 15 bits (block floating point), so the fixed scaling by 1/2 of every stage of
+ * dsps_fft2r_sc16(...) does not lose the resolution of 12 bit samples.
+ * The spectrum of the input is equal to the FFT result multiplied by 2^exp.
+ * The rounding of the 16 bit butterflies limits the dynamic range to about 60 dB below the peak.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: unsigned samples, for example of 12 bit ADC
+ * @param[in] window: window in Q15 (for example dsps_wind_hann_f32(...) multiplied by 32767). Could be NULL
+ * @param data: output complex array. Length of 2*len
+ * @param len: length of the input array, power of 2
+ * @param exp: result exponent of the block
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_spectrum_prep_sc16(const uint16_t *input, const int16_t *window, int16_t *data, int len, int *exp);
+
+/**
+ * @brief   Magnitude of sc16 complex array
+ *
+ * Integer magnitude of the FFT result without float and sqrt, for chips without FPU.
+ * DSPS_MAG_ISQRT uses dsps_isqrt_u32(...).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] data: complex array. An elements located: Re[0], Im[0], ... Re[len-1], Im[len-1]
+ * @param mag: output magnitudes. Length of len
+ * @param len: amount of complex elements
+ * @param method: method of the calculation
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mag_sc16(const int16_t *data, uint16_t *mag, int len, dsps_mag_method_t method);
+
+/**
+ * @brief   Magnitude in dB
+ *
+ * Function calculates 20*log10(mag*2^exp) in 0.01 dB by dsps_log2_u32(...): the position of the highest bit and
+ * a table of log2 with linear interpolation, error less than 0.01 dB.
+ * 0 magnitude returns INT16_MIN.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] mag: magnitudes, for example of dsps_mag_sc16(...)
+ * @param db: output, 0.01 dB. Length of len. Could be the same as mag
+ * @param len: length of the arrays
+ * @param exp: exponent of the magnitudes, for example of dsps_spectrum_prep_sc16(...)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mag_db_sc16(const uint16_t *mag, int16_t *db, int len, int exp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_spectrum_H_
@@ -0,0 +1,161 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_czt.h"
+#include "dsps_fft2r.h"
+#include "dsps_peak.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_czt_f32";
+
+#define N_MAX       300
+#define M_MAX       128
+#define FFT_MAX     512
+#define DECIM       16
+#define ZOOM_LEN    128
+#define FIR_LEN     (8 * DECIM)
+#define SIG_LEN     (DECIM * ZOOM_LEN)
+
+static float x[2 * SIG_LEN];
+static float out[2 * SIG_LEN];
+static float buff[2 * (N_MAX + M_MAX) + 4 * FFT_MAX];
+static float zoom_buff[3 * FIR_LEN + 2 * DECIM + ZOOM_LEN] __attribute__((aligned(16)));
+
+// Direct DTFT in double precision, the error is relative to the largest bin
+static float czt_error(const float *input, int cplx, int N, int M, float f_start, float f_step, const float *result)
+{
+    float max_err = 0;
+    float max_mag = 0;
+    for (int k = 0; k < M; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0; n < N; n++) {
+            double ph = -2 * M_PI * ((double)f_start + (double)k * f_step) * n;
+            double xr = cplx ? input[n * 2 + 0] : input[n];
+            double xi = cplx ? input[n * 2 + 1] : 0;
+            re += xr * cos(ph) - xi * sin(ph);
+            im += xr * sin(ph) + xi * cos(ph);
+        }
+        float err = hypot(result[k * 2 + 0] - re, result[k * 2 + 1] - im);
+        max_err = fmaxf(max_err, err);
+        max_mag = fmaxf(max_mag, hypot(re, im));
+    }
+    return max_err / max_mag;
+}
+
+TEST_CASE("dsps_czt_f32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, FFT_MAX));
+    srand(66);
+    for (int i = 0; i < 2 * N_MAX; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    for (int n = 0; n < N_MAX; n++) {
+        x[n] += sinf(2 * M_PI * 0.1103f * n);
+    }
+    // Length, bins, span: dense bins in a narrow band, negative frequencies, the full DFT
+    const int Ns[] = {N_MAX, 200, 64};
+    const int Ms[] = {M_MAX, 50, 64};
+    const float starts[] = {0.1f, -0.3f, 0};
+    const float steps[] = {0.02f / M_MAX, 0.6f / 50, 1.0f / 64};
+    czt_f32_t czt;
+    for (int t = 0; t < 3; t++) {
+        TEST_ESP_OK(dsps_czt_init_f32(&czt, buff, Ns[t], Ms[t], starts[t], steps[t]));
+        TEST_ESP_OK(dsps_czt_f32(&czt, x, out));
+        float err = czt_error(x, 0, Ns[t], Ms[t], starts[t], steps[t], out);
+        TEST_ESP_OK(dsps_czt_fc32(&czt, x, out));
+        float err_c = czt_error(x, 1, Ns[t], Ms[t], starts[t], steps[t], out);
+        ESP_LOGI(TAG, "N %i, M %i, FFT %i: relative error real %e, complex %e", Ns[t], Ms[t], czt.fft_len, err, err_c);
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * err));
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * err_c));
+    }
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_zoom_fft_f32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, ZOOM_LEN));
+    // Two tones 3 bins apart at the resolution of SIG_LEN samples around 0.2
+    const float fc = 0.2f;
+    const float f1 = fc + 10.0f / SIG_LEN;
+    const float f2 = fc + 13.0f / SIG_LEN;
+    const float f3 = fc - 20.3f / SIG_LEN;
+    zoom_fft_f32_t zoom;
+    TEST_ESP_OK(dsps_zoom_fft_init_f32(&zoom, zoom_buff, fc, DECIM, FIR_LEN, ZOOM_LEN));
+    dsps_peak_t peaks[4];
+    for (int b = 0; b < 3; b++) {
+        for (int i = 0; i < SIG_LEN; i++) {
+            int n = b * SIG_LEN + i;
+            // Strong tone out of the band must be rejected by the filter
+            x[i] = cosf(2 * M_PI * f1 * n) + 0.5f * cosf(2 * M_PI * f2 * n) + 0.25f * cosf(2 * M_PI * f3 * n + 1)
+                   + 10 * cosf(2 * M_PI * 0.3f * n);
+        }
+        TEST_ESP_OK(dsps_zoom_fft_f32(&zoom, x, out));
+    }
+    int n = dsps_peak_find_fc32(out, ZOOM_LEN, ZOOM_LEN, peaks, 4, 0.1f, DSPS_PEAK_WIN_HANN);
+    const float freqs[] = {f1, f2, f3};
+    const float amps[] = {1, 0.5f, 0.25f};
+    TEST_ASSERT_EQUAL(3, n);
+    for (int i = 0; i < n; i++) {
+        float f = fc + (peaks[i].bin - ZOOM_LEN / 2) / SIG_LEN;
+        ESP_LOGI(TAG, "zoom peak %i: frequency %f (%f), amplitude %f", i, f, freqs[i], peaks[i].mag);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f / SIG_LEN, freqs[i], f);
+        TEST_ASSERT_FLOAT_WITHIN(0.03f * amps[i] + 0.01f, amps[i], peaks[i].mag);
+    }
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_czt_f32 benchmark", "[dsps]")
+{
+    const int N = 256;
+    const int M = 64;
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, FFT_MAX));
+    for (int i = 0; i < N; i++) {
+        x[i] = sinf(2 * M_PI * 0.1f * i);
+    }
+    czt_f32_t czt;
+    TEST_ESP_OK(dsps_czt_init_f32(&czt, buff, N, M, 0.09f, 0.02f / M));
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_czt_f32(&czt, x, out);
+    unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+    // Direct evaluation of the same bins with precalculated twiddles costs N*M complex multiplications
+    ESP_LOGI(TAG, "N %i, M %i: chirp-Z %i cycles, direct DFT %i complex multiplications", N, M, cycles, N * M);
+    TEST_ASSERT_EXEC_IN_RANGE(czt.fft_len, 100 * czt.fft_len * 9, cycles);
+    dsps_fft2r_deinit_fc32();
+
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, SIG_LEN));
+    zoom_fft_f32_t zoom;
+    TEST_ESP_OK(dsps_zoom_fft_init_f32(&zoom, zoom_buff, 0.1f, DECIM, FIR_LEN, ZOOM_LEN));
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_zoom_fft_f32(&zoom, x, out);
+    unsigned int cycles_zoom = dsp_get_cpu_cycle_count() - start_b;
+    for (int i = 0; i < SIG_LEN; i++) {
+        out[i * 2 + 0] = x[i];
+        out[i * 2 + 1] = 0;
+    }
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_fft2r_fc32(out, SIG_LEN);
+    dsps_bit_rev_fc32(out, SIG_LEN);
+    unsigned int cycles_fft = dsp_get_cpu_cycle_count() - start_b;
+    ESP_LOGI(TAG, "zoom FFT %i x %i: %i cycles, FFT %i: %i cycles", DECIM, ZOOM_LEN, cycles_zoom, SIG_LEN, cycles_fft);
+    dsps_fft2r_deinit_fc32();
+}
@@ -0,0 +1,191 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fft2r_plan.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fft2r_plan_fc32";
+
+#define N_MAX       1024
+#define N_TASKS     4
+#define N_RUNS      20
+// Sum of the task sizes: {N_MAX, N_MAX/4, N_MAX/16, N_MAX/64}
+#define N_DATA      (N_MAX + N_MAX / 4 + N_MAX / 16 + N_MAX / 64)
+
+static float buff_large[N_MAX * 2];
+static float buff_small[N_TASKS][N_MAX / 2];
+static float input[2 * N_MAX];
+// Complex buffers of all tasks one after another
+static float data[2 * N_DATA];
+static float result[2 * N_DATA];
+
+// Buffer of the task t in data or result
+static float *task_buff(float *buff, int t)
+{
+    int pos = 0;
+    for (int i = 0; i < t; i++) {
+        pos += 2 * (N_MAX >> (2 * i));
+    }
+    return &buff[pos];
+}
+
+// Direct DFT accumulated in double. Error relative to RMS of the spectrum
+static float plan_error(const float *x, const float *y, int N)
+{
+    double err = 0;
+    double energy = 0;
+    for (int k = 0; k < N; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0; n < N; n++) {
+            double a = -2 * M_PI * (double)((n * k) % N) / N;
+            re += x[n * 2 + 0] * cos(a) - x[n * 2 + 1] * sin(a);
+            im += x[n * 2 + 0] * sin(a) + x[n * 2 + 1] * cos(a);
+        }
+        err += (y[k * 2 + 0] - re) * (y[k * 2 + 0] - re) + (y[k * 2 + 1] - im) * (y[k * 2 + 1] - im);
+        energy += re * re + im * im;
+    }
+    return sqrt(err / energy);
+}
+
+TEST_CASE("dsps_fft2r_plan_fc32 functionality", "[dsps]")
+{
+    // Plans do not use the global tables
+    dsps_fft2r_deinit_fc32();
+    srand(68);
+    for (int i = 0; i < 2 * N_MAX; i++) {
+        input[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    fft2r_plan_fc32_t large;
+    fft2r_plan_cost_t cost;
+    TEST_ESP_OK(dsps_fft2r_plan_cost_fc32(1024, 0, &cost));
+    TEST_ESP_OK(dsps_fft2r_plan_init_fc32(&large, buff_large, 1024, NULL));
+    TEST_ASSERT_EQUAL(1024 + 496, cost.buff_len);
+    TEST_ASSERT_EQUAL(496, large.rev_size);
+    TEST_ASSERT_EQUAL(5120, cost.butterflies);
+
+    const int sizes[] = {1024, 512, 64, 8, 2};
+    for (int t = 0; t < sizeof(sizes) / sizeof(int); t++) {
+        int N = sizes[t];
+        fft2r_plan_fc32_t plan;
+        TEST_ESP_OK(dsps_fft2r_plan_cost_fc32(N, 1, &cost));
+        TEST_ESP_OK(dsps_fft2r_plan_init_fc32(&plan, buff_small[0], N, &large));
+        TEST_ASSERT_TRUE(plan.w == large.w);
+        TEST_ASSERT_EQUAL(0, cost.trig);
+        memcpy(data, input, 2 * N * sizeof(float));
+        TEST_ESP_OK(dsps_fft2r_plan_fc32(&plan, data));
+        float err = plan_error(input, data, N);
+        ESP_LOGI(TAG, "N %4i from table of %i: relative RMS error %e, tables %i bytes", N, large.N, err, cost.mem_bytes);
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6f * err));
+    }
+    // Table of the plan is equal to the global table
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, 1024));
+    TEST_ASSERT_EQUAL(0, memcmp(large.w, dsps_fft_w_table_fc32, 1024 * sizeof(float)));
+    dsps_fft2r_deinit_fc32();
+
+    fft2r_plan_fc32_t plan;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft2r_plan_init_fc32(&plan, buff_small[0], 100, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_fft2r_plan_init_fc32(&plan, buff_small[0], 2048, &large));
+}
+
+typedef struct plan_task_s {
+    const fft2r_plan_fc32_t *plan;
+    int     index;
+    int     errors;
+} plan_task_t;
+
+static void *plan_task(void *arg)
+{
+    plan_task_t *task = (plan_task_t *)arg;
+    int N = task->plan->N;
+    float *task_data = task_buff(data, task->index);
+    float *task_result = task_buff(result, task->index);
+    for (int r = 0; r < N_RUNS; r++) {
+        memcpy(task_data, input, 2 * N * sizeof(float));
+        dsps_fft2r_plan_fc32(task->plan, task_data);
+        task->errors += memcmp(task_data, task_result, 2 * N * sizeof(float)) != 0;
+    }
+    return NULL;
+}
+
+TEST_CASE("dsps_fft2r_plan_fc32 concurrent plans", "[dsps]")
+{
+    srand(168);
+    for (int i = 0; i < 2 * N_MAX; i++) {
+        input[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    // One own table of N_MAX and three plans derived from it, and the plan of N_MAX itself
+    const int sizes[N_TASKS] = {N_MAX, N_MAX / 4, N_MAX / 16, N_MAX / 64};
+    fft2r_plan_fc32_t plans[N_TASKS];
+    TEST_ESP_OK(dsps_fft2r_plan_init_fc32(&plans[0], buff_large, sizes[0], NULL));
+    for (int t = 1; t < N_TASKS; t++) {
+        TEST_ESP_OK(dsps_fft2r_plan_init_fc32(&plans[t], buff_small[t], sizes[t], &plans[0]));
+    }
+    // Results of the sequential calls
+    for (int t = 0; t < N_TASKS; t++) {
+        memcpy(task_buff(result, t), input, 2 * sizes[t] * sizeof(float));
+        TEST_ESP_OK(dsps_fft2r_plan_fc32(&plans[t], task_buff(result, t)));
+    }
+    plan_task_t tasks[N_TASKS];
+    pthread_t threads[N_TASKS];
+    for (int t = 0; t < N_TASKS; t++) {
+        tasks[t].plan = &plans[t];
+        tasks[t].index = t;
+        tasks[t].errors = 0;
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[t], NULL, plan_task, &tasks[t]));
+    }
+    for (int t = 0; t < N_TASKS; t++) {
+        TEST_ASSERT_EQUAL(0, pthread_join(threads[t], NULL));
+        ESP_LOGI(TAG, "N %4i: %i runs, %i different results", sizes[t], N_RUNS, tasks[t].errors);
+        TEST_ASSERT_EQUAL(0, tasks[t].errors);
+    }
+}
+
+TEST_CASE("dsps_fft2r_plan_fc32 benchmark", "[dsps]")
+{
+    const int sizes[] = {64, 256, 1024};
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N_MAX));
+    for (int t = 0; t < sizeof(sizes) / sizeof(int); t++) {
+        int N = sizes[t];
+        fft2r_plan_fc32_t plan;
+        fft2r_plan_cost_t cost;
+        TEST_ESP_OK(dsps_fft2r_plan_cost_fc32(N, 0, &cost));
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_fft2r_plan_init_fc32(&plan, buff_large, N, NULL);
+        unsigned int cycles_init = dsp_get_cpu_cycle_count() - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft2r_plan_fc32(&plan, data);
+        unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft2r_fc32(result, N);
+        dsps_bit_rev_fc32(result, N);
+        unsigned int cycles_global = dsp_get_cpu_cycle_count() - start_b;
+        ESP_LOGI(TAG, "N %4i: init %7i cycles (%i sin/cos, %i bytes), fft %7i cycles, global tables %7i cycles",
+                 N, cycles_init, cost.trig, cost.mem_bytes, cycles, cycles_global);
+        TEST_ASSERT_EXEC_IN_RANGE(cost.butterflies, 200 * cost.butterflies, cycles);
+    }
+    dsps_fft2r_deinit_fc32();
+}
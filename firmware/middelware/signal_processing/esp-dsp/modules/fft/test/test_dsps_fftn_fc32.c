@@ -0,0 +1,114 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fftn.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fftn_fc32";
+
+#define N_MAX       2000
+#define FFT2_MAX    4096
+
+static float data[2 * FFT2_MAX];
+static float input[2 * N_MAX];
+static float table[2 * N_MAX];
+static float buff[6 * N_MAX + 4 * FFT2_MAX];
+
+// Direct DFT with the twiddle index n*k mod N, accumulated in double. Error relative to RMS of the spectrum
+static float fftn_error(const float *x, const float *result, int N)
+{
+    for (int i = 0; i < N; i++) {
+        table[i * 2 + 0] = cos(2 * M_PI * i / N);
+        table[i * 2 + 1] = -sin(2 * M_PI * i / N);
+    }
+    double err = 0;
+    double energy = 0;
+    for (int k = 0; k < N; k++) {
+        double re = 0;
+        double im = 0;
+        int idx = 0;
+        for (int n = 0; n < N; n++) {
+            re += x[n * 2 + 0] * table[idx * 2 + 0] - x[n * 2 + 1] * table[idx * 2 + 1];
+            im += x[n * 2 + 0] * table[idx * 2 + 1] + x[n * 2 + 1] * table[idx * 2 + 0];
+            idx += k;
+            idx -= (idx >= N) ? N : 0;
+        }
+        err += (result[k * 2 + 0] - re) * (result[k * 2 + 0] - re) + (result[k * 2 + 1] - im) * (result[k * 2 + 1] - im);
+        energy += re * re + im * im;
+    }
+    return sqrt(err / energy);
+}
+
+TEST_CASE("dsps_fftn_fc32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, FFT2_MAX));
+    // Mixed radix: 100, 360, 1000, 1024, 1500, 2000. Bluestein: 97, 231 (3*7*11), 1001
+    const int sizes[] = {1, 2, 3, 5, 100, 360, 1000, 1024, 1500, 2000, 97, 231, 1001};
+    srand(67);
+    for (int t = 0; t < sizeof(sizes) / sizeof(int); t++) {
+        int N = sizes[t];
+        TEST_ASSERT_TRUE(dsps_fftn_buff_len_fc32(N) <= sizeof(buff) / sizeof(float));
+        for (int i = 0; i < 2 * N; i++) {
+            input[i] = (float)rand() / RAND_MAX - 0.5f;
+        }
+        fftn_f32_t plan;
+        TEST_ESP_OK(dsps_fftn_init_fc32(&plan, buff, N));
+        memcpy(data, input, 2 * N * sizeof(float));
+        TEST_ESP_OK(dsps_fftn_fc32(&plan, data));
+        float err = fftn_error(input, data, N);
+        ESP_LOGI(TAG, "N %4i, %s: relative RMS error %e", N, plan.n_factors ? "mixed radix" : "Bluestein", err);
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6f * err));
+    }
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_fftn_fc32 benchmark", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, FFT2_MAX));
+    const int sizes[] = {100, 231, 500, 1000, 1024, 1500, 2000};
+    for (int t = 0; t < sizeof(sizes) / sizeof(int); t++) {
+        int N = sizes[t];
+        for (int i = 0; i < 2 * N; i++) {
+            data[i] = (float)rand() / RAND_MAX - 0.5f;
+        }
+        fftn_f32_t plan;
+        TEST_ESP_OK(dsps_fftn_init_fc32(&plan, buff, N));
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_fftn_fc32(&plan, data);
+        unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+        // Padding to power of 2
+        int L = 1;
+        while (L < N) {
+            L <<= 1;
+        }
+        memset(&data[2 * N], 0, 2 * (L - N) * sizeof(float));
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft2r_fc32(data, L);
+        dsps_bit_rev_fc32(data, L);
+        unsigned int cycles_pad = dsp_get_cpu_cycle_count() - start_b;
+        ESP_LOGI(TAG, "N %4i (%s): %7i cycles, padded fft2r %4i: %7i cycles", N, plan.n_factors ? "mixed radix" : "Bluestein ",
+                 cycles, L, cycles_pad);
+        TEST_ASSERT_EXEC_IN_RANGE(N, 500 * N * 11, cycles);
+    }
+    dsps_fft2r_deinit_fc32();
+}
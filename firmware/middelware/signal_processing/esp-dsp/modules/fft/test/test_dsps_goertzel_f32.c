@@ -0,0 +1,213 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_goertzel.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_goertzel_f32";
+
+#define SIG_LEN     8192
+#define MAX_TONES   16
+#define FFT_LEN     2048
+
+static float x[SIG_LEN];
+static float buff[FFT_LEN + 8 * MAX_TONES];
+static float mag[SIG_LEN / 100 * MAX_TONES];
+static float phase[SIG_LEN / 100 * MAX_TONES];
+static float fft_data[2 * FFT_LEN];
+
+// Direct DFT sum(x[n]*exp(-j*w*n)) in double precision
+static void dft_ref(const float *data, int len, float freq, double *re, double *im)
+{
+    *re = 0;
+    *im = 0;
+    for (int n = 0; n < len; n++) {
+        double w = 2 * M_PI * freq * n;
+        *re += data[n] * cos(w);
+        *im -= data[n] * sin(w);
+    }
+}
+
+static float phase_diff(float a, float b)
+{
+    float d = a - b;
+    return fabsf(d - 2 * (float)M_PI * roundf(d / (2 * (float)M_PI)));
+}
+
+TEST_CASE("dsps_goertzel_f32 functionality", "[dsps]")
+{
+    // DTMF: fs = 8000 Hz, 205 samples per block. Key '5' (770 + 1336 Hz) and the other frequencies
+    const float fs = 8000;
+    const float tones_hz[] = {697, 770, 852, 941, 1209, 1336, 1477, 1633};
+    const int n_tones = sizeof(tones_hz) / sizeof(float);
+    const int N = 205;
+    float freqs[n_tones];
+    for (int t = 0; t < n_tones; t++) {
+        freqs[t] = tones_hz[t] / fs;
+    }
+    srand(64);
+    for (int i = 0; i < SIG_LEN; i++) {
+        x[i] = 0.7f * sinf(2 * M_PI * 770 / fs * i + 0.3f) + 0.5f * cosf(2 * M_PI * 1336 / fs * i)
+               + 0.05f * ((float)rand() / RAND_MAX - 0.5f);
+    }
+    goertzel_f32_t g;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_goertzel_init_f32(&g, buff, (const float[]) {
+        0.6f
+    }, 1, N));
+    TEST_ESP_OK(dsps_goertzel_init_f32(&g, buff, freqs, n_tones, N));
+    // Chunks of random length
+    int blocks = 0;
+    int pos = 0;
+    const int max_blocks = SIG_LEN / 100;
+    while (pos < SIG_LEN) {
+        int chunk = 1 + rand() % 300;
+        chunk = (chunk > SIG_LEN - pos) ? SIG_LEN - pos : chunk;
+        blocks += dsps_goertzel_f32(&g, &x[pos], chunk, &mag[blocks * n_tones], &phase[blocks * n_tones], max_blocks - blocks);
+        pos += chunk;
+    }
+    TEST_ASSERT_EQUAL(SIG_LEN / N, blocks);
+    float max_err = 0;
+    float max_phase_err = 0;
+    for (int b = 0; b < blocks; b++) {
+        for (int t = 0; t < n_tones; t++) {
+            double re, im;
+            dft_ref(&x[b * N], N, freqs[t], &re, &im);
+            float m = 2 * sqrt(re * re + im * im) / N;
+            max_err = fmaxf(max_err, fabsf(mag[b * n_tones + t] - m));
+            if (m > 0.1f) {
+                max_phase_err = fmaxf(max_phase_err, phase_diff(phase[b * n_tones + t], atan2(im, re)));
+            }
+        }
+    }
+    ESP_LOGI(TAG, "DTMF block 0: 770 Hz %f, 1336 Hz %f, 697 Hz %f", mag[1], mag[5], mag[0]);
+    ESP_LOGI(TAG, "max error: amplitude %e, phase %e", max_err, max_phase_err);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * max_err));
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * max_phase_err));
+    TEST_ASSERT_TRUE(mag[1] > 0.6f);
+    TEST_ASSERT_TRUE(mag[5] > 0.4f);
+    TEST_ASSERT_TRUE(mag[0] < 0.2f);
+
+    // Integer bin: exact amplitude and phase of a cosine
+    const int L = 1024;
+    float f = 37.0f / L;
+    for (int i = 0; i < L; i++) {
+        x[i] = 0.25f + 1.5f * cosf(2 * M_PI * f * i + 1.0f);
+    }
+    float freqs2[2] = {0, f};
+    TEST_ESP_OK(dsps_goertzel_init_f32(&g, buff, freqs2, 2, L));
+    TEST_ASSERT_EQUAL(1, dsps_goertzel_f32(&g, x, L, mag, phase, 1));
+    ESP_LOGI(TAG, "DC %f, amplitude %f, phase %f", mag[0], mag[1], phase[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.25f, mag[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.5f, mag[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, phase[1]);
+}
+
+TEST_CASE("dsps_sdft_f32 functionality", "[dsps]")
+{
+    const int N = 256;
+    const float freqs[] = {0, 10.0f / N, 0.1234f, 0.37f, 0.5f};
+    const int n_tones = sizeof(freqs) / sizeof(float);
+    srand(65);
+    for (int i = 0; i < SIG_LEN; i++) {
+        x[i] = 1 + sinf(2 * M_PI * 0.1234f * i) + 0.5f * ((float)rand() / RAND_MAX - 0.5f);
+    }
+    sdft_f32_t sd;
+    TEST_ESP_OK(dsps_sdft_init_f32(&sd, buff, freqs, n_tones, N));
+    float max_err = 0;
+    float last_err = 0;
+    int pos = 0;
+    while (pos < SIG_LEN) {
+        int chunk = 1 + rand() % 100;
+        chunk = (chunk > SIG_LEN - pos) ? SIG_LEN - pos : chunk;
+        TEST_ESP_OK(dsps_sdft_f32(&sd, &x[pos], chunk));
+        pos += chunk;
+        if (pos < N) {
+            continue;
+        }
+        TEST_ESP_OK(dsps_sdft_get_f32(&sd, mag, phase));
+        last_err = 0;
+        for (int t = 0; t < n_tones; t++) {
+            double re, im;
+            dft_ref(&x[pos - N], N, freqs[t], &re, &im);
+            float scale = ((freqs[t] == 0) || (freqs[t] == 0.5f)) ? 1.0f / N : 2.0f / N;
+            float m = sqrt(re * re + im * im) * scale;
+            last_err = fmaxf(last_err, fabsf(mag[t] - m));
+            if (m > 0.1f) {
+                last_err = fmaxf(last_err, phase_diff(phase[t], atan2(im, re)));
+            }
+        }
+        max_err = fmaxf(max_err, last_err);
+    }
+    ESP_LOGI(TAG, "sliding DFT: DC %f, 0.1234 %f, max error %e, error at the end %e", mag[0], mag[2], max_err, last_err);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 1, mag[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 1, mag[2]);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * max_err));
+}
+
+TEST_CASE("dsps_goertzel_f32 benchmark", "[dsps]")
+{
+    const int N = FFT_LEN;
+    for (int i = 0; i < N; i++) {
+        x[i] = sinf(2 * M_PI * 0.1f * i);
+    }
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N));
+    // FFT magnitude of the real signal, as FFTMagnitude
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    for (int i = 0; i < N; i++) {
+        fft_data[i * 2 + 0] = x[i];
+        fft_data[i * 2 + 1] = 0;
+    }
+    dsps_fft2r_fc32(fft_data, N);
+    dsps_bit_rev_fc32(fft_data, N);
+    dsps_cplx2reC_fc32(fft_data, N);
+    for (int i = 0; i < N / 2; i++) {
+        fft_data[i] = sqrtf(fft_data[i * 2 + 0] * fft_data[i * 2 + 0] + fft_data[i * 2 + 1] * fft_data[i * 2 + 1]);
+    }
+    unsigned int cycles_fft = dsp_get_cpu_cycle_count() - start_b;
+    dsps_fft2r_deinit_fc32();
+
+    float freqs[MAX_TONES];
+    for (int t = 0; t < MAX_TONES; t++) {
+        freqs[t] = 0.01f + 0.03f * t;
+    }
+    const int tones[] = {1, 2, 4, 8, 16};
+    unsigned int cycles_1 = 0;
+    for (int k = 0; k < sizeof(tones) / sizeof(int); k++) {
+        goertzel_f32_t g;
+        sdft_f32_t sd;
+        TEST_ESP_OK(dsps_goertzel_init_f32(&g, buff, freqs, tones[k], N));
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_goertzel_f32(&g, x, N, mag, phase, 1);
+        unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+        cycles_1 = (k == 0) ? cycles : cycles_1;
+
+        TEST_ESP_OK(dsps_sdft_init_f32(&sd, buff, freqs, tones[k], N));
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_sdft_f32(&sd, x, N);
+        unsigned int cycles_sdft = (dsp_get_cpu_cycle_count() - start_b) / N;
+        ESP_LOGI(TAG, "%2i tones: Goertzel %i cycles, sliding DFT %i cycles per sample, FFT %i cycles",
+                 tones[k], cycles, cycles_sdft, cycles_fft);
+    }
+    ESP_LOGI(TAG, "Single tone: Goertzel to FFT ratio %.2f", (float)cycles_1 / cycles_fft);
+    TEST_ASSERT_EXEC_IN_RANGE(N, 20 * N, cycles_1);
+}
@@ -0,0 +1,193 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_peak.h"
+#include "dsps_fft2r.h"
+#include "dsps_wind.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_peak_f32";
+
+#define N_FFT       256
+#define MAX_PEAKS   8
+
+static float wind[N_FFT];
+static float data[2 * N_FFT];
+static float mag[N_FFT / 2];
+
+// Spectrum of a sum of cosines with the window: complex in data, magnitude in mag
+static void spectrum(const float *bins, const float *amps, int n, int hann)
+{
+    if (hann) {
+        dsps_wind_hann_f32(wind, N_FFT);
+    }
+    for (int i = 0; i < N_FFT; i++) {
+        float v = 0;
+        for (int t = 0; t < n; t++) {
+            v += amps[t] * cosf(2 * M_PI * bins[t] * i / N_FFT + 0.3f * t + 0.5f);
+        }
+        data[i * 2 + 0] = hann ? v * wind[i] : v;
+        data[i * 2 + 1] = 0;
+    }
+    dsps_fft2r_fc32(data, N_FFT);
+    dsps_bit_rev_fc32(data, N_FFT);
+    for (int k = 0; k < N_FFT / 2; k++) {
+        mag[k] = sqrtf(data[k * 2 + 0] * data[k * 2 + 0] + data[k * 2 + 1] * data[k * 2 + 1]);
+    }
+}
+
+TEST_CASE("dsps_peak_find_f32 accuracy", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N_FFT));
+    const char *names[] = {"none", "quadratic", "gaussian", "jacobsen", "jacobsen rect"};
+    float max_err[5] = {0};
+    float max_mag_err = 0;
+    dsps_peak_t peaks[MAX_PEAKS];
+    // Sweep of the offset from the bin center
+    for (int s = 0; s <= 50; s++) {
+        float bin = 40 + s * 0.02f;
+        float amp = 1;
+        spectrum(&bin, &amp, 1, 1);
+        for (int m = 0; m < 3; m++) {
+            TEST_ASSERT_EQUAL(1, dsps_peak_find_f32(mag, N_FFT / 2, peaks, MAX_PEAKS, 1, (dsps_peak_interp_t)m));
+            max_err[m] = fmaxf(max_err[m], fabsf(peaks[0].bin - bin));
+            if (m == DSPS_PEAK_GAUSSIAN) {
+                // Hann window: peak |X| = amp*N/4
+                max_mag_err = fmaxf(max_mag_err, fabsf(peaks[0].mag / (N_FFT / 4) - amp));
+            }
+        }
+        TEST_ASSERT_EQUAL(1, dsps_peak_find_fc32(data, N_FFT / 2, N_FFT, peaks, MAX_PEAKS, 1, DSPS_PEAK_WIN_HANN));
+        max_err[3] = fmaxf(max_err[3], fabsf(peaks[0].bin - bin));
+        spectrum(&bin, &amp, 1, 0);
+        TEST_ASSERT_TRUE(dsps_peak_find_fc32(data, N_FFT / 2, N_FFT, peaks, 1, 1, DSPS_PEAK_WIN_RECT) == 1);
+        max_err[4] = fmaxf(max_err[4], fabsf(peaks[0].bin - bin));
+    }
+    for (int m = 0; m < 5; m++) {
+        ESP_LOGI(TAG, "%s: max error %f bins", names[m], max_err[m]);
+    }
+    ESP_LOGI(TAG, "gaussian: max relative error of magnitude %f", max_mag_err);
+    TEST_ASSERT_LESS_OR_EQUAL(500, (int)(1000 * max_err[0]));
+    TEST_ASSERT_LESS_OR_EQUAL(100, (int)(1000 * max_err[1]));
+    TEST_ASSERT_LESS_OR_EQUAL(20, (int)(1000 * max_err[2]));
+    // dsps_wind_hann_f32 is symmetric (period of N - 1), that adds a small bias to the Hann estimators
+    TEST_ASSERT_LESS_OR_EQUAL(5, (int)(1000 * max_err[3]));
+    TEST_ASSERT_LESS_OR_EQUAL(1, (int)(1000 * max_err[4]));
+    TEST_ASSERT_LESS_OR_EQUAL(40, (int)(1000 * max_mag_err));
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_peak_find_f32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N_FFT));
+    const float bins[] = {10.3f, 31.7f, 55.45f, 90.1f};
+    const float amps[] = {0.5f, 1.0f, 0.25f, 0.01f};
+    spectrum(bins, amps, 4, 1);
+    dsps_peak_t peaks[MAX_PEAKS];
+    // The smallest tone is below min_mag
+    int n = dsps_peak_find_f32(mag, N_FFT / 2, peaks, MAX_PEAKS, 0.05f * N_FFT / 4, DSPS_PEAK_GAUSSIAN);
+    TEST_ASSERT_EQUAL(3, n);
+    const int order[] = {1, 0, 2};
+    for (int i = 0; i < n; i++) {
+        ESP_LOGI(TAG, "peak %i: bin %f, magnitude %f", i, peaks[i].bin, peaks[i].mag / (N_FFT / 4));
+        TEST_ASSERT_FLOAT_WITHIN(0.02f, bins[order[i]], peaks[i].bin);
+        TEST_ASSERT_FLOAT_WITHIN(0.02f, amps[order[i]], peaks[i].mag / (N_FFT / 4));
+    }
+    // Only the largest peaks are kept
+    n = dsps_peak_find_f32(mag, N_FFT / 2, peaks, 2, 0, DSPS_PEAK_QUADRATIC);
+    TEST_ASSERT_EQUAL(2, n);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, bins[1], peaks[0].bin);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, bins[0], peaks[1].bin);
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_peak_harmonics_f32 functionality", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N_FFT));
+    // Harmonics 2..6 of f0 = 9.37 bins without the fundamental, and an unrelated tone
+    const float f0_ref = 9.37f;
+    float bins[6];
+    float amps[6];
+    for (int h = 2; h <= 6; h++) {
+        bins[h - 2] = h * f0_ref;
+        amps[h - 2] = 1.0f / h;
+    }
+    bins[5] = 77.7f;
+    amps[5] = 0.3f;
+    spectrum(bins, amps, 6, 1);
+    dsps_peak_t peaks[MAX_PEAKS];
+    int n = dsps_peak_find_fc32(data, N_FFT / 2, N_FFT, peaks, MAX_PEAKS, 0.05f * N_FFT / 4, DSPS_PEAK_WIN_HANN);
+    TEST_ASSERT_EQUAL(6, n);
+    float f0;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_peak_harmonics_f32(peaks, 0, 8, 0.02f, &f0));
+    TEST_ESP_OK(dsps_peak_harmonics_f32(peaks, n, 8, 0.02f, &f0));
+    ESP_LOGI(TAG, "f0 %f bins (%f)", f0, f0_ref);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, f0_ref, f0);
+    for (int i = 0; i < n; i++) {
+        int h = (fabsf(peaks[i].bin - 77.7f) < 0.5f) ? 0 : (int)roundf(peaks[i].bin / f0_ref);
+        TEST_ASSERT_EQUAL(h, peaks[i].harmonic);
+    }
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_peak_track_f32 functionality", "[dsps]")
+{
+    peak_track_f32_t tr;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_peak_track_init_f32(&tr, 2, 0.5f, 0.5f, 3));
+    TEST_ESP_OK(dsps_peak_track_init_f32(&tr, 2, 2, 0.5f, 3));
+    dsps_peak_t peaks[2];
+    float bin = -1;
+    TEST_ASSERT_EQUAL(0, dsps_peak_track_f32(&tr, peaks, 0, &bin));
+    TEST_ASSERT_EQUAL(-1, bin);
+    const int frames = 60;
+    for (int f = 0; f < frames; f++) {
+        // Slow sweep of the tracked tone
+        float tone = 20 + 0.1f * f;
+        int n = 0;
+        if ((f < 20) || (f >= 23)) {
+            peaks[n].bin = tone;
+            peaks[n].mag = 1;
+            n++;
+        }
+        // Interference: 1.5 times larger for a few frames, then 3 times larger
+        if ((f >= 10) && (f < 15)) {
+            peaks[n].bin = 50;
+            peaks[n].mag = 1.5f;
+            n++;
+        }
+        if (f >= 40) {
+            peaks[n].bin = 60;
+            peaks[n].mag = 3;
+            n++;
+        }
+        TEST_ASSERT_EQUAL(1, dsps_peak_track_f32(&tr, peaks, n, &bin));
+        if (f < 40) {
+            // Dropout of 3 frames is held, the interference is ignored
+            TEST_ASSERT_FLOAT_WITHIN(0.5f, tone, bin);
+        } else {
+            TEST_ASSERT_EQUAL(60, bin);
+        }
+    }
+    // The track is lost after hold frames
+    for (int f = 0; f < 4; f++) {
+        TEST_ASSERT_EQUAL(f < 3, dsps_peak_track_f32(&tr, peaks, 0, &bin));
+    }
+}
@@ -0,0 +1,202 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_spectrum.h"
+#include "dsps_fft2r.h"
+#include "dsps_wind.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_spectrum_sc16";
+
+#define N_FFT       1024
+
+static uint16_t adc[N_FFT];
+static float wind[N_FFT];
+static int16_t wind_q15[N_FFT];
+static float data_fc32[N_FFT * 2];
+__attribute__((aligned(16)))
+static int16_t data_sc16[N_FFT * 2];
+static uint16_t mag[N_FFT];
+static int16_t db[N_FFT];
+static float db_ref[N_FFT];
+
+TEST_CASE("dsps_mag_sc16 functionality", "[dsps]")
+{
+    const char *names[] = {"alpha max + beta min", "CORDIC", "integer sqrt"};
+    const int max_err[] = {400, 5, 5};
+    srand(69);
+    for (int i = 0; i < N_FFT; i++) {
+        // Magnitudes from 1000 to 32767 at all angles
+        float r = 1000 + (float)rand() / RAND_MAX * 31767;
+        float a = 2 * M_PI * i / N_FFT;
+        data_sc16[i * 2 + 0] = roundf(r * cosf(a));
+        data_sc16[i * 2 + 1] = roundf(r * sinf(a));
+    }
+    for (int method = DSPS_MAG_AMAX_BMIN; method <= DSPS_MAG_ISQRT; method++) {
+        TEST_ESP_OK(dsps_mag_sc16(data_sc16, mag, N_FFT, method));
+        float err = 0;
+        for (int i = 0; i < N_FFT; i++) {
+            float re = data_sc16[i * 2 + 0];
+            float im = data_sc16[i * 2 + 1];
+            float ref = sqrtf(re * re + im * im);
+            float e = fabsf(mag[i] - ref) / ref;
+            err = (e > err) ? e : err;
+        }
+        ESP_LOGI(TAG, "%s: maximum relative error %.5f%%", names[method], 100 * err);
+        // 0.01%
+        TEST_ASSERT_LESS_OR_EQUAL(max_err[method], (int)(1e4f * err));
+    }
+    // dB of all magnitudes with exponent
+    const int exps[] = {-4, 0, 10};
+    for (int e = 0; e < sizeof(exps) / sizeof(int); e++) {
+        int err = 0;
+        for (int m = 1; m < 65536; m += 7) {
+            uint16_t v = m;
+            int16_t out;
+            TEST_ESP_OK(dsps_mag_db_sc16(&v, &out, 1, exps[e]));
+            int ref = (int)roundf(2000 * log10f(m) + 2000 * log10f(2) * exps[e]);
+            err = (abs(out - ref) > err) ? abs(out - ref) : err;
+        }
+        ESP_LOGI(TAG, "dB, exponent %i: maximum error %i.%02i dB", exps[e], err / 100, err % 100);
+        TEST_ASSERT_LESS_OR_EQUAL(1, err);
+    }
+    uint16_t zero = 0;
+    TEST_ESP_OK(dsps_mag_db_sc16(&zero, db, 1, 0));
+    TEST_ASSERT_EQUAL(INT16_MIN, db[0]);
+}
+
+// 12 bit ADC: offset, tone of 1500 LSB between the bins, tone of 40 LSB and noise of 2 LSB
+static void spectrum_signal(void)
+{
+    srand(169);
+    for (int i = 0; i < N_FFT; i++) {
+        float v = 2048 + 1500 * sinf(2 * M_PI * 100.3f * i / N_FFT) + 40 * sinf(2 * M_PI * 300 * i / N_FFT);
+        v += 4 * ((float)rand() / RAND_MAX - 0.5f);
+        adc[i] = (uint16_t)roundf(v);
+    }
+    dsps_wind_hann_f32(wind, N_FFT);
+    for (int i = 0; i < N_FFT; i++) {
+        wind_q15[i] = (int16_t)roundf(wind[i] * INT16_MAX);
+    }
+}
+
+// Float path as FFTMagnitude, with the same mean removed, dB of |X|
+static void spectrum_fc32(float *out)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < N_FFT; i++) {
+        sum += adc[i];
+    }
+    float mean = (float)((sum + N_FFT / 2) / N_FFT);
+    for (int i = 0; i < N_FFT; i++) {
+        data_fc32[i * 2 + 0] = (adc[i] - mean) * wind[i];
+        data_fc32[i * 2 + 1] = 0;
+    }
+    dsps_fft2r_fc32(data_fc32, N_FFT);
+    dsps_bit_rev_fc32(data_fc32, N_FFT);
+    for (int i = 0; i < N_FFT / 2; i++) {
+        out[i] = 20 * log10f(1e-9f + sqrtf(data_fc32[i * 2 + 0] * data_fc32[i * 2 + 0] + data_fc32[i * 2 + 1] * data_fc32[i * 2 + 1]));
+    }
+}
+
+static void spectrum_sc16(dsps_mag_method_t method)
+{
+    int exp;
+    dsps_spectrum_prep_sc16(adc, wind_q15, data_sc16, N_FFT, &exp);
+    dsps_fft2r_sc16(data_sc16, N_FFT);
+    dsps_bit_rev_sc16(data_sc16, N_FFT);
+    dsps_mag_sc16(data_sc16, mag, N_FFT / 2, method);
+    dsps_mag_db_sc16(mag, db, N_FFT / 2, exp);
+}
+
+TEST_CASE("dsps_spectrum_sc16 accuracy", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    TEST_ESP_OK(dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    spectrum_signal();
+    spectrum_fc32(db_ref);
+    float peak = -1000;
+    for (int i = 1; i < N_FFT / 2; i++) {
+        peak = (db_ref[i] > peak) ? db_ref[i] : peak;
+    }
+    const char *names[] = {"alpha max + beta min", "CORDIC", "integer sqrt"};
+    // 0.01 dB for the peak, 0.01 dB for the bins down to -40 dB and to -60 dB
+    const int max_err[3][3] = {{10, 40, 200}, {2, 10, 200}, {2, 10, 200}};
+    for (int method = DSPS_MAG_AMAX_BMIN; method <= DSPS_MAG_ISQRT; method++) {
+        spectrum_sc16(method);
+        float err_peak = 0;
+        float err_40 = 0;
+        float err_60 = 0;
+        for (int i = 1; i < N_FFT / 2; i++) {
+            float e = fabsf(db[i] / 100.0f - db_ref[i]);
+            if (db_ref[i] >= peak - 0.01f) {
+                err_peak = e;
+            }
+            if (db_ref[i] > peak - 40) {
+                err_40 = (e > err_40) ? e : err_40;
+            } else if (db_ref[i] > peak - 60) {
+                err_60 = (e > err_60) ? e : err_60;
+            }
+        }
+        ESP_LOGI(TAG, "%s: error of the peak %.3f dB, down to -40 dB %.3f dB, -40..-60 dB %.3f dB", names[method], err_peak, err_40, err_60);
+        TEST_ASSERT_LESS_OR_EQUAL(max_err[method][0], (int)(100 * err_peak));
+        TEST_ASSERT_LESS_OR_EQUAL(max_err[method][1], (int)(100 * err_40));
+        TEST_ASSERT_LESS_OR_EQUAL(max_err[method][2], (int)(100 * err_60));
+    }
+    dsps_fft2r_deinit_sc16();
+    dsps_fft2r_deinit_fc32();
+}
+
+TEST_CASE("dsps_spectrum_sc16 benchmark", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    TEST_ESP_OK(dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    spectrum_signal();
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    spectrum_fc32(db_ref);
+    unsigned int cycles_fc32 = dsp_get_cpu_cycle_count() - start_b;
+
+    start_b = dsp_get_cpu_cycle_count();
+    spectrum_sc16(DSPS_MAG_CORDIC);
+    unsigned int cycles_sc16 = dsp_get_cpu_cycle_count() - start_b;
+
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_mag_sc16(data_sc16, mag, N_FFT / 2, DSPS_MAG_AMAX_BMIN);
+    unsigned int cycles_amax = dsp_get_cpu_cycle_count() - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_mag_sc16(data_sc16, mag, N_FFT / 2, DSPS_MAG_CORDIC);
+    unsigned int cycles_cordic = dsp_get_cpu_cycle_count() - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_mag_sc16(data_sc16, mag, N_FFT / 2, DSPS_MAG_ISQRT);
+    unsigned int cycles_isqrt = dsp_get_cpu_cycle_count() - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_mag_db_sc16(mag, db, N_FFT / 2, 0);
+    unsigned int cycles_db = dsp_get_cpu_cycle_count() - start_b;
+
+    ESP_LOGI(TAG, "Spectrum of %i samples: float %i cycles, sc16 %i cycles, speedup %.2f", N_FFT, cycles_fc32, cycles_sc16,
+             (float)cycles_fc32 / cycles_sc16);
+    ESP_LOGI(TAG, "Magnitude of %i bins: alpha max + beta min %i, CORDIC %i, integer sqrt %i cycles, dB %i cycles",
+             N_FFT / 2, cycles_amax, cycles_cordic, cycles_isqrt, cycles_db);
+    TEST_ASSERT_EXEC_IN_RANGE(N_FFT, 200 * N_FFT * 10, cycles_sc16);
+    dsps_fft2r_deinit_sc16();
+    dsps_fft2r_deinit_fc32();
+}
@@ -0,0 +1,92 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_cic.h"
+#include <string.h>
+
+#define CIC_MAX_ORDER 8
+
+int dsps_cic_growth_bits(int order, int rate, int diff_delay)
+{
+    // ceil(order*log2(rate*diff_delay)) = smallest bits with 2^bits >= (rate*diff_delay)^order
+    uint64_t gain = 1;
+    int bits = 0;
+    for (int i = 0; i < order; i++) {
+        gain *= rate * diff_delay;
+        while ((1ULL << bits) < gain) {
+            bits++;
+        }
+        if (bits > 32) {
+            return bits;
+        }
+    }
+    return bits;
+}
+
+esp_err_t dsps_cic_dec_init_s32(cic_s32_t *cic, uint32_t *state, int order, int rate, int diff_delay, int in_bits, int out_bits)
+{
+    if ((cic == NULL) || (state == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((order <= 0) || (order > CIC_MAX_ORDER) || (rate <= 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((diff_delay < 1) || (diff_delay > 2) || (in_bits < 1) || (out_bits < 1) || (out_bits > 32)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    int bits = in_bits + dsps_cic_growth_bits(order, rate, diff_delay);
+    if (bits > 32) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    memset(state, 0, order * (1 + diff_delay) * sizeof(uint32_t));
+    cic->integ = state;
+    cic->comb = state + order;
+    cic->order = order;
+    cic->rate = rate;
+    cic->diff_delay = diff_delay;
+    cic->phase = 0;
+    cic->comb_pos = 0;
+    cic->shift = (bits > out_bits) ? bits - out_bits : 0;
+    return ESP_OK;
+}
+
+int dsps_cic_dec_s32(cic_s32_t *cic, const int32_t *input, int32_t *output, int len)
+{
+    // Modular (unsigned) arithmetic: overflow of the integrators is canceled by the combs
+    uint32_t *integ = cic->integ;
+    int order = cic->order;
+    int n = 0;
+    for (int i = 0; i < len; i++) {
+        uint32_t acc = (uint32_t)input[i];
+        for (int s = 0; s < order; s++) {
+            integ[s] += acc;
+            acc = integ[s];
+        }
+        if (++cic->phase < cic->rate) {
+            continue;
+        }
+        cic->phase = 0;
+        uint32_t *comb = &cic->comb[cic->comb_pos];
+        for (int s = 0; s < order; s++) {
+            uint32_t old = comb[s * cic->diff_delay];
+            comb[s * cic->diff_delay] = acc;
+            acc -= old;
+        }
+        if (++cic->comb_pos >= cic->diff_delay) {
+            cic->comb_pos = 0;
+        }
+        output[n++] = (int32_t)acc >> cic->shift;
+    }
+    return n;
+}
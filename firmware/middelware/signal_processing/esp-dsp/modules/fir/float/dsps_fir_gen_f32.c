@@ -0,0 +1,110 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fir_gen.h"
+#include "dsps_wind_kaiser.h"
+#include <math.h>
+
+int dsps_fir_kaiser_len_f32(float atten_db, float width, float *beta)
+{
+    float b = 0;
+    if (atten_db > 50) {
+        b = 0.1102f * (atten_db - 8.7f);
+    } else if (atten_db >= 21) {
+        b = 0.5842f * powf(atten_db - 21, 0.4f) + 0.07886f * (atten_db - 21);
+    }
+    if (beta != NULL) {
+        *beta = b;
+    }
+    int len = (int)ceilf((atten_db - 7.95f) / (14.36f * width)) + 1;
+    if (len < 3) {
+        len = 3;
+    }
+    return len | 1;
+}
+
+esp_err_t dsps_fir_gen_lpf_f32(float *coeffs, int len, float f, float beta, float gain)
+{
+    if (len <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((f <= 0) || (f > 0.5)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    dsps_wind_kaiser_f32(coeffs, len, beta);
+    float center = (len - 1) / 2.0f;
+    float sum = 0;
+    for (int i = 0; i < len; i++) {
+        float t = i - center;
+        float sinc = 2 * f;
+        if (fabsf(t) > 1e-6f) {
+            sinc = sinf(2 * M_PI * f * t) / (M_PI * t);
+        }
+        coeffs[i] *= sinc;
+        sum += coeffs[i];
+    }
+    // Normalize the DC gain
+    float norm = gain / sum;
+    for (int i = 0; i < len; i++) {
+        coeffs[i] *= norm;
+    }
+    return ESP_OK;
+}
+
+// Magnitude response of CIC decimator at frequency f, normalized to the output sample frequency
+static float dsps_cic_response_f32(float f, int order, int rate, int diff_delay)
+{
+    float x = M_PI * f / rate;
+    if (fabsf(x) < 1e-9f) {
+        return 1;
+    }
+    float h = sinf(x * rate * diff_delay) / (rate * diff_delay * sinf(x));
+    return powf(fabsf(h), order);
+}
+
+esp_err_t dsps_fir_gen_cic_comp_f32(float *coeffs, int len, float f, float beta, int order, int rate, int diff_delay)
+{
+    if (len <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((f <= 0) || (f > 0.5) || (order <= 0) || (rate <= 0) || (diff_delay <= 0)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    // Response of the CIC filter must not reach zero in passband
+    if (f * diff_delay >= 1) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    const int steps = 256;
+    float df = f / steps;
+    float center = (len - 1) / 2.0f;
+    dsps_wind_kaiser_f32(coeffs, len, beta);
+    float sum = 0;
+    for (int i = 0; i < len; i++) {
+        // h[t] = 2*integral(0..f, cos(2*pi*v*t)/H_cic(v) dv), Simpson rule
+        float t = i - center;
+        float acc = 0;
+        for (int k = 0; k <= steps; k++) {
+            float v = k * df;
+            float w = (k == 0 || k == steps) ? 1 : ((k & 1) ? 4 : 2);
+            acc += w * cosf(2 * M_PI * v * t) / dsps_cic_response_f32(v, order, rate, diff_delay);
+        }
+        coeffs[i] *= 2 * acc * df / 3;
+        sum += coeffs[i];
+    }
+    // Normalize the DC gain
+    for (int i = 0; i < len; i++) {
+        coeffs[i] /= sum;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,125 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_lms.h"
+#include <string.h>
+#include <math.h>
+
+static void dsps_lms_hum_set_freq(lms_hum_f32_t *lms, float f)
+{
+    lms->f = f;
+    lms->rot_re = cosf(2 * M_PI * f);
+    lms->rot_im = sinf(2 * M_PI * f);
+}
+
+// Correct the reference frequency by the rotation of the fundamental weights.
+// For hum A*cos(2*pi*(f + df)*n + p) the weights are A*cos(psi), -A*sin(psi), psi = 2*pi*df*n + p,
+// so the phase of the weights decreases by 2*pi*df per sample.
+static void dsps_lms_hum_track(lms_hum_f32_t *lms)
+{
+    float phase = atan2f(lms->w[1], lms->w[0]);
+    float d = phase - lms->phase;
+    if (d > M_PI) {
+        d -= 2 * M_PI;
+    } else if (d < -M_PI) {
+        d += 2 * M_PI;
+    }
+    lms->phase = phase;
+    float f = lms->f - lms->mu_f * d / (2 * M_PI * DSPS_LMS_HUM_TRACK_LEN);
+    f = (f < lms->f_min) ? lms->f_min : f;
+    f = (f > lms->f_max) ? lms->f_max : f;
+    dsps_lms_hum_set_freq(lms, f);
+}
+
+esp_err_t dsps_lms_hum_init_f32(lms_hum_f32_t *lms, float f, int n_harm, float mu, float mu_f, int normalized)
+{
+    if (lms == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((n_harm <= 0) || (n_harm > DSPS_LMS_HUM_MAX_HARM)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((f <= 0) || (f * n_harm >= 0.5f) || (mu <= 0) || (mu_f < 0)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    memset(lms, 0, sizeof(lms_hum_f32_t));
+    lms->n_harm = n_harm;
+    lms->step = normalized ? mu / n_harm : mu;
+    lms->mu_f = mu_f;
+    // Mains frequency is stable within a few percent
+    lms->f_min = f * 0.9f;
+    lms->f_max = f * 1.1f;
+    if (lms->f_max * n_harm >= 0.5f) {
+        lms->f_max = 0.5f / n_harm;
+    }
+    lms->warmup = (int)(4 / lms->step);
+    lms->re = 1;
+    lms->im = 0;
+    dsps_lms_hum_set_freq(lms, f);
+    return ESP_OK;
+}
+
+esp_err_t dsps_lms_hum_f32(lms_hum_f32_t *lms, const float *input, float *output, int len)
+{
+    if ((lms == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    float ref[2 * DSPS_LMS_HUM_MAX_HARM];
+    float *w = lms->w;
+    int n = lms->n_harm;
+
+    for (int i = 0; i < len; i++) {
+        // Harmonics of the reference are powers of the fundamental phasor
+        float cr = lms->re;
+        float ci = lms->im;
+        float y = 0;
+        for (int h = 0; h < n; h++) {
+            ref[h * 2 + 0] = cr;
+            ref[h * 2 + 1] = ci;
+            y += w[h * 2 + 0] * cr + w[h * 2 + 1] * ci;
+            float t = cr * lms->re - ci * lms->im;
+            ci = cr * lms->im + ci * lms->re;
+            cr = t;
+        }
+        float e = input[i] - y;
+        output[i] = e;
+
+        float g = lms->step * e;
+        for (int h = 0; h < 2 * n; h++) {
+            w[h] += g * ref[h];
+        }
+
+        // Rotate the phasor and keep its magnitude at 1
+        float re = lms->re * lms->rot_re - lms->im * lms->rot_im;
+        float im = lms->re * lms->rot_im + lms->im * lms->rot_re;
+        float norm = 1.5f - 0.5f * (re * re + im * im);
+        lms->re = re * norm;
+        lms->im = im * norm;
+
+        if (lms->mu_f > 0) {
+            if (lms->warmup > 0) {
+                if (--lms->warmup == 0) {
+                    lms->phase = atan2f(w[1], w[0]);
+                }
+            } else if (++lms->count >= DSPS_LMS_HUM_TRACK_LEN) {
+                lms->count = 0;
+                dsps_lms_hum_track(lms);
+            }
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,225 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_resample.h"
+#include "dsps_fir_gen.h"
+#include "dsps_dotprod.h"
+#include <string.h>
+#include <malloc.h>
+
+static int dsps_resample_gcd(int a, int b)
+{
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Split x to factors not greater than DSPS_RESAMPLE_MAX_STAGE_FACTOR (a larger prime is kept as is).
+// Factors are returned in descending order, the amount of factors is returned.
+static int dsps_resample_factorize(int x, int *factors, int max_factors)
+{
+    int primes[32];
+    int n_primes = 0;
+    for (int p = 2; (p * p <= x) && (n_primes < 32); p++) {
+        while ((x % p == 0) && (n_primes < 32)) {
+            primes[n_primes++] = p;
+            x /= p;
+        }
+    }
+    if ((x > 1) && (n_primes < 32)) {
+        primes[n_primes++] = x;
+    }
+    // Group primes, starting from the largest one
+    int n = 0;
+    for (int i = n_primes - 1; i >= 0; i--) {
+        if ((n > 0) && (factors[n - 1] * primes[i] <= DSPS_RESAMPLE_MAX_STAGE_FACTOR)) {
+            factors[n - 1] *= primes[i];
+        } else if (n < max_factors) {
+            factors[n++] = primes[i];
+        } else {
+            factors[n - 1] *= primes[i];
+        }
+    }
+    // Sort descending
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (factors[j] > factors[i]) {
+                int t = factors[i];
+                factors[i] = factors[j];
+                factors[j] = t;
+            }
+        }
+    }
+    return n;
+}
+
+static esp_err_t dsps_resample_stage_init(resample_stage_f32_t *st, int up, int down, float rate_in, float f_pass, float f_stop, float atten_db)
+{
+    float rate_up = rate_in * up;
+    float beta = 0;
+    int len = dsps_fir_kaiser_len_f32(atten_db, (f_stop - f_pass) / rate_up, &beta);
+
+    st->up = up;
+    st->down = down;
+    st->taps = (len + up - 1) / up;
+    st->phase = 0;
+    st->pos = st->taps - 1;
+    st->coeffs = (float *)malloc(st->taps * up * sizeof(float));
+    st->delay = (float *)calloc(2 * st->taps, sizeof(float));
+    float *h = (float *)calloc(st->taps * up, sizeof(float));
+    if ((st->coeffs == NULL) || (st->delay == NULL) || (h == NULL)) {
+        free(h);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    dsps_fir_gen_lpf_f32(h, len, (f_pass + f_stop) / 2 / rate_up, beta, up);
+    // Polyphase decomposition: phase p uses h[p], h[p + up], h[p + 2*up] ...
+    for (int p = 0; p < up; p++) {
+        for (int k = 0; k < st->taps; k++) {
+            st->coeffs[p * st->taps + k] = h[p + k * up];
+        }
+    }
+    free(h);
+    return ESP_OK;
+}
+
+esp_err_t dsps_resample_init_f32(resample_f32_t *rs, int up, int down, float pass, float atten_db)
+{
+    memset(rs, 0, sizeof(resample_f32_t));
+    if ((up <= 0) || (down <= 0)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((pass <= 0) || (pass >= 1) || (atten_db <= 0)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int gcd = dsps_resample_gcd(up, down);
+    up /= gcd;
+    down /= gcd;
+    rs->up = up;
+    rs->down = down;
+
+    if (up == down) {
+        // Unity ratio: single pass through stage with one tap
+        resample_stage_f32_t *st = &rs->stage[0];
+        st->up = 1;
+        st->down = 1;
+        st->taps = 1;
+        st->coeffs = (float *)malloc(sizeof(float));
+        st->delay = (float *)calloc(2, sizeof(float));
+        rs->n_stages = 1;
+        if ((st->coeffs == NULL) || (st->delay == NULL)) {
+            dsps_resample_free_f32(rs);
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        st->coeffs[0] = 1;
+        return ESP_OK;
+    }
+
+    // Stages: interpolation stages go from the smallest factor, the last one takes the whole decimation.
+    // Decimation stages go from the largest factor, the first one takes the whole interpolation.
+    // So the intermediate sample rates are never lower than the input or output rate.
+    int ups[DSPS_RESAMPLE_MAX_STAGES] = {1};
+    int downs[DSPS_RESAMPLE_MAX_STAGES] = {1};
+    int factors[DSPS_RESAMPLE_MAX_STAGES];
+    if (up >= down) {
+        int n = dsps_resample_factorize(up, factors, DSPS_RESAMPLE_MAX_STAGES);
+        for (int i = 0; i < n; i++) {
+            ups[i] = factors[n - 1 - i];
+            downs[i] = 1;
+        }
+        downs[n - 1] = down;
+        rs->n_stages = n;
+    } else {
+        int n = dsps_resample_factorize(down, factors, DSPS_RESAMPLE_MAX_STAGES);
+        for (int i = 0; i < n; i++) {
+            ups[i] = 1;
+            downs[i] = factors[i];
+        }
+        ups[0] = up;
+        rs->n_stages = n;
+    }
+
+    float rate_min = (up < down) ? (float)up / down : 1;
+    float f_pass = pass * rate_min / 2;
+    float rate = 1;
+    for (int s = 0; s < rs->n_stages; s++) {
+        float rate_out = rate * ups[s] / downs[s];
+        float stage_min = (rate < rate_out) ? rate : rate_out;
+        // Only the stage at the lowest rate needs the sharp filter, the others must just protect the passband
+        float f_stop = stage_min - f_pass;
+        if (stage_min <= rate_min * 1.0001f) {
+            f_stop = rate_min / 2;
+        }
+        esp_err_t ret = dsps_resample_stage_init(&rs->stage[s], ups[s], downs[s], rate, f_pass, f_stop, atten_db);
+        if (ret != ESP_OK) {
+            dsps_resample_free_f32(rs);
+            return ret;
+        }
+        rate = rate_out;
+    }
+    return ESP_OK;
+}
+
+// Push one sample to the stage and pass all produced samples to the next stage
+static int dsps_resample_push(resample_f32_t *rs, int s, float x, float *output, int out_pos)
+{
+    resample_stage_f32_t *st = &rs->stage[s];
+    st->delay[st->pos] = x;
+    st->delay[st->pos + st->taps] = x;
+    while (st->phase < st->up) {
+        float acc;
+        dsps_dotprod_f32(&st->coeffs[st->phase * st->taps], &st->delay[st->pos], &acc, st->taps);
+        if (s == rs->n_stages - 1) {
+            output[out_pos++] = acc;
+        } else {
+            out_pos = dsps_resample_push(rs, s + 1, acc, output, out_pos);
+        }
+        st->phase += st->down;
+    }
+    st->phase -= st->up;
+    st->pos = (st->pos == 0) ? st->taps - 1 : st->pos - 1;
+    return out_pos;
+}
+
+int dsps_resample_f32(resample_f32_t *rs, const float *input, float *output, int len)
+{
+    int result = 0;
+    for (int i = 0; i < len; i++) {
+        result = dsps_resample_push(rs, 0, input[i], output, result);
+    }
+    return result;
+}
+
+int dsps_resample_taps_f32(resample_f32_t *rs)
+{
+    int taps = 0;
+    for (int s = 0; s < rs->n_stages; s++) {
+        taps += rs->stage[s].taps * rs->stage[s].up;
+    }
+    return taps;
+}
+
+esp_err_t dsps_resample_free_f32(resample_f32_t *rs)
+{
+    for (int s = 0; s < DSPS_RESAMPLE_MAX_STAGES; s++) {
+        free(rs->stage[s].coeffs);
+        free(rs->stage[s].delay);
+        rs->stage[s].coeffs = NULL;
+        rs->stage[s].delay = NULL;
+    }
+    rs->n_stages = 0;
+    return ESP_OK;
+}
@@ -0,0 +1,106 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_cic_H_
+#define _dsps_cic_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of s32 CIC decimator
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_cic_dec_init_s32(...) function.
+ */
+typedef struct cic_s32_s {
+    uint32_t *integ;        /*!< Integrator registers. Length of order.*/
+    uint32_t *comb;         /*!< Delay lines of the comb stages. order lines of diff_delay samples.*/
+    int       order;        /*!< Amount of integrator and comb stages.*/
+    int       rate;         /*!< Decimation factor.*/
+    int       diff_delay;   /*!< Differential delay of the comb stages, 1 or 2.*/
+    int       phase;        /*!< Amount of input samples since the last output sample.*/
+    int       comb_pos;     /*!< Position of the oldest sample in the comb delay lines.*/
+    int16_t   shift;        /*!< Amount of bits to shift the output right.*/
+} cic_s32_t;
+
+/**
+ * @brief   Bit growth of CIC filter
+ *
+ * Amount of bits added to the input by the gain of the filter: ceil(order*log2(rate*diff_delay)).
+ *
+ * @param order: amount of stages
+ * @param rate: decimation factor
+ * @param diff_delay: differential delay
+ *
+ * @return
+ *      - bit growth of the filter
+ */
+int dsps_cic_growth_bits(int order, int rate, int diff_delay);
+
+/**
+ * @brief   initialize structure for CIC decimator
+ *
+ * Function initializes the structure and clears the registers.
+ * The registers are 32 bit and wrap around on overflow. The result is still exact,
+ * while in_bits + growth bits fit to 32 bit, this is checked by the function.
+ * The output is shifted right by in_bits + growth - out_bits, so the gain of the filter is
+ * (rate*diff_delay)^order / 2^shift and the output fits to out_bits.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param cic: pointer to the filter structure, that must be preallocated
+ * @param state: buffer for the registers. Length of order*(1 + diff_delay)
+ * @param order: amount of integrator and comb stages, 1..8
+ * @param rate: decimation factor
+ * @param diff_delay: differential delay of the comb stages, 1 or 2
+ * @param in_bits: amount of bits of the input samples with sign, for example 2 for PDM (+-1) and 13 for 12 bit ADC
+ * @param out_bits: amount of bits of the output samples with sign, 32 for full precision
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if the registers are too short for the bit growth
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_cic_dec_init_s32(cic_s32_t *cic, uint32_t *state, int order, int rate, int diff_delay, int in_bits, int out_bits);
+
+/**
+ * @brief   CIC decimator
+ *
+ * Cascaded integrator-comb decimation filter: order integrators at the input rate,
+ * decimation by rate, then order comb stages at the output rate. No multiplications are used.
+ * The response is ((sin(pi*f*diff_delay*rate)/sin(pi*f))/(rate*diff_delay))^order at the input rate,
+ * the passband droop could be corrected by a filter from dsps_fir_gen_cic_comp_f32(...).
+ * The input could be processed by blocks of any length, the decimation phase is kept in the structure.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param cic: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Length of len/rate + 1. Could be the same as input
+ * @param len: length of input array
+ *
+ * @return
+ *      - amount of output samples
+ */
+int dsps_cic_dec_s32(cic_s32_t *cic, const int32_t *input, int32_t *output, int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_cic_H_
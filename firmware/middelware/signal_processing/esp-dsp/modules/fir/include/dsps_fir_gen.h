@@ -0,0 +1,85 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fir_gen_H_
+#define _dsps_fir_gen_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief   Kaiser FIR filter length and window parameter
+ *
+ * Function estimates the length of a windowed sinc FIR filter and the beta of the Kaiser window
+ * required for the given stopband attenuation and transition band width (Kaiser formula).
+ *
+ * @param atten_db: stopband attenuation in dB
+ * @param width: transition band width, normalized to sample frequency (0..0.5)
+ * @param[out] beta: Kaiser window parameter. Could be NULL
+ *
+ * @return
+ *      - length of the filter (odd value)
+ */
+int dsps_fir_kaiser_len_f32(float atten_db, float width, float *beta);
+
+/**
+ * @brief   LPF FIR filter coefficients
+ *
+ * Function generates windowed sinc low pass filter with Kaiser window.
+ * The gain of the filter at DC is equal to gain.
+ *
+ * @param coeffs: result coefficients. Length of len
+ * @param len: length of the filter
+ * @param f: filter cut off frequency (-6 dB point) in range of 0..0.5 (normalized to sample frequency)
+ * @param beta: Kaiser window parameter
+ * @param gain: gain of the filter in passband
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fir_gen_lpf_f32(float *coeffs, int len, float f, float beta, float gain);
+
+/**
+ * @brief   CIC compensation FIR filter coefficients
+ *
+ * Function generates a low pass filter for the output of a CIC decimator, with inverse response of
+ * the CIC filter in passband, so the passband droop of the cascade is corrected.
+ * The desired response (1/H_cic up to f, 0 above) is sampled by numerical integration
+ * and windowed with Kaiser window. The gain of the filter at DC is 1.
+ * The frequencies are normalized to the output sample frequency of the decimator.
+ *
+ * @param coeffs: result coefficients. Length of len
+ * @param len: length of the filter, for example 15..63
+ * @param f: filter cut off frequency in range of 0..0.5, the passband is flat up to about f - 2/len
+ * @param beta: Kaiser window parameter
+ * @param order: amount of stages of the CIC filter
+ * @param rate: decimation factor of the CIC filter
+ * @param diff_delay: differential delay of the CIC filter
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fir_gen_cic_comp_f32(float *coeffs, int len, float f, float beta, int order, int rate, int diff_delay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fir_gen_H_
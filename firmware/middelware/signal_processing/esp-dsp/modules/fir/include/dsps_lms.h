@@ -0,0 +1,102 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_lms_H_
+#define _dsps_lms_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_LMS_HUM_MAX_HARM   8   /*!< Maximum amount of harmonics of the hum canceller.*/
+#define DSPS_LMS_HUM_TRACK_LEN  64  /*!< Length of block for the frequency tracking, samples.*/
+
+/**
+ * @brief Data struct of f32 adaptive powerline interference canceller
+ *
+ * This structure is used by a canceller internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_lms_hum_init_f32(...) function.
+ */
+typedef struct lms_hum_f32_s {
+    float   f;                                  /*!< Mains frequency, normalized to sample frequency. Updated by the frequency tracking.*/
+    float   f_min;                              /*!< Lower limit of the frequency tracking.*/
+    float   f_max;                              /*!< Upper limit of the frequency tracking.*/
+    float   step;                               /*!< Step of the weights update.*/
+    float   mu_f;                               /*!< Gain of the frequency tracking. 0 - frequency is fixed.*/
+    float   re;                                 /*!< Real part of the phasor of the reference fundamental.*/
+    float   im;                                 /*!< Imaginary part of the phasor of the reference fundamental.*/
+    float   rot_re;                             /*!< Real part of the phasor rotation per sample: cos(2*pi*f).*/
+    float   rot_im;                             /*!< Imaginary part of the phasor rotation per sample: sin(2*pi*f).*/
+    float   phase;                              /*!< Phase of the fundamental weights at the start of the tracking block.*/
+    float   w[2 * DSPS_LMS_HUM_MAX_HARM];       /*!< Weights of cos and sin reference for every harmonic.*/
+    int     n_harm;                             /*!< Amount of harmonics, including fundamental.*/
+    int     count;                              /*!< Samples processed in the current tracking block.*/
+    int     warmup;                             /*!< Samples left before the frequency tracking starts.*/
+} lms_hum_f32_t;
+
+/**
+ * @brief   initialize structure for adaptive powerline interference canceller
+ *
+ * The canceller generates the reference cos/sin pairs of the mains frequency and its harmonics
+ * internally and adapts their weights by LMS, so the hum with any amplitude and phase is subtracted
+ * from the input. The adaptive canceller is equal to a notch bank with bandwidth about mu*f_s/(2*pi)
+ * (NLMS) that follows the hum.
+ * With NLMS the step is normalized by the power of the reference vector. For unit sinusoids
+ * it is constant and equal to n_harm, so the stability range 0 < mu < 2 does not depend
+ * on the amount of harmonics.
+ * The frequency tracking measures the rotation of the fundamental weights every DSPS_LMS_HUM_TRACK_LEN
+ * samples and corrects the reference frequency, so the drift of the mains frequency is followed.
+ * The tracking starts after 4/step samples, when the weights are converged.
+ *
+ * @param lms: pointer to the canceller structure, that must be preallocated
+ * @param f: nominal mains frequency, normalized to sample frequency (for example 50/500)
+ * @param n_harm: amount of harmonics including fundamental, 1..DSPS_LMS_HUM_MAX_HARM
+ * @param mu: step size. Typical values are 0.001..0.05
+ * @param mu_f: gain of the frequency tracking, 0..1. 0 - frequency tracking is disabled
+ * @param normalized: 1 - NLMS, 0 - LMS
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_lms_hum_init_f32(lms_hum_f32_t *lms, float f, int n_harm, float mu, float mu_f, int normalized);
+
+/**
+ * @brief   Adaptive powerline interference canceller
+ *
+ * Function subtracts the estimated hum from the input and adapts the weights sample by sample.
+ * The cost is about 6*n_harm multiply-add operations per sample, the reference is generated
+ * by phasor rotation without trigonometric functions.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param lms: pointer to the canceller structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_lms_hum_f32(lms_hum_f32_t *lms, const float *input, float *output, int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_lms_H_
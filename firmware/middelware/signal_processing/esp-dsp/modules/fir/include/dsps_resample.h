@@ -0,0 +1,128 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_resample_H_
+#define _dsps_resample_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifndef DSPS_RESAMPLE_MAX_STAGES
+#define DSPS_RESAMPLE_MAX_STAGES        4   /*!< Maximum amount of stages of the resampler.*/
+#endif
+
+#ifndef DSPS_RESAMPLE_MAX_STAGE_FACTOR
+#define DSPS_RESAMPLE_MAX_STAGE_FACTOR  8   /*!< Interpolation or decimation factor of one stage, if the ratio could be factorized.*/
+#endif
+
+/**
+ * @brief Data struct of one polyphase stage of the resampler
+ *
+ * This structure is used by a resampler internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ */
+typedef struct resample_stage_f32_s {
+    float  *coeffs;     /*!< Polyphase coefficients. up phases of taps coefficients.*/
+    float  *delay;      /*!< Delay line. Length of 2*taps, every sample is stored twice.*/
+    int     taps;       /*!< Amount of coefficients of one phase.*/
+    int     up;         /*!< Interpolation factor of the stage.*/
+    int     down;       /*!< Decimation factor of the stage.*/
+    int     phase;      /*!< Current phase of the polyphase filter.*/
+    int     pos;        /*!< Position of the newest sample in the delay line.*/
+} resample_stage_f32_t;
+
+/**
+ * @brief Data struct of f32 rational resampler
+ *
+ * This structure is used by a resampler internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_resample_init_f32(...) function.
+ */
+typedef struct resample_f32_s {
+    resample_stage_f32_t stage[DSPS_RESAMPLE_MAX_STAGES];   /*!< Polyphase stages.*/
+    int     n_stages;   /*!< Amount of stages.*/
+    int     up;         /*!< Total interpolation factor.*/
+    int     down;       /*!< Total decimation factor.*/
+} resample_f32_t;
+
+/**
+ * @brief   initialize structure for 32 bit rational resampler
+ *
+ * Function initializes a resampler, that changes the sample rate by up/down.
+ * The ratio is reduced, factorized and split to up to DSPS_RESAMPLE_MAX_STAGES polyphase stages.
+ * If the reduced ratio is 1 (up == down), the resampler is a single pass through stage.
+ * Anti-alias (and anti-image) filters of all stages are designed automatically as Kaiser windowed
+ * sinc filters. Intermediate stages have relaxed transition bands, the aliases of intermediate stages
+ * fall only to the final transition band.
+ * Coefficients and delay lines are allocated by the function and must be released by dsps_resample_free_f32(...)
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param rs: pointer to resampler structure, that must be preallocated
+ * @param up: interpolation factor
+ * @param down: decimation factor
+ * @param pass: passband edge as a part of the lower Nyquist frequency (input or output), for example 0.8
+ * @param atten_db: stopband attenuation in dB, for example 60
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_resample_init_f32(resample_f32_t *rs, int up, int down, float pass, float atten_db);
+
+/**
+ * @brief   32 bit floating point rational resampler
+ *
+ * Function resamples the input block. The state is kept in the structure, so the stream could be
+ * split to the blocks of any length.
+ * The inner products use the optimized dsps_dotprod_f32 function.
+ *
+ * @param rs: pointer to resampler structure, that must be initialized before
+ * @param input: input array
+ * @param output: output array. Must have a space for (len*up + down - 1)/down samples
+ * @param len: length of input array
+ *
+ * @return: function returns the number of samples stored in the output array
+ */
+int dsps_resample_f32(resample_f32_t *rs, const float *input, float *output, int len);
+
+/**
+ * @brief   Total amount of coefficients of the resampler
+ *
+ * @param rs: pointer to resampler structure, that must be initialized before
+ *
+ * @return: amount of multiplications per input sample multiplied by up
+ */
+int dsps_resample_taps_f32(resample_f32_t *rs);
+
+/**
+ * @brief   support arrays freeing function
+ *
+ * Function frees coefficients and delay lines of all stages.
+ *
+ * @param rs: pointer to resampler structure, that must be initialized before
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t dsps_resample_free_f32(resample_f32_t *rs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_resample_H_
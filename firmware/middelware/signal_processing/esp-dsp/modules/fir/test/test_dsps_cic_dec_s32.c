@@ -0,0 +1,209 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_cic.h"
+#include "dsps_fir_gen.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_cic_dec_s32";
+
+#define SIG_LEN     4096
+#define MAX_ORDER   8
+#define COMP_LEN    31
+
+static int32_t input[SIG_LEN];
+static int32_t output[SIG_LEN];
+static int64_t ref[SIG_LEN];
+static int64_t tmp[SIG_LEN];
+static uint32_t state[MAX_ORDER * 3];
+static float comp[COMP_LEN];
+
+// Reference: order times moving sum of rate*diff_delay samples in 64 bit
+static void cic_ref(const int32_t *x, int len, int order, int rate, int diff_delay)
+{
+    int win = rate * diff_delay;
+    for (int i = 0; i < len; i++) {
+        ref[i] = x[i];
+    }
+    for (int s = 0; s < order; s++) {
+        for (int i = 0; i < len; i++) {
+            int64_t acc = 0;
+            for (int k = 0; k < win && k <= i; k++) {
+                acc += ref[i - k];
+            }
+            tmp[i] = acc;
+        }
+        memcpy(ref, tmp, len * sizeof(int64_t));
+    }
+}
+
+TEST_CASE("dsps_cic_dec_s32 functionality", "[dsps]")
+{
+    const struct {
+        int order;
+        int rate;
+        int diff_delay;
+        int in_bits;
+    } cases[] = {
+        {1, 2, 1, 16},
+        {3, 8, 1, 16},
+        {4, 16, 2, 12},
+        {5, 32, 1, 2},
+    };
+    for (int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int order = cases[c].order;
+        int rate = cases[c].rate;
+        int diff_delay = cases[c].diff_delay;
+        int in_max = (1 << (cases[c].in_bits - 1)) - 1;
+        for (int i = 0; i < SIG_LEN; i++) {
+            input[i] = (rand() % (2 * in_max + 1)) - in_max;
+        }
+        cic_ref(input, SIG_LEN, order, rate, diff_delay);
+
+        cic_s32_t cic;
+        TEST_ESP_OK(dsps_cic_dec_init_s32(&cic, state, order, rate, diff_delay, cases[c].in_bits, 32));
+        TEST_ASSERT_EQUAL(0, cic.shift);
+        // Blocks of random length, the output is exact
+        int pos = 0;
+        int n = 0;
+        while (pos < SIG_LEN) {
+            int block = rand() % (3 * rate);
+            block = (block > SIG_LEN - pos) ? SIG_LEN - pos : block;
+            n += dsps_cic_dec_s32(&cic, &input[pos], &output[n], block);
+            pos += block;
+        }
+        TEST_ASSERT_EQUAL(SIG_LEN / rate, n);
+        for (int i = 0; i < n; i++) {
+            TEST_ASSERT_EQUAL_INT32((int32_t)ref[i * rate + rate - 1], output[i]);
+        }
+    }
+    cic_s32_t cic;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_cic_dec_init_s32(&cic, state, 4, 32, 2, 9, 32));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_cic_dec_init_s32(&cic, state, 0, 32, 1, 8, 32));
+}
+
+TEST_CASE("dsps_cic_dec_s32 maximum gain", "[dsps]")
+{
+    // in_bits + growth = 8 + 4*6 = 32 bit: the integrators wrap around many times,
+    // but the output at full scale input must be exact
+    const int order = 4;
+    const int rate = 32;
+    const int diff_delay = 2;
+    const int64_t gain = 1 << 24;
+    const int32_t levels[] = {127, -128, 0, -128, 127};
+    cic_s32_t cic;
+    TEST_ESP_OK(dsps_cic_dec_init_s32(&cic, state, order, rate, diff_delay, 8, 32));
+    for (int l = 0; l < sizeof(levels) / sizeof(int32_t); l++) {
+        for (int i = 0; i < SIG_LEN; i++) {
+            input[i] = levels[l];
+        }
+        int n = dsps_cic_dec_s32(&cic, input, output, SIG_LEN);
+        // After order*diff_delay output samples the transient is over
+        TEST_ASSERT_EQUAL(levels[l] * gain, output[n - 1]);
+        TEST_ASSERT_EQUAL(levels[l] * gain, output[order * diff_delay]);
+    }
+    // Output normalized to 16 bit
+    TEST_ESP_OK(dsps_cic_dec_init_s32(&cic, state, order, rate, diff_delay, 8, 16));
+    TEST_ASSERT_EQUAL(16, cic.shift);
+    for (int i = 0; i < SIG_LEN; i++) {
+        input[i] = -128;
+    }
+    int n = dsps_cic_dec_s32(&cic, input, input, SIG_LEN);
+    TEST_ASSERT_EQUAL(-32768, input[n - 1]);
+}
+
+TEST_CASE("dsps_cic_dec_s32 frequency response", "[dsps]")
+{
+    const int order = 3;
+    const int rate = 8;
+    const float gain = rate * rate * rate;
+    const float amplitude = 30000;
+    const float freqs[] = {0.01f, 0.1f, 0.25f, 0.4f};
+    cic_s32_t cic;
+    for (int k = 0; k < sizeof(freqs) / sizeof(float); k++) {
+        // Frequency normalized to the output sample frequency
+        float f = freqs[k];
+        for (int i = 0; i < SIG_LEN; i++) {
+            input[i] = (int32_t)roundf(amplitude * sinf(2 * M_PI * f * i / rate));
+        }
+        TEST_ESP_OK(dsps_cic_dec_init_s32(&cic, state, order, rate, 1, 16, 32));
+        int n = dsps_cic_dec_s32(&cic, input, output, SIG_LEN);
+        // Amplitude by correlation with sine and cosine after the transient
+        float re = 0;
+        float im = 0;
+        int start = 2 * order;
+        int count = 0;
+        for (int i = start; i < n; i++) {
+            re += output[i] * cosf(2 * M_PI * f * i);
+            im += output[i] * sinf(2 * M_PI * f * i);
+            count++;
+        }
+        float measured = 2 * sqrtf(re * re + im * im) / count / (gain * amplitude);
+        float x = M_PI * f / rate;
+        float expected = powf(sinf(x * rate) / (rate * sinf(x)), order);
+        ESP_LOGI(TAG, "f = %.2f: response %f, expected %f", f, measured, expected);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, expected, measured);
+    }
+}
+
+TEST_CASE("dsps_fir_gen_cic_comp_f32 functionality", "[dsps]")
+{
+    // Response of the cascade CIC + compensator must be flat in passband
+    const int order = 4;
+    const int rate = 16;
+    const float f_cut = 0.3f;
+    const float f_pass = 0.2f;
+    TEST_ESP_OK(dsps_fir_gen_cic_comp_f32(comp, COMP_LEN, f_cut, 6, order, rate, 1));
+    float ripple = 0;
+    float droop = 0;
+    for (int k = 0; k <= 100; k++) {
+        float f = f_pass * k / 100;
+        float re = 0;
+        float im = 0;
+        for (int i = 0; i < COMP_LEN; i++) {
+            re += comp[i] * cosf(2 * M_PI * f * i);
+            im += comp[i] * sinf(2 * M_PI * f * i);
+        }
+        float x = M_PI * f / rate;
+        float h_cic = (k == 0) ? 1 : powf(sinf(x * rate) / (rate * sinf(x)), order);
+        float db = 20 * log10f(h_cic * sqrtf(re * re + im * im));
+        ripple = (fabsf(db) > ripple) ? fabsf(db) : ripple;
+        droop = (-20 * log10f(h_cic) > droop) ? -20 * log10f(h_cic) : droop;
+    }
+    ESP_LOGI(TAG, "CIC droop %.3f dB, compensated ripple %.3f dB", droop, ripple);
+    TEST_ASSERT_GREATER_THAN(1000, (int)(1000 * droop));
+    TEST_ASSERT_LESS_THAN(100, (int)(1000 * ripple));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_fir_gen_cic_comp_f32(comp, COMP_LEN, 0.6f, 6, order, rate, 1));
+}
+
+TEST_CASE("dsps_cic_dec_s32 benchmark", "[dsps]")
+{
+    const int order = 4;
+    const int rate = 16;
+    cic_s32_t cic;
+    TEST_ESP_OK(dsps_cic_dec_init_s32(&cic, state, order, rate, 1, 16, 16));
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_cic_dec_s32(&cic, input, output, SIG_LEN);
+    unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+    ESP_LOGI(TAG, "order %i, rate %i: %i cycles per input sample", order, rate, cycles / SIG_LEN);
+    TEST_ASSERT_EXEC_IN_RANGE(SIG_LEN, 100 * SIG_LEN, cycles);
+}
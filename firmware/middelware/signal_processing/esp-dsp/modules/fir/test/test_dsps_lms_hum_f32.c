@@ -0,0 +1,203 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_lms.h"
+#include "dsps_biquad.h"
+#include "dsps_biquad_gen.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_lms_hum_f32";
+
+#define FS          500.0f
+#define ECG_LEN     10000
+#define BLOCK_LEN   500
+#define HUM_HARM    3
+
+// The signals are generated and processed by blocks, so the buffers are short
+static float ecg[BLOCK_LEN];
+static float x[BLOCK_LEN];
+static float y[BLOCK_LEN];
+static float ref[BLOCK_LEN];
+
+// Synthetic ECG: P, QRS and T waves as gaussian pulses at 72 bpm, amplitude in mV.
+// Samples from start to start + len - 1.
+static void gen_ecg(float *data, int start, int len)
+{
+    const float pos[] = {-0.2f, -0.03f, 0, 0.03f, 0.25f};
+    const float amp[] = {0.15f, -0.1f, 1.0f, -0.25f, 0.3f};
+    const float width[] = {0.025f, 0.008f, 0.01f, 0.008f, 0.04f};
+    const float period = 60.0f / 72;
+    for (int i = 0; i < len; i++) {
+        float t = fmodf((start + i) / FS, period) - period / 2;
+        data[i] = 0;
+        for (int k = 0; k < 5; k++) {
+            float d = (t - pos[k]) / width[k];
+            data[i] += amp[k] * expf(-0.5f * d * d);
+        }
+    }
+}
+
+// Hum of frequency f_hum with harmonics. Samples from start to start + len - 1.
+static void add_hum(const float *in, float *out, int start, int len, float f_hum)
+{
+    const float amp[HUM_HARM] = {0.5f, 0.2f, 0.1f};
+    const float phase[HUM_HARM] = {0.3f, 1.7f, -2.1f};
+    for (int i = 0; i < len; i++) {
+        out[i] = in[i];
+        for (int h = 0; h < HUM_HARM; h++) {
+            out[i] += amp[h] * cosf(fmodf(2 * M_PI * f_hum * (h + 1) * (start + i) / FS, 2 * M_PI) + phase[h]);
+        }
+    }
+}
+
+static float sum_sq_diff(const float *a, const float *b, int len)
+{
+    float acc = 0;
+    for (int i = 0; i < len; i++) {
+        acc += (a[i] - b[i]) * (a[i] - b[i]);
+    }
+    return acc;
+}
+
+// Process ECG_LEN samples with hum by the canceller. Returns RMS of the hum and of the residual
+// in the last quarter of the signal, when the canceller has converged.
+static void lms_hum_process(lms_hum_f32_t *lms, float f_hum, bool random_blocks, float *hum_rms, float *res_rms)
+{
+    int tail = ECG_LEN / 4;
+    float hum_acc = 0;
+    float res_acc = 0;
+    for (int start = 0; start < ECG_LEN; start += BLOCK_LEN) {
+        gen_ecg(ecg, start, BLOCK_LEN);
+        add_hum(ecg, x, start, BLOCK_LEN, f_hum);
+        // Process by blocks of different length, the result does not depend on it
+        for (int pos = 0; pos < BLOCK_LEN;) {
+            int n = random_blocks ? 1 + rand() % 100 : BLOCK_LEN;
+            n = (pos + n > BLOCK_LEN) ? BLOCK_LEN - pos : n;
+            TEST_ESP_OK(dsps_lms_hum_f32(lms, &x[pos], &y[pos], n));
+            pos += n;
+        }
+        if (start >= ECG_LEN - tail) {
+            hum_acc += sum_sq_diff(x, ecg, BLOCK_LEN);
+            res_acc += sum_sq_diff(y, ecg, BLOCK_LEN);
+        }
+    }
+    *hum_rms = sqrtf(hum_acc / tail);
+    *res_rms = sqrtf(res_acc / tail);
+}
+
+TEST_CASE("dsps_lms_hum_f32 functionality", "[dsps]")
+{
+    const float f_hum[] = {50, 50.4f, 49.6f, 60.3f};
+    const float f_nom[] = {50, 50, 50, 60};
+    for (int k = 0; k < sizeof(f_hum) / sizeof(float); k++) {
+        float hum_rms;
+        float res_rms;
+        lms_hum_f32_t lms;
+        TEST_ESP_OK(dsps_lms_hum_init_f32(&lms, f_nom[k] / FS, HUM_HARM, 0.02f, 0.5f, 1));
+        lms_hum_process(&lms, f_hum[k], true, &hum_rms, &res_rms);
+        float att = 20 * log10f(hum_rms / res_rms);
+        ESP_LOGI(TAG, "hum %.1f Hz, nominal %.1f Hz: tracked %.3f Hz, hum %f, residual %f, attenuation %.1f dB",
+                 f_hum[k], f_nom[k], lms.f * FS, hum_rms, res_rms, att);
+        TEST_ASSERT_FLOAT_WITHIN(0.02, f_hum[k], lms.f * FS);
+        TEST_ASSERT_GREATER_THAN(20, (int)att);
+
+        // Without the frequency tracking the drift is removed worse
+        if (f_hum[k] != f_nom[k]) {
+            float fixed_rms;
+            TEST_ESP_OK(dsps_lms_hum_init_f32(&lms, f_nom[k] / FS, HUM_HARM, 0.02f, 0, 1));
+            lms_hum_process(&lms, f_hum[k], false, &hum_rms, &fixed_rms);
+            ESP_LOGI(TAG, "without tracking: residual %f", fixed_rms);
+            TEST_ASSERT_GREATER_THAN((int)(1000000 * res_rms), (int)(1000000 * fixed_rms));
+        }
+    }
+
+    lms_hum_f32_t lms;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_lms_hum_init_f32(&lms, 0.1f, DSPS_LMS_HUM_MAX_HARM + 1, 0.01f, 0, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_lms_hum_init_f32(&lms, 0.1f, 5, 0.01f, 0, 1));
+}
+
+TEST_CASE("dsps_biquad_gen_notch_bank_f32 functionality", "[dsps]")
+{
+    float coeffs[5 * HUM_HARM];
+    float w[2 * HUM_HARM] = {0};
+    float w_ref[2 * HUM_HARM] = {0};
+    TEST_ESP_OK(dsps_biquad_gen_notch_bank_f32(coeffs, 50 / FS, HUM_HARM, -200, 10));
+
+    // Response of the cascade at the notches and in passband
+    for (int i = 0; i <= 2 * HUM_HARM; i++) {
+        float f = (i == 2 * HUM_HARM) ? 10 / FS : 50 * (i / 2 + 1) / FS + ((i & 1) ? 2 / FS : 0);
+        float gain = 1;
+        for (int s = 0; s < HUM_HARM; s++) {
+            float *c = &coeffs[s * 5];
+            float cr = cosf(2 * M_PI * f), ci = -sinf(2 * M_PI * f);
+            float c2r = cr * cr - ci * ci, c2i = 2 * cr * ci;
+            float nr = c[0] + c[1] * cr + c[2] * c2r, ni = c[1] * ci + c[2] * c2i;
+            float dr = 1 + c[3] * cr + c[4] * c2r, di = c[3] * ci + c[4] * c2i;
+            gain *= sqrtf((nr * nr + ni * ni) / (dr * dr + di * di));
+        }
+        ESP_LOGI(TAG, "notch bank gain at %.1f Hz: %.1f dB", f * FS, 20 * log10f(gain + 1e-9));
+        if (i == 2 * HUM_HARM) {
+            TEST_ASSERT_FLOAT_WITHIN(0.01, 1, gain);
+        } else if ((i & 1) == 0) {
+            TEST_ASSERT_LESS_THAN(-60, (int)(20 * log10f(gain + 1e-9)));
+        }
+    }
+
+    // Hum is removed, the filtered hum-free ECG is the reference
+    int tail = ECG_LEN / 4;
+    float res_acc = 0;
+    float dist_acc = 0;
+    for (int start = 0; start < ECG_LEN; start += BLOCK_LEN) {
+        gen_ecg(ecg, start, BLOCK_LEN);
+        add_hum(ecg, x, start, BLOCK_LEN, 50);
+        for (int s = 0; s < HUM_HARM; s++) {
+            dsps_biquad_f32(s == 0 ? x : y, y, BLOCK_LEN, &coeffs[s * 5], &w[s * 2]);
+            dsps_biquad_f32(s == 0 ? ecg : ref, ref, BLOCK_LEN, &coeffs[s * 5], &w_ref[s * 2]);
+        }
+        if (start >= ECG_LEN - tail) {
+            res_acc += sum_sq_diff(y, ref, BLOCK_LEN);
+            dist_acc += sum_sq_diff(ref, ecg, BLOCK_LEN);
+        }
+    }
+    float res_rms = sqrtf(res_acc / tail);
+    float dist_rms = sqrtf(dist_acc / tail);
+    ESP_LOGI(TAG, "notch bank: hum residual %f, ECG distortion %f", res_rms, dist_rms);
+    TEST_ASSERT_LESS_THAN(1000, (int)(1000000 * res_rms));
+    TEST_ASSERT_LESS_THAN(50, (int)(1000 * dist_rms));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_biquad_gen_notch_bank_f32(coeffs, 0.1f, 5, -200, 10));
+}
+
+TEST_CASE("dsps_lms_hum_f32 benchmark", "[dsps]")
+{
+    lms_hum_f32_t lms;
+    TEST_ESP_OK(dsps_lms_hum_init_f32(&lms, 50 / FS, HUM_HARM, 0.02f, 0.5f, 1));
+    gen_ecg(ecg, 0, BLOCK_LEN);
+
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_lms_hum_f32(&lms, ecg, y, BLOCK_LEN);
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    float cycles = (float)(end_b - start_b) / BLOCK_LEN;
+    ESP_LOGI(TAG, "dsps_lms_hum_f32 - %f cycles per sample for %i harmonics", cycles, HUM_HARM);
+    TEST_ASSERT_EXEC_IN_RANGE(2, 500, (int)cycles);
+}
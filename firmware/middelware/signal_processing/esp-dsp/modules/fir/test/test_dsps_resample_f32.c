@@ -0,0 +1,212 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_resample.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_resample_f32";
+
+#define RS_LEN      4096
+#define RS_OUT_LEN  (RS_LEN * 4)
+
+static float x[RS_LEN];
+static float y[RS_OUT_LEN];
+static float y_chunk[RS_OUT_LEN];
+
+// Amplitude of the output in steady state for an input tone of frequency f (normalized to input rate)
+static float tone_gain(resample_f32_t *rs, float f)
+{
+    // Feed blocks until the filter settles and enough output samples are collected
+    int total = 0;
+    int collected = 0;
+    double phase = 0;
+    while (collected < RS_LEN) {
+        for (int i = 0 ; i < RS_LEN / 2 ; i++) {
+            x[i] = sin(2 * M_PI * phase);
+            phase = fmod(phase + f, 1.0);
+        }
+        int res = dsps_resample_f32(rs, x, &y[total], RS_LEN / 2);
+        total += res;
+        collected += res;
+        if (total >= RS_LEN) {
+            memmove(y, &y[total - RS_LEN / 2], RS_LEN / 2 * sizeof(float));
+            total = RS_LEN / 2;
+        }
+    }
+    float pow = 0;
+    for (int i = total - RS_LEN / 2 ; i < total ; i++) {
+        pow += y[i] * y[i];
+    }
+    return sqrtf(2 * pow / (RS_LEN / 2));
+}
+
+static void check_response(int up, int down, float pass, float atten_db)
+{
+    resample_f32_t rs;
+    TEST_ESP_OK(dsps_resample_init_f32(&rs, up, down, pass, atten_db));
+    float nyq = (up < down) ? 0.5 * up / down : 0.5;
+
+    float gain_min = 1000;
+    float gain_max = 0;
+    for (int i = 1 ; i <= 10 ; i++) {
+        float f = pass * nyq * i / 10;
+        float g = tone_gain(&rs, f);
+        gain_min = fminf(g, gain_min);
+        gain_max = fmaxf(g, gain_max);
+    }
+    float ripple = 20 * log10f(gain_max / gain_min);
+
+    // Stopband: input tones which would alias to the passband, or images of the passband tones
+    float stop_max = 0;
+    for (int i = 1 ; i <= 10 ; i++) {
+        float f_alias = 2 * nyq - pass * nyq * i / 10;
+        if (up < down) {
+            stop_max = fmaxf(stop_max, tone_gain(&rs, f_alias));
+        }
+    }
+    float atten = -20 * log10f(stop_max + 1e-9);
+    ESP_LOGI(TAG, "%i/%i: %i stages, %i taps, passband ripple %f dB, gain %f, stopband attenuation %f dB",
+             up, down, rs.n_stages, dsps_resample_taps_f32(&rs), ripple, gain_max, up < down ? atten : 0);
+    TEST_ASSERT_LESS_THAN(100000, (int)(1e6 * ripple));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1, gain_max);
+    if (up < down) {
+        TEST_ASSERT_GREATER_THAN((int)atten_db - 3, (int)atten);
+    }
+    dsps_resample_free_f32(&rs);
+}
+
+TEST_CASE("dsps_resample_f32 decimation", "[dsps]")
+{
+    check_response(1, 2, 0.8, 60);
+    check_response(1, 10, 0.8, 60);
+    check_response(1, 48, 0.8, 60);
+}
+
+TEST_CASE("dsps_resample_f32 interpolation and rational ratio", "[dsps]")
+{
+    check_response(4, 1, 0.8, 60);
+    check_response(3, 2, 0.8, 60);
+    check_response(2, 3, 0.8, 60);
+    check_response(160, 147, 0.8, 60);
+}
+
+TEST_CASE("dsps_resample_f32 unity ratio", "[dsps]")
+{
+    // up == down after the reduction passes the input through
+    int ratios[][2] = {{1, 1}, {2, 2}, {48, 48}};
+    for (int r = 0 ; r < 3 ; r++) {
+        resample_f32_t rs;
+        TEST_ESP_OK(dsps_resample_init_f32(&rs, ratios[r][0], ratios[r][1], 0.8, 60));
+        TEST_ASSERT_EQUAL(1, rs.n_stages);
+        int len = 100;
+        for (int i = 0 ; i < len ; i++) {
+            x[i] = sinf(0.01 * i) + cosf(0.37 * i);
+        }
+        TEST_ASSERT_EQUAL(len, dsps_resample_f32(&rs, x, y, len));
+        for (int i = 0 ; i < len ; i++) {
+            TEST_ASSERT_TRUE(x[i] == y[i]);
+        }
+        dsps_resample_free_f32(&rs);
+    }
+}
+
+TEST_CASE("dsps_resample_f32 image rejection", "[dsps]")
+{
+    // Interpolation by 4: a tone at f produces images at 1 - f, 1 + f ... of the input rate
+    resample_f32_t rs;
+    TEST_ESP_OK(dsps_resample_init_f32(&rs, 4, 1, 0.8, 60));
+    float f = 0.1;
+    for (int i = 0 ; i < RS_LEN ; i++) {
+        x[i] = sinf(2 * M_PI * f * i);
+    }
+    int total = dsps_resample_f32(&rs, x, y, RS_LEN);
+    TEST_ASSERT_EQUAL(RS_LEN * 4, total);
+    float max_image = 0;
+    for (int k = 1 ; k < 4 ; k++) {
+        float images[2] = {(k - f) / 4, (k + f) / 4};
+        for (int m = 0 ; m < 2 ; m++) {
+            float re = 0;
+            float im = 0;
+            for (int i = total / 2 ; i < total ; i++) {
+                re += y[i] * cosf(2 * M_PI * images[m] * i);
+                im += y[i] * sinf(2 * M_PI * images[m] * i);
+            }
+            float amp = 2 * sqrtf(re * re + im * im) / (total - total / 2);
+            max_image = fmaxf(max_image, amp);
+        }
+    }
+    ESP_LOGI(TAG, "Image rejection %f dB", -20 * log10f(max_image + 1e-9));
+    TEST_ASSERT_LESS_THAN(2000, (int)(1e6 * max_image));
+    dsps_resample_free_f32(&rs);
+}
+
+TEST_CASE("dsps_resample_f32 streaming", "[dsps]")
+{
+    // Result must not depend on the block size
+    int ratios[][2] = {{1, 10}, {3, 2}, {2, 3}, {5, 1}};
+    for (int r = 0 ; r < 4 ; r++) {
+        resample_f32_t rs1;
+        resample_f32_t rs2;
+        TEST_ESP_OK(dsps_resample_init_f32(&rs1, ratios[r][0], ratios[r][1], 0.8, 60));
+        TEST_ESP_OK(dsps_resample_init_f32(&rs2, ratios[r][0], ratios[r][1], 0.8, 60));
+        int len = 1000;
+        for (int i = 0 ; i < len ; i++) {
+            x[i] = sinf(0.01 * i) + cosf(0.37 * i);
+        }
+        int total = dsps_resample_f32(&rs1, x, y, len);
+        TEST_ASSERT_EQUAL((len * ratios[r][0] + ratios[r][1] - 1) / ratios[r][1], total);
+        int pos = 0;
+        int out = 0;
+        int chunk = 1;
+        while (pos < len) {
+            int n = (pos + chunk > len) ? len - pos : chunk;
+            int max_out = (n * ratios[r][0] + ratios[r][1] - 1) / ratios[r][1];
+            int res = dsps_resample_f32(&rs2, &x[pos], &y_chunk[out], n);
+            TEST_ASSERT_LESS_OR_EQUAL(max_out, res);
+            out += res;
+            pos += n;
+            chunk = (chunk * 7 + 3) % 37 + 1;
+        }
+        TEST_ASSERT_EQUAL(total, out);
+        for (int i = 0 ; i < total ; i++) {
+            TEST_ASSERT_EQUAL(y[i], y_chunk[i]);
+        }
+        dsps_resample_free_f32(&rs1);
+        dsps_resample_free_f32(&rs2);
+    }
+}
+
+TEST_CASE("dsps_resample_f32 benchmark", "[dsps]")
+{
+    resample_f32_t rs;
+    TEST_ESP_OK(dsps_resample_init_f32(&rs, 1, 10, 0.8, 60));
+    for (int i = 0 ; i < RS_LEN ; i++) {
+        x[i] = 0;
+    }
+    unsigned int start_b = xthal_get_ccount();
+    dsps_resample_f32(&rs, x, y, RS_LEN);
+    unsigned int end_b = xthal_get_ccount();
+    float cycles = (float)(end_b - start_b) / RS_LEN;
+    ESP_LOGI(TAG, "dsps_resample_f32 1/10 - %f cycles per input sample, %i taps", cycles, dsps_resample_taps_f32(&rs));
+    float min_exec = 5;
+    float max_exec = 3000;
+    TEST_ASSERT_EXEC_IN_RANGE(min_exec, max_exec, cycles);
+    dsps_resample_free_f32(&rs);
+}
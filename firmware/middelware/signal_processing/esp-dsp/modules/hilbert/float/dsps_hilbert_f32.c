@@ -0,0 +1,182 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_hilbert.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include <string.h>
+#include <math.h>
+
+esp_err_t dsps_hilbert_init_f32(hilbert_f32_t *hb, float *coeffs, float *delay, int n_taps)
+{
+    if ((hb == NULL) || (coeffs == NULL) || (delay == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((n_taps < 3) || ((n_taps & 1) == 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int half = (n_taps - 1) / 2;
+    hb->coeffs = coeffs;
+    hb->delay = delay;
+    hb->n_taps = n_taps;
+    hb->n_coeffs = (n_taps + 1) / 4;
+    hb->pos = 0;
+    hb->prev_re = 0;
+    hb->prev_im = 0;
+    memset(delay, 0, 2 * n_taps * sizeof(float));
+
+    // 2/(Pi*k) with Blackman window, the gain at fs/4 is sum of 2*c[k]*sin(Pi*k/2)
+    float gain = 0;
+    for (int i = 0; i < hb->n_coeffs; i++) {
+        int k = 2 * i + 1;
+        float w = 0.42f + 0.5f * cosf(M_PI * k / (half + 1)) + 0.08f * cosf(2 * M_PI * k / (half + 1));
+        coeffs[i] = 2 / (M_PI * k) * w;
+        gain += (i & 1) ? -2 * coeffs[i] : 2 * coeffs[i];
+    }
+    for (int i = 0; i < hb->n_coeffs; i++) {
+        coeffs[i] /= gain;
+    }
+    return ESP_OK;
+}
+
+// Next analytic sample: the delay line is doubled, so the last n_taps samples are continuous from pos
+static inline void dsps_hilbert_step_f32(hilbert_f32_t *hb, float x, float *re, float *im)
+{
+    int n = hb->n_taps;
+    hb->pos = (hb->pos > 0) ? hb->pos - 1 : n - 1;
+    hb->delay[hb->pos] = x;
+    hb->delay[hb->pos + n] = x;
+    // center[j] = x[i - (n_taps - 1)/2 - j]
+    const float *center = &hb->delay[hb->pos + (n - 1) / 2];
+    const float *c = hb->coeffs;
+    float acc = 0;
+    for (int i = 0; i < hb->n_coeffs; i++) {
+        int k = 2 * i + 1;
+        acc += c[i] * (center[k] - center[-k]);
+    }
+    *re = center[0];
+    *im = acc;
+}
+
+static inline void dsps_analytic_demod_f32(float re, float im, float prev_re, float prev_im, float *env, float *phase, float *freq, int i)
+{
+    if (env) {
+        env[i] = sqrtf(re * re + im * im);
+    }
+    if (phase) {
+        phase[i] = atan2f(im, re);
+    }
+    if (freq) {
+        // arg(z*conj(z_prev))
+        freq[i] = atan2f(im * prev_re - re * prev_im, re * prev_re + im * prev_im) * (float)(1 / (2 * M_PI));
+    }
+}
+
+esp_err_t dsps_hilbert_f32(hilbert_f32_t *hb, const float *input, float *output, int len)
+{
+    if ((hb == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 1) {
+        return ESP_OK;
+    }
+    for (int i = 0; i < len; i++) {
+        dsps_hilbert_step_f32(hb, input[i], &output[i * 2 + 0], &output[i * 2 + 1]);
+    }
+    hb->prev_re = output[len * 2 - 2];
+    hb->prev_im = output[len * 2 - 1];
+    return ESP_OK;
+}
+
+esp_err_t dsps_hilbert_env_f32(hilbert_f32_t *hb, const float *input, float *env, float *phase, float *freq, int len)
+{
+    if ((hb == NULL) || (input == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int i = 0; i < len; i++) {
+        float re, im;
+        dsps_hilbert_step_f32(hb, input[i], &re, &im);
+        dsps_analytic_demod_f32(re, im, hb->prev_re, hb->prev_im, env, phase, freq, i);
+        hb->prev_re = re;
+        hb->prev_im = im;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_analytic_f32(float *data, int N)
+{
+    if (data == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((N < 2) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (dsps_fft2r_initialized == 0) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    for (int i = N - 1; i >= 0; i--) {
+        data[i * 2 + 0] = data[i];
+        data[i * 2 + 1] = 0;
+    }
+    esp_err_t ret = dsps_fft2r_fc32(data, N);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = dsps_bit_rev_fc32(data, N);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Bins 0 and N/2 are kept, the positive frequencies are doubled and the negative cleared.
+    // The inverse FFT is the forward FFT of the conjugate, 1/N is applied together
+    float scale = 1.0f / N;
+    data[0] *= scale;
+    data[1] *= -scale;
+    for (int i = 1; i < N / 2; i++) {
+        data[i * 2 + 0] *= 2 * scale;
+        data[i * 2 + 1] *= -2 * scale;
+    }
+    data[N + 0] *= scale;
+    data[N + 1] *= -scale;
+    memset(&data[N + 2], 0, (N - 2) * sizeof(float));
+    ret = dsps_fft2r_fc32(data, N);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = dsps_bit_rev_fc32(data, N);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int i = 0; i < N; i++) {
+        data[i * 2 + 1] = -data[i * 2 + 1];
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_analytic_env_f32(const float *data, float *env, float *phase, float *freq, int len)
+{
+    if (data == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 1) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    for (int i = 0; i < len; i++) {
+        int prev = (i > 0) ? i - 1 : 0;
+        dsps_analytic_demod_f32(data[i * 2 + 0], data[i * 2 + 1], data[prev * 2 + 0], data[prev * 2 + 1], env, phase, freq, i);
+    }
+    if (freq && (len > 1)) {
+        freq[0] = freq[1];
+    }
+    return ESP_OK;
+}
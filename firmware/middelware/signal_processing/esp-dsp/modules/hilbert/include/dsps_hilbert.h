@@ -0,0 +1,150 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_hilbert_H_
+#define _dsps_hilbert_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 FIR Hilbert transformer
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_hilbert_init_f32(...) function.
+ */
+typedef struct hilbert_f32_s {
+    float  *coeffs;     /*!< Non zero coefficients for the taps 1, 3, 5... after the center.*/
+    float  *delay;      /*!< Delay line of two copies of the last n_taps samples.*/
+    int     n_taps;     /*!< Length of the filter, odd.*/
+    int     n_coeffs;   /*!< Amount of non zero coefficients, (n_taps + 1)/4.*/
+    int     pos;        /*!< Position of the last sample in the delay line.*/
+    float   prev_re;    /*!< Real part of the previous analytic sample, for the instantaneous frequency.*/
+    float   prev_im;    /*!< Imaginary part of the previous analytic sample.*/
+} hilbert_f32_t;
+
+/**
+ * @brief   initialize structure for FIR Hilbert transformer
+ *
+ * Function designs a type III FIR Hilbert transformer: the ideal response 2/(Pi*k) for odd k
+ * with Blackman window, normalized to unit gain at fs/4. All even taps except the center are zero
+ * and the odd taps are antisymmetric, so only (n_taps + 1)/4 coefficients are stored.
+ * The gain is within 0.1% from about 3/n_taps to 0.5 - 3/n_taps of the sample frequency.
+ *
+ * @param hb: pointer to the filter structure, that must be preallocated
+ * @param coeffs: buffer for the coefficients. Length of (n_taps + 1)/4
+ * @param delay: buffer for the delay line. Length of 2*n_taps
+ * @param n_taps: length of the filter, odd, at least 3. The delay of the filter is (n_taps - 1)/2
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_hilbert_init_f32(hilbert_f32_t *hb, float *coeffs, float *delay, int n_taps);
+
+/**
+ * @brief   FIR Hilbert transformer
+ *
+ * Function calculates the analytic signal of the input stream: the real part is the input
+ * delayed by (n_taps - 1)/2 samples and the imaginary part is the Hilbert transform.
+ * The zero taps are skipped and the antisymmetric taps are added before the multiplication,
+ * so there is one multiplication per four taps, instead of one per tap of dsps_fir_f32(...).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param hb: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output complex array. An element with index i is at output[i*2 + 0] (re) and output[i*2 + 1] (im).
+ *                Length of 2*len
+ * @param len: length of input array
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_hilbert_f32(hilbert_f32_t *hb, const float *input, float *output, int len);
+
+/**
+ * @brief   Envelope, phase and frequency by FIR Hilbert transformer
+ *
+ * Function calculates the analytic signal as dsps_hilbert_f32(...) and outputs
+ * the demodulated values of it as dsps_analytic_env_f32(...). The outputs are delayed by
+ * (n_taps - 1)/2 samples. The instantaneous frequency is continuous between the calls.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param hb: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param env: output envelope. Could be NULL
+ * @param phase: output instantaneous phase, -Pi..Pi. Could be NULL
+ * @param freq: output instantaneous frequency, -0.5..0.5 of the sample frequency. Could be NULL
+ * @param len: length of input and output arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_hilbert_env_f32(hilbert_f32_t *hb, const float *input, float *env, float *phase, float *freq, int len);
+
+/**
+ * @brief   Analytic signal by FFT
+ *
+ * Function calculates the analytic signal of a block, as scipy.signal.hilbert: the spectrum
+ * of the negative frequencies is cleared and the positive frequencies are doubled.
+ * There is no delay and no band edges, but the block is periodic: the values near the ends
+ * are influenced by the other end of the block.
+ * FFT tables must be initialized by dsps_fft2r_init_fc32(...) for N or more before.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param data: input/output array. Input is the real signal at data[0..N-1], output is the complex
+ *              analytic signal, an element with index i is at data[i*2 + 0] (re) and data[i*2 + 1] (im).
+ *              Length of 2*N
+ * @param N: length of the signal, power of 2, at least 2
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if FFT tables are not initialized
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_analytic_f32(float *data, int N);
+
+/**
+ * @brief   Envelope, phase and frequency of analytic signal
+ *
+ * env = |z[i]|, phase = arg(z[i]) and freq = arg(z[i]*conj(z[i - 1]))/(2*Pi). The frequency is
+ * calculated from the phase difference without unwrapping, it is equal to
+ * numpy.diff(numpy.unwrap(numpy.angle(z)))/(2*Pi). freq[0] is equal to freq[1].
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] data: input complex array, analytic signal. An element with index i is at
+ *                  data[i*2 + 0] (re) and data[i*2 + 1] (im)
+ * @param env: output envelope. Could be NULL
+ * @param phase: output instantaneous phase, -Pi..Pi. Could be NULL
+ * @param freq: output instantaneous frequency, -0.5..0.5 of the sample frequency. Could be NULL
+ * @param len: amount of complex elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_analytic_env_f32(const float *data, float *env, float *phase, float *freq, int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_hilbert_H_
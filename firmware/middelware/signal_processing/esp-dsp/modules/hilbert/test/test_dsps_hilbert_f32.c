@@ -0,0 +1,173 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_hilbert.h"
+#include "dsps_fir.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_hilbert";
+
+#define HB_N_GOLDEN     64
+#define HB_TAPS         63
+// Equivalent FIR filter: one zero tap before the Hilbert taps, a multiple of 4 as dsps_fir_f32 requires on ESP32-S3
+#define FIR_TAPS        (HB_TAPS + 1)
+#define HB_LEN          1024
+
+// scipy.signal.hilbert(x), x[n] = (1 + 0.5*cos(2*pi*0.03*n))*sin(2*pi*0.125*n + 0.3) + 0.2*cos(2*pi*0.3*n)
+static const float hilbert_golden_im[HB_N_GOLDEN] = {
+    -1.279641f, -0.477323f, 0.359858f, 1.155906f, 1.518348f, 0.614087f, -0.532119f, -0.869277f,
+    -0.855585f, -0.621625f, 0.259326f, 0.866369f, 0.540884f, 0.173102f, 0.030357f, -0.460730f,
+    -0.666560f, -0.113580f, 0.274149f, 0.296258f, 0.572326f, 0.498809f, -0.331134f, -0.837880f,
+    -0.673441f, -0.465527f, 0.134632f, 1.165571f, 1.329968f, 0.436469f, -0.414419f, -1.094292f,
+    -1.535387f, -0.817081f, 0.632024f, 1.304658f, 1.182931f, 0.763136f, -0.273419f, -1.288792f,
+    -1.104731f, -0.306959f, 0.166342f, 0.655213f, 0.939213f, 0.327293f, -0.381662f, -0.396158f,
+    -0.398095f, -0.430818f, 0.142366f, 0.636387f, 0.387075f, 0.147211f, -0.005723f, -0.630666f,
+    -0.952441f, -0.299105f, 0.390264f, 0.737985f, 1.083717f, 0.748545f, -0.539423f, -1.417180f
+};
+
+static const float hilbert_golden_env[HB_N_GOLDEN] = {
+    1.432233f, 1.344668f, 1.288912f, 1.420312f, 1.556263f, 1.478041f, 1.219168f, 0.941938f,
+    0.867452f, 0.987473f, 1.040561f, 0.914372f, 0.651479f, 0.419327f, 0.475918f, 0.640334f,
+    0.699077f, 0.615491f, 0.429690f, 0.353950f, 0.572830f, 0.814232f, 0.922660f, 0.865998f,
+    0.749789f, 0.827793f, 1.114805f, 1.367002f, 1.434101f, 1.323095f, 1.214661f, 1.320701f,
+    1.560144f, 1.697283f, 1.619463f, 1.393086f, 1.237433f, 1.308925f, 1.447672f, 1.439285f,
+    1.230165f, 0.930219f, 0.781449f, 0.868678f, 0.954617f, 0.887127f, 0.665619f, 0.410561f,
+    0.398112f, 0.579967f, 0.692461f, 0.660172f, 0.502184f, 0.379041f, 0.545358f, 0.823437f,
+    0.996906f, 0.982925f, 0.857496f, 0.856138f, 1.092874f, 1.380001f, 1.520517f, 1.497712f
+};
+
+static float x[HB_LEN];
+static float z[HB_LEN * 2];
+static float z_fft[HB_LEN * 2];
+static float env[HB_LEN];
+static float freq[HB_LEN];
+static float hb_coeffs[(HB_TAPS + 1) / 4];
+static float hb_delay[HB_TAPS * 2];
+__attribute__((aligned(16)))
+static float fir_coeffs[FIR_TAPS];
+__attribute__((aligned(16)))
+static float fir_delay[FIR_TAPS + 4];
+
+TEST_CASE("dsps_analytic_f32 scipy", "[dsps]")
+{
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    for (int n = 0; n < HB_N_GOLDEN; n++) {
+        z[n] = (1 + 0.5 * cos(2 * M_PI * 0.03 * n)) * sin(2 * M_PI * 0.125 * n + 0.3) + 0.2 * cos(2 * M_PI * 0.3 * n);
+        x[n] = z[n];
+    }
+    TEST_ESP_OK(dsps_analytic_f32(z, HB_N_GOLDEN));
+    TEST_ESP_OK(dsps_analytic_env_f32(z, env, NULL, NULL, HB_N_GOLDEN));
+    float err = 0;
+    for (int n = 0; n < HB_N_GOLDEN; n++) {
+        err = fmaxf(err, fabsf(z[n * 2 + 0] - x[n]));
+        err = fmaxf(err, fabsf(z[n * 2 + 1] - hilbert_golden_im[n]));
+        err = fmaxf(err, fabsf(env[n] - hilbert_golden_env[n]));
+    }
+    ESP_LOGI(TAG, "analytic signal: maximum error to scipy %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6 * err));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_analytic_f32(z, 48));
+    dsps_fft2r_deinit_fc32();
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_analytic_f32(z, HB_N_GOLDEN));
+}
+
+TEST_CASE("dsps_hilbert_f32 functionality", "[dsps]")
+{
+    hilbert_f32_t hb;
+    const int delay = (HB_TAPS - 1) / 2;
+    // AM signal: carrier 104/HB_LEN, modulation 5/HB_LEN of the sample frequency, periodic in the block for the FFT
+    const float f_c = 104.0f / HB_LEN;
+    const float f_m = 5.0f / HB_LEN;
+    for (int n = 0; n < HB_LEN; n++) {
+        x[n] = (1 + 0.5f * cosf(2 * M_PI * f_m * n)) * cosf(2 * M_PI * f_c * n);
+    }
+    TEST_ESP_OK(dsps_hilbert_init_f32(&hb, hb_coeffs, hb_delay, HB_TAPS));
+    // Two calls are equal to one
+    TEST_ESP_OK(dsps_hilbert_f32(&hb, x, z, 100));
+    TEST_ESP_OK(dsps_hilbert_f32(&hb, &x[100], &z[200], HB_LEN - 100));
+
+    // FIR result is the FFT result delayed, except the ends of the block
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    memcpy(z_fft, x, sizeof(x));
+    TEST_ESP_OK(dsps_analytic_f32(z_fft, HB_LEN));
+    dsps_fft2r_deinit_fc32();
+    float err = 0;
+    for (int n = 2 * HB_TAPS; n < HB_LEN - HB_TAPS; n++) {
+        err = fmaxf(err, fabsf(z[n * 2 + 0] - z_fft[(n - delay) * 2 + 0]));
+        err = fmaxf(err, fabsf(z[n * 2 + 1] - z_fft[(n - delay) * 2 + 1]));
+    }
+    ESP_LOGI(TAG, "FIR to FFT analytic signal: maximum error %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(200, (int)(1e6 * err));
+
+    // Envelope and frequency of the AM signal
+    TEST_ESP_OK(dsps_hilbert_init_f32(&hb, hb_coeffs, hb_delay, HB_TAPS));
+    TEST_ESP_OK(dsps_hilbert_env_f32(&hb, x, env, NULL, freq, HB_LEN));
+    float err_env = 0;
+    float err_freq = 0;
+    for (int n = 2 * HB_TAPS; n < HB_LEN; n++) {
+        err_env = fmaxf(err_env, fabsf(env[n] - (1 + 0.5f * cosf(2 * M_PI * f_m * (n - delay)))));
+        err_freq = fmaxf(err_freq, fabsf(freq[n] - f_c));
+    }
+    ESP_LOGI(TAG, "AM envelope: maximum error %e, frequency: maximum error %e", err_env, err_freq);
+    TEST_ASSERT_LESS_OR_EQUAL(200, (int)(1e6 * err_env));
+    TEST_ASSERT_LESS_OR_EQUAL(100, (int)(1e6 * err_freq));
+
+    // Equal to FIR filter with all taps
+    memset(fir_coeffs, 0, sizeof(fir_coeffs));
+    for (int i = 0; i < hb.n_coeffs; i++) {
+        int k = 2 * i + 1;
+        // dsps_fir_f32 multiplies the first coefficient by the oldest sample
+        fir_coeffs[1 + delay - k] = hb_coeffs[i];
+        fir_coeffs[1 + delay + k] = -hb_coeffs[i];
+    }
+    fir_f32_t fir;
+    TEST_ESP_OK(dsps_fir_init_f32(&fir, fir_coeffs, fir_delay, FIR_TAPS));
+    dsps_fir_f32(&fir, x, freq, HB_LEN);
+    err = 0;
+    for (int n = 0; n < HB_LEN; n++) {
+        err = fmaxf(err, fabsf(freq[n] - z[n * 2 + 1]));
+    }
+    ESP_LOGI(TAG, "FIR with all taps: maximum difference %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6 * err));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_hilbert_init_f32(&hb, hb_coeffs, hb_delay, 62));
+}
+
+TEST_CASE("dsps_hilbert_f32 benchmark", "[dsps]")
+{
+    hilbert_f32_t hb;
+    fir_f32_t fir;
+    memset(fir_coeffs, 0, sizeof(fir_coeffs));
+    TEST_ESP_OK(dsps_hilbert_init_f32(&hb, hb_coeffs, hb_delay, HB_TAPS));
+    TEST_ESP_OK(dsps_fir_init_f32(&fir, fir_coeffs, fir_delay, FIR_TAPS));
+
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_hilbert_f32(&hb, x, z, HB_LEN);
+    unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_fir_f32(&fir, x, freq, HB_LEN);
+    unsigned int cycles_fir = dsp_get_cpu_cycle_count() - start_b;
+
+    ESP_LOGI(TAG, "%i taps: %.1f cycles per sample, dsps_fir_f32 with %i taps %.1f", HB_TAPS, (float)cycles / HB_LEN,
+             FIR_TAPS, (float)cycles_fir / HB_LEN);
+    TEST_ASSERT_EXEC_IN_RANGE(HB_LEN, HB_LEN * HB_TAPS * 2, cycles);
+}
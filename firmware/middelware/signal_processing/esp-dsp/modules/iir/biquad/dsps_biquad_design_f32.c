@@ -0,0 +1,505 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad_design.h"
+#include <string.h>
+#include <math.h>
+
+#define DESIGN_MAX_ROOTS    (2 * DSPS_BIQUAD_DESIGN_MAX_ORDER)
+
+// Complex arithmetic in double precision, the design is not time critical
+typedef struct design_cplx_s {
+    double re;
+    double im;
+} design_cplx_t;
+
+static design_cplx_t cplx(double re, double im)
+{
+    design_cplx_t r = {re, im};
+    return r;
+}
+
+static design_cplx_t cplx_add(design_cplx_t a, design_cplx_t b)
+{
+    return cplx(a.re + b.re, a.im + b.im);
+}
+
+static design_cplx_t cplx_sub(design_cplx_t a, design_cplx_t b)
+{
+    return cplx(a.re - b.re, a.im - b.im);
+}
+
+static design_cplx_t cplx_mul(design_cplx_t a, design_cplx_t b)
+{
+    return cplx(a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re);
+}
+
+static design_cplx_t cplx_div(design_cplx_t a, design_cplx_t b)
+{
+    double d = b.re * b.re + b.im * b.im;
+    return cplx((a.re * b.re + a.im * b.im) / d, (a.im * b.re - a.re * b.im) / d);
+}
+
+static design_cplx_t cplx_scale(design_cplx_t a, double s)
+{
+    return cplx(a.re * s, a.im * s);
+}
+
+static double cplx_abs(design_cplx_t a)
+{
+    return hypot(a.re, a.im);
+}
+
+static design_cplx_t cplx_sqrt(design_cplx_t a)
+{
+    double m = cplx_abs(a);
+    double re = sqrt(0.5 * (m + a.re));
+    double im = sqrt(0.5 * (m - a.re));
+    return cplx(re, (a.im < 0) ? -im : im);
+}
+
+// Zeros, poles and gain of a filter
+typedef struct design_zpk_s {
+    design_cplx_t z[DESIGN_MAX_ROOTS];
+    design_cplx_t p[DESIGN_MAX_ROOTS];
+    int nz;
+    int np;
+    double k;
+} design_zpk_t;
+
+// Roots of the reverse Bessel polynomial, scaled to the phase normalization:
+// theta(s) = sum(a[i]*s^i), a[i] = (2N - i)!/(2^(N - i)*i!*(N - i)!), roots are divided by a[0]^(1/N)
+static void design_bessel_poles(design_cplx_t *p, int n)
+{
+    double a[DSPS_BIQUAD_DESIGN_MAX_ORDER + 1];
+    // a[N] = 1, a[i - 1] = a[i]*(2N - i + 1)*i/(2*(N - i + 1))
+    a[n] = 1;
+    for (int i = n; i > 0; i--) {
+        a[i - 1] = a[i] * (2 * n - i + 1) * i / (2.0 * (n - i + 1));
+    }
+    double c = pow(a[0], 1.0 / n);
+    // Monic polynomial of x = s/c
+    double q[DSPS_BIQUAD_DESIGN_MAX_ORDER + 1];
+    for (int i = 0; i <= n; i++) {
+        q[i] = a[i] * pow(c, i - n);
+    }
+    // Durand-Kerner iterations
+    design_cplx_t seed = cplx(0.4, 0.9);
+    design_cplx_t r = cplx(1, 0);
+    for (int i = 0; i < n; i++) {
+        p[i] = r;
+        r = cplx_mul(r, seed);
+    }
+    for (int iter = 0; iter < 200; iter++) {
+        double delta = 0;
+        for (int i = 0; i < n; i++) {
+            design_cplx_t num = cplx(q[n], 0);
+            for (int j = n - 1; j >= 0; j--) {
+                num = cplx_add(cplx_mul(num, p[i]), cplx(q[j], 0));
+            }
+            design_cplx_t den = cplx(1, 0);
+            for (int j = 0; j < n; j++) {
+                if (j != i) {
+                    den = cplx_mul(den, cplx_sub(p[i], p[j]));
+                }
+            }
+            design_cplx_t d = cplx_div(num, den);
+            p[i] = cplx_sub(p[i], d);
+            delta += cplx_abs(d);
+        }
+        // Float coefficients do not need more precision, the rounding floor is about 1e-12
+        if (delta < 1e-10) {
+            break;
+        }
+    }
+}
+
+// Analog low pass prototype with cutoff 1 rad/s
+static void design_prototype(design_zpk_t *f, dsps_biquad_proto_t proto, int n, double ripple)
+{
+    f->nz = 0;
+    f->np = n;
+    f->k = 1;
+    switch (proto) {
+    case DSPS_BIQUAD_BUTTER:
+        for (int i = 0; i < n; i++) {
+            double theta = M_PI * (-n + 1 + 2 * i) / (2 * n);
+            f->p[i] = cplx(-cos(theta), -sin(theta));
+        }
+        break;
+    case DSPS_BIQUAD_CHEBY1: {
+        double eps = sqrt(pow(10, 0.1 * ripple) - 1);
+        double mu = asinh(1 / eps) / n;
+        design_cplx_t prod = cplx(1, 0);
+        for (int i = 0; i < n; i++) {
+            double theta = M_PI * (-n + 1 + 2 * i) / (2 * n);
+            f->p[i] = cplx(-sinh(mu) * cos(theta), -cosh(mu) * sin(theta));
+            prod = cplx_mul(prod, cplx_scale(f->p[i], -1));
+        }
+        f->k = prod.re;
+        if ((n % 2) == 0) {
+            f->k /= sqrt(1 + eps * eps);
+        }
+        break;
+    }
+    case DSPS_BIQUAD_CHEBY2: {
+        double de = 1 / sqrt(pow(10, 0.1 * ripple) - 1);
+        double mu = asinh(1 / de) / n;
+        design_cplx_t prod = cplx(1, 0);
+        for (int i = 0; i < n; i++) {
+            int m = -n + 1 + 2 * i;
+            double theta = M_PI * m / (2 * n);
+            design_cplx_t base = cplx(sinh(mu) * -cos(theta), cosh(mu) * -sin(theta));
+            f->p[i] = cplx_div(cplx(1, 0), base);
+            prod = cplx_mul(prod, cplx_scale(f->p[i], -1));
+            // Zero at infinity for the middle pole of odd order
+            if (m != 0) {
+                f->z[f->nz] = cplx(0, 1 / sin(theta));
+                prod = cplx_div(prod, cplx_scale(f->z[f->nz], -1));
+                f->nz++;
+            }
+        }
+        f->k = prod.re;
+        break;
+    }
+    case DSPS_BIQUAD_BESSEL:
+        design_bessel_poles(f->p, n);
+        break;
+    }
+}
+
+// Frequency transformation of the prototype, as scipy.signal.lp2xx_zpk
+static void design_transform(design_zpk_t *f, dsps_biquad_band_t band, double wo, double bw)
+{
+    int degree = f->np - f->nz;
+    design_cplx_t prod = cplx(1, 0);
+    design_cplx_t wo2 = cplx(wo * wo, 0);
+    switch (band) {
+    case DSPS_BIQUAD_LPF:
+        for (int i = 0; i < f->nz; i++) {
+            f->z[i] = cplx_scale(f->z[i], wo);
+        }
+        for (int i = 0; i < f->np; i++) {
+            f->p[i] = cplx_scale(f->p[i], wo);
+        }
+        f->k *= pow(wo, degree);
+        break;
+    case DSPS_BIQUAD_HPF:
+        for (int i = 0; i < f->nz; i++) {
+            prod = cplx_div(prod, cplx_scale(f->z[i], -1));
+            f->z[i] = cplx_div(cplx(wo, 0), f->z[i]);
+        }
+        for (int i = 0; i < f->np; i++) {
+            prod = cplx_mul(prod, cplx_scale(f->p[i], -1));
+            f->p[i] = cplx_div(cplx(wo, 0), f->p[i]);
+        }
+        // prod(-z)/prod(-p) of the prototype
+        f->k *= 1 / prod.re;
+        for (int i = 0; i < degree; i++) {
+            f->z[f->nz++] = cplx(0, 0);
+        }
+        break;
+    case DSPS_BIQUAD_BPF:
+    case DSPS_BIQUAD_BSF: {
+        design_cplx_t *roots[2] = {f->z, f->p};
+        int *count[2] = {&f->nz, &f->np};
+        for (int r = 0; r < 2; r++) {
+            int n = *count[r];
+            for (int i = 0; i < n; i++) {
+                design_cplx_t x;
+                if (band == DSPS_BIQUAD_BPF) {
+                    x = cplx_scale(roots[r][i], bw / 2);
+                } else {
+                    prod = (r == 0) ? cplx_div(prod, cplx_scale(roots[r][i], -1)) : cplx_mul(prod, cplx_scale(roots[r][i], -1));
+                    x = cplx_div(cplx(bw / 2, 0), roots[r][i]);
+                }
+                design_cplx_t s = cplx_sqrt(cplx_sub(cplx_mul(x, x), wo2));
+                roots[r][i] = cplx_add(x, s);
+                roots[r][n + i] = cplx_sub(x, s);
+            }
+            *count[r] = 2 * n;
+        }
+        if (band == DSPS_BIQUAD_BPF) {
+            for (int i = 0; i < degree; i++) {
+                f->z[f->nz++] = cplx(0, 0);
+            }
+            f->k *= pow(bw, degree);
+        } else {
+            for (int i = 0; i < degree; i++) {
+                f->z[f->nz++] = cplx(0, wo);
+                f->z[f->nz++] = cplx(0, -wo);
+            }
+            f->k *= 1 / prod.re;
+        }
+        break;
+    }
+    }
+}
+
+// Bilinear transform with sample frequency 1, as scipy.signal.bilinear_zpk(fs = 1)
+static void design_bilinear(design_zpk_t *f)
+{
+    const design_cplx_t fs2 = cplx(2, 0);
+    design_cplx_t prod = cplx(1, 0);
+    for (int i = 0; i < f->nz; i++) {
+        prod = cplx_mul(prod, cplx_sub(fs2, f->z[i]));
+        f->z[i] = cplx_div(cplx_add(fs2, f->z[i]), cplx_sub(fs2, f->z[i]));
+    }
+    for (int i = 0; i < f->np; i++) {
+        prod = cplx_div(prod, cplx_sub(fs2, f->p[i]));
+        f->p[i] = cplx_div(cplx_add(fs2, f->p[i]), cplx_sub(fs2, f->p[i]));
+    }
+    while (f->nz < f->np) {
+        f->z[f->nz++] = cplx(-1, 0);
+    }
+    f->k *= prod.re;
+}
+
+// Split roots to complex roots with positive imaginary part (one of the conjugate pair) and real roots
+static int design_split(const design_cplx_t *roots, int n, design_cplx_t *out, int *is_real)
+{
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        double tol = 1e-9 * (1 + cplx_abs(roots[i]));
+        if (fabs(roots[i].im) <= tol) {
+            out[m] = cplx(roots[i].re, 0);
+            is_real[m++] = 1;
+        } else if (roots[i].im > 0) {
+            out[m] = roots[i];
+            is_real[m++] = 0;
+        }
+    }
+    return m;
+}
+
+// Take the unused root nearest to x. If real_only is set, only real roots are considered.
+static int design_nearest(const design_cplx_t *roots, const int *is_real, int *used, int n, design_cplx_t x, int real_only)
+{
+    int best = -1;
+    double best_d = 0;
+    for (int i = 0; i < n; i++) {
+        if (used[i] || (real_only && !is_real[i])) {
+            continue;
+        }
+        double d = cplx_abs(cplx_sub(roots[i], x));
+        if ((best < 0) || (d < best_d)) {
+            best = i;
+            best_d = d;
+        }
+    }
+    if (best >= 0) {
+        used[best] = 1;
+    }
+    return best;
+}
+
+// Second order polynomial 1 + c1*z^-1 + c2*z^-2 of one complex root (with conjugate) or up to two real roots
+static void design_poly(const design_cplx_t *roots, const int *is_real, int a, int b, float *c1, float *c2)
+{
+    double r1 = 0;
+    double r2 = 0;
+    if ((a >= 0) && !is_real[a]) {
+        r1 = -2 * roots[a].re;
+        r2 = roots[a].re * roots[a].re + roots[a].im * roots[a].im;
+    } else if ((a >= 0) && (b >= 0)) {
+        r1 = -(roots[a].re + roots[b].re);
+        r2 = roots[a].re * roots[b].re;
+    } else if (a >= 0) {
+        r1 = -roots[a].re;
+    }
+    *c1 = r1;
+    *c2 = r2;
+}
+
+// Magnitude of the section at frequency w
+static double design_section_gain(const float *c, double w)
+{
+    design_cplx_t z1 = cplx(cos(w), -sin(w));
+    design_cplx_t z2 = cplx_mul(z1, z1);
+    design_cplx_t num = cplx_add(cplx_add(cplx(c[0], 0), cplx_scale(z1, c[1])), cplx_scale(z2, c[2]));
+    design_cplx_t den = cplx_add(cplx_add(cplx(1, 0), cplx_scale(z1, c[3])), cplx_scale(z2, c[4]));
+    return cplx_abs(num) / cplx_abs(den);
+}
+
+// Pair poles with the nearest zeros, as scipy.signal.zpk2sos(pairing='nearest'):
+// the section with poles closest to the unit circle is the last one
+static int design_sos(const design_zpk_t *f, float *coeffs, double w_ref)
+{
+    design_cplx_t p[DESIGN_MAX_ROOTS], z[DESIGN_MAX_ROOTS];
+    int p_real[DESIGN_MAX_ROOTS], z_real[DESIGN_MAX_ROOTS];
+    int p_used[DESIGN_MAX_ROOTS] = {0}, z_used[DESIGN_MAX_ROOTS] = {0};
+    int np = design_split(f->p, f->np, p, p_real);
+    int nz = design_split(f->z, f->nz, z, z_real);
+    float sect[5 * DSPS_BIQUAD_DESIGN_MAX_SECT];
+    int n_sect = 0;
+
+    for (;;) {
+        // Pole closest to the unit circle
+        int p1 = -1;
+        for (int i = 0; i < np; i++) {
+            if (!p_used[i] && ((p1 < 0) || (cplx_abs(p[i]) > cplx_abs(p[p1])))) {
+                p1 = i;
+            }
+        }
+        int z_left = 0;
+        for (int i = 0; i < nz; i++) {
+            z_left += !z_used[i];
+        }
+        if ((p1 < 0) && (z_left == 0)) {
+            break;
+        }
+        if (n_sect >= DSPS_BIQUAD_DESIGN_MAX_SECT) {
+            return -1;
+        }
+        int p2 = -1;
+        int need = 0;
+        design_cplx_t ref = cplx(1, 0);
+        if (p1 >= 0) {
+            p_used[p1] = 1;
+            ref = p[p1];
+            need = 2;
+            if (p_real[p1]) {
+                p2 = design_nearest(p, p_real, p_used, np, p[p1], 1);
+                need = (p2 >= 0) ? 2 : 1;
+            }
+        }
+        int z1 = design_nearest(z, z_real, z_used, nz, ref, need == 1);
+        if (z1 < 0) {
+            z1 = design_nearest(z, z_real, z_used, nz, ref, 0);
+        }
+        int z2 = -1;
+        if ((z1 >= 0) && z_real[z1] && (need != 1)) {
+            z2 = design_nearest(z, z_real, z_used, nz, ref, 1);
+        }
+        float *c = &sect[n_sect * 5];
+        c[0] = 1;
+        design_poly(z, z_real, z1, z2, &c[1], &c[2]);
+        design_poly(p, p_real, p1, p2, &c[3], &c[4]);
+        n_sect++;
+    }
+
+    // Reverse order and normalize the gain of every section at the reference frequency
+    double gain = f->k;
+    for (int s = 0; s < n_sect; s++) {
+        float *c = &coeffs[s * 5];
+        memcpy(c, &sect[(n_sect - 1 - s) * 5], 5 * sizeof(float));
+        double g = design_section_gain(c, w_ref);
+        gain *= g;
+        for (int i = 0; i < 3; i++) {
+            c[i] /= g;
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        coeffs[i] *= gain;
+    }
+    return n_sect;
+}
+
+esp_err_t dsps_biquad_design_f32(float *coeffs, int *n_sect, dsps_biquad_proto_t proto, dsps_biquad_band_t band,
+                                 int order, float f1, float f2, float ripple)
+{
+    if ((coeffs == NULL) || (n_sect == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((order <= 0) || (order > DSPS_BIQUAD_DESIGN_MAX_ORDER)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((proto < DSPS_BIQUAD_BUTTER) || (proto > DSPS_BIQUAD_BESSEL) || (band < DSPS_BIQUAD_LPF) || (band > DSPS_BIQUAD_BSF)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    int two_edges = (band == DSPS_BIQUAD_BPF) || (band == DSPS_BIQUAD_BSF);
+    if ((f1 <= 0) || (f1 >= 0.5f) || (two_edges && ((f2 <= f1) || (f2 >= 0.5f)))) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (((proto == DSPS_BIQUAD_CHEBY1) || (proto == DSPS_BIQUAD_CHEBY2)) && (ripple <= 0)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    design_zpk_t f;
+    design_prototype(&f, proto, order, ripple);
+
+    // Prewarping of the edge frequencies
+    double w1 = 2 * tan(M_PI * f1);
+    double wo = w1;
+    double bw = 0;
+    double w_ref = (band == DSPS_BIQUAD_HPF) ? M_PI : 0;
+    if (two_edges) {
+        double w2 = 2 * tan(M_PI * f2);
+        wo = sqrt(w1 * w2);
+        bw = w2 - w1;
+        if (band == DSPS_BIQUAD_BPF) {
+            w_ref = 2 * atan(wo / 2);
+        }
+    }
+    design_transform(&f, band, wo, bw);
+    design_bilinear(&f);
+
+    int n = design_sos(&f, coeffs, w_ref);
+    if (n < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    *n_sect = n;
+    return ESP_OK;
+}
+
+esp_err_t dsps_biquad_design_cached_f32(biquad_design_cache_t *cache, const float **coeffs, int *n_sect, dsps_biquad_proto_t proto,
+                                        dsps_biquad_band_t band, int order, float f1, float f2, float ripple)
+{
+    if ((cache == NULL) || (coeffs == NULL) || (n_sect == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    // Parameters which are not used by the design do not split the cache
+    if ((band == DSPS_BIQUAD_LPF) || (band == DSPS_BIQUAD_HPF)) {
+        f2 = 0;
+    }
+    if ((proto == DSPS_BIQUAD_BUTTER) || (proto == DSPS_BIQUAD_BESSEL)) {
+        ripple = 0;
+    }
+    cache->time++;
+    biquad_design_entry_t *lru = &cache->entry[0];
+    for (int i = 0; i < DSPS_BIQUAD_DESIGN_CACHE_SIZE; i++) {
+        biquad_design_entry_t *e = &cache->entry[i];
+        if ((e->n_sect > 0) && (e->proto == proto) && (e->band == band) && (e->order == order) &&
+                (e->f1 == f1) && (e->f2 == f2) && (e->ripple == ripple)) {
+            e->used = cache->time;
+            cache->hits++;
+            *coeffs = e->coeffs;
+            *n_sect = e->n_sect;
+            return ESP_OK;
+        }
+        if ((e->n_sect == 0) || ((lru->n_sect != 0) && (e->used < lru->used))) {
+            lru = e;
+        }
+    }
+    cache->misses++;
+    // Designed into a scratch buffer first, so an invalid request does not drop a stored design
+    float sect[5 * DSPS_BIQUAD_DESIGN_MAX_SECT];
+    int n = 0;
+    esp_err_t ret = dsps_biquad_design_f32(sect, &n, proto, band, order, f1, f2, ripple);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    memcpy(lru->coeffs, sect, 5 * n * sizeof(float));
+    lru->proto = proto;
+    lru->band = band;
+    lru->order = order;
+    lru->f1 = f1;
+    lru->f2 = f2;
+    lru->ripple = ripple;
+    lru->n_sect = n;
+    lru->used = cache->time;
+    *coeffs = lru->coeffs;
+    *n_sect = n;
+    return ESP_OK;
+}
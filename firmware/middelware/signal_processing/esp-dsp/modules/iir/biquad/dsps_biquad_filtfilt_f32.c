@@ -0,0 +1,91 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+#include <math.h>
+
+// Reverse array in place
+static void dsps_biquad_reverse_f32(float *data, int len)
+{
+    for (int i = 0, j = len - 1; i < j; i++, j--) {
+        float tmp = data[i];
+        data[i] = data[j];
+        data[j] = tmp;
+    }
+}
+
+// Set the delay lines of all sections to the steady state of a constant input x0.
+// For the direct form II section the steady state is w0 = w1 = x / (1 + a1 + a2),
+// the output of the section becomes the constant input of the next one.
+static void dsps_biquad_steady_state_f32(const float *coef, float *w, int n_sect, float x0)
+{
+    float x = x0;
+    for (int s = 0; s < n_sect; s++) {
+        const float *c = &coef[s * 5];
+        float den = 1 + c[3] + c[4];
+        float st = 0;
+        if (fabsf(den) > 1e-12f) {
+            st = x / den;
+        }
+        w[s * 2 + 0] = st;
+        w[s * 2 + 1] = st;
+        x = (c[0] + c[1] + c[2]) * st;
+    }
+}
+
+// Filter [pre, data, post] by the whole cascade, section by section, in place
+static void dsps_biquad_cascade_f32(float *pre, float *data, float *post, int len, int pad_len, float *coef, float *w, int n_sect)
+{
+    for (int s = 0; s < n_sect; s++) {
+        dsps_biquad_f32(pre, pre, pad_len, &coef[s * 5], &w[s * 2]);
+        dsps_biquad_f32(data, data, len, &coef[s * 5], &w[s * 2]);
+        dsps_biquad_f32(post, post, pad_len, &coef[s * 5], &w[s * 2]);
+    }
+}
+
+esp_err_t dsps_biquad_filtfilt_f32(float *data, int len, float *coef, float *w, int n_sect, float *pad_buff, int pad_len)
+{
+    if ((len <= 0) || (n_sect <= 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((pad_len < 0) || (pad_len >= len)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((pad_len > 0) && (pad_buff == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    float *left = pad_buff;
+    float *right = pad_buff + pad_len;
+
+    // Odd (reflected) extension of the signal on both edges
+    for (int i = 0; i < pad_len; i++) {
+        left[i] = 2 * data[0] - data[pad_len - i];
+        right[i] = 2 * data[len - 1] - data[len - 2 - i];
+    }
+
+    // Forward pass, starting from the steady state of the first extended sample
+    dsps_biquad_steady_state_f32(coef, w, n_sect, (pad_len > 0) ? left[0] : data[0]);
+    dsps_biquad_cascade_f32(left, data, right, len, pad_len, coef, w, n_sect);
+
+    // Backward pass: reverse the extended signal, so the right pad is processed first
+    dsps_biquad_reverse_f32(left, pad_len);
+    dsps_biquad_reverse_f32(data, len);
+    dsps_biquad_reverse_f32(right, pad_len);
+
+    dsps_biquad_steady_state_f32(coef, w, n_sect, (pad_len > 0) ? right[0] : data[0]);
+    dsps_biquad_cascade_f32(right, data, left, len, pad_len, coef, w, n_sect);
+
+    dsps_biquad_reverse_f32(data, len);
+    return ESP_OK;
+}
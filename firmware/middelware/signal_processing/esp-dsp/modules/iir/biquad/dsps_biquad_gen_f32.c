@@ -152,6 +152,20 @@ esp_err_t dsps_biquad_gen_notch_f32(float *coeffs, float f, float gain, float qF
     return ESP_OK;
 }
 
+esp_err_t dsps_biquad_gen_notch_bank_f32(float *coeffs, float f, int n_notch, float gain, float qFactor)
+{
+    if (n_notch <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((f <= 0) || (f * n_notch >= 0.5f)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    for (int k = 1; k <= n_notch; k++) {
+        dsps_biquad_gen_notch_f32(&coeffs[(k - 1) * 5], f * k, gain, qFactor * k);
+    }
+    return ESP_OK;
+}
+
 esp_err_t dsps_biquad_gen_allpass360_f32(float *coeffs, float f, float qFactor)
 {
     if (qFactor <= 0.0001) {
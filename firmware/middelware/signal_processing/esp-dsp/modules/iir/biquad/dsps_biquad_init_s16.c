@@ -0,0 +1,51 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+#include <math.h>
+
+esp_err_t dsps_biquad_quant_s16(const float *coef, int16_t *coef_out, int n_sect, int16_t shift)
+{
+    if ((shift < 1) || (shift > 15)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    float scale = (float)(1 << shift);
+    for (int i = 0; i < n_sect * 5; i++) {
+        float val = roundf(coef[i] * scale);
+        if ((val > INT16_MAX) || (val < INT16_MIN)) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        coef_out[i] = (int16_t)val;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_biquad_init_s16(biquad_s16_t *bq, int16_t *coeffs, int16_t *delay, int n_sect, int16_t shift, int16_t noise_shaping)
+{
+    if (n_sect <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((shift < 1) || (shift > 15)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    bq->coeffs = coeffs;
+    bq->delay = delay;
+    bq->n_sect = n_sect;
+    bq->shift = shift;
+    bq->noise_shaping = noise_shaping;
+    for (int i = 0; i < n_sect * 5; i++) {
+        bq->delay[i] = 0;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,51 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+#include <math.h>
+
+esp_err_t dsps_biquad_quant_s32(const float *coef, int32_t *coef_out, int n_sect, int16_t shift)
+{
+    if ((shift < 1) || (shift > 30)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    double scale = (double)(1 << shift);
+    for (int i = 0; i < n_sect * 5; i++) {
+        double val = round((double)coef[i] * scale);
+        if ((val > INT32_MAX) || (val < INT32_MIN)) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        coef_out[i] = (int32_t)val;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_biquad_init_s32(biquad_s32_t *bq, int32_t *coeffs, int32_t *delay, int n_sect, int16_t shift, int16_t noise_shaping)
+{
+    if (n_sect <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((shift < 1) || (shift > 30)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    bq->coeffs = coeffs;
+    bq->delay = delay;
+    bq->n_sect = n_sect;
+    bq->shift = shift;
+    bq->noise_shaping = noise_shaping;
+    for (int i = 0; i < n_sect * 5; i++) {
+        bq->delay[i] = 0;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,51 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+
+esp_err_t dsps_biquad_s32_ansi(biquad_s32_t *bq, const int32_t *input, int32_t *output, int len)
+{
+    const int shift = bq->shift;
+    const int64_t rounding = bq->noise_shaping ? 0 : ((int64_t)1 << (shift - 1));
+    const int64_t err_mask = ((int64_t)1 << shift) - 1;
+    for (int i = 0 ; i < len ; i++) {
+        int32_t x = input[i];
+        for (int s = 0 ; s < bq->n_sect ; s++) {
+            const int32_t *c = &bq->coeffs[s * 5];
+            int32_t *d = &bq->delay[s * 5];
+            // Direct form I: d[0..1] - previous inputs, d[2..3] - previous outputs, d[4] - truncation error
+            int64_t acc = (int64_t)c[0] * x + (int64_t)c[1] * d[0] + (int64_t)c[2] * d[1]
+                          - (int64_t)c[3] * d[2] - (int64_t)c[4] * d[3];
+            if (bq->noise_shaping) {
+                acc += d[4];
+            } else {
+                acc += rounding;
+            }
+            int64_t y = acc >> shift;
+            d[4] = (int32_t)(acc & err_mask);
+            if (y > INT32_MAX) {
+                y = INT32_MAX;
+            } else if (y < INT32_MIN) {
+                y = INT32_MIN;
+            }
+            d[1] = d[0];
+            d[0] = x;
+            d[3] = d[2];
+            d[2] = (int32_t)y;
+            x = (int32_t)y;
+        }
+        output[i] = x;
+    }
+    return ESP_OK;
+}
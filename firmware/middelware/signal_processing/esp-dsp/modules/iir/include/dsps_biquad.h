@@ -25,6 +25,36 @@ extern "C"
 {
 #endif
 
+/**
+ * @brief Data struct of s16 bi quad cascade
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_biquad_init_s16(...) function.
+ */
+typedef struct biquad_s16_s {
+    int16_t *coeffs;        /*!< Pointer to the coefficients. n_sect sections of b0,b1,b2,a1,a2 with shift fractional bits.*/
+    int16_t *delay;         /*!< Pointer to the delay lines. n_sect sections of x1,x2,y1,y2,err.*/
+    int      n_sect;        /*!< Amount of bi quad sections.*/
+    int16_t  shift;         /*!< Amount of fractional bits of the coefficients.*/
+    int16_t  noise_shaping; /*!< Feed the truncation error back to the next sample (1) or round (0).*/
+} biquad_s16_t;
+
+/**
+ * @brief Data struct of s32 bi quad cascade
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_biquad_init_s32(...) function.
+ */
+typedef struct biquad_s32_s {
+    int32_t *coeffs;        /*!< Pointer to the coefficients. n_sect sections of b0,b1,b2,a1,a2 with shift fractional bits.*/
+    int32_t *delay;         /*!< Pointer to the delay lines. n_sect sections of x1,x2,y1,y2,err.*/
+    int      n_sect;        /*!< Amount of bi quad sections.*/
+    int16_t  shift;         /*!< Amount of fractional bits of the coefficients.*/
+    int16_t  noise_shaping; /*!< Feed the truncation error back to the next sample (1) or round (0).*/
+} biquad_s32_t;
+
 /**@{*/
 /**
  * @brief   IIR filter
@@ -48,6 +78,124 @@ esp_err_t dsps_biquad_f32_ae32(const float *input, float *output, int len, float
 esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float *coef, float *w);
 /**@}*/
 
+/**
+ * @brief   Zero-phase IIR filter (filtfilt)
+ *
+ * The signal is filtered by a cascade of bi quad sections forward and then backward,
+ * so the result has zero phase shift and squared magnitude response of the cascade.
+ * Both edges of the signal are extended by odd reflection (2*x[0] - x[pad_len..1] and
+ * 2*x[len-1] - x[len-2..len-1-pad_len]) and the delay lines of every pass are initialized
+ * to the steady state of the first sample, to avoid start-up transients.
+ * The result is equal to scipy.signal.sosfiltfilt(sos, x, padtype='odd', padlen=pad_len).
+ * The data array is processed in place, only the padding is stored in the pad_buff.
+ * The implementation use ANSI C and the optimized dsps_biquad_f32 for every section.
+ *
+ * @param data: input/output array
+ * @param len: length of data array
+ * @param coef: array of coefficients of the cascade. n_sect sections of b0,b1,b2,a1,a2
+ * @param w: delay lines of the cascade. Length of 2*n_sect. Overwritten by the function.
+ * @param n_sect: amount of bi quad sections
+ * @param pad_buff: buffer for edge padding. Length of 2*pad_len. Could be NULL if pad_len = 0
+ * @param pad_len: amount of samples to extend each edge. Must be less than len.
+ *                 Recommended value is 3*(2*n_sect + 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_filtfilt_f32(float *data, int len, float *coef, float *w, int n_sect, float *pad_buff, int pad_len);
+
+/**@{*/
+/**
+ * @brief   Quantize floating point bi quad coefficients
+ *
+ * Function converts coefficients of a cascade, generated by dsps_biquad_gen_xxx_f32(...),
+ * to fixed point with shift fractional bits, rounding to the nearest value.
+ * Typical values of shift are 14 for s16 (coefficients in range -2..2) and 28 for s32.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] coef: array of floating point coefficients. n_sect sections of b0,b1,b2,a1,a2
+ * @param[out] coef_out: array of fixed point coefficients. Length of 5*n_sect
+ * @param n_sect: amount of bi quad sections
+ * @param shift: amount of fractional bits of the result
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if a coefficient does not fit to the fixed point format
+ */
+esp_err_t dsps_biquad_quant_s16(const float *coef, int16_t *coef_out, int n_sect, int16_t shift);
+esp_err_t dsps_biquad_quant_s32(const float *coef, int32_t *coef_out, int n_sect, int16_t shift);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   initialize structure for fixed point bi quad cascade
+ *
+ * Function initialize structure for 16 bit (Q15 data) or 32 bit (Q31 data) bi quad cascade
+ * and clears the delay lines.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param bq: pointer to the filter structure, that must be preallocated
+ * @param coeffs: coefficients quantized by dsps_biquad_quant_sxx(...). Length of 5*n_sect
+ * @param delay: delay lines of the cascade. Length of 5*n_sect
+ * @param n_sect: amount of bi quad sections
+ * @param shift: amount of fractional bits of the coefficients. Range 1..15 for s16 and 1..30 for s32
+ * @param noise_shaping: 1 - feed the truncation error of the recursive part back to the next sample
+ *                       (first order error feedback, moves the quantization noise away from DC),
+ *                       0 - round the result
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_init_s16(biquad_s16_t *bq, int16_t *coeffs, int16_t *delay, int n_sect, int16_t shift, int16_t noise_shaping);
+esp_err_t dsps_biquad_init_s32(biquad_s32_t *bq, int32_t *coeffs, int32_t *delay, int n_sect, int16_t shift, int16_t noise_shaping);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   16 bit fixed point IIR filter cascade
+ *
+ * Cascade of 2nd order direct form I (bi quad) sections with Q15 input and output.
+ * Products are accumulated in 64 bit and the output of each section is saturated
+ * to the 16 bit range, so the filter never wraps around.
+ * The 12 bit ADC samples could be converted to Q15 by shift left to 3 bits.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param bq: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_s16_ansi(biquad_s16_t *bq, const int16_t *input, int16_t *output, int len);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   32 bit fixed point IIR filter cascade
+ *
+ * Cascade of 2nd order direct form I (bi quad) sections with Q31 input and output.
+ * Products are accumulated in 64 bit and the output of each section is saturated
+ * to the 32 bit range. Coefficients with up to 28 fractional bits keep the accumulator
+ * free of overflow.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param bq: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_s32_ansi(biquad_s32_t *bq, const int32_t *input, int32_t *output, int len);
+/**@}*/
+
 
 #ifdef __cplusplus
 }
@@ -63,9 +211,14 @@ esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float
 #define dsps_biquad_f32 dsps_biquad_f32_ansi
 #endif
 
+#define dsps_biquad_s16 dsps_biquad_s16_ansi
+#define dsps_biquad_s32 dsps_biquad_s32_ansi
+
 #else // CONFIG_DSP_OPTIMIZED
 
 #define dsps_biquad_f32 dsps_biquad_f32_ansi
+#define dsps_biquad_s16 dsps_biquad_s16_ansi
+#define dsps_biquad_s32 dsps_biquad_s32_ansi
 
 #endif // CONFIG_DSP_OPTIMIZED
 
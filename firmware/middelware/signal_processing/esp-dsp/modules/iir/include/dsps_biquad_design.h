@@ -0,0 +1,136 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_biquad_design_H_
+#define _dsps_biquad_design_H_
+
+#include <stdint.h>
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_BIQUAD_DESIGN_MAX_ORDER    12  /*!< Maximum order of the analog prototype.*/
+#define DSPS_BIQUAD_DESIGN_MAX_SECT     DSPS_BIQUAD_DESIGN_MAX_ORDER /*!< Maximum amount of bi quad sections of a design.*/
+#define DSPS_BIQUAD_DESIGN_CACHE_SIZE   8   /*!< Amount of designs stored in the cache.*/
+
+/**
+ * @brief Analog prototype of the filter
+ */
+typedef enum dsps_biquad_proto_e {
+    DSPS_BIQUAD_BUTTER = 0, /*!< Butterworth, maximally flat passband.*/
+    DSPS_BIQUAD_CHEBY1 = 1, /*!< Chebyshev type I, equiripple passband.*/
+    DSPS_BIQUAD_CHEBY2 = 2, /*!< Chebyshev type II, equiripple stopband.*/
+    DSPS_BIQUAD_BESSEL = 3, /*!< Bessel, maximally flat group delay. Phase normalized.*/
+} dsps_biquad_proto_t;
+
+/**
+ * @brief Type of the filter
+ */
+typedef enum dsps_biquad_band_e {
+    DSPS_BIQUAD_LPF = 0,    /*!< Low pass filter.*/
+    DSPS_BIQUAD_HPF = 1,    /*!< High pass filter.*/
+    DSPS_BIQUAD_BPF = 2,    /*!< Band pass filter.*/
+    DSPS_BIQUAD_BSF = 3,    /*!< Band stop filter.*/
+} dsps_biquad_band_t;
+
+/**
+ * @brief Entry of the design cache
+ */
+typedef struct biquad_design_entry_s {
+    dsps_biquad_proto_t proto;  /*!< Analog prototype.*/
+    dsps_biquad_band_t band;    /*!< Type of the filter.*/
+    int         order;          /*!< Order of the prototype.*/
+    float       f1;             /*!< First edge frequency.*/
+    float       f2;             /*!< Second edge frequency.*/
+    float       ripple;         /*!< Ripple or attenuation.*/
+    int         n_sect;         /*!< Amount of bi quad sections. 0 - entry is empty.*/
+    uint32_t    used;           /*!< Time of the last use, for replacement of the least recently used entry.*/
+    float       coeffs[5 * DSPS_BIQUAD_DESIGN_MAX_SECT]; /*!< Coefficients of the cascade.*/
+} biquad_design_entry_t;
+
+/**
+ * @brief Data struct of the design cache
+ *
+ * The structure must be cleared (for example by memset or static allocation) before the first use.
+ */
+typedef struct biquad_design_cache_s {
+    biquad_design_entry_t entry[DSPS_BIQUAD_DESIGN_CACHE_SIZE]; /*!< Stored designs.*/
+    uint32_t    time;           /*!< Counter of the requests.*/
+    uint32_t    hits;           /*!< Amount of requests found in the cache.*/
+    uint32_t    misses;         /*!< Amount of requests designed again.*/
+} biquad_design_cache_t;
+
+/**
+ * @brief   IIR filter design
+ *
+ * Function designs a digital IIR filter from an analog prototype of any order up to
+ * DSPS_BIQUAD_DESIGN_MAX_ORDER by the bilinear transform with prewarping of the edge frequencies.
+ * The result is a cascade of bi quad sections for dsps_biquad_f32(...), sections with poles
+ * closest to the unit circle are placed last. Each section has unit gain at the center of
+ * the passband, the overall gain is applied in the first section.
+ * The frequency response is equal to scipy.signal.butter/cheby1/cheby2/bessel(norm='phase')
+ * with output='sos'.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param coeffs: result coefficients. n_sect sections of b0,b1,b2,a1,a2. Length of 5*DSPS_BIQUAD_DESIGN_MAX_SECT
+ * @param n_sect: result amount of sections. order/2 rounded up for LPF/HPF and order for BPF/BSF
+ * @param proto: analog prototype
+ * @param band: type of the filter
+ * @param order: order of the prototype, 1..DSPS_BIQUAD_DESIGN_MAX_ORDER. Order of BPF/BSF is 2*order
+ * @param f1: edge frequency in range of 0..0.5 (normalized to sample frequency). For CHEBY2 it is stopband edge,
+ *            for others it is passband edge (-3 dB for BUTTER, -ripple for CHEBY1)
+ * @param f2: upper edge frequency for BPF/BSF, ignored for LPF/HPF
+ * @param ripple: passband ripple in dB for CHEBY1, stopband attenuation in dB for CHEBY2, ignored for others
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_design_f32(float *coeffs, int *n_sect, dsps_biquad_proto_t proto, dsps_biquad_band_t band,
+                                 int order, float f1, float f2, float ripple);
+
+/**
+ * @brief   IIR filter design with cache
+ *
+ * Function returns the coefficients stored in the cache for the same parameters or designs
+ * the filter by dsps_biquad_design_f32(...) and replaces the least recently used entry.
+ * Sweep of a parameter by a control with limited amount of positions does not require recalculation.
+ * The returned pointer is valid until DSPS_BIQUAD_DESIGN_CACHE_SIZE other designs are requested.
+ * A request with invalid parameters returns the error and does not modify the stored designs.
+ *
+ * @param cache: pointer to the cache structure
+ * @param coeffs: pointer to the coefficients of the cascade inside the cache
+ * @param n_sect: result amount of sections
+ * @param proto: analog prototype
+ * @param band: type of the filter
+ * @param order: order of the prototype
+ * @param f1: edge frequency
+ * @param f2: upper edge frequency for BPF/BSF
+ * @param ripple: passband ripple or stopband attenuation in dB
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_design_cached_f32(biquad_design_cache_t *cache, const float **coeffs, int *n_sect, dsps_biquad_proto_t proto,
+                                        dsps_biquad_band_t band, int order, float f1, float f2, float ripple);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_biquad_design_H_
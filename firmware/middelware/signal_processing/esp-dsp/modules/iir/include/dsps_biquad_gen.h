@@ -111,6 +111,26 @@ esp_err_t dsps_biquad_gen_bpf0db_f32(float *coeffs, float f, float qFactor);
  */
 esp_err_t dsps_biquad_gen_notch_f32(float *coeffs, float f, float gain, float qFactor);
 
+/**
+ * @brief   Notch bank IIR filter coefficients
+ *
+ * Coefficients for cascade of notch 2nd order IIR filters (bi-quad) at frequency f and its harmonics
+ * 2*f, 3*f, ... n_notch*f, for example to remove powerline interference.
+ * All notches have the same bandwidth f/qFactor, so Q factor of the k-th harmonic is k*qFactor.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param coeffs: result coefficients. n_notch sections of b0,b1,b2,a1,a2. Length of 5*n_notch
+ * @param f: fundamental frequency in range of 0..0.5 (normalized to sample frequency)
+ * @param n_notch: amount of notches (fundamental and harmonics)
+ * @param gain: gain in stopband in dB, as for dsps_biquad_gen_notch_f32(...)
+ * @param qFactor: Q factor of the fundamental notch
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if the last harmonic is not below Nyquist frequency
+ */
+esp_err_t dsps_biquad_gen_notch_bank_f32(float *coeffs, float f, int n_notch, float gain, float qFactor);
+
 /**
  * @brief   Allpass 360 degree IIR filter coefficients
  *
@@ -0,0 +1,148 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_biquad_gen.h"
+#include "dsps_biquad.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_biquad_s32_ansi";
+
+#define BQ_LEN      1024
+#define BQ_N_SECT   2
+#define BQ_SHIFT    28
+#define BQ_SCALE    2147483647.0
+
+static int32_t x32[BQ_LEN];
+static int32_t y32[BQ_LEN];
+static float x[BQ_LEN];
+static float y[BQ_LEN];
+
+static float coeffs[BQ_N_SECT * 5];
+static int32_t coeffs32[BQ_N_SECT * 5];
+static int32_t delay32[BQ_N_SECT * 5];
+
+// 4th order Butterworth LPF as a cascade of two sections
+static void gen_lpf(float f)
+{
+    dsps_biquad_gen_lpf_f32(&coeffs[0], f, 1 / 0.765);
+    dsps_biquad_gen_lpf_f32(&coeffs[5], f, 1 / 1.848);
+}
+
+// Signal to noise ratio of the fixed point result against the float cascade, in dB.
+// With quant_ref the float cascade uses the quantized coefficients, so only the arithmetic noise is measured.
+static float snr_s32(int noise_shaping, int quant_ref)
+{
+    float w[BQ_N_SECT * 2] = {0};
+    float ref_coeffs[BQ_N_SECT * 5];
+    biquad_s32_t bq;
+
+    for (int i = 0 ; i < BQ_LEN ; i++) {
+        x[i] = 0.5 * sinf(2 * M_PI * 0.005 * i) + 0.25 * sinf(2 * M_PI * 0.3 * i);
+        x32[i] = (int32_t)lroundf(x[i] * BQ_SCALE);
+        x[i] = x32[i] / BQ_SCALE;
+    }
+    TEST_ESP_OK(dsps_biquad_quant_s32(coeffs, coeffs32, BQ_N_SECT, BQ_SHIFT));
+    for (int i = 0 ; i < BQ_N_SECT * 5 ; i++) {
+        ref_coeffs[i] = quant_ref ? (float)coeffs32[i] / (float)(1 << BQ_SHIFT) : coeffs[i];
+    }
+    dsps_biquad_f32_ansi(x, y, BQ_LEN, &ref_coeffs[0], &w[0]);
+    dsps_biquad_f32_ansi(y, y, BQ_LEN, &ref_coeffs[5], &w[2]);
+
+    TEST_ESP_OK(dsps_biquad_init_s32(&bq, coeffs32, delay32, BQ_N_SECT, BQ_SHIFT, noise_shaping));
+    dsps_biquad_s32_ansi(&bq, x32, y32, BQ_LEN);
+
+    float pow_signal = 0;
+    float pow_noise = 0;
+    for (int i = BQ_LEN / 2 ; i < BQ_LEN ; i++) {
+        float err = y32[i] / BQ_SCALE - y[i];
+        pow_signal += y[i] * y[i];
+        pow_noise += err * err;
+    }
+    return 10 * log10f(pow_signal / (pow_noise + 1e-30));
+}
+
+TEST_CASE("dsps_biquad_s32_ansi functionality", "[dsps]")
+{
+    gen_lpf(0.01);
+    float snr_total = snr_s32(1, 0);
+    float snr_round = snr_s32(0, 1);
+    float snr_shaped = snr_s32(1, 1);
+    ESP_LOGI(TAG, "Q31 cascade SNR against float coefficients: %f dB", snr_total);
+    ESP_LOGI(TAG, "Q31 cascade arithmetic SNR: %f dB rounding, %f dB noise shaping", snr_round, snr_shaped);
+    TEST_ASSERT_GREATER_THAN(90, (int)snr_total);
+    TEST_ASSERT_GREATER_THAN(90, (int)snr_round);
+    TEST_ASSERT_GREATER_THAN((int)(snr_round - 1), (int)snr_shaped);
+
+    // Out of range coefficients must be rejected
+    float big[5] = {16, 0, 0, 0, 0};
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_biquad_quant_s32(big, coeffs32, 1, BQ_SHIFT));
+}
+
+TEST_CASE("dsps_biquad_s32_ansi saturation", "[dsps]")
+{
+    // Full scale square wave to resonant section: output must be clipped, but never wrap around
+    biquad_s32_t bq;
+    dsps_biquad_gen_bpf_f32(coeffs, 0.05, 20);
+    coeffs[0] *= 8;
+    coeffs[2] *= 8;
+    TEST_ESP_OK(dsps_biquad_quant_s32(coeffs, coeffs32, 1, BQ_SHIFT));
+    TEST_ESP_OK(dsps_biquad_init_s32(&bq, coeffs32, delay32, 1, BQ_SHIFT, 1));
+    for (int i = 0 ; i < BQ_LEN ; i++) {
+        x32[i] = ((i / 10) & 1) ? INT32_MIN : INT32_MAX;
+    }
+    dsps_biquad_s32_ansi(&bq, x32, y32, BQ_LEN);
+    int clipped = 0;
+    for (int i = 1 ; i < BQ_LEN ; i++) {
+        // A wrap around is a jump between the rails in one sample
+        int64_t step = (int64_t)y32[i] - y32[i - 1];
+        TEST_ASSERT_LESS_THAN(BQ_SCALE, step > 0 ? step : -step);
+        if ((y32[i] == INT32_MAX) || (y32[i] == INT32_MIN)) {
+            clipped++;
+        }
+    }
+    ESP_LOGI(TAG, "Clipped samples: %i", clipped);
+    TEST_ASSERT_GREATER_THAN(0, clipped);
+}
+
+TEST_CASE("dsps_biquad_s32_ansi benchmark", "[dsps]")
+{
+    biquad_s32_t bq;
+    float w[2] = {0};
+    gen_lpf(0.1);
+    dsps_biquad_quant_s32(coeffs, coeffs32, BQ_N_SECT, BQ_SHIFT);
+    dsps_biquad_init_s32(&bq, coeffs32, delay32, BQ_N_SECT, BQ_SHIFT, 1);
+
+    unsigned int start_b = xthal_get_ccount();
+    dsps_biquad_s32_ansi(&bq, x32, y32, BQ_LEN);
+    unsigned int end_b = xthal_get_ccount();
+    float cycles = (float)(end_b - start_b) / (BQ_LEN * BQ_N_SECT);
+
+    start_b = xthal_get_ccount();
+    for (int s = 0 ; s < BQ_N_SECT ; s++) {
+        dsps_biquad_f32(x, y, BQ_LEN, coeffs, w);
+    }
+    end_b = xthal_get_ccount();
+    float cycles_f32 = (float)(end_b - start_b) / (BQ_LEN * BQ_N_SECT);
+
+    ESP_LOGI(TAG, "dsps_biquad_s32_ansi - %f cycles per section and sample, dsps_biquad_f32 - %f", cycles, cycles_f32);
+    float min_exec = 2;
+    float max_exec = 400;
+    TEST_ASSERT_EXEC_IN_RANGE(min_exec, max_exec, cycles);
+}
@@ -0,0 +1,185 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_biquad.h"
+#include "dsps_biquad_design.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_biquad_design";
+
+typedef struct design_golden_s {
+    dsps_biquad_proto_t proto;
+    dsps_biquad_band_t band;
+    int order;
+    float f1;
+    float f2;
+    float ripple;
+    float db[32];
+} design_golden_t;
+
+// Responses in dB from scipy.signal.butter/cheby1/cheby2/bessel(norm='phase', output='sos') and sosfreqz
+// at frequencies (i + 0.5)/DESIGN_N_FREQ*0.5
+#define DESIGN_N_FREQ 32
+static const design_golden_t design_golden[] = {
+    {DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_LPF, 4, 0.100f, 0.000f, 0.0f, {-0.000f, -0.000f, -0.002f, -0.029f, -0.220f, -1.062f, -3.308f, -6.943f, -11.139f, -15.337f, -19.364f, -23.204f, -26.886f, -30.448f, -33.925f, -37.353f, -40.764f, -44.193f, -47.672f, -51.238f, -54.932f, -58.802f, -62.908f, -67.324f, -72.154f, -77.539f, -83.693f, -90.952f, -99.911f, -111.770f, -129.630f, -167.856f}},
+    {DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_HPF, 5, 0.050f, 0.000f, 0.0f, {-80.969f, -33.189f, -11.204f, -1.466f, -0.130f, -0.016f, -0.003f, -0.001f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, 0.000f, 0.000f, 0.000f}},
+    {DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_BPF, 3, 0.100f, 0.200f, 0.0f, {-82.685f, -53.475f, -38.952f, -28.244f, -18.869f, -9.881f, -2.472f, -0.137f, -0.001f, -0.000f, -0.012f, -0.312f, -2.048f, -5.842f, -10.391f, -14.777f, -18.834f, -22.613f, -26.197f, -29.666f, -33.087f, -36.527f, -40.052f, -43.733f, -47.661f, -51.952f, -56.771f, -62.379f, -69.225f, -78.211f, -91.667f, -120.366f}},
+    {DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_BSF, 4, 0.080f, 0.120f, 0.0f, {-0.000f, -0.000f, -0.000f, -0.001f, -0.082f, -15.050f, -63.101f, -5.831f, -0.137f, -0.009f, -0.001f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, 0.000f, 0.000f}},
+    {DSPS_BIQUAD_CHEBY1, DSPS_BIQUAD_LPF, 6, 0.150f, 0.000f, 1.0f, {-0.927f, -0.442f, -0.012f, -0.264f, -0.860f, -0.920f, -0.233f, -0.200f, -0.998f, -0.380f, -12.797f, -23.752f, -32.341f, -39.716f, -46.381f, -52.604f, -58.555f, -64.356f, -70.102f, -75.880f, -81.774f, -87.870f, -94.271f, -101.097f, -108.508f, -116.724f, -126.066f, -137.044f, -150.552f, -168.392f, -195.215f, -200.000f}},
+    {DSPS_BIQUAD_CHEBY1, DSPS_BIQUAD_HPF, 3, 0.200f, 0.000f, 0.5f, {-91.172f, -62.443f, -48.926f, -39.841f, -32.858f, -27.065f, -22.006f, -17.420f, -13.153f, -9.155f, -5.529f, -2.611f, -0.810f, -0.099f, -0.010f, -0.137f, -0.289f, -0.405f, -0.474f, -0.499f, -0.491f, -0.459f, -0.411f, -0.353f, -0.290f, -0.228f, -0.169f, -0.117f, -0.072f, -0.037f, -0.014f, -0.002f}},
+    {DSPS_BIQUAD_CHEBY1, DSPS_BIQUAD_BPF, 4, 0.100f, 0.150f, 0.5f, {-133.806f, -94.490f, -74.304f, -58.524f, -43.230f, -24.915f, -0.000f, -0.176f, -0.000f, -0.029f, -17.905f, -30.884f, -39.906f, -47.036f, -53.070f, -58.414f, -63.306f, -67.904f, -72.323f, -76.654f, -80.977f, -85.368f, -89.905f, -94.682f, -99.810f, -105.441f, -111.794f, -119.214f, -128.297f, -140.246f, -158.166f, -196.421f}},
+    {DSPS_BIQUAD_CHEBY2, DSPS_BIQUAD_LPF, 5, 0.200f, 0.000f, 40.0f, {-0.000f, -0.000f, -0.000f, -0.000f, -0.002f, -0.016f, -0.111f, -0.621f, -2.637f, -7.377f, -14.258f, -22.708f, -34.450f, -50.651f, -40.383f, -40.615f, -44.053f, -52.300f, -57.926f, -47.126f, -43.318f, -41.387f, -40.400f, -40.021f, -40.099f, -40.572f, -41.432f, -42.724f, -44.571f, -47.255f, -51.538f, -61.005f}},
+    {DSPS_BIQUAD_CHEBY2, DSPS_BIQUAD_HPF, 4, 0.100f, 0.000f, 60.0f, {-60.404f, -64.309f, -97.486f, -64.002f, -60.035f, -64.531f, -57.862f, -45.011f, -37.189f, -31.098f, -25.928f, -21.339f, -17.162f, -13.316f, -9.799f, -6.692f, -4.147f, -2.304f, -1.155f, -0.534f, -0.231f, -0.095f, -0.037f, -0.013f, -0.004f, -0.001f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f, -0.000f}},
+    {DSPS_BIQUAD_CHEBY2, DSPS_BIQUAD_BSF, 3, 0.100f, 0.300f, 50.0f, {-0.001f, -0.762f, -7.967f, -17.830f, -27.122f, -37.044f, -52.292f, -54.235f, -50.077f, -50.894f, -54.466f, -63.685f, -64.131f, -55.022f, -51.497f, -50.087f, -50.503f, -54.230f, -67.803f, -46.541f, -38.423f, -32.411f, -27.221f, -22.381f, -17.640f, -12.856f, -8.051f, -3.725f, -1.015f, -0.136f, -0.006f, -0.000f}},
+    {DSPS_BIQUAD_BESSEL, DSPS_BIQUAD_LPF, 4, 0.100f, 0.000f, 0.0f, {-0.036f, -0.330f, -0.938f, -1.907f, -3.326f, -5.299f, -7.858f, -10.898f, -14.227f, -17.678f, -21.143f, -24.575f, -27.957f, -31.294f, -34.601f, -37.896f, -41.204f, -44.549f, -47.960f, -51.470f, -55.118f, -58.950f, -63.024f, -67.414f, -72.222f, -77.589f, -83.727f, -90.974f, -99.924f, -111.777f, -129.633f, -167.856f}},
+    {DSPS_BIQUAD_BESSEL, DSPS_BIQUAD_HPF, 7, 0.020f, 0.000f, 0.0f, {-57.958f, -7.856f, -2.616f, -1.302f, -0.773f, -0.508f, -0.356f, -0.261f, -0.197f, -0.153f, -0.121f, -0.097f, -0.078f, -0.064f, -0.052f, -0.043f, -0.035f, -0.029f, -0.024f, -0.019f, -0.016f, -0.012f, -0.010f, -0.008f, -0.006f, -0.004f, -0.003f, -0.002f, -0.001f, -0.001f, -0.000f, -0.000f}},
+    {DSPS_BIQUAD_BESSEL, DSPS_BIQUAD_BPF, 2, 0.050f, 0.250f, 0.0f, {-35.392f, -16.425f, -8.143f, -3.742f, -1.562f, -0.564f, -0.138f, -0.004f, -0.046f, -0.223f, -0.530f, -0.970f, -1.553f, -2.285f, -3.169f, -4.202f, -5.375f, -6.681f, -8.112f, -9.665f, -11.342f, -13.154f, -15.118f, -17.262f, -19.632f, -22.293f, -25.348f, -28.963f, -33.433f, -39.357f, -48.283f, -67.395f}},
+    {DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_LPF, 12, 0.010f, 0.000f, 0.0f, {-0.012f, -88.933f, -142.513f, -178.091f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f, -200.000f}},
+    {DSPS_BIQUAD_CHEBY1, DSPS_BIQUAD_LPF, 1, 0.300f, 0.000f, 3.0f, {-0.001f, -0.012f, -0.035f, -0.068f, -0.114f, -0.171f, -0.242f, -0.327f, -0.427f, -0.543f, -0.677f, -0.830f, -1.006f, -1.206f, -1.433f, -1.692f, -1.985f, -2.320f, -2.701f, -3.137f, -3.636f, -4.211f, -4.876f, -5.651f, -6.562f, -7.645f, -8.954f, -10.576f, -12.660f, -15.507f, -19.892f, -29.409f}},
+};
+
+// Response of the cascade in dB at frequency f
+static float cascade_db(const float *coeffs, int n_sect, float f)
+{
+    double gain = 1;
+    double cr = cos(2 * M_PI * f), ci = -sin(2 * M_PI * f);
+    double c2r = cr * cr - ci * ci, c2i = 2 * cr * ci;
+    for (int s = 0; s < n_sect; s++) {
+        const float *c = &coeffs[s * 5];
+        double nr = c[0] + c[1] * cr + c[2] * c2r, ni = c[1] * ci + c[2] * c2i;
+        double dr = 1 + c[3] * cr + c[4] * c2r, di = c[3] * ci + c[4] * c2i;
+        gain *= sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+    }
+    return 20 * log10(gain > 1e-10 ? gain : 1e-10);
+}
+
+TEST_CASE("dsps_biquad_design_f32 functionality", "[dsps]")
+{
+    float coeffs[5 * DSPS_BIQUAD_DESIGN_MAX_SECT];
+    for (int d = 0; d < sizeof(design_golden) / sizeof(design_golden_t); d++) {
+        const design_golden_t *g = &design_golden[d];
+        int n_sect = 0;
+        TEST_ESP_OK(dsps_biquad_design_f32(coeffs, &n_sect, g->proto, g->band, g->order, g->f1, g->f2, g->ripple));
+        int two_edges = (g->band == DSPS_BIQUAD_BPF) || (g->band == DSPS_BIQUAD_BSF);
+        TEST_ASSERT_EQUAL(two_edges ? g->order : (g->order + 1) / 2, n_sect);
+
+        float max_err = 0;
+        for (int i = 0; i < DESIGN_N_FREQ; i++) {
+            float f = (i + 0.5f) / DESIGN_N_FREQ * 0.5f;
+            float db = cascade_db(coeffs, n_sect, f);
+            // Deep stopband is compared only by level
+            if ((g->db[i] < -80) && (db < -75)) {
+                continue;
+            }
+            float err = fabsf(db - g->db[i]);
+            // Relative tolerance in the stopband, float coefficients
+            float tol = (g->db[i] > -3) ? 0.01f : 0.01f - g->db[i] * 0.002f;
+            if (err > tol) {
+                ESP_LOGE(TAG, "design %i: at %f expected %f dB, got %f dB", d, f, g->db[i], db);
+            }
+            TEST_ASSERT_FLOAT_WITHIN(tol, g->db[i], db);
+            max_err = fmaxf(max_err, err);
+        }
+        ESP_LOGI(TAG, "design %i: proto %i, band %i, order %i, %i sections, max error %f dB",
+                 d, g->proto, g->band, g->order, n_sect, max_err);
+    }
+
+    int n_sect;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_biquad_design_f32(coeffs, &n_sect, DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_LPF, DSPS_BIQUAD_DESIGN_MAX_ORDER + 1, 0.1f, 0, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_biquad_design_f32(coeffs, &n_sect, DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_BPF, 4, 0.2f, 0.1f, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_biquad_design_f32(coeffs, &n_sect, DSPS_BIQUAD_CHEBY1, DSPS_BIQUAD_LPF, 4, 0.1f, 0, 0));
+}
+
+TEST_CASE("dsps_biquad_design_f32 filtering", "[dsps]")
+{
+    // The cascade is stable and filters a tone as designed
+    float coeffs[5 * DSPS_BIQUAD_DESIGN_MAX_SECT];
+    float w[2 * DSPS_BIQUAD_DESIGN_MAX_SECT] = {0};
+    int n_sect = 0;
+    TEST_ESP_OK(dsps_biquad_design_f32(coeffs, &n_sect, DSPS_BIQUAD_CHEBY2, DSPS_BIQUAD_BPF, 6, 0.1f, 0.2f, 60));
+    const int len = 2048;
+    static float x[2048];
+    const float tones[] = {0.15f, 0.05f};
+    for (int t = 0; t < 2; t++) {
+        for (int i = 0; i < len; i++) {
+            x[i] = sinf(2 * M_PI * tones[t] * i);
+        }
+        memset(w, 0, sizeof(w));
+        for (int s = 0; s < n_sect; s++) {
+            dsps_biquad_f32(x, x, len, &coeffs[s * 5], &w[s * 2]);
+        }
+        float peak = 0;
+        for (int i = len / 2; i < len; i++) {
+            peak = fmaxf(peak, fabsf(x[i]));
+        }
+        float expected = powf(10, cascade_db(coeffs, n_sect, tones[t]) / 20);
+        ESP_LOGI(TAG, "tone %f: amplitude %f, expected %f", tones[t], peak, expected);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, expected, peak);
+    }
+}
+
+TEST_CASE("dsps_biquad_design_cached_f32 functionality", "[dsps]")
+{
+    static biquad_design_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    const float *coeffs = NULL;
+    int n_sect = 0;
+
+    // Knob sweep forth and back over 6 positions: the way back is taken from the cache
+    const int positions = 6;
+    for (int i = 0; i < 2 * positions; i++) {
+        int k = (i < positions) ? i : 2 * positions - 1 - i;
+        float f = 0.05f + 0.01f * k;
+        TEST_ESP_OK(dsps_biquad_design_cached_f32(&cache, &coeffs, &n_sect, DSPS_BIQUAD_BESSEL, DSPS_BIQUAD_LPF, 8, f, 0.3f, 1));
+        TEST_ASSERT_EQUAL(4, n_sect);
+        float expected[5 * DSPS_BIQUAD_DESIGN_MAX_SECT];
+        int n = 0;
+        dsps_biquad_design_f32(expected, &n, DSPS_BIQUAD_BESSEL, DSPS_BIQUAD_LPF, 8, f, 0, 0);
+        TEST_ASSERT_EQUAL(0, memcmp(expected, coeffs, 5 * n * sizeof(float)));
+    }
+    ESP_LOGI(TAG, "cache hits %i, misses %i", cache.hits, cache.misses);
+    TEST_ASSERT_EQUAL(positions, cache.misses);
+    TEST_ASSERT_EQUAL(positions, cache.hits);
+
+    // Failed request on a full cache keeps the least recently used design
+    memset(&cache, 0, sizeof(cache));
+    for (int k = 0; k < DSPS_BIQUAD_DESIGN_CACHE_SIZE; k++) {
+        TEST_ESP_OK(dsps_biquad_design_cached_f32(&cache, &coeffs, &n_sect, DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_LPF, 4, 0.05f + 0.01f * k, 0, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE,
+                      dsps_biquad_design_cached_f32(&cache, &coeffs, &n_sect, DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_LPF, 4, 0.7f, 0, 0));
+    TEST_ESP_OK(dsps_biquad_design_cached_f32(&cache, &coeffs, &n_sect, DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_LPF, 4, 0.05f, 0, 0));
+    TEST_ASSERT_EQUAL(1, cache.hits);
+    TEST_ASSERT_EQUAL(DSPS_BIQUAD_DESIGN_CACHE_SIZE + 1, cache.misses);
+
+    // Timing of design and cached request
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_biquad_design_cached_f32(&cache, &coeffs, &n_sect, DSPS_BIQUAD_BESSEL, DSPS_BIQUAD_BPF, 10, 0.1f, 0.2f, 0);
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    unsigned int design_cycles = end_b - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_biquad_design_cached_f32(&cache, &coeffs, &n_sect, DSPS_BIQUAD_BESSEL, DSPS_BIQUAD_BPF, 10, 0.1f, 0.2f, 0);
+    end_b = dsp_get_cpu_cycle_count();
+    unsigned int cached_cycles = end_b - start_b;
+    ESP_LOGI(TAG, "10th order Bessel band pass: design %i cycles, from cache %i cycles", design_cycles, cached_cycles);
+    TEST_ASSERT_LESS_THAN(design_cycles, cached_cycles);
+    TEST_ASSERT_EXEC_IN_RANGE(2, 1000000, design_cycles);
+}
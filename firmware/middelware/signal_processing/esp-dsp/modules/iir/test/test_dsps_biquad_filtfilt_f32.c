@@ -0,0 +1,107 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_tone_gen.h"
+#include "dsps_biquad_gen.h"
+#include "dsps_biquad.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_biquad_filtfilt_f32";
+
+#define FILTFILT_N_SECT     3
+#define FILTFILT_PAD_LEN    (3 * (2 * FILTFILT_N_SECT + 1))
+#define FILTFILT_LEN        64
+
+// Two LPF sections (f = 0.05, Q = 1/0.765, 1/1.848) and one HPF section (f = 0.005, Q = 1/1.414)
+// generated by dsps_biquad_gen_lpf_f32/dsps_biquad_gen_hpf_f32
+static float coeffs[FILTFILT_N_SECT * 5] = {
+    0.0218849517, 0.0437699035, 0.0218849517, -1.70105064, 0.788590431,
+    0.0190362707, 0.0380725414, 0.0190362707, -1.4796313, 0.555776477,
+    0.978033662, -1.95606732, 0.978033662, -1.95558465, 0.956550121
+};
+
+// scipy.signal.sosfiltfilt(sos, x, padtype='odd', padlen=21)
+// x[i] = 1 + sin(2*pi*0.02*i) + 0.5*sin(2*pi*0.3*i)
+static const float y_ref[FILTFILT_LEN] = {
+    0.4758058f, 0.5927005f, 0.7077083f, 0.8185242f, 0.9229974f, 1.0191646f, 1.1052719f, 1.1797886f,
+    1.2414146f, 1.2890834f, 1.3219622f, 1.3394516f, 1.3411836f, 1.3270204f, 1.2970524f, 1.2515954f,
+    1.1911875f, 1.1165829f, 1.0287434f, 0.9288270f, 0.8181720f, 0.6982778f, 0.5707813f, 0.4374307f,
+    0.3000548f, 0.1605326f, 0.0207600f, -0.1173816f, -0.2520564f, -0.3815014f, -0.5040506f, -0.6181552f,
+    -0.7223983f, -0.8155055f, -0.8963521f, -0.9639671f, -1.0175361f, -1.0564045f, -1.0800842f, -1.0882632f,
+    -1.0808224f, -1.0578585f, -1.0197138f, -0.9670116f, -0.9006944f, -0.8220620f, -0.7328026f, -0.6350121f,
+    -0.5311946f, -0.4242361f, -0.3173464f, -0.2139647f, -0.1176264f, -0.0317943f, 0.0403406f, 0.0960766f,
+    0.1334213f, 0.1512940f, 0.1496863f, 0.1297569f, 0.0938385f, 0.0453376f, -0.0114784f, -0.0718019f,
+};
+
+static float x[1024];
+static float w[FILTFILT_N_SECT * 2];
+static float pad[FILTFILT_PAD_LEN * 2];
+
+TEST_CASE("dsps_biquad_filtfilt_f32 functionality", "[dsps]")
+{
+    for (int i = 0 ; i < FILTFILT_LEN ; i++) {
+        x[i] = 1 + sinf(2 * M_PI * 0.02 * i) + 0.5 * sinf(2 * M_PI * 0.3 * i);
+    }
+    esp_err_t ret = dsps_biquad_filtfilt_f32(x, FILTFILT_LEN, coeffs, w, FILTFILT_N_SECT, pad, FILTFILT_PAD_LEN);
+    TEST_ESP_OK(ret);
+    for (int i = 0 ; i < FILTFILT_LEN ; i++) {
+        ESP_LOGD(TAG, "y[%i] = %f, expected = %f", i, x[i], y_ref[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.0005, y_ref[i], x[i]);
+    }
+}
+
+TEST_CASE("dsps_biquad_filtfilt_f32 zero phase", "[dsps]")
+{
+    // A passband tone must stay aligned with the input: no delay and no start-up transient
+    int len = sizeof(x) / sizeof(float);
+    float lpf[5];
+    dsps_biquad_gen_lpf_f32(lpf, 0.1, 0.707);
+    dsps_tone_gen_f32(x, len, 1, 0.01, 0);
+    esp_err_t ret = dsps_biquad_filtfilt_f32(x, len, lpf, w, 1, pad, 9);
+    TEST_ESP_OK(ret);
+    float max_err = 0;
+    for (int i = 0 ; i < len ; i++) {
+        float ref = sinf(2 * M_PI * 0.01 * i);
+        if (fabsf(x[i] - ref) > max_err) {
+            max_err = fabsf(x[i] - ref);
+        }
+    }
+    ESP_LOGI(TAG, "Max error against input tone = %f", max_err);
+    TEST_ASSERT_LESS_THAN(20000, (int)(1e6 * max_err));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_biquad_filtfilt_f32(x, 8, lpf, w, 1, pad, 9));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_biquad_filtfilt_f32(x, len, lpf, w, 1, NULL, 9));
+}
+
+TEST_CASE("dsps_biquad_filtfilt_f32 benchmark", "[dsps]")
+{
+    int len = sizeof(x) / sizeof(float);
+    dsps_tone_gen_f32(x, len, 1, 0.01, 0);
+
+    unsigned int start_b = xthal_get_ccount();
+    dsps_biquad_filtfilt_f32(x, len, coeffs, w, FILTFILT_N_SECT, pad, FILTFILT_PAD_LEN);
+    unsigned int end_b = xthal_get_ccount();
+
+    float cycles = (float)(end_b - start_b) / len;
+    ESP_LOGI(TAG, "dsps_biquad_filtfilt_f32 - %f cycles per sample for %i sections", cycles, FILTFILT_N_SECT);
+    float min_exec = 10;
+    float max_exec = 1000;
+    TEST_ASSERT_EXEC_IN_RANGE(min_exec, max_exec, cycles);
+}
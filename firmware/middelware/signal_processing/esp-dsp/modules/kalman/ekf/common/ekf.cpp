@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "ekf.h"
+#include "dsps_dotprod.h"
+#include "dspm_mult.h"
 #include <float.h>
 
 ekf::ekf(int x, int w) : NUMX(x),
@@ -22,8 +24,21 @@ ekf::ekf(int x, int w) : NUMX(x),
     F(*new dspm::Mat(x, x)),
     G(*new dspm::Mat(x, w)),
     P(*new dspm::Mat(x, x)),
-    Q(*new dspm::Mat(w, w))
+    Q(*new dspm::Mat(w, w)),
+
+    Xlast(*new dspm::Mat(x, 1)),
+    Xdot(*new dspm::Mat(x, 1)),
+    Xsum(*new dspm::Mat(x, 1)),
+    Fdt(*new dspm::Mat(x, x)),
+    FP(*new dspm::Mat(x, x)),
+    GQ(*new dspm::Mat(x, w))
 {
+    this->JosephForm = false;
+    this->Sparse = false;
+    this->F_rows = new int[this->NUMX + 1];
+    this->F_cols = new int[this->NUMX * this->NUMX];
+    this->G_rows = new int[this->NUMX + 1];
+    this->G_cols = new int[this->NUMX * this->NUMW];
 
     this->P *= 0;
     this->Q *= 0;
@@ -45,8 +60,19 @@ ekf::~ekf()
     delete &P;
     delete &Q;
 
-    delete this->HP;
-    delete this->Km;
+    delete &Xlast;
+    delete &Xdot;
+    delete &Xsum;
+    delete &Fdt;
+    delete &FP;
+    delete &GQ;
+
+    delete[] this->HP;
+    delete[] this->Km;
+    delete[] this->F_rows;
+    delete[] this->F_cols;
+    delete[] this->G_rows;
+    delete[] this->G_cols;
 }
 
 void ekf::Process(float *u, float dt)
@@ -58,23 +84,37 @@ void ekf::Process(float *u, float dt)
 
 void ekf::RungeKutta(dspm::Mat &x, float *U, float dt)
 {
-
+    // All intermediate values are in the workspace: Xsum accumulates k1 + 2*k2 + 2*k3
     float dt2 = dt / 2.0f;
+    float *xd = this->Xdot.data;
+    float *xl = this->Xlast.data;
+    float *xs = this->Xsum.data;
+
+    this->Xlast = x;          // make a working copy
+    StateXdot(x, U, this->Xdot); // k1 = f(x, u)
+    for (int i = 0; i < this->NUMX; i++) {
+        xs[i] = xd[i];
+        x.data[i] = xl[i] + xd[i] * dt2;
+    }
 
-    dspm::Mat Xlast = x;          // make a working copy
-    dspm::Mat K1 = StateXdot(x, U); // k1 = f(x, u)
-    x = Xlast + (K1 * dt2);
-
-    dspm::Mat K2 = StateXdot(x, U); // k2 = f(x + 0.5*dT*k1, u)
-    x = Xlast + K2 * dt2;
+    StateXdot(x, U, this->Xdot); // k2 = f(x + 0.5*dT*k1, u)
+    for (int i = 0; i < this->NUMX; i++) {
+        xs[i] += 2.0f * xd[i];
+        x.data[i] = xl[i] + xd[i] * dt2;
+    }
 
-    dspm::Mat K3 = StateXdot(x, U); // k3 = f(x + 0.5*dT*k2, u)
-    x = Xlast + K3 * dt;
+    StateXdot(x, U, this->Xdot); // k3 = f(x + 0.5*dT*k2, u)
+    for (int i = 0; i < this->NUMX; i++) {
+        xs[i] += 2.0f * xd[i];
+        x.data[i] = xl[i] + xd[i] * dt;
+    }
 
-    dspm::Mat K4 = StateXdot(x, U); // k4 = f(x + dT * k3, u)
+    StateXdot(x, U, this->Xdot); // k4 = f(x + dT * k3, u)
 
     // Xnew = X + dT * (k1 + 2 * k2 + 2 * k3 + k4) / 6
-    x = Xlast + (K1 + 2.0f * K2 + 2.0f * K3 + K4) * (dt / 6.0f);
+    for (int i = 0; i < this->NUMX; i++) {
+        x.data[i] = xl[i] + (xs[i] + xd[i]) * (dt / 6.0f);
+    }
 }
 
 dspm::Mat ekf::SkewSym4x4(float w[3])
@@ -135,14 +175,122 @@ dspm::Mat ekf::qProduct(float *q)
     return result;
 }
 
-void ekf::CovariancePrediction(float dt)
+void ekf::SetSparsity(const uint8_t *F_mask, const uint8_t *G_mask)
 {
-    dspm::Mat f = this->F * dt;
+    if ((F_mask == NULL) || (G_mask == NULL)) {
+        this->Sparse = false;
+        return;
+    }
+    int nnz = 0;
+    for (int i = 0; i < this->NUMX; i++) {
+        this->F_rows[i] = nnz;
+        for (int j = 0; j < this->NUMX; j++) {
+            if (F_mask[i * this->NUMX + j] || (i == j)) {
+                this->F_cols[nnz++] = j;
+            }
+        }
+    }
+    this->F_rows[this->NUMX] = nnz;
+
+    nnz = 0;
+    for (int i = 0; i < this->NUMX; i++) {
+        this->G_rows[i] = nnz;
+        for (int j = 0; j < this->NUMW; j++) {
+            if (G_mask[i * this->NUMW + j]) {
+                this->G_cols[nnz++] = j;
+            }
+        }
+    }
+    this->G_rows[this->NUMX] = nnz;
 
-    f = f + dspm::Mat::eye(this->NUMX);
+    // Elements of I + F*dt outside of the pattern are never written in sparse mode
+    this->Fdt *= 0;
+    this->Sparse = true;
+}
+
+void ekf::CovariancePrediction(float dt)
+{
+    if (this->Sparse) {
+        CovariancePredictionSparse(dt);
+        return;
+    }
+    // f = F*dt + I
+    for (int i = 0; i < this->NUMX; i++) {
+        for (int j = 0; j < this->NUMX; j++) {
+            Fdt(i, j) = F(i, j) * dt;
+        }
+        Fdt(i, i) += 1;
+    }
+    dspm_mult_f32(this->Fdt.data, this->P.data, this->FP.data, this->NUMX, this->NUMX, this->NUMX);
+    dspm_mult_f32(this->G.data, this->Q.data, this->GQ.data, this->NUMX, this->NUMW, this->NUMW);
+
+    // P = (f*P)*f' + dt^2*(G*Q)*G'. Rows of f' and G' are the rows of f and G,
+    // so the elements are dot products of the rows and the transposes are not required.
+    // The result is symmetric: only the upper triangle is calculated and mirrored.
+    for (int i = 0; i < this->NUMX; i++) {
+        for (int j = i; j < this->NUMX; j++) {
+            float fpf, gqg;
+            dsps_dotprod_f32(&this->FP.data[i * this->NUMX], &this->Fdt.data[j * this->NUMX], &fpf, this->NUMX);
+            dsps_dotprod_f32(&this->GQ.data[i * this->NUMW], &this->G.data[j * this->NUMW], &gqg, this->NUMW);
+            P(i, j) = P(j, i) = fpf + (dt * dt) * gqg;
+        }
+    }
+}
 
-    dspm::Mat f_t = f.t();
-    this->P = ((f * this->P) * f_t) + (dt * dt) * ((G * Q) * G.t());
+void ekf::CovariancePredictionSparse(float dt)
+{
+    int n = this->NUMX;
+    int w = this->NUMW;
+    // f = F*dt + I, only the elements of the pattern
+    for (int i = 0; i < n; i++) {
+        for (int p = F_rows[i]; p < F_rows[i + 1]; p++) {
+            int k = F_cols[p];
+            Fdt(i, k) = F(i, k) * dt + ((i == k) ? 1 : 0);
+        }
+    }
+    // FP = f*P and GQ = G*Q as sums of the rows of P and Q
+    for (int i = 0; i < n; i++) {
+        float *fp = &FP.data[i * n];
+        for (int j = 0; j < n; j++) {
+            fp[j] = 0;
+        }
+        for (int p = F_rows[i]; p < F_rows[i + 1]; p++) {
+            int k = F_cols[p];
+            float f = Fdt(i, k);
+            float *p_row = &P.data[k * n];
+            for (int j = 0; j < n; j++) {
+                fp[j] += f * p_row[j];
+            }
+        }
+        float *gq = &GQ.data[i * w];
+        for (int j = 0; j < w; j++) {
+            gq[j] = 0;
+        }
+        for (int p = G_rows[i]; p < G_rows[i + 1]; p++) {
+            int k = G_cols[p];
+            float g = G(i, k);
+            float *q_row = &Q.data[k * w];
+            for (int j = 0; j < w; j++) {
+                gq[j] += g * q_row[j];
+            }
+        }
+    }
+    // P = (f*P)*f' + dt^2*(G*Q)*G', upper triangle and mirror
+    for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++) {
+            float fpf = 0;
+            for (int p = F_rows[j]; p < F_rows[j + 1]; p++) {
+                int k = F_cols[p];
+                fpf += FP(i, k) * Fdt(j, k);
+            }
+            float gqg = 0;
+            for (int p = G_rows[j]; p < G_rows[j + 1]; p++) {
+                int k = G_cols[p];
+                gqg += GQ(i, k) * G(j, k);
+            }
+            P(i, j) = P(j, i) = fpf + (dt * dt) * gqg;
+        }
+    }
 }
 
 void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
@@ -170,10 +318,20 @@ void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
         for (int k = 0; k < this->NUMX; k++) {
             Km[k] = HP[k] * invHPHR; // find K = HP/HPHR
         }
-        for (int i = 0; i < this->NUMX; i++) {
-            // Find P(m)= P(m-1) + K*HP
-            for (int j = i; j < NUMX; j++) {
-                P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j];
+        if (this->JosephForm) {
+            // Find P(m) = (I - K*H)*P(m-1)*(I - K*H)' + K*R*K'
+            //           = P(m-1) - K*HP - HP'*K' + K*HPHR*K'
+            for (int i = 0; i < this->NUMX; i++) {
+                for (int j = i; j < NUMX; j++) {
+                    P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j] - HP[i] * Km[j] + HPHR * Km[i] * Km[j];
+                }
+            }
+        } else {
+            for (int i = 0; i < this->NUMX; i++) {
+                // Find P(m)= P(m-1) + K*HP
+                for (int j = i; j < NUMX; j++) {
+                    P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j];
+                }
             }
         }
 
@@ -206,12 +364,18 @@ void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
 }
 
 dspm::Mat ekf::quat2rotm(float q[4])
+{
+    dspm::Mat Rm(3, 3);
+    quat2rotm(q, Rm);
+    return Rm;
+}
+
+void ekf::quat2rotm(const float q[4], dspm::Mat &Rm)
 {
     float q0 = q[0];
     float q1 = q[1];
     float q2 = q[2];
     float q3 = q[3];
-    dspm::Mat Rm(3, 3);
 
     Rm(0, 0) = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
     Rm(1, 0) = 2.0f * (q1 * q2 + q0 * q3);
@@ -222,8 +386,6 @@ dspm::Mat ekf::quat2rotm(float q[4])
     Rm(0, 2) = 2.0f * (q1 * q3 + q0 * q2);
     Rm(1, 2) = 2.0f * (q2 * q3 - q0 * q1);
     Rm(2, 2) = (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
-
-    return Rm;
 }
 
 dspm::Mat ekf::quat2eul(const float q[4])
@@ -388,6 +550,12 @@ dspm::Mat ekf::dFdq(dspm::Mat &vector, dspm::Mat &q)
 dspm::Mat ekf::dFdq_inv(dspm::Mat &vector, dspm::Mat &q)
 {
     dspm::Mat result(3, 4);
+    dFdq_inv(vector, q, result);
+    return result;
+}
+
+void ekf::dFdq_inv(dspm::Mat &vector, dspm::Mat &q, dspm::Mat &result)
+{
     result(0, 0) = q.data[0] * vector.data[0] + q.data[3] * vector.data[1] - q.data[2] * vector.data[2];
     result(0, 1) = q.data[1] * vector.data[0] + q.data[2] * vector.data[1] + q.data[3] * vector.data[2];
     result(0, 2) = -q.data[2] * vector.data[0] + q.data[1] * vector.data[1] - q.data[0] * vector.data[2];
@@ -404,7 +572,6 @@ dspm::Mat ekf::dFdq_inv(dspm::Mat &vector, dspm::Mat &q)
     result(2, 3) = q.data[1] * vector.data[0] + q.data[2] * vector.data[1] + q.data[3] * vector.data[2];
 
     result *= 2;
-    return result;
 }
 
 dspm::Mat ekf::StateXdot(dspm::Mat &x, float *u)
@@ -413,3 +580,8 @@ dspm::Mat ekf::StateXdot(dspm::Mat &x, float *u)
     dspm::Mat Xdot = (this->F * x + this->G * U);
     return Xdot;
 }
+
+void ekf::StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot)
+{
+    xdot = StateXdot(x, u);
+}
@@ -31,7 +31,8 @@ public:
 
     /**
      * Constructor of EKF.
-     * THe constructor allocate main memory for the matrixes.
+     * THe constructor allocate main memory for the matrixes and the workspace of the prediction,
+     * so Process(...) and Update(...) do not allocate memory.
      * @param[in] x: - amount of states in EKF. x[n] = F*x[n-1] + G*u + W. Size of matrix F
      * @param[in] w: - amount of control measurements and noise inputs. Size of matrix G
     */
@@ -112,6 +113,16 @@ public:
      *      - derivative of input vector x and u
      */
     virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
+    /**
+     * Derivative of state vector X to preallocated matrix.
+     * This method is called by RungeKutta(...) four times per step. The default implementation
+     * calls StateXdot(x, u), that allocates the result: a derived class should override this method
+     * to process without memory allocation.
+     * @param[in] x: state vector
+     * @param[in] u: control measurement
+     * @param[out] xdot: derivative of input vector x and u, NUMX x 1
+     */
+    virtual void StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot);
     /**
      * Calculation of system state matrices F and G
      * @param[in] x: state vector
@@ -124,15 +135,38 @@ public:
 
     /**
      * Calculates covariance prediction matrux P.
-     * Update matrix P
+     * Update matrix P. P is symmetric: only the upper triangle is calculated and mirrored.
      * @param[in] dt: time interval from last update
      */
     virtual void CovariancePrediction(float dt);
 
+    /**
+     * Set sparsity pattern of the matrices F and G.
+     * With the pattern CovariancePrediction(...) processes only the elements of the pattern,
+     * and skips the known zero elements of F and G. The elements outside of the pattern must be
+     * zero after LinearizeFG(...). The diagonal of F is always included.
+     * Without the pattern (default) the dense matrices are processed.
+     * The method does not allocate memory.
+     * @param[in] F_mask: NUMX x NUMX array, not zero for the elements of F that could be not zero.
+     *                    NULL to process dense matrices.
+     * @param[in] G_mask: NUMX x NUMW array, not zero for the elements of G that could be not zero.
+     *                    NULL to process dense matrices.
+     */
+    void SetSparsity(const uint8_t *F_mask, const uint8_t *G_mask);
+
+    /**
+     * Covariance prediction with the sparsity pattern set by SetSparsity(...).
+     * Called by CovariancePrediction(...) if the pattern is set.
+     * @param[in] dt: time interval from last update
+     */
+    void CovariancePredictionSparse(float dt);
+
     /**
      * Update of current state by measured values.
      * Optimized method for non correlated values
      * Calculate Kalman gain and update matrix P and vector X.
+     * The measurements are processed one by one. If JosephForm is set, P is updated by
+     * the Joseph form P = (I - K*H)*P*(I - K*H)' + K*R*K', otherwise by P = P - K*H*P.
      * @param[in] H: derivative matrix
      * @param[in] measured: array of measured values
      * @param[in] expected: array of expected values
@@ -150,6 +184,14 @@ public:
      */
     virtual void UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R);
 
+    /**
+     * Use the Joseph form of the covariance update in Update(...).
+     * The Joseph form keeps P symmetric and positive definite with the rounding errors
+     * of the float calculations, but takes about twice more operations for P.
+     * Default is false.
+    */
+    bool JosephForm;
+
     /**
      * Matrix for intermidieve calculations
     */
@@ -159,6 +201,54 @@ public:
     */
     float *Km;
 
+    /**
+     * Workspace of RungeKutta: state before the step, NUMX x 1
+    */
+    dspm::Mat &Xlast;
+    /**
+     * Workspace of RungeKutta: derivative of the state, NUMX x 1
+    */
+    dspm::Mat &Xdot;
+    /**
+     * Workspace of RungeKutta: weighted sum of the derivatives, NUMX x 1
+    */
+    dspm::Mat &Xsum;
+    /**
+     * Workspace of CovariancePrediction: I + F*dt, NUMX x NUMX
+    */
+    dspm::Mat &Fdt;
+    /**
+     * Workspace of CovariancePrediction: (I + F*dt)*P, NUMX x NUMX
+    */
+    dspm::Mat &FP;
+    /**
+     * Workspace of CovariancePrediction: G*Q, NUMX x NUMW
+    */
+    dspm::Mat &GQ;
+
+    /**
+     * Sparsity pattern is set by SetSparsity(...)
+    */
+    bool Sparse;
+    /**
+     * Sparsity pattern of I + F*dt in CSR format: the columns of row i are F_cols[F_rows[i]..F_rows[i + 1] - 1].
+     * Size of F_rows is NUMX + 1, size of F_cols is NUMX x NUMX
+    */
+    int *F_rows;
+    /**
+     * Column indexes of the sparsity pattern of I + F*dt
+    */
+    int *F_cols;
+    /**
+     * Sparsity pattern of G in CSR format: the columns of row i are G_cols[G_rows[i]..G_rows[i + 1] - 1].
+     * Size of G_rows is NUMX + 1, size of G_cols is NUMX x NUMW
+    */
+    int *G_rows;
+    /**
+     * Column indexes of the sparsity pattern of G
+    */
+    int *G_cols;
+
 public:
     // Additional universal helper methods
     /**
@@ -170,6 +260,13 @@ public:
      */
     static dspm::Mat quat2rotm(float q[4]);
 
+    /**
+     * Convert quaternion to rotation matrix without memory allocation.
+     * @param[in] q: quaternion
+     * @param[out] Rm: rotation matrix 3x3
+     */
+    static void quat2rotm(const float q[4], dspm::Mat &Rm);
+
     /**
      * Convert rotation matrix to quaternion.
      * @param[in] R: rotation matrix
@@ -225,6 +322,14 @@ public:
      */
     static dspm::Mat dFdq_inv(dspm::Mat &vector, dspm::Mat &quat);
 
+    /**
+     * Df/dq: Derivative of vector by inverted quaternion without memory allocation.
+     * @param[in] vector: input vector
+     * @param[in] quat: quaternion
+     * @param[out] result: derivative matrix 3x4
+     */
+    static void dFdq_inv(dspm::Mat &vector, dspm::Mat &quat, dspm::Mat &result);
+
     /**
      * Make skew-symmetric matrix of vector.
      * @param[in] w: source vector
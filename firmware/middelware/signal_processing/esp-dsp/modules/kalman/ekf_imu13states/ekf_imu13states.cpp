@@ -16,9 +16,32 @@
 
 ekf_imu13states::ekf_imu13states() : ekf(13, 18),
     mag0(3, 1),
-    accel0(3, 1)
+    accel0(3, 1),
+    Hbuff(10, 13)
 {
     this->NUMU = 3;
+
+    // Sparsity pattern of F and G, see LinearizeFG(...)
+    uint8_t F_mask[13 * 13] = {0};
+    uint8_t G_mask[13 * 18] = {0};
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 7; j++) {
+            F_mask[i * 13 + j] = 1; // dqdot / dq, dqdot / dwbias
+        }
+        for (int j = 0; j < 3; j++) {
+            G_mask[i * 18 + j] = 1; // dqdot / dnw
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            G_mask[(i + 7) * 18 + j + 6] = 1; // rotation matrix
+        }
+        G_mask[(i + 4) * 18 + i + 3] = 1;
+        G_mask[(i + 7) * 18 + i + 12] = 1;
+        G_mask[(i + 10) * 18 + i + 9] = 1;
+        G_mask[(i + 10) * 18 + i + 15] = 1;
+    }
+    this->SetSparsity(F_mask, G_mask);
 }
 
 ekf_imu13states::~ekf_imu13states()
@@ -51,53 +74,78 @@ void ekf_imu13states::Init()
 }
 
 dspm::Mat ekf_imu13states::StateXdot(dspm::Mat &x, float *u)
+{
+    dspm::Mat Xdot(this->NUMX, 1);
+    StateXdot(x, u, Xdot);
+    return Xdot;
+}
+
+void ekf_imu13states::StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot)
 {
     float wx = u[0] - x(4, 0); // subtract the biases on gyros
     float wy = u[1] - x(5, 0);
     float wz = u[2] - x(6, 0);
-
-    float w[] = {wx, wy, wz};
-    dspm::Mat q = dspm::Mat(x.data, 4, 1);
-
-    // qdot = Q * w
-    dspm::Mat Omega = 0.5 * SkewSym4x4(w);
-    dspm::Mat qdot = Omega * q;
-    dspm::Mat Xdot(this->NUMX, 1);
-    Xdot *= 0;
-    Xdot.Copy(qdot, 0, 0);
+    float *q = x.data;
+
+    // qdot = 0.5 * SkewSym4x4(w) * q
+    xdot *= 0;
+    xdot.data[0] = 0.5f * (-wx * q[1] - wy * q[2] - wz * q[3]);
+    xdot.data[1] = 0.5f * (wx * q[0] + wz * q[2] - wy * q[3]);
+    xdot.data[2] = 0.5f * (wy * q[0] - wz * q[1] + wx * q[3]);
+    xdot.data[3] = 0.5f * (wz * q[0] + wy * q[1] - wx * q[2]);
     // dwbias = 0
     // dMang_Ampl = 0
     // dMang_offset = 0
-    return Xdot;
 }
 
 void ekf_imu13states::LinearizeFG(dspm::Mat &x, float *u)
 {
     float w[3] = {(u[0] - x(4, 0)), (u[1] - x(5, 0)), (u[2] - x(6, 0))}; // subtract the biases on gyros
-    // float w[3] = {u[0], u[1], u[2]}; // subtract the biases on gyros
+    float *q = x.data;
 
     this->F *= 0; // Initialize F and G matrixes.
     this->G *= 0;
 
-    // dqdot / dq - skey matrix
-    F.Copy(0.5 * ekf::SkewSym4x4(w), 0, 0);
-
-    // dqdot/dvector
-    dspm::Mat dq = -0.5 * qProduct(x.data);
-    dspm::Mat dq_q = dq.Get(0, 4, 1, 3);
-
-    // dqdot / dnw
-    G.Copy(dq_q, 0, 0);
-    // dqdot / dwbias
-    F.Copy(dq_q, 0, 4);
-
-    dspm::Mat rotm = -1 * this->quat2rotm(x.data); // Convert quat to rotation matrix
+    // dqdot / dq - 0.5 * skew matrix
+    F(0, 1) = -0.5f * w[0];
+    F(0, 2) = -0.5f * w[1];
+    F(0, 3) = -0.5f * w[2];
+    F(1, 0) = 0.5f * w[0];
+    F(1, 2) = 0.5f * w[2];
+    F(1, 3) = -0.5f * w[1];
+    F(2, 0) = 0.5f * w[1];
+    F(2, 1) = -0.5f * w[2];
+    F(2, 3) = 0.5f * w[0];
+    F(3, 0) = 0.5f * w[2];
+    F(3, 1) = 0.5f * w[1];
+    F(3, 2) = -0.5f * w[0];
+
+    // dqdot/dvector: columns 1..3 of -0.5 * qProduct(q)
+    float dq_q[4][3] = {
+        { 0.5f * q[1],  0.5f * q[2],  0.5f * q[3]},
+        {-0.5f * q[0],  0.5f * q[3], -0.5f * q[2]},
+        {-0.5f * q[3], -0.5f * q[0],  0.5f * q[1]},
+        { 0.5f * q[2], -0.5f * q[1], -0.5f * q[0]},
+    };
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            G(i, j) = dq_q[i][j]; // dqdot / dnw
+            F(i, j + 4) = dq_q[i][j]; // dqdot / dwbias
+        }
+    }
 
-    G.Copy(rotm, 7, 6);
-    G.Copy(dspm::Mat::eye(3), 4, 3);   // random noise wbias
-    G.Copy(dspm::Mat::eye(3), 7, 12);  // random noise magnetometer amplitude
-    G.Copy(dspm::Mat::eye(3), 10, 9);  // magnetometer offset constant
-    G.Copy(dspm::Mat::eye(3), 10, 15); // random noise offset constant
+    float rotm_data[9];
+    dspm::Mat rotm(rotm_data, 3, 3);
+    this->quat2rotm(q, rotm); // Convert quat to rotation matrix
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            G(i + 7, j + 6) = -rotm(i, j);
+        }
+        G(i + 4, i + 3) = 1;   // random noise wbias
+        G(i + 7, i + 12) = 1;  // random noise magnetometer amplitude
+        G(i + 10, i + 9) = 1;  // magnetometer offset constant
+        G(i + 10, i + 15) = 1; // random noise offset constant
+    }
 }
 
 void ekf_imu13states::Test()
@@ -184,32 +232,55 @@ void ekf_imu13states::TestFull(bool enable_att)
     std::cout << "Final State data : " << this->X.t() << std::endl;
 }
 
-void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
+void ekf_imu13states::RefMeasurement(dspm::Mat &H, float *expected, dspm::Mat &Re)
 {
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
+    float rotm_data[9];
+    dspm::Mat rotm(rotm_data, 3, 3);
+    this->quat2rotm(quat.data, rotm);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            Re(i, j) = rotm(j, i);
+        }
+    }
 
+    float dF_dq_data[12];
+    dspm::Mat dF_dq(dF_dq_data, 3, 4);
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
+    ekf::dFdq_inv(this->accel0, quat, dF_dq);
+    H.Copy(dF_dq, 3, 0);
 
     // dMagn/dq
     dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    ekf::dFdq_inv(magn, quat, dF_dq);
+    H.Copy(dF_dq, 0, 0);
+
+    // expected_magn = Re * magn + magn_offset, expected_accel = Re * accel0
+    float *magn_offset = &this->X.data[10];
+    for (int i = 0; i < 3; i++) {
+        expected[i] = magn_offset[i];
+        expected[i + 3] = 0;
+        for (int j = 0; j < 3; j++) {
+            expected[i] += Re(i, j) * magn.data[j];
+            expected[i + 3] += Re(i, j) * this->accel0.data[j];
+        }
+    }
+}
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
+{
+    dspm::Mat quat(this->X.data, 4, 1);
+    dspm::Mat H(this->Hbuff.data, 6, this->NUMX);
+    H *= 0;
+    float Re_data[9];
+    dspm::Mat Re(Re_data, 3, 3);
 
     float measured_data[6];
     float expected_data[6];
+    RefMeasurement(H, expected_data, Re);
     for (size_t i = 0; i < 3; i++) {
         measured_data[i] = magn_data[i];
-        expected_data[i] = expected_magn.data[i];
         measured_data[i + 3] = accel_data[i];
-        expected_data[i + 3] = expected_accel.data[i];
     }
 
     this->Update(H, measured_data, expected_data, R);
@@ -219,33 +290,22 @@ void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data,
 void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_data, float R[6])
 {
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
-
-    // We include these two line to update magnetometer initial state
-    H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
-
-    // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
-
-    // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
-
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    dspm::Mat H(this->Hbuff.data, 6, this->NUMX);
+    H *= 0;
+    float Re_data[9];
+    dspm::Mat Re(Re_data, 3, 3);
 
     float measured_data[6];
     float expected_data[6];
+    RefMeasurement(H, expected_data, Re);
+    // We include these two line to update magnetometer initial state
+    H.Copy(Re, 0, 7);
+    for (int i = 0; i < 3; i++) {
+        H(i, i + 10) = 1;
+    }
     for (size_t i = 0; i < 3; i++) {
         measured_data[i] = magn_data[i];
-        expected_data[i] = expected_magn.data[i];
         measured_data[i + 3] = accel_data[i];
-        expected_data[i + 3] = expected_accel.data[i];
     }
 
     this->Update(H, measured_data, expected_data, R);
@@ -255,33 +315,26 @@ void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_da
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10])
 {
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(10, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
+    dspm::Mat H(this->Hbuff.data, 10, this->NUMX);
+    H *= 0;
+    float Re_data[9];
+    dspm::Mat Re(Re_data, 3, 3);
 
+    float measured_data[10];
+    float expected_data[10];
+    RefMeasurement(H, expected_data, Re);
     H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
-    // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
-    // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
-
+    for (int i = 0; i < 3; i++) {
+        H(i, i + 10) = 1;
+    }
     // dq/dq
-    H.Copy(dspm::Mat::eye(4), 6, 1);
-
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    for (int i = 0; i < 4; i++) {
+        H(i + 6, i + 1) = 1;
+    }
 
-    float measured_data[10];
-    float expected_data[10];
     for (size_t i = 0; i < 3; i++) {
         measured_data[i] = magn_data[i];
-        expected_data[i] = expected_magn.data[i];
         measured_data[i + 3] = accel_data[i];
-        expected_data[i + 3] = expected_accel.data[i];
     }
     for (size_t i = 0; i < 4; i++) {
         measured_data[i + 6] = attitude[i];
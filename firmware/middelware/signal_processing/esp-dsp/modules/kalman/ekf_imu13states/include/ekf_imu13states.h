@@ -37,6 +37,7 @@ public:
     // Method calculates Xdot values depends on U
     // U - gyroscope values in radian per seconds (rad/sec)
     virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
+    virtual void StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot);
     virtual void LinearizeFG(dspm::Mat &x, float *u);
 
     /**
@@ -64,6 +65,11 @@ public:
     */
     int NUMU;
 
+    /**
+    *     Workspace for the measurement matrix H of the reference updates, 10 x NUMX.
+    */
+    dspm::Mat Hbuff;
+
     /**
      * Update part of system state by reference measurements accelerometer and magnetometer.
      * Only attitude and gyro bias will be updated.
@@ -93,6 +99,16 @@ public:
      */
     void UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10]);
 
+private:
+    /**
+     * Common part of the reference updates: derivatives of the magnetometer (rows 0..2) and
+     * accelerometer (rows 3..5) by the quaternion and the expected values of them.
+     *
+     * @param[out] H: measurement matrix, must be cleared before
+     * @param[out] expected: expected magnetometer and accelerometer values, 6 values
+     * @param[out] Re: inverted rotation matrix 3x3
+     */
+    void RefMeasurement(dspm::Mat &H, float *expected, dspm::Mat &Re);
 };
 
 #endif // _ekf_imu13states_H_
@@ -13,15 +13,48 @@
 // limitations under the License.
 
 #include <string.h>
+#include <stdlib.h>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
 #include "unity.h"
 #include "dsp_platform.h"
 #include "esp_log.h"
 
 #include "ekf_imu13states.h"
 #include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
 
 static const char *TAG = "ekf_imu13states";
 
+// One step of the filter with all kinds of the measurement updates
+static void ekf_imu13states_step(ekf_imu13states *ekf13, int n)
+{
+    float dt = 0.01;
+    float gyro[] = {0.1f, 0.2f, 0.3f};
+    float accel[] = {0, 0, 1};
+    float magn[] = {1, 0, 0};
+    float attitude[] = {1, 0, 0, 0};
+    float R[10];
+    for (size_t i = 0; i < 10; i++) {
+        R[i] = 0.01;
+    }
+
+    ekf13->Process(gyro, dt);
+    switch (n % 3) {
+    case 0:
+        ekf13->UpdateRefMeasurement(accel, magn, R);
+        break;
+    case 1:
+        ekf13->UpdateRefMeasurementMagn(accel, magn, R);
+        break;
+    default:
+        ekf13->UpdateRefMeasurement(accel, magn, attitude, R);
+        break;
+    }
+}
+
 
 TEST_CASE("ekf_imu13states functionality gyro only", "[dspm]")
 {
@@ -58,3 +91,162 @@ TEST_CASE("ekf_imu13states functionality gyro and magn", "[dspm]")
     printf("Expected result = %i, calculated result = %i\n", 200, (int)(1000 * ekf13->X.data[5] + 0.5));
     printf("Expected result = %i, calculated result = %i\n", 300, (int)(1000 * ekf13->X.data[6] + 0.5));
 }
+
+TEST_CASE("ekf_imu13states no memory allocation", "[dspm]")
+{
+    ekf_imu13states *ekf13 = new ekf_imu13states();
+    ekf13->Init();
+
+    // The heap is the same after the steps, the result matrices are not allocated.
+    // Where supported, the minimum of the free heap during the steps shows temporary allocations as well.
+    multi_heap_info_t heap_before;
+    multi_heap_info_t heap_after;
+    heap_caps_get_info(&heap_before, MALLOC_CAP_DEFAULT);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+    heap_caps_monitor_local_minimum_free_size_start();
+#endif
+    for (int n = 0; n < 300; n++) {
+        ekf_imu13states_step(ekf13, n);
+    }
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+    size_t heap_min = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+    heap_caps_monitor_local_minimum_free_size_stop();
+    TEST_ASSERT_EQUAL(heap_before.total_free_bytes, heap_min);
+#endif
+    heap_caps_get_info(&heap_after, MALLOC_CAP_DEFAULT);
+    ESP_LOGI(TAG, "Heap after 300 steps: %i allocated blocks, %i allocated bytes (before %i, %i)",
+             (int)heap_after.allocated_blocks, (int)heap_after.total_allocated_bytes,
+             (int)heap_before.allocated_blocks, (int)heap_before.total_allocated_bytes);
+    TEST_ASSERT_EQUAL(heap_before.allocated_blocks, heap_after.allocated_blocks);
+    TEST_ASSERT_EQUAL(heap_before.total_allocated_bytes, heap_after.total_allocated_bytes);
+    for (int i = 0; i < ekf13->NUMX; i++) {
+        TEST_ASSERT_FALSE(isnan(ekf13->X.data[i]));
+    }
+    delete ekf13;
+}
+
+TEST_CASE("ekf_imu13states benchmark", "[dspm]")
+{
+    const int steps = 1000;
+    ekf_imu13states *ekf13 = new ekf_imu13states();
+    ekf13->Init();
+
+    auto start_t = std::chrono::steady_clock::now();
+    unsigned int start_b = xthal_get_ccount();
+    for (int n = 0; n < steps; n++) {
+        ekf_imu13states_step(ekf13, n);
+    }
+    unsigned int cycles = xthal_get_ccount() - start_b;
+    auto end_t = std::chrono::steady_clock::now();
+    float seconds = std::chrono::duration<float>(end_t - start_t).count();
+
+    ESP_LOGI(TAG, "Process and update: %i cycles per step, %.0f steps per second", cycles / steps, steps / seconds);
+    delete ekf13;
+}
+
+TEST_CASE("ekf_imu13states covariance prediction", "[dspm]")
+{
+    float dt = 0.01;
+    float gyro[] = {0.1f, 0.2f, 0.3f};
+    ekf_imu13states *ekf13 = new ekf_imu13states();
+    ekf13->Init();
+    for (int n = 0; n < 100; n++) {
+        ekf_imu13states_step(ekf13, n);
+    }
+
+    // Reference: P = (F*dt + I)*P*(F*dt + I)' + dt^2*G*Q*G'
+    ekf13->LinearizeFG(ekf13->X, gyro);
+    dspm::Mat f = ekf13->F * dt + dspm::Mat::eye(ekf13->NUMX);
+    dspm::Mat P_ref = f * ekf13->P * f.t() + (dt * dt) * (ekf13->G * ekf13->Q * ekf13->G.t());
+    ekf13->CovariancePrediction(dt);
+
+    float max_err = 0;
+    float max_p = 0;
+    for (int i = 0; i < ekf13->NUMX; i++) {
+        for (int j = 0; j < ekf13->NUMX; j++) {
+            max_err = std::max(max_err, std::abs(ekf13->P(i, j) - P_ref(i, j)));
+            max_p = std::max(max_p, std::abs(P_ref(i, j)));
+            TEST_ASSERT_TRUE(ekf13->P(i, j) == ekf13->P(j, i));
+        }
+    }
+    ESP_LOGI(TAG, "Covariance prediction: maximum error %e, maximum value %e", max_err, max_p);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6 * max_err / max_p));
+    delete ekf13;
+}
+
+TEST_CASE("ekf_imu13states Joseph form update", "[dspm]")
+{
+    const int steps = 6000;
+    ekf_imu13states *ekf13 = new ekf_imu13states();
+    ekf_imu13states *ekf13_joseph = new ekf_imu13states();
+    ekf13->Init();
+    ekf13_joseph->Init();
+    ekf13_joseph->JosephForm = true;
+    for (int n = 0; n < steps; n++) {
+        ekf_imu13states_step(ekf13, n);
+        ekf_imu13states_step(ekf13_joseph, n);
+    }
+
+    // Both forms give the same state, the covariance stays symmetric and positive on the diagonal
+    float max_err = 0;
+    for (int i = 0; i < ekf13->NUMX; i++) {
+        max_err = std::max(max_err, std::abs(ekf13->X.data[i] - ekf13_joseph->X.data[i]));
+        TEST_ASSERT_GREATER_THAN(0, (int)(1e9 * ekf13_joseph->P(i, i)));
+        for (int j = 0; j < ekf13->NUMX; j++) {
+            TEST_ASSERT_TRUE(ekf13->P(i, j) == ekf13->P(j, i));
+            TEST_ASSERT_TRUE(ekf13_joseph->P(i, j) == ekf13_joseph->P(j, i));
+        }
+    }
+    ESP_LOGI(TAG, "Joseph form: maximum state difference %e after %i steps", max_err, steps);
+    TEST_ASSERT_LESS_OR_EQUAL(100, (int)(1e6 * max_err));
+    delete ekf13;
+    delete ekf13_joseph;
+}
+
+TEST_CASE("ekf_imu13states sparse covariance prediction", "[dspm]")
+{
+    const int repeat = 1000;
+    float dt = 0.01;
+    float gyro[] = {0.1f, 0.2f, 0.3f};
+    ekf_imu13states *ekf13 = new ekf_imu13states();
+    ekf13->Init();
+    for (int n = 0; n < 100; n++) {
+        ekf_imu13states_step(ekf13, n);
+    }
+    ekf13->LinearizeFG(ekf13->X, gyro);
+    dspm::Mat P0 = ekf13->P;
+
+    // Sparsity pattern is set by the constructor
+    TEST_ASSERT_TRUE(ekf13->Sparse);
+    unsigned int start_b = xthal_get_ccount();
+    for (int n = 0; n < repeat; n++) {
+        ekf13->CovariancePrediction(dt);
+    }
+    unsigned int cycles_sparse = xthal_get_ccount() - start_b;
+    ekf13->P = P0;
+    ekf13->CovariancePrediction(dt);
+    dspm::Mat P_sparse = ekf13->P;
+
+    ekf13->SetSparsity(NULL, NULL);
+    ekf13->P = P0;
+    start_b = xthal_get_ccount();
+    for (int n = 0; n < repeat; n++) {
+        ekf13->CovariancePrediction(dt);
+    }
+    unsigned int cycles_dense = xthal_get_ccount() - start_b;
+    ekf13->P = P0;
+    ekf13->CovariancePrediction(dt);
+
+    float max_err = 0;
+    float max_p = 0;
+    for (int i = 0; i < ekf13->NUMX; i++) {
+        for (int j = 0; j < ekf13->NUMX; j++) {
+            max_err = std::max(max_err, std::abs(ekf13->P(i, j) - P_sparse(i, j)));
+            max_p = std::max(max_p, std::abs(ekf13->P(i, j)));
+        }
+    }
+    ESP_LOGI(TAG, "Covariance prediction: sparse %i, dense %i cycles, speedup %.2f, maximum difference %e",
+             cycles_sparse / repeat, cycles_dense / repeat, (float)cycles_dense / cycles_sparse, max_err);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6 * max_err / max_p));
+    delete ekf13;
+}
@@ -0,0 +1,214 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fastmath.h"
+#include "dsps_sqrt.h"
+#include <math.h>
+
+// Polynomial coefficients are minimax fits, the maximum error is noted in the header
+
+#define FAST_SQRT2      1.41421356f
+#define FAST_LOG10_2    0.301029996f
+#define FAST_LOG2_E     1.44269504f
+#define FAST_LN2_HI     0.693145752f            // ln(2) = HI + LO, HI has 15 bits of mantissa
+#define FAST_LN2_LO     1.42860677e-06f
+#define FAST_PI         3.14159265f
+#define FAST_2_PI       0.636619772f
+#define FAST_PI_2_HI    1.5703125f              // pi/2 = HI + LO, HI has 8 bits of mantissa
+#define FAST_PI_2_LO    4.83826794e-04f
+
+typedef union {
+    float f;
+    uint32_t i;
+} fast_f32_t;
+
+// log2(x), x > 0: exponent and log2(1 + t) for mantissa 1 + t in range sqrt(0.5)..sqrt(2)
+static inline float dsps_log2f_fast(float x)
+{
+    fast_f32_t u = {x};
+    int e = (int)((u.i >> 23) & 0xff) - 127;
+    u.i = (u.i & 0x007fffff) | 0x3f800000;
+    float m = u.f;
+    if (m > FAST_SQRT2) {
+        m *= 0.5f;
+        e++;
+    }
+    float t = m - 1;
+    float p = -0.206581712f;
+    p = p * t + 0.322139651f;
+    p = p * t - 0.367488086f;
+    p = p * t + 0.479349434f;
+    p = p * t - 0.72113198f;
+    p = p * t + 1.4427135f;
+    return e + p * t;
+}
+
+esp_err_t dsps_log2_f32(const float *input, float *output, int len, int step_in, int step_out)
+{
+    if ((input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int i = 0; i < len; i++) {
+        output[i * step_out] = dsps_log2f_fast(input[i * step_in]);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_log10_f32(const float *input, float *output, int len, int step_in, int step_out)
+{
+    return dsps_db_f32(input, output, len, 1, step_in, step_out);
+}
+
+esp_err_t dsps_db_f32(const float *input, float *output, int len, float mult, int step_in, int step_out)
+{
+    if ((input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    float scale = mult * FAST_LOG10_2;
+    for (int i = 0; i < len; i++) {
+        output[i * step_out] = scale * dsps_log2f_fast(input[i * step_in]);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_exp_f32(const float *input, float *output, int len, int step_in, int step_out)
+{
+    if ((input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int i = 0; i < len; i++) {
+        float v = input[i * step_in];
+        v = (v < -87) ? -87 : v;
+        v = (v > 88) ? 88 : v;
+        // exp(v) = 2^n*exp(r), r = v - n*ln(2) in range -ln(2)/2..ln(2)/2, reduction in two steps
+        float t = v * FAST_LOG2_E;
+        int n = (int)(t + 126.5f) - 126;
+        float r = (v - n * FAST_LN2_HI) - n * FAST_LN2_LO;
+        float p = 0.00829759426f;
+        p = p * r + 0.0419152677f;
+        p = p * r + 0.166675746f;
+        p = p * r + 0.499988973f;
+        p = p * r + 0.999999702f;
+        p = p * r + 1.00000012f;
+        fast_f32_t s;
+        s.i = (uint32_t)(n + 127) << 23;
+        output[i * step_out] = p * s.f;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_atan2_f32(const float *y, const float *x, float *output, int len, int step_in, int step_out)
+{
+    if ((y == NULL) || (x == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int i = 0; i < len; i++) {
+        float yv = y[i * step_in];
+        float xv = x[i * step_in];
+        float ax = fabsf(xv);
+        float ay = fabsf(yv);
+        float mx = (ax > ay) ? ax : ay;
+        float mn = (ax > ay) ? ay : ax;
+        float z = (mx > 0) ? mn / mx : 0;
+        float z2 = z * z;
+        float p = 0.0208489485f;
+        p = p * z2 - 0.0851640031f;
+        p = p * z2 + 0.180164278f;
+        p = p * z2 - 0.330305964f;
+        p = p * z2 + 0.999866426f;
+        float a = p * z;
+        a = (ay > ax) ? 0.5f * FAST_PI - a : a;
+        a = (xv < 0) ? FAST_PI - a : a;
+        output[i * step_out] = (yv < 0) ? -a : a;
+    }
+    return ESP_OK;
+}
+
+static inline float dsps_rsqrtf_fast(float x)
+{
+    float y = dsps_inverted_sqrtf_f32(x);
+    return y * (1.5f - 0.5f * x * y * y);
+}
+
+esp_err_t dsps_rsqrt_f32(const float *input, float *output, int len, int step_in, int step_out)
+{
+    if ((input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int i = 0; i < len; i++) {
+        output[i * step_out] = dsps_rsqrtf_fast(input[i * step_in]);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_sqrt_nr_f32(const float *input, float *output, int len, int step_in, int step_out)
+{
+    if ((input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int i = 0; i < len; i++) {
+        float v = input[i * step_in];
+        output[i * step_out] = v * dsps_rsqrtf_fast(v);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_sincos_f32(const float *input, float *sin_out, float *cos_out, int len, int step_in, int step_out)
+{
+    if (input == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    for (int i = 0; i < len; i++) {
+        float v = input[i * step_in];
+        // Quadrant: nearest multiple of pi/2, reduction in two steps to keep the precision
+        float q = v * FAST_2_PI;
+        int n = (int)(q + ((q < 0) ? -0.5f : 0.5f));
+        float r = (v - n * FAST_PI_2_HI) - n * FAST_PI_2_LO;
+        float r2 = r * r;
+        float s = -0.000195019122f;
+        s = s * r2 + 0.00833201688f;
+        s = s * r2 - 0.166666508f;
+        s = (s * r2) * r + r;
+        float c = 2.43800005e-05f;
+        c = c * r2 - 0.00138866203f;
+        c = c * r2 + 0.0416666158f;
+        c = c * r2 - 0.5f;
+        c = c * r2 + 1;
+        float so = s;
+        float co = c;
+        switch (n & 3) {
+        case 1:
+            so = c;
+            co = -s;
+            break;
+        case 2:
+            so = -s;
+            co = -c;
+            break;
+        case 3:
+            so = -c;
+            co = s;
+            break;
+        default:
+            break;
+        }
+        if (sin_out != NULL) {
+            sin_out[i * step_out] = so;
+        }
+        if (cos_out != NULL) {
+            cos_out[i * step_out] = co;
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,324 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_fastmath_H_
+#define _dsps_fastmath_H_
+
+#include <stdint.h>
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_SIN_TABLE_BITS     10  /*!< Resolution of the quarter wave sine table, bits.*/
+#define DSPS_SIN_TABLE_SIZE     (1 << DSPS_SIN_TABLE_BITS) /*!< Amount of table steps per quarter of the period.*/
+
+/**
+ * @brief Quarter wave sine table, Q15
+ *
+ * sin(pi/2*i/DSPS_SIN_TABLE_SIZE), i = 0..DSPS_SIN_TABLE_SIZE. Shared by the integer sine functions
+ * and the numerically controlled oscillator.
+ */
+extern const int16_t dsps_sin_table_q15[DSPS_SIN_TABLE_SIZE + 1];
+
+/**
+ * @brief   Fast base 2 logarithm
+ *
+ * The function calculates x[i*step_out] = log2(|y[i*step_in]|); i=[0..len)
+ * from the exponent of the float and a polynomial of degree 6 of the mantissa.
+ * Maximum absolute error is 3e-6, and the rounding of the result for |log2| > 16. 0 returns -127.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_log2_f32(const float *input, float *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Fast base 10 logarithm
+ *
+ * The function calculates x[i*step_out] = log10(|y[i*step_in]|); i=[0..len) by dsps_log2_f32(...).
+ * Maximum absolute error is 1e-6. 0 returns -38.2.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_log10_f32(const float *input, float *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Fast conversion to dB
+ *
+ * The function calculates x[i*step_out] = mult*log10(|y[i*step_in]|); i=[0..len) by dsps_log2_f32(...).
+ * Maximum absolute error is 3e-5 dB for mult = 20. 0 returns -127*mult*log10(2).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param mult: 10 for power, 20 for magnitude
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_db_f32(const float *input, float *output, int len, float mult, int step_in, int step_out);
+
+/**
+ * @brief   Fast exponent
+ *
+ * The function calculates x[i*step_out] = exp(y[i*step_in]); i=[0..len)
+ * as 2^n*exp(r) with integer n and polynomial of degree 5 of r in range -ln(2)/2..ln(2)/2.
+ * Maximum relative error is 3e-7. The input is limited to -87..88.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_exp_f32(const float *input, float *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Fast arctangent of y/x
+ *
+ * The function calculates z[i*step_out] = atan2(y[i*step_in], x[i*step_in]); i=[0..len)
+ * in range -pi..pi by octant reduction and odd polynomial of degree 9.
+ * Maximum absolute error is 1.2e-5 rad. atan2(0, 0) returns 0.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] y: input array of the ordinates, for example imaginary parts
+ * @param[in] x: input array of the abscissas, for example real parts
+ * @param output: output array, rad
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input arrays (2 for interleaved complex data)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_atan2_f32(const float *y, const float *x, float *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Fast inverted square root
+ *
+ * The function calculates x[i*step_out] = 1/sqrt(y[i*step_in]); i=[0..len)
+ * by dsps_inverted_sqrtf_f32(...), that makes one Newton iteration, and the second Newton iteration.
+ * Maximum relative error is 5e-6.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, positive values
+ * @param output: output array. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_rsqrt_f32(const float *input, float *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Fast square root
+ *
+ * The function calculates x[i*step_out] = sqrt(y[i*step_in]); i=[0..len) as y*dsps_rsqrt_f32(y).
+ * Maximum relative error is 5e-6, 0 returns 0. For the error of 4% dsps_sqrt_f32(...) is faster.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, not negative values
+ * @param output: output array. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sqrt_nr_f32(const float *input, float *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Fast sine and cosine
+ *
+ * The function calculates s[i*step_out] = sin(y[i*step_in]), c[i*step_out] = cos(y[i*step_in]); i=[0..len)
+ * by reduction to range -pi/4..pi/4 and polynomials of degree 7 and 8.
+ * Maximum absolute error is 2e-7 for |y| < 100 and grows with |y| by the rounding of the input.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, rad
+ * @param sin_out: output array of sine. Could be NULL
+ * @param cos_out: output array of cosine. Could be NULL
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output arrays (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sincos_f32(const float *input, float *sin_out, float *cos_out, int len, int step_in, int step_out);
+
+/**
+ * @brief   Base 2 logarithm of integers
+ *
+ * The function calculates x[i*step_out] = log2(y[i*step_in]) in Q16; i=[0..len)
+ * by the position of the highest bit and a table of 129 values with linear interpolation.
+ * Maximum absolute error is 2.1e-5 (1.4 LSB). Not positive values return INT32_MIN.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array, Q16. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_log2_s32(const int32_t *input, int32_t *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Base 2 logarithm of one integer
+ *
+ * Scalar version of dsps_log2_s32(...): log2(x) in Q16, 0 returns INT32_MIN.
+ *
+ * @param x: input value
+ *
+ * @return log2(x), Q16
+ */
+int32_t dsps_log2_u32(uint32_t x);
+
+/**
+ * @brief   Base 2 exponent of integers
+ *
+ * The function calculates x[i*step_out] = 2^y[i*step_in]; i=[0..len) with input and output in Q16,
+ * by a table of 129 values with linear interpolation. Maximum relative error is 1e-5 for the results from 1.
+ * The input is limited to -16..15 (output 1..INT32_MAX).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, Q16
+ * @param output: output array, Q16. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_exp2_s32(const int32_t *input, int32_t *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Arctangent of y/x for integers
+ *
+ * The function calculates z[i*step_out] = atan2(y[i*step_in], x[i*step_in]); i=[0..len)
+ * by 16 iterations of CORDIC without multiplications and divisions.
+ * The output is the binary angle: -32768..32767 for -pi..pi. Maximum error is 1 LSB (1e-4 rad).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] y: input array of the ordinates
+ * @param[in] x: input array of the abscissas
+ * @param output: output array, binary angle
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input arrays (2 for interleaved complex data)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_atan2_s16(const int16_t *y, const int16_t *x, int16_t *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Sine and cosine of integers
+ *
+ * The function calculates s[i*step_out] = sin(y[i*step_in]), c[i*step_out] = cos(y[i*step_in]); i=[0..len)
+ * in Q15 for the binary angle (-32768..32767 for -pi..pi) by the quarter wave table dsps_sin_table_q15
+ * with linear interpolation. Maximum error is 1 LSB.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array, binary angle
+ * @param sin_out: output array of sine, Q15. Could be NULL
+ * @param cos_out: output array of cosine, Q15. Could be NULL
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output arrays (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sincos_s16(const int16_t *input, int16_t *sin_out, int16_t *cos_out, int len, int step_in, int step_out);
+
+/**
+ * @brief   Square root of integers
+ *
+ * The function calculates x[i*step_out] = sqrt(y[i*step_in]); i=[0..len) rounded to the nearest integer,
+ * bit by bit without multiplications. Negative values return 0.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: amount of operations for arrays
+ * @param step_in: step over input array (by default should be 1)
+ * @param step_out: step over output array (by default should be 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_sqrt_s32(const int32_t *input, int32_t *output, int len, int step_in, int step_out);
+
+/**
+ * @brief   Square root of one integer
+ *
+ * Scalar version of dsps_sqrt_s32(...) for the full unsigned range, rounded to the nearest integer.
+ *
+ * @param x: input value
+ *
+ * @return sqrt(x)
+ */
+uint32_t dsps_isqrt_u32(uint32_t x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fastmath_H_
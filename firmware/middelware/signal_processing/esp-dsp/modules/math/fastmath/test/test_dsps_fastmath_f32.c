@@ -0,0 +1,213 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fastmath.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fastmath_f32";
+
+#define N_SWEEP     4096
+
+static float x[N_SWEEP];
+static float y[N_SWEEP];
+static float out[N_SWEEP];
+static float out2[N_SWEEP];
+
+// Logarithmic sweep from 10^lo to 10^hi
+static void fastmath_log_sweep(float lo, float hi)
+{
+    for (int i = 0; i < N_SWEEP; i++) {
+        x[i] = powf(10, lo + (hi - lo) * i / (N_SWEEP - 1));
+    }
+}
+
+TEST_CASE("dsps_fastmath_f32 accuracy", "[dsps]")
+{
+    double err;
+    fastmath_log_sweep(-4, 4);
+    TEST_ESP_OK(dsps_log2_f32(x, out, N_SWEEP, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out[i] - log2(x[i])));
+    }
+    ESP_LOGI(TAG, "log2: maximum absolute error %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(30, (int)(1e7 * err));
+
+    TEST_ESP_OK(dsps_log10_f32(x, out, N_SWEEP, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out[i] - log10(x[i])));
+    }
+    ESP_LOGI(TAG, "log10: maximum absolute error %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e7 * err));
+
+    fastmath_log_sweep(-6, 6);
+    TEST_ESP_OK(dsps_db_f32(x, out, N_SWEEP, 20, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out[i] - 20 * log10(x[i])));
+    }
+    ESP_LOGI(TAG, "dB: maximum absolute error %e dB", err);
+    TEST_ASSERT_LESS_OR_EQUAL(30, (int)(1e6 * err));
+
+    for (int i = 0; i < N_SWEEP; i++) {
+        x[i] = -87 + 175.0f * i / (N_SWEEP - 1);
+    }
+    TEST_ESP_OK(dsps_exp_f32(x, out, N_SWEEP, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out[i] / exp(x[i]) - 1));
+    }
+    ESP_LOGI(TAG, "exp: maximum relative error %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(3, (int)(1e7 * err));
+
+    // Points on circles of different radius at all angles
+    for (int i = 0; i < N_SWEEP; i++) {
+        float r = powf(10, -3 + 6.0f * (i % 64) / 63);
+        float a = -M_PI + 2 * M_PI * i / N_SWEEP;
+        x[i] = r * cosf(a);
+        y[i] = r * sinf(a);
+    }
+    TEST_ESP_OK(dsps_atan2_f32(y, x, out, N_SWEEP, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out[i] - atan2(y[i], x[i])));
+    }
+    ESP_LOGI(TAG, "atan2: maximum absolute error %e rad", err);
+    TEST_ASSERT_LESS_OR_EQUAL(12, (int)(1e6 * err));
+    float zero = 0;
+    TEST_ESP_OK(dsps_atan2_f32(&zero, &zero, out, 1, 1, 1));
+    TEST_ASSERT_EQUAL(0, (int)out[0]);
+
+    fastmath_log_sweep(-20, 20);
+    TEST_ESP_OK(dsps_rsqrt_f32(x, out, N_SWEEP, 1, 1));
+    TEST_ESP_OK(dsps_sqrt_nr_f32(x, out2, N_SWEEP, 1, 1));
+    err = 0;
+    double err2 = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out[i] * sqrt(x[i]) - 1));
+        err2 = fmax(err2, fabs(out2[i] / sqrt(x[i]) - 1));
+    }
+    ESP_LOGI(TAG, "rsqrt: maximum relative error %e, sqrt: %e", err, err2);
+    TEST_ASSERT_LESS_OR_EQUAL(50, (int)(1e7 * err));
+    TEST_ASSERT_LESS_OR_EQUAL(50, (int)(1e7 * err2));
+
+    for (int i = 0; i < N_SWEEP; i++) {
+        x[i] = -100 + 200.0f * i / (N_SWEEP - 1);
+    }
+    TEST_ESP_OK(dsps_sincos_f32(x, out, out2, N_SWEEP, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out[i] - sin(x[i])));
+        err = fmax(err, fabs(out2[i] - cos(x[i])));
+    }
+    ESP_LOGI(TAG, "sin/cos: maximum absolute error %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(2, (int)(1e7 * err));
+}
+
+TEST_CASE("dsps_fastmath_f32 strides", "[dsps]")
+{
+    // Phase and magnitude in dB of interleaved complex data
+    for (int i = 0; i < N_SWEEP; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    memset(out, 0, sizeof(out));
+    TEST_ESP_OK(dsps_atan2_f32(&x[1], &x[0], out, N_SWEEP / 2, 2, 2));
+    TEST_ESP_OK(dsps_db_f32(x, &out[1], N_SWEEP / 2, 20, 2, 2));
+    for (int i = 0; i < N_SWEEP / 2; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, atan2f(x[i * 2 + 1], x[i * 2]), out[i * 2]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, 20 * log10f(fabsf(x[i * 2])), out[i * 2 + 1]);
+    }
+    TEST_ESP_OK(dsps_sincos_f32(x, out, NULL, N_SWEEP, 1, 1));
+    for (int i = 0; i < N_SWEEP; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, sinf(x[i]), out[i]);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_exp_f32(NULL, out, N_SWEEP, 1, 1));
+}
+
+TEST_CASE("dsps_fastmath_f32 benchmark", "[dsps]")
+{
+    const char *names[] = {"log2", "dB", "exp", "atan2", "rsqrt", "sqrt", "sin/cos"};
+    for (int i = 0; i < N_SWEEP; i++) {
+        x[i] = 0.01f + (float)rand() / RAND_MAX;
+        y[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    for (int f = 0; f < sizeof(names) / sizeof(char *); f++) {
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        switch (f) {
+        case 0:
+            dsps_log2_f32(x, out, N_SWEEP, 1, 1);
+            break;
+        case 1:
+            dsps_db_f32(x, out, N_SWEEP, 20, 1, 1);
+            break;
+        case 2:
+            dsps_exp_f32(x, out, N_SWEEP, 1, 1);
+            break;
+        case 3:
+            dsps_atan2_f32(y, x, out, N_SWEEP, 1, 1);
+            break;
+        case 4:
+            dsps_rsqrt_f32(x, out, N_SWEEP, 1, 1);
+            break;
+        case 5:
+            dsps_sqrt_nr_f32(x, out, N_SWEEP, 1, 1);
+            break;
+        default:
+            dsps_sincos_f32(x, out, out2, N_SWEEP, 1, 1);
+            break;
+        }
+        unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < N_SWEEP; i++) {
+            switch (f) {
+            case 0:
+                out[i] = log2f(x[i]);
+                break;
+            case 1:
+                out[i] = 20 * log10f(x[i]);
+                break;
+            case 2:
+                out[i] = expf(x[i]);
+                break;
+            case 3:
+                out[i] = atan2f(y[i], x[i]);
+                break;
+            case 4:
+                out[i] = 1 / sqrtf(x[i]);
+                break;
+            case 5:
+                out[i] = sqrtf(x[i]);
+                break;
+            default:
+                out[i] = sinf(x[i]);
+                out2[i] = cosf(x[i]);
+                break;
+            }
+        }
+        unsigned int cycles_libm = dsp_get_cpu_cycle_count() - start_b;
+        ESP_LOGI(TAG, "%-8s: %5.1f cycles per value, libm %5.1f, speedup %.2f", names[f], (float)cycles / N_SWEEP,
+                 (float)cycles_libm / N_SWEEP, (float)cycles_libm / cycles);
+        TEST_ASSERT_EXEC_IN_RANGE(N_SWEEP, 200 * N_SWEEP, cycles);
+    }
+}
@@ -0,0 +1,149 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fastmath.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fastmath_fixed";
+
+#define N_SWEEP     4096
+
+static int32_t x32[N_SWEEP];
+static int32_t out32[N_SWEEP];
+static int16_t x16[N_SWEEP * 2];
+static int16_t out16[N_SWEEP];
+static int16_t out16_2[N_SWEEP];
+
+TEST_CASE("dsps_fastmath_fixed accuracy", "[dsps]")
+{
+    double err;
+    // log2 of 1..INT32_MAX
+    for (int i = 0; i < N_SWEEP; i++) {
+        x32[i] = (int32_t)pow(2, 31.0 * i / N_SWEEP);
+    }
+    TEST_ESP_OK(dsps_log2_s32(x32, out32, N_SWEEP, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out32[i] / 65536.0 - log2(x32[i])));
+    }
+    ESP_LOGI(TAG, "log2: maximum absolute error %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(21, (int)(1e6 * err));
+    x32[0] = 0;
+    TEST_ESP_OK(dsps_log2_s32(x32, out32, 1, 1, 1));
+    TEST_ASSERT_EQUAL(INT32_MIN, out32[0]);
+
+    // exp2 of 0..15 in Q16
+    for (int i = 0; i < N_SWEEP; i++) {
+        x32[i] = (int32_t)(15 * 65536.0 * i / N_SWEEP);
+    }
+    TEST_ESP_OK(dsps_exp2_s32(x32, out32, N_SWEEP, 1, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        err = fmax(err, fabs(out32[i] / (65536.0 * pow(2, x32[i] / 65536.0)) - 1));
+    }
+    ESP_LOGI(TAG, "exp2: maximum relative error %e", err);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6 * err));
+    x32[0] = -16 * 65536;
+    TEST_ESP_OK(dsps_exp2_s32(x32, out32, 1, 1, 1));
+    TEST_ASSERT_EQUAL(1, out32[0]);
+
+    // atan2 of interleaved complex data at all angles and radius from 100 to 32767
+    for (int i = 0; i < N_SWEEP; i++) {
+        float r = 100 + 32667.0f * (i % 64) / 63;
+        float a = -M_PI + 2 * M_PI * i / N_SWEEP;
+        x16[i * 2 + 0] = roundf(r * cosf(a));
+        x16[i * 2 + 1] = roundf(r * sinf(a));
+    }
+    TEST_ESP_OK(dsps_atan2_s16(&x16[1], &x16[0], out16, N_SWEEP, 2, 1));
+    err = 0;
+    for (int i = 0; i < N_SWEEP; i++) {
+        double ref = atan2(x16[i * 2 + 1], x16[i * 2 + 0]) * 32768 / M_PI;
+        double e = fabs(out16[i] - ref);
+        // -pi and pi are the same angle
+        err = fmax(err, fmin(e, 65536 - e));
+    }
+    ESP_LOGI(TAG, "atan2: maximum error %.2f LSB (%e rad)", err, err * M_PI / 32768);
+    TEST_ASSERT_LESS_OR_EQUAL(100, (int)(100 * err));
+
+    // sin/cos of all binary angles
+    int err_sc = 0;
+    for (int a = -32768; a < 32768; a += N_SWEEP) {
+        for (int i = 0; i < N_SWEEP; i++) {
+            x16[i] = a + i;
+        }
+        TEST_ESP_OK(dsps_sincos_s16(x16, out16, out16_2, N_SWEEP, 1, 1));
+        for (int i = 0; i < N_SWEEP; i++) {
+            double ang = x16[i] * M_PI / 32768;
+            int es = abs(out16[i] - (int)round(32767 * sin(ang)));
+            int ec = abs(out16_2[i] - (int)round(32767 * cos(ang)));
+            err_sc = (es > err_sc) ? es : err_sc;
+            err_sc = (ec > err_sc) ? ec : err_sc;
+        }
+    }
+    ESP_LOGI(TAG, "sin/cos: maximum error %i LSB", err_sc);
+    TEST_ASSERT_LESS_OR_EQUAL(1, err_sc);
+
+    // sqrt: the result is rounded to the nearest
+    srand(70);
+    for (int i = 0; i < N_SWEEP; i++) {
+        x32[i] = (i < 16) ? i : rand();
+    }
+    x32[N_SWEEP - 1] = INT32_MAX;
+    TEST_ESP_OK(dsps_sqrt_s32(x32, out32, N_SWEEP, 1, 1));
+    for (int i = 0; i < N_SWEEP; i++) {
+        TEST_ASSERT_EQUAL((int32_t)round(sqrt(x32[i])), out32[i]);
+    }
+}
+
+TEST_CASE("dsps_fastmath_fixed benchmark", "[dsps]")
+{
+    const char *names[] = {"log2", "exp2", "atan2", "sin/cos", "sqrt"};
+    srand(170);
+    for (int i = 0; i < N_SWEEP; i++) {
+        x32[i] = rand() >> 8;
+        x16[i * 2 + 0] = rand();
+        x16[i * 2 + 1] = rand();
+    }
+    for (int f = 0; f < sizeof(names) / sizeof(char *); f++) {
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        switch (f) {
+        case 0:
+            dsps_log2_s32(x32, out32, N_SWEEP, 1, 1);
+            break;
+        case 1:
+            dsps_exp2_s32(x32, out32, N_SWEEP, 1, 1);
+            break;
+        case 2:
+            dsps_atan2_s16(&x16[1], &x16[0], out16, N_SWEEP, 2, 1);
+            break;
+        case 3:
+            dsps_sincos_s16(x16, out16, out16_2, N_SWEEP, 1, 1);
+            break;
+        default:
+            dsps_sqrt_s32(x32, out32, N_SWEEP, 1, 1);
+            break;
+        }
+        unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+        ESP_LOGI(TAG, "%-8s: %5.1f cycles per value", names[f], (float)cycles / N_SWEEP);
+        TEST_ASSERT_EXEC_IN_RANGE(N_SWEEP, 200 * N_SWEEP, cycles);
+    }
+}
@@ -0,0 +1,256 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_qrs.h"
+#include "dsps_biquad_design.h"
+#include <string.h>
+#include <math.h>
+
+#define QRS_MASK (DSPS_QRS_HIST - 1)
+
+// Group delay of the bi quad cascade at frequency f (normalized), samples
+static float dsps_qrs_group_delay(const float *coeffs, int n_sect, float f)
+{
+    const float df = 1e-3f;
+    float phase[2] = {0, 0};
+    for (int k = 0; k < 2; k++) {
+        float w = 2 * M_PI * (f + (k ? df : -df));
+        for (int s = 0; s < n_sect; s++) {
+            const float *c = &coeffs[s * 5];
+            float num_re = c[0] + c[1] * cosf(w) + c[2] * cosf(2 * w);
+            float num_im = -c[1] * sinf(w) - c[2] * sinf(2 * w);
+            float den_re = 1 + c[3] * cosf(w) + c[4] * cosf(2 * w);
+            float den_im = -c[3] * sinf(w) - c[4] * sinf(2 * w);
+            phase[k] += atan2f(num_im, num_re) - atan2f(den_im, den_re);
+        }
+    }
+    float d = phase[1] - phase[0];
+    d -= 2 * M_PI * roundf(d / (2 * M_PI));
+    return -d / (2 * M_PI * 2 * df);
+}
+
+esp_err_t dsps_qrs_init_f32(qrs_f32_t *qrs, float fs)
+{
+    if (qrs == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((fs < 100) || (fs > 850)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    memset(qrs, 0, sizeof(qrs_f32_t));
+    float coeffs[5 * DSPS_BIQUAD_DESIGN_MAX_SECT];
+    int n_sect;
+    esp_err_t ret = dsps_biquad_design_f32(coeffs, &n_sect, DSPS_BIQUAD_BUTTER, DSPS_BIQUAD_BPF, DSPS_QRS_BP_SECT, 5 / fs, 15 / fs, 0);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    memcpy(qrs->coeffs, coeffs, sizeof(qrs->coeffs));
+    qrs->delay = (int)roundf(dsps_qrs_group_delay(qrs->coeffs, DSPS_QRS_BP_SECT, 10 / fs));
+    qrs->fs = fs;
+    qrs->mwi_len = (int)roundf(0.15f * fs);
+    qrs->refractory = (int)roundf(0.2f * fs);
+    qrs->t_wave = (int)roundf(0.36f * fs);
+    qrs->learn = (int)roundf(2 * fs);
+    qrs->r_search = (int)roundf(0.05f * fs);
+    return dsps_movavg_init_f32(&qrs->mwi, qrs->mwi_delay, qrs->mwi_len);
+}
+
+static float dsps_qrs_average(const uint32_t *rr, int n)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += rr[i];
+    }
+    return (float)sum / n;
+}
+
+static void dsps_qrs_thresholds(qrs_f32_t *qrs)
+{
+    qrs->thr1 = qrs->npki + 0.25f * (qrs->spki - qrs->npki);
+    if (qrs->irregular) {
+        qrs->thr1 *= 0.5f;
+    }
+    qrs->thr2 = 0.5f * qrs->thr1;
+}
+
+// Register the beat with R peak at r, found by the integrator peak at pos
+static int dsps_qrs_beat(qrs_f32_t *qrs, uint32_t r, uint32_t pos, float slope, int searchback, dsps_qrs_beat_t *beat)
+{
+    if ((qrs->n_beats > 0) && ((int32_t)(r - qrs->last_r) <= 0)) {
+        return 0;
+    }
+    uint32_t rr = (qrs->n_beats > 0) ? r - qrs->last_r : 0;
+    qrs->last_qrs = pos;
+    qrs->last_r = r;
+    qrs->last_slope = slope;
+    qrs->cand_peak = 0;
+    qrs->n_beats = (qrs->n_beats < 2) ? qrs->n_beats + 1 : 2;
+    if (rr > 0) {
+        qrs->rr1[qrs->pos_rr1] = rr;
+        qrs->pos_rr1 = (qrs->pos_rr1 + 1) % DSPS_QRS_RR_AVG;
+        qrs->n_rr1 += (qrs->n_rr1 < DSPS_QRS_RR_AVG);
+        qrs->rr_avg1 = dsps_qrs_average(qrs->rr1, qrs->n_rr1);
+        if ((qrs->n_rr2 == 0) || ((rr > 0.92f * qrs->rr_avg2) && (rr < 1.16f * qrs->rr_avg2))) {
+            qrs->rr2[qrs->pos_rr2] = rr;
+            qrs->pos_rr2 = (qrs->pos_rr2 + 1) % DSPS_QRS_RR_AVG;
+            qrs->n_rr2 += (qrs->n_rr2 < DSPS_QRS_RR_AVG);
+            qrs->irregular = 0;
+        } else if (++qrs->irregular >= DSPS_QRS_RR_AVG) {
+            // The rhythm has changed: restart the regular average from the last intervals
+            memcpy(qrs->rr2, qrs->rr1, sizeof(qrs->rr2));
+            qrs->n_rr2 = qrs->n_rr1;
+            qrs->pos_rr2 = qrs->pos_rr1;
+            qrs->irregular = 0;
+        }
+        qrs->rr_avg2 = dsps_qrs_average(qrs->rr2, qrs->n_rr2);
+    }
+    dsps_qrs_thresholds(qrs);
+    if (beat != NULL) {
+        beat->r_pos = r;
+        beat->rr = rr;
+        beat->hr = (rr > 0) ? 60 * qrs->fs / rr : 0;
+        beat->hr_avg = (qrs->n_rr1 > 0) ? 60 * qrs->fs / qrs->rr_avg1 : 0;
+        beat->searchback = searchback;
+    }
+    return 1;
+}
+
+// Classify the peak of the integrated signal at position pos
+static int dsps_qrs_peak(qrs_f32_t *qrs, uint32_t pos, float peak, dsps_qrs_beat_t *beat)
+{
+    if ((qrs->n_beats > 0) && (pos - qrs->last_qrs < (uint32_t)qrs->refractory)) {
+        return 0;
+    }
+    if (peak <= qrs->thr2) {
+        qrs->npki = 0.125f * peak + 0.875f * qrs->npki;
+        dsps_qrs_thresholds(qrs);
+        return 0;
+    }
+    // R peak and the maximum slope in the integration window
+    float slope = 0;
+    float r_val = 0;
+    uint32_t r = pos;
+    for (int k = 0; k < qrs->mwi_len; k++) {
+        int h = (pos - k) & QRS_MASK;
+        float d = fabsf(qrs->der[h]);
+        float b = fabsf(qrs->bp[h]);
+        slope = (d > slope) ? d : slope;
+        if (b > r_val) {
+            r_val = b;
+            r = pos - k;
+        }
+    }
+    r = (r > (uint32_t)qrs->delay) ? r - qrs->delay : 0;
+
+    // Refine the R peak in the input signal
+    uint32_t lo = (r > (uint32_t)qrs->r_search) ? r - qrs->r_search : 0;
+    uint32_t hi = r + qrs->r_search;
+    hi = (hi > qrs->n) ? qrs->n : hi;
+    float mean = 0;
+    for (uint32_t k = lo; k <= hi; k++) {
+        mean += qrs->raw[k & QRS_MASK];
+    }
+    mean /= (hi - lo + 1);
+    r_val = 0;
+    for (uint32_t k = lo; k <= hi; k++) {
+        float dev = fabsf(qrs->raw[k & QRS_MASK] - mean);
+        if (dev > r_val) {
+            r_val = dev;
+            r = k;
+        }
+    }
+
+    if (peak > qrs->thr1) {
+        int t_wave = (qrs->n_beats > 0) && (pos - qrs->last_qrs < (uint32_t)qrs->t_wave) && (slope < 0.5f * qrs->last_slope);
+        if (!t_wave) {
+            qrs->spki = 0.125f * peak + 0.875f * qrs->spki;
+            return dsps_qrs_beat(qrs, r, pos, slope, 0, beat);
+        }
+    } else if (peak > qrs->cand_peak) {
+        qrs->cand_peak = peak;
+        qrs->cand_slope = slope;
+        qrs->cand_r = r;
+        qrs->cand_pos = pos;
+    }
+    qrs->npki = 0.125f * peak + 0.875f * qrs->npki;
+    dsps_qrs_thresholds(qrs);
+    return 0;
+}
+
+int dsps_qrs_f32(qrs_f32_t *qrs, const float *input, int len, dsps_qrs_beat_t *beats, int max_beats)
+{
+    int count = 0;
+    float scale = qrs->fs / 8;
+    for (int i = 0; i < len; i++) {
+        uint32_t n = qrs->n;
+        float v = input[i];
+        qrs->raw[n & QRS_MASK] = v;
+        if (n == 0) {
+            // Start from the steady state of the first sample, to avoid the transient of the offset
+            float x = v;
+            for (int s = 0; s < DSPS_QRS_BP_SECT; s++) {
+                const float *c = &qrs->coeffs[s * 5];
+                float st = x / (1 + c[3] + c[4]);
+                qrs->w[s * 2 + 0] = st;
+                qrs->w[s * 2 + 1] = st;
+                x = (c[0] + c[1] + c[2]) * st;
+            }
+        }
+        // Band pass filter, direct form II
+        for (int s = 0; s < DSPS_QRS_BP_SECT; s++) {
+            const float *c = &qrs->coeffs[s * 5];
+            float *w = &qrs->w[s * 2];
+            float d0 = v - c[3] * w[0] - c[4] * w[1];
+            v = c[0] * d0 + c[1] * w[0] + c[2] * w[1];
+            w[1] = w[0];
+            w[0] = d0;
+        }
+        int h = n & QRS_MASK;
+        qrs->bp[h] = v;
+        // Five point derivative
+        float d = (2 * v + qrs->bp[(n - 1) & QRS_MASK] - qrs->bp[(n - 3) & QRS_MASK] - 2 * qrs->bp[(n - 4) & QRS_MASK]) * scale;
+        qrs->der[h] = d;
+        float sq = d * d;
+        float m;
+        dsps_movavg_f32(&qrs->mwi, &sq, &m, 1);
+
+        int found = 0;
+        dsps_qrs_beat_t *beat = (count < max_beats) ? &beats[count] : NULL;
+        if (n < (uint32_t)qrs->learn) {
+            // Learning of the initial thresholds
+            qrs->learn_max = (m > qrs->learn_max) ? m : qrs->learn_max;
+            qrs->learn_sum += m;
+            if (n == (uint32_t)qrs->learn - 1) {
+                qrs->spki = qrs->learn_max / 3;
+                qrs->npki = 0.5f * qrs->learn_sum / qrs->learn;
+                dsps_qrs_thresholds(qrs);
+            }
+        } else {
+            if ((qrs->mwi1 > qrs->mwi2) && (qrs->mwi1 >= m)) {
+                found = dsps_qrs_peak(qrs, n - 1, qrs->mwi1, beat);
+            }
+            // Search back for a missed beat with the lower threshold
+            if (!found && (qrs->n_rr2 > 0) && (qrs->cand_peak > 0) && ((float)(n - qrs->last_qrs) > 1.66f * qrs->rr_avg2)) {
+                qrs->spki = 0.25f * qrs->cand_peak + 0.75f * qrs->spki;
+                found = dsps_qrs_beat(qrs, qrs->cand_r, qrs->cand_pos, qrs->cand_slope, 1, beat);
+                qrs->cand_peak = 0;
+            }
+        }
+        qrs->mwi2 = qrs->mwi1;
+        qrs->mwi1 = m;
+        qrs->n++;
+        count += found && (beat != NULL);
+    }
+    return count;
+}
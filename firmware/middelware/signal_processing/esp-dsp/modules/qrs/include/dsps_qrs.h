@@ -0,0 +1,137 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_qrs_H_
+#define _dsps_qrs_H_
+
+#include "dsp_err.h"
+#include "dsps_smooth.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_QRS_HIST       256 /*!< Length of the history of the signals, power of two. Limits the sample frequency to 850 Hz.*/
+#define DSPS_QRS_RR_AVG     8   /*!< Amount of RR intervals in the averages.*/
+#define DSPS_QRS_BP_SECT    2   /*!< Amount of bi quad sections of the band pass filter.*/
+
+/**
+ * @brief Detected heart beat
+ */
+typedef struct dsps_qrs_beat_s {
+    uint32_t    r_pos;      /*!< Position of the R peak, samples from the start of the detector.*/
+    uint32_t    rr;         /*!< Interval from the previous R peak, samples. 0 for the first beat.*/
+    float       hr;         /*!< Instantaneous heart rate, beats per minute. 0 for the first beat.*/
+    float       hr_avg;     /*!< Heart rate by the average of the last DSPS_QRS_RR_AVG intervals, beats per minute.*/
+    int         searchback; /*!< 1 if the beat was found by the search back with the lower threshold.*/
+} dsps_qrs_beat_t;
+
+/**
+ * @brief Data struct of f32 QRS detector
+ *
+ * This structure is used by a detector internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_qrs_init_f32(...) function.
+ */
+typedef struct qrs_f32_s {
+    float       fs;                             /*!< Sample frequency, Hz.*/
+    float       coeffs[5 * DSPS_QRS_BP_SECT];   /*!< Band pass filter coefficients.*/
+    float       w[2 * DSPS_QRS_BP_SECT];        /*!< Band pass filter delay lines.*/
+    float       raw[DSPS_QRS_HIST];             /*!< History of the input signal.*/
+    float       bp[DSPS_QRS_HIST];              /*!< History of the band pass filtered signal.*/
+    float       der[DSPS_QRS_HIST];             /*!< History of the derivative.*/
+    float       mwi_delay[DSPS_QRS_HIST];       /*!< Delay line of the moving window integrator.*/
+    movavg_f32_t mwi;                           /*!< Moving window integrator of the squared derivative.*/
+    float       mwi1;                           /*!< Output of the integrator one sample before.*/
+    float       mwi2;                           /*!< Output of the integrator two samples before.*/
+    float       spki;                           /*!< Running estimate of the signal (QRS) peak.*/
+    float       npki;                           /*!< Running estimate of the noise peak.*/
+    float       thr1;                           /*!< Detection threshold.*/
+    float       thr2;                           /*!< Search back threshold.*/
+    float       learn_max;                      /*!< Maximum of the integrator in the learning period.*/
+    float       learn_sum;                      /*!< Sum of the integrator in the learning period.*/
+    float       last_slope;                     /*!< Maximum slope of the last QRS.*/
+    float       cand_peak;                      /*!< Highest peak above thr2 since the last QRS, for the search back. 0 - none.*/
+    float       cand_slope;                     /*!< Maximum slope of the search back candidate.*/
+    uint32_t    cand_r;                         /*!< Position of the R peak of the search back candidate.*/
+    uint32_t    cand_pos;                       /*!< Position of the integrator peak of the search back candidate.*/
+    uint32_t    rr1[DSPS_QRS_RR_AVG];           /*!< Last RR intervals.*/
+    uint32_t    rr2[DSPS_QRS_RR_AVG];           /*!< Last RR intervals in the regular range.*/
+    float       rr_avg1;                        /*!< Average of rr1.*/
+    float       rr_avg2;                        /*!< Average of rr2.*/
+    uint32_t    n;                              /*!< Amount of processed samples.*/
+    uint32_t    last_qrs;                       /*!< Position of the integrator peak of the last QRS.*/
+    uint32_t    last_r;                         /*!< Position of the last R peak.*/
+    int         n_beats;                        /*!< Amount of detected beats, saturated to 2.*/
+    int         n_rr1;                          /*!< Amount of intervals in rr1.*/
+    int         pos_rr1;                        /*!< Position of the oldest interval in rr1.*/
+    int         n_rr2;                          /*!< Amount of intervals in rr2.*/
+    int         pos_rr2;                        /*!< Position of the oldest interval in rr2.*/
+    int         irregular;                      /*!< Amount of consecutive intervals out of the regular range.*/
+    int         mwi_len;                        /*!< Length of the integration window, samples.*/
+    int         refractory;                     /*!< Refractory period, samples.*/
+    int         t_wave;                         /*!< Interval after QRS with the T wave check, samples.*/
+    int         learn;                          /*!< Length of the learning period, samples.*/
+    int         delay;                          /*!< Group delay of the band pass filter, samples.*/
+    int         r_search;                       /*!< Half width of the R peak search window in the input signal, samples.*/
+} qrs_f32_t;
+
+/**
+ * @brief   initialize structure for QRS detector
+ *
+ * @param qrs: pointer to the detector structure, that must be preallocated
+ * @param fs: sample frequency in Hz, 100..850
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_qrs_init_f32(qrs_f32_t *qrs, float fs);
+
+/**
+ * @brief   QRS detector (Pan-Tompkins)
+ *
+ * Real time detector of the QRS complexes of ECG by Pan and Tompkins:
+ * band pass filter 5..15 Hz (Butterworth, DSPS_QRS_BP_SECT sections), 5 point derivative, squaring and
+ * moving window integration (150 ms). The peaks of the integrated signal are classified by the
+ * adaptive thresholds of signal and noise peaks, with 200 ms refractory period, T wave discrimination
+ * by the slope up to 360 ms after QRS, and search back with the half threshold if no QRS was found
+ * for 166% of the average regular RR interval. The thresholds are halved for irregular rhythm.
+ * The first 2 seconds are used to learn the initial thresholds, no beats are reported.
+ * The R peak is located as the maximum of the filtered signal in the integration window,
+ * compensated by the delay of the filter, and refined to the largest deviation of the input signal
+ * from its mean within +-50 ms.
+ * The beat is reported after the end of the QRS (about 150..250 ms after the R peak), or later if found by search back.
+ * The cost per sample is constant, except for the samples with the peaks of the integrated signal,
+ * where the integration window is scanned.
+ * The input could be processed by blocks of any length, also one sample.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param qrs: pointer to the detector structure, that must be initialized before
+ * @param[in] input: ECG samples, any scale and offset
+ * @param len: length of input array
+ * @param beats: array for the detected beats
+ * @param max_beats: length of beats array. If more beats are detected in the block, they are lost
+ *
+ * @return
+ *      - amount of beats detected in the block
+ */
+int dsps_qrs_f32(qrs_f32_t *qrs, const float *input, int len, dsps_qrs_beat_t *beats, int max_beats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_qrs_H_
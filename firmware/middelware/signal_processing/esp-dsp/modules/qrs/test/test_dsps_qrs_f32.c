@@ -0,0 +1,236 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_qrs.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_qrs_f32";
+
+#define FS          250
+#define SIG_LEN     (FS * 120)
+#define MAX_BEATS   300
+
+// ECG beats of projects/proyecto2_e4, R peak at ECG_R and OTRO_ECG_R
+#define ECG_R       132
+#define OTRO_ECG_R  96
+
+static const uint8_t ecg[231] = {
+    76, 77, 78, 77, 79, 86, 81, 76, 84, 93, 85, 80, 89, 95, 89, 85, 93, 98, 94, 88,
+    98, 105, 96, 91, 99, 105, 101, 96, 102, 106, 101, 96, 100, 107, 101, 94, 100, 104, 100, 91,
+    99, 103, 98, 91, 96, 105, 95, 88, 95, 100, 94, 85, 93, 99, 92, 84, 91, 96, 87, 80,
+    83, 92, 86, 78, 84, 89, 79, 73, 81, 83, 78, 70, 80, 82, 79, 69, 80, 82, 81, 70,
+    75, 81, 77, 74, 79, 83, 82, 72, 80, 87, 79, 76, 85, 95, 87, 81, 88, 93, 88, 84,
+    87, 94, 86, 82, 85, 94, 85, 82, 85, 95, 86, 83, 92, 99, 91, 88, 94, 98, 95, 90,
+    97, 105, 104, 94, 98, 114, 117, 124, 144, 180, 210, 236, 253, 227, 171, 99, 49, 34, 29, 43,
+    69, 89, 89, 90, 98, 107, 104, 98, 104, 110, 102, 98, 103, 111, 101, 94, 103, 108, 102, 95,
+    97, 106, 100, 92, 101, 103, 100, 94, 98, 103, 96, 90, 98, 103, 97, 90, 99, 104, 95, 90,
+    99, 104, 100, 93, 100, 106, 101, 93, 101, 105, 103, 96, 105, 112, 105, 99, 103, 108, 99, 96,
+    102, 106, 99, 90, 92, 100, 87, 80, 82, 88, 77, 69, 75, 79, 74, 67, 71, 78, 72, 67,
+    73, 81, 77, 71, 75, 84, 79, 77, 77, 76, 76,
+};
+
+static const uint8_t otro_ecg[256] = {
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 17, 17, 17, 17, 17, 17,
+    17, 18, 18, 18, 18, 18, 18, 18, 17, 17, 16, 16, 16, 16, 17, 17, 18, 18, 18, 17,
+    17, 17, 17, 18, 18, 19, 21, 22, 24, 25, 26, 27, 28, 29, 31, 32, 33, 34, 34, 35,
+    37, 38, 37, 34, 29, 24, 19, 15, 14, 15, 16, 17, 17, 17, 16, 15, 14, 13, 13, 13,
+    13, 13, 13, 13, 12, 12, 10, 6, 2, 3, 15, 43, 88, 145, 199, 237, 252, 242, 211, 167,
+    117, 70, 35, 16, 14, 22, 32, 38, 37, 32, 27, 24, 24, 26, 27, 28, 28, 27, 28, 28,
+    30, 31, 31, 31, 32, 33, 34, 36, 38, 39, 40, 41, 42, 43, 45, 47, 49, 51, 53, 55,
+    57, 60, 62, 65, 68, 71, 75, 79, 83, 87, 92, 97, 101, 106, 111, 116, 121, 125, 129, 133,
+    136, 138, 139, 140, 140, 139, 137, 133, 129, 123, 117, 109, 101, 92, 84, 77, 70, 64, 58, 52,
+    47, 42, 39, 36, 34, 31, 30, 28, 27, 26, 25, 25, 25, 25, 25, 25, 25, 25, 24, 24,
+    24, 24, 25, 25, 25, 25, 25, 25, 25, 24, 24, 24, 24, 24, 24, 24, 24, 23, 23, 22,
+    22, 21, 21, 21, 20, 20, 20, 20, 20, 19, 19, 18, 18, 18, 19, 19, 19, 19, 18, 17,
+    17, 18, 18, 18, 18, 18, 18, 18, 18, 17, 17, 17, 17, 17, 17, 17,
+};
+
+static float signal[SIG_LEN];
+static uint32_t r_ref[MAX_BEATS];
+static dsps_qrs_beat_t beats[MAX_BEATS];
+
+static float gauss_noise(void)
+{
+    float u1 = ((float)rand() + 1) / ((float)RAND_MAX + 2);
+    float u2 = (float)rand() / RAND_MAX;
+    return sqrtf(-2 * logf(u1)) * cosf(2 * M_PI * u2);
+}
+
+// Run the detector by blocks of random length, returns amount of beats
+static int run_detector(const float *sig, int len, float fs)
+{
+    qrs_f32_t qrs;
+    TEST_ESP_OK(dsps_qrs_init_f32(&qrs, fs));
+    int pos = 0;
+    int n = 0;
+    while (pos < len) {
+        int block = 1 + rand() % 64;
+        block = (block > len - pos) ? len - pos : block;
+        n += dsps_qrs_f32(&qrs, &sig[pos], block, &beats[n], MAX_BEATS - n);
+        pos += block;
+    }
+    return n;
+}
+
+// Match the detected beats to the reference within the window, returns amount of true positives
+static int match_beats(int n_det, const uint32_t *ref, int n_ref, uint32_t start, int window, int *max_err)
+{
+    int tp = 0;
+    int j = 0;
+    *max_err = 0;
+    for (int i = 0; i < n_ref; i++) {
+        if (ref[i] < start) {
+            continue;
+        }
+        while ((j < n_det) && ((int)beats[j].r_pos < (int)ref[i] - window)) {
+            j++;
+        }
+        if ((j < n_det) && (abs((int)beats[j].r_pos - (int)ref[i]) <= window)) {
+            int err = abs((int)beats[j].r_pos - (int)ref[i]);
+            *max_err = (err > *max_err) ? err : *max_err;
+            tp++;
+            j++;
+        }
+    }
+    return tp;
+}
+
+TEST_CASE("dsps_qrs_f32 ECG tables", "[dsps]")
+{
+    const uint8_t *tables[] = {ecg, otro_ecg};
+    const int lens[] = {sizeof(ecg), sizeof(otro_ecg)};
+    const int r_pos[] = {ECG_R, OTRO_ECG_R};
+    for (int t = 0; t < 2; t++) {
+        // The beat is repeated, as by the DAC of the project
+        int len = 60 * FS;
+        int n_ref = 0;
+        for (int i = 0; i < len; i++) {
+            signal[i] = tables[t][i % lens[t]];
+            if (i % lens[t] == r_pos[t]) {
+                r_ref[n_ref++] = i;
+            }
+        }
+        int n = run_detector(signal, len, FS);
+        int max_err;
+        int tp = match_beats(n, r_ref, n_ref, 2 * FS, FS / 10, &max_err);
+        int expected = 0;
+        for (int i = 0; i < n_ref; i++) {
+            expected += (r_ref[i] >= 2 * FS);
+        }
+        float hr = 60.0f * FS / lens[t];
+        ESP_LOGI(TAG, "table %i: %i beats of %i, max R error %i samples, HR %.1f (avg %.1f), expected %.1f",
+                 t, tp, expected, max_err, beats[n - 1].hr, beats[n - 1].hr_avg, hr);
+        TEST_ASSERT_EQUAL(expected, tp);
+        TEST_ASSERT_EQUAL(expected, n);
+        TEST_ASSERT_LESS_OR_EQUAL(3, max_err);
+        for (int i = 1; i < n; i++) {
+            TEST_ASSERT_EQUAL(lens[t], beats[i].rr);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, hr, beats[n - 1].hr_avg);
+    }
+}
+
+// Synthetic ECG: sum of gaussian waves (P, Q, R, S, T) of the beat at the time of R peak
+static void add_beat(float *sig, int len, float r_time, float amp, float fs)
+{
+    const float t_wave[5] = {-0.2f, -0.03f, 0, 0.03f, 0.3f};
+    const float a_wave[5] = {0.12f, -0.15f, 1.0f, -0.25f, 0.3f};
+    const float w_wave[5] = {0.025f, 0.01f, 0.012f, 0.01f, 0.06f};
+    int start = (int)((r_time - 0.4f) * fs);
+    int end = (int)((r_time + 0.6f) * fs);
+    start = (start < 0) ? 0 : start;
+    end = (end > len) ? len : end;
+    for (int i = start; i < end; i++) {
+        float t = i / fs - r_time;
+        for (int k = 0; k < 5; k++) {
+            float x = (t - t_wave[k]) / w_wave[k];
+            sig[i] += amp * a_wave[k] * expf(-0.5f * x * x);
+        }
+    }
+}
+
+TEST_CASE("dsps_qrs_f32 synthetic ECG", "[dsps]")
+{
+    const float fs_list[] = {250, 360, 500};
+    srand(61);
+    for (int f = 0; f < sizeof(fs_list) / sizeof(float); f++) {
+        float fs = fs_list[f];
+        int len = (int)(100 * fs);
+        len = (len > SIG_LEN) ? SIG_LEN : len;
+        memset(signal, 0, len * sizeof(float));
+        // Heart rate variability, rate change from 60 to 110 bpm, amplitude modulation by breathing
+        // and one weak beat, below the detection threshold, that is found by the search back
+        int n_ref = 0;
+        float t = 0.5f;
+        while ((t < len / fs - 0.6f) && (n_ref < MAX_BEATS)) {
+            float base_rr = (t < 50) ? 1.0f : 0.55f;
+            float amp = 1 + 0.2f * sinf(2 * M_PI * 0.25f * t);
+            if (n_ref == 40) {
+                amp = 0.38f;
+            }
+            add_beat(signal, len, t, amp, fs);
+            r_ref[n_ref++] = (uint32_t)roundf(t * fs);
+            t += base_rr * (1 + 0.05f * sinf(2 * M_PI * 0.1f * t) + 0.03f * gauss_noise());
+        }
+        // Baseline wander, powerline and white noise
+        for (int i = 0; i < len; i++) {
+            float ti = i / fs;
+            signal[i] = 1000 * signal[i] + 300 * sinf(2 * M_PI * 0.3f * ti) + 20 * sinf(2 * M_PI * 50 * ti) + 20 * gauss_noise() + 2000;
+        }
+        int n = run_detector(signal, len, fs);
+        int max_err;
+        int tp = match_beats(n, r_ref, n_ref, (uint32_t)(2 * fs), (int)(0.075f * fs), &max_err);
+        int expected = 0;
+        for (int i = 0; i < n_ref; i++) {
+            expected += (r_ref[i] >= 2 * fs);
+        }
+        int searchback = 0;
+        for (int i = 0; i < n; i++) {
+            searchback += beats[i].searchback;
+        }
+        ESP_LOGI(TAG, "fs %.0f: detected %i, true %i of %i, search back %i, max R error %.1f ms, last HR %.1f",
+                 fs, n, tp, expected, searchback, max_err * 1000 / fs, beats[n - 1].hr_avg);
+        TEST_ASSERT_EQUAL(expected, tp);
+        TEST_ASSERT_EQUAL(expected, n);
+        // Only the weak beat could need the search back
+        TEST_ASSERT_LESS_OR_EQUAL(1, searchback);
+        TEST_ASSERT_LESS_OR_EQUAL((int)(0.02f * fs), max_err);
+        TEST_ASSERT_FLOAT_WITHIN(10, 60 / 0.55f, beats[n - 1].hr_avg);
+    }
+    qrs_f32_t qrs;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_qrs_init_f32(&qrs, 1000));
+}
+
+TEST_CASE("dsps_qrs_f32 benchmark", "[dsps]")
+{
+    int len = 10 * FS;
+    for (int i = 0; i < len; i++) {
+        signal[i] = ecg[i % sizeof(ecg)];
+    }
+    qrs_f32_t qrs;
+    TEST_ESP_OK(dsps_qrs_init_f32(&qrs, FS));
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_qrs_f32(&qrs, signal, len, beats, MAX_BEATS);
+    unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+    ESP_LOGI(TAG, "%i cycles per sample", cycles / len);
+    TEST_ASSERT_EXEC_IN_RANGE(len, 500 * len, cycles);
+}
@@ -0,0 +1,65 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_smooth.h"
+#include <string.h>
+
+esp_err_t dsps_movavg_init_f32(movavg_f32_t *ma, float *delay, int len)
+{
+    if ((ma == NULL) || (delay == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    memset(delay, 0, len * sizeof(float));
+    ma->delay = delay;
+    ma->len = len;
+    ma->pos = 0;
+    ma->count = 0;
+    ma->sum = 0;
+    ma->comp = 0;
+    return ESP_OK;
+}
+
+esp_err_t dsps_movavg_f32(movavg_f32_t *ma, const float *input, float *output, int len)
+{
+    if ((ma == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    float scale = 1.0f / ma->len;
+    for (int i = 0; i < len; i++) {
+        float x = input[i];
+        // Kahan summation of the difference between the new and the oldest sample
+        float y = (x - ma->delay[ma->pos]) - ma->comp;
+        float t = ma->sum + y;
+        ma->comp = (t - ma->sum) - y;
+        ma->sum = t;
+        ma->delay[ma->pos] = x;
+        ma->pos++;
+        if (ma->pos >= ma->len) {
+            ma->pos = 0;
+        }
+        if (ma->count < ma->len) {
+            ma->count++;
+            output[i] = ma->sum / ma->count;
+        } else {
+            output[i] = ma->sum * scale;
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,162 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_smooth.h"
+
+// Amount of samples in the min-heap (upper half, positive indexes) and in the max-heap (lower half, negative indexes).
+// The median heap[0] is not counted.
+#define MIN_COUNT(mm) (((mm)->count - 1) / 2)
+#define MAX_COUNT(mm) ((mm)->count / 2)
+
+static inline int dsps_movmedian_less(movmedian_f32_t *mm, int i, int j)
+{
+    return mm->data[mm->heap[i]] < mm->data[mm->heap[j]];
+}
+
+static inline void dsps_movmedian_exchange(movmedian_f32_t *mm, int i, int j)
+{
+    int t = mm->heap[i];
+    mm->heap[i] = mm->heap[j];
+    mm->heap[j] = t;
+    mm->pos[mm->heap[i]] = i;
+    mm->pos[mm->heap[j]] = j;
+}
+
+// Exchange items i and j if heap[i] < heap[j], returns 1 if exchanged
+static inline int dsps_movmedian_cmp_exchange(movmedian_f32_t *mm, int i, int j)
+{
+    if (dsps_movmedian_less(mm, i, j)) {
+        dsps_movmedian_exchange(mm, i, j);
+        return 1;
+    }
+    return 0;
+}
+
+// Restore the min-heap property below item i/2
+static void dsps_movmedian_min_down(movmedian_f32_t *mm, int i)
+{
+    for (; i <= MIN_COUNT(mm); i *= 2) {
+        if ((i > 1) && (i < MIN_COUNT(mm)) && dsps_movmedian_less(mm, i + 1, i)) {
+            i++;
+        }
+        if (!dsps_movmedian_cmp_exchange(mm, i, i / 2)) {
+            break;
+        }
+    }
+}
+
+// Restore the max-heap property below item i/2 (negative indexes)
+static void dsps_movmedian_max_down(movmedian_f32_t *mm, int i)
+{
+    for (; i >= -MAX_COUNT(mm); i *= 2) {
+        if ((i < -1) && (i > -MAX_COUNT(mm)) && dsps_movmedian_less(mm, i, i - 1)) {
+            i--;
+        }
+        if (!dsps_movmedian_cmp_exchange(mm, i / 2, i)) {
+            break;
+        }
+    }
+}
+
+// Move item i of the min-heap up, returns 1 if it became the median
+static int dsps_movmedian_min_up(movmedian_f32_t *mm, int i)
+{
+    while ((i > 0) && dsps_movmedian_cmp_exchange(mm, i, i / 2)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+// Move item i of the max-heap up, returns 1 if it became the median
+static int dsps_movmedian_max_up(movmedian_f32_t *mm, int i)
+{
+    while ((i < 0) && dsps_movmedian_cmp_exchange(mm, i / 2, i)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+esp_err_t dsps_movmedian_init_f32(movmedian_f32_t *mm, float *data, int *index, int len)
+{
+    if ((mm == NULL) || (data == NULL) || (index == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len <= 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    mm->data = data;
+    mm->pos = index;
+    mm->heap = index + len + len / 2;
+    mm->len = len;
+    mm->idx = 0;
+    mm->count = 0;
+    // Slots are placed alternately to the min-heap and to the max-heap, starting from the median
+    for (int i = 0; i < len; i++) {
+        data[i] = 0;
+        mm->pos[i] = ((i + 1) / 2) * ((i & 1) ? -1 : 1);
+        mm->heap[mm->pos[i]] = i;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_movmedian_f32(movmedian_f32_t *mm, const float *input, float *output, int len)
+{
+    if ((mm == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    for (int n = 0; n < len; n++) {
+        float v = input[n];
+        int is_new = mm->count < mm->len;
+        int p = mm->pos[mm->idx];
+        float old = mm->data[mm->idx];
+        mm->data[mm->idx] = v;
+        mm->idx++;
+        if (mm->idx >= mm->len) {
+            mm->idx = 0;
+        }
+        mm->count += is_new;
+
+        // The new sample takes the place of the oldest one
+        if (p > 0) {
+            if (!is_new && (old < v)) {
+                dsps_movmedian_min_down(mm, p * 2);
+            } else if (dsps_movmedian_min_up(mm, p)) {
+                dsps_movmedian_max_down(mm, -1);
+            }
+        } else if (p < 0) {
+            if (!is_new && (v < old)) {
+                dsps_movmedian_max_down(mm, p * 2);
+            } else if (dsps_movmedian_max_up(mm, p)) {
+                dsps_movmedian_min_down(mm, 1);
+            }
+        } else {
+            if (MAX_COUNT(mm)) {
+                dsps_movmedian_max_down(mm, -1);
+            }
+            if (MIN_COUNT(mm)) {
+                dsps_movmedian_min_down(mm, 1);
+            }
+        }
+
+        float median = mm->data[mm->heap[0]];
+        if ((mm->count & 1) == 0) {
+            median = 0.5f * (median + mm->data[mm->heap[-1]]);
+        }
+        output[n] = median;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,138 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_smooth.h"
+#include "dsps_dotprod.h"
+#include <string.h>
+#include <math.h>
+
+#define SAVGOL_MAX_ORDER 8
+
+esp_err_t dsps_savgol_gen_f32(float *coeffs, int half_len, int poly_order, int deriv)
+{
+    if (coeffs == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((half_len <= 0) || (poly_order < 0) || (poly_order > SAVGOL_MAX_ORDER) || (poly_order >= 2 * half_len + 1)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((deriv < 0) || (deriv > poly_order)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int n = poly_order + 1;
+    // Normal equations G*x = e_deriv, G = A'*A, A[i][j] = u_i^j, u_i = i/half_len.
+    // Offsets are scaled to -1..1 to keep G well conditioned.
+    double g[SAVGOL_MAX_ORDER + 1][SAVGOL_MAX_ORDER + 2];
+    double moment[2 * SAVGOL_MAX_ORDER + 1] = {0};
+    for (int i = -half_len; i <= half_len; i++) {
+        double u = (double)i / half_len;
+        double p = 1;
+        for (int k = 0; k < 2 * n - 1; k++) {
+            moment[k] += p;
+            p *= u;
+        }
+    }
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            g[r][c] = moment[r + c];
+        }
+        g[r][n] = (r == deriv) ? 1 : 0;
+    }
+    // Gauss-Jordan elimination with partial pivoting
+    for (int c = 0; c < n; c++) {
+        int piv = c;
+        for (int r = c + 1; r < n; r++) {
+            if (fabs(g[r][c]) > fabs(g[piv][c])) {
+                piv = r;
+            }
+        }
+        for (int k = 0; k <= n; k++) {
+            double t = g[c][k];
+            g[c][k] = g[piv][k];
+            g[piv][k] = t;
+        }
+        for (int r = 0; r < n; r++) {
+            if (r == c) {
+                continue;
+            }
+            double f = g[r][c] / g[c][c];
+            for (int k = c; k <= n; k++) {
+                g[r][k] -= f * g[c][k];
+            }
+        }
+    }
+    // coeffs[i] = deriv! * sum(x[j]*u_i^j) / half_len^deriv
+    double scale = 1;
+    for (int k = 1; k <= deriv; k++) {
+        scale *= (double)k / half_len;
+    }
+    for (int i = -half_len; i <= half_len; i++) {
+        double u = (double)i / half_len;
+        double p = 1;
+        double acc = 0;
+        for (int j = 0; j < n; j++) {
+            acc += g[j][n] / g[j][j] * p;
+            p *= u;
+        }
+        coeffs[half_len + i] = acc * scale;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_savgol_init_f32(savgol_f32_t *sg, float *coeffs, float *delay, int half_len, int poly_order, int deriv)
+{
+    if ((sg == NULL) || (delay == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    esp_err_t ret = dsps_savgol_gen_f32(coeffs, half_len, poly_order, deriv);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    int len = 2 * half_len + 1;
+    // The newest sample has the largest offset from the center
+    for (int i = 0, j = len - 1; i < j; i++, j--) {
+        float t = coeffs[i];
+        coeffs[i] = coeffs[j];
+        coeffs[j] = t;
+    }
+    memset(delay, 0, 2 * len * sizeof(float));
+    sg->coeffs = coeffs;
+    sg->delay = delay;
+    sg->len = len;
+    sg->pos = 0;
+    return ESP_OK;
+}
+
+esp_err_t dsps_savgol_f32(savgol_f32_t *sg, const float *input, float *output, int len)
+{
+    if ((sg == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int n = sg->len;
+    float *delay = sg->delay;
+    for (int i = 0; i < len; i++) {
+        // Every sample is written twice, so the window delay[pos..pos + n - 1] is continuous
+        sg->pos--;
+        if (sg->pos < 0) {
+            sg->pos = n - 1;
+        }
+        delay[sg->pos] = input[i];
+        delay[sg->pos + n] = input[i];
+        dsps_dotprod_f32(sg->coeffs, &delay[sg->pos], &output[i], n);
+    }
+    return ESP_OK;
+}
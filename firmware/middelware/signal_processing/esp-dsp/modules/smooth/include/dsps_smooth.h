@@ -0,0 +1,197 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_smooth_H_
+#define _dsps_smooth_H_
+
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 moving average
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_movavg_init_f32(...) function.
+ */
+typedef struct movavg_f32_s {
+    float  *delay;      /*!< Last len samples.*/
+    float   sum;        /*!< Running sum of the delay line.*/
+    float   comp;       /*!< Compensation of the rounding error of the running sum (Kahan summation).*/
+    int     len;        /*!< Length of the window.*/
+    int     pos;        /*!< Position of the oldest sample in the delay line.*/
+    int     count;      /*!< Amount of samples in the delay line, up to len.*/
+} movavg_f32_t;
+
+/**
+ * @brief Data struct of f32 moving median
+ *
+ * The samples are kept in two heaps around the median: max-heap of the lower half and min-heap
+ * of the upper half, stored in one array with the median at the center (heap[0]).
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_movmedian_init_f32(...) function.
+ */
+typedef struct movmedian_f32_s {
+    float  *data;       /*!< Last len samples in order of arrival (circular buffer).*/
+    int    *pos;        /*!< Position of every sample in the heap.*/
+    int    *heap;       /*!< Indexes of the samples, from -len/2 (max-heap) to (len - 1)/2 (min-heap).*/
+    int     len;        /*!< Length of the window.*/
+    int     idx;        /*!< Position of the oldest sample in the data array.*/
+    int     count;      /*!< Amount of samples in the window, up to len.*/
+} movmedian_f32_t;
+
+/**
+ * @brief Data struct of f32 Savitzky-Golay filter
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_savgol_init_f32(...) function.
+ */
+typedef struct savgol_f32_s {
+    float  *coeffs;     /*!< Convolution coefficients, for the newest sample first. Length of 2*half_len + 1.*/
+    float  *delay;      /*!< Double delay line. Length of 2*(2*half_len + 1).*/
+    int     len;        /*!< Length of the window: 2*half_len + 1.*/
+    int     pos;        /*!< Position of the newest sample in the delay line.*/
+} savgol_f32_t;
+
+/**
+ * @brief   initialize structure for moving average
+ *
+ * @param ma: pointer to the filter structure, that must be preallocated
+ * @param delay: buffer for the window. Length of len
+ * @param len: length of the window
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_movavg_init_f32(movavg_f32_t *ma, float *delay, int len);
+
+/**
+ * @brief   Moving average
+ *
+ * Average of the last len samples by a running sum: one addition and one subtraction per sample,
+ * independent of the window length. The rounding error of the running sum is compensated,
+ * so it does not grow with time. Until len samples are received, the average of
+ * the received samples is returned.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param ma: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_movavg_f32(movavg_f32_t *ma, const float *input, float *output, int len);
+
+/**
+ * @brief   initialize structure for moving median
+ *
+ * @param mm: pointer to the filter structure, that must be preallocated
+ * @param data: buffer for the window. Length of len
+ * @param index: buffer for the heap. Length of 2*len
+ * @param len: length of the window
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_movmedian_init_f32(movmedian_f32_t *mm, float *data, int *index, int len);
+
+/**
+ * @brief   Moving median
+ *
+ * Median of the last len samples. The new sample replaces the oldest one in its place in
+ * the double heap and is moved up or down, so the cost is O(log(len)) per sample.
+ * For even amount of samples the mean of two middle samples is returned.
+ * Until len samples are received, the median of the received samples is returned.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param mm: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_movmedian_f32(movmedian_f32_t *mm, const float *input, float *output, int len);
+
+/**
+ * @brief   Savitzky-Golay filter coefficients
+ *
+ * Function calculates the convolution coefficients of the least squares fit of polynomial of
+ * poly_order to 2*half_len + 1 samples: value (deriv = 0) or derivative of the polynomial at the center.
+ * coeffs[half_len + i] is the weight of the sample at offset i from the center, as scipy.signal.savgol_coeffs(..., use='dot').
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param coeffs: result coefficients. Length of 2*half_len + 1
+ * @param half_len: half of the window, the window is 2*half_len + 1 samples
+ * @param poly_order: order of the polynomial, less than 2*half_len + 1 and not more than 8
+ * @param deriv: order of the derivative, 0..poly_order. The derivative is per sample
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_savgol_gen_f32(float *coeffs, int half_len, int poly_order, int deriv);
+
+/**
+ * @brief   initialize structure for Savitzky-Golay filter
+ *
+ * @param sg: pointer to the filter structure, that must be preallocated
+ * @param coeffs: buffer for the coefficients. Length of 2*half_len + 1
+ * @param delay: buffer for the delay line. Length of 2*(2*half_len + 1)
+ * @param half_len: half of the window
+ * @param poly_order: order of the polynomial
+ * @param deriv: order of the derivative
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_savgol_init_f32(savgol_f32_t *sg, float *coeffs, float *delay, int half_len, int poly_order, int deriv);
+
+/**
+ * @brief   Savitzky-Golay filter
+ *
+ * Streaming convolution with the precomputed coefficients by dsps_dotprod_f32.
+ * The output is the smoothed value of the center of the window, so it is delayed by half_len samples.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param sg: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_savgol_f32(savgol_f32_t *sg, const float *input, float *output, int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_smooth_H_
@@ -0,0 +1,125 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_smooth.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_movmedian_f32";
+
+#define SIG_LEN     1000
+#define WIN_MAX     101
+
+static float signal[SIG_LEN];
+static float out_test[SIG_LEN];
+static float window[WIN_MAX];
+static float data[WIN_MAX];
+static int heap_index[2 * WIN_MAX];
+
+static int compare_float(const void *a, const void *b)
+{
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+// Median of the last len samples by sorting
+static float median_ref(const float *sig, int pos, int len)
+{
+    int start = (pos - len + 1 < 0) ? 0 : pos - len + 1;
+    int n = pos - start + 1;
+    memcpy(window, &sig[start], n * sizeof(float));
+    qsort(window, n, sizeof(float), compare_float);
+    if (n & 1) {
+        return window[n / 2];
+    }
+    return 0.5f * (window[n / 2 - 1] + window[n / 2]);
+}
+
+TEST_CASE("dsps_movmedian_f32 functionality", "[dsps]")
+{
+    srand(58);
+    for (int iter = 0; iter < 200; iter++) {
+        int len = 1 + rand() % WIN_MAX;
+        // Few levels produce a lot of equal samples
+        int levels = (iter & 1) ? 4 : RAND_MAX;
+        for (int i = 0; i < SIG_LEN; i++) {
+            signal[i] = (float)(rand() % levels) - levels / 2;
+        }
+        // Long constant and monotonic runs
+        if (iter % 5 == 0) {
+            for (int i = SIG_LEN / 4; i < SIG_LEN / 2; i++) {
+                signal[i] = (iter % 10 == 0) ? 1.0f : (float)i;
+            }
+        }
+        movmedian_f32_t mm;
+        TEST_ESP_OK(dsps_movmedian_init_f32(&mm, data, heap_index, len));
+        int pos = 0;
+        while (pos < SIG_LEN) {
+            int block = rand() % (2 * len + 1);
+            block = (block > SIG_LEN - pos) ? SIG_LEN - pos : block;
+            TEST_ESP_OK(dsps_movmedian_f32(&mm, &signal[pos], &out_test[pos], block));
+            pos += block;
+        }
+        for (int i = 0; i < SIG_LEN; i++) {
+            float ref = median_ref(signal, i, len);
+            if (out_test[i] != ref) {
+                ESP_LOGE(TAG, "window %i, sample %i: %f != %f", len, i, out_test[i], ref);
+            }
+            TEST_ASSERT_FLOAT_WITHIN(1e-6f, ref, out_test[i]);
+        }
+    }
+    movmedian_f32_t mm;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_movmedian_init_f32(&mm, data, heap_index, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_movmedian_init_f32(&mm, data, NULL, 5));
+}
+
+TEST_CASE("dsps_movmedian_f32 in place", "[dsps]")
+{
+    const int len = 5;
+    for (int i = 0; i < SIG_LEN; i++) {
+        signal[i] = (float)rand() / RAND_MAX;
+        out_test[i] = signal[i];
+    }
+    movmedian_f32_t mm;
+    TEST_ESP_OK(dsps_movmedian_init_f32(&mm, data, heap_index, len));
+    TEST_ESP_OK(dsps_movmedian_f32(&mm, out_test, out_test, SIG_LEN));
+    for (int i = 0; i < SIG_LEN; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, median_ref(signal, i, len), out_test[i]);
+    }
+}
+
+TEST_CASE("dsps_movmedian_f32 benchmark", "[dsps]")
+{
+    const int win_lens[] = {5, 31, WIN_MAX};
+    for (int w = 0; w < sizeof(win_lens) / sizeof(int); w++) {
+        for (int i = 0; i < SIG_LEN; i++) {
+            signal[i] = (float)rand() / RAND_MAX;
+        }
+        movmedian_f32_t mm;
+        TEST_ESP_OK(dsps_movmedian_init_f32(&mm, data, heap_index, win_lens[w]));
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_movmedian_f32(&mm, signal, out_test, SIG_LEN);
+        unsigned int cycles = dsp_get_cpu_cycle_count() - start_b;
+        ESP_LOGI(TAG, "window %i: %i cycles per sample", win_lens[w], cycles / SIG_LEN);
+        TEST_ASSERT_EXEC_IN_RANGE(SIG_LEN, 1000 * SIG_LEN, cycles);
+    }
+}
@@ -0,0 +1,161 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_smooth.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_smooth_f32";
+
+#define SIG_LEN     2000
+#define WIN_MAX     64
+#define SG_HALF_MAX 10
+
+static float signal[SIG_LEN];
+static float out_test[SIG_LEN];
+static float delay[2 * WIN_MAX];
+static float coeffs[2 * SG_HALF_MAX + 1];
+
+static void fill_random(float *data, int len)
+{
+    for (int i = 0; i < len; i++) {
+        data[i] = (float)rand() / RAND_MAX * 2 - 1;
+    }
+}
+
+TEST_CASE("dsps_movavg_f32 functionality", "[dsps]")
+{
+    const int win_lens[] = {1, 5, 16, 64};
+    for (int w = 0; w < sizeof(win_lens) / sizeof(int); w++) {
+        int n = win_lens[w];
+        fill_random(signal, SIG_LEN);
+        // DC offset makes the rounding error of a plain running sum visible
+        for (int i = 0; i < SIG_LEN; i++) {
+            signal[i] += 100;
+        }
+        movavg_f32_t ma;
+        TEST_ESP_OK(dsps_movavg_init_f32(&ma, delay, n));
+        // Blocks of random length
+        int pos = 0;
+        while (pos < SIG_LEN) {
+            int block = 1 + rand() % 100;
+            block = (block > SIG_LEN - pos) ? SIG_LEN - pos : block;
+            TEST_ESP_OK(dsps_movavg_f32(&ma, &signal[pos], &out_test[pos], block));
+            pos += block;
+        }
+        float err = 0;
+        for (int i = 0; i < SIG_LEN; i++) {
+            double ref = 0;
+            int start = (i - n + 1 < 0) ? 0 : i - n + 1;
+            for (int k = start; k <= i; k++) {
+                ref += signal[k];
+            }
+            ref /= (i - start + 1);
+            float e = fabsf(out_test[i] - (float)ref);
+            err = (e > err) ? e : err;
+        }
+        ESP_LOGI(TAG, "window %i: error %e", n, err);
+        TEST_ASSERT_LESS_THAN(100, (int)(1000000 * err));
+    }
+    movavg_f32_t ma;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_movavg_init_f32(&ma, delay, 0));
+}
+
+TEST_CASE("dsps_savgol_gen_f32 functionality", "[dsps]")
+{
+    // scipy.signal.savgol_coeffs(window, poly_order, deriv, use='dot')
+    const float ref_7_2_0[] = {-0.09523810f, 0.14285714f, 0.28571429f, 0.33333333f, 0.28571429f, 0.14285714f, -0.09523810f};
+    const float ref_11_4_0[] = {0.04195804f, -0.10489510f, -0.02331002f, 0.13986014f, 0.27972028f, 0.33333333f, 0.27972028f, 0.13986014f, -0.02331002f, -0.10489510f, 0.04195804f};
+    const float ref_9_3_1[] = {0.07239057f, -0.11952862f, -0.16245791f, -0.10606061f, 0.0f, 0.10606061f, 0.16245791f, 0.11952862f, -0.07239057f};
+    const float ref_21_6_2[] = {0.01534134f, -0.02705334f, -0.01572073f, 0.01007115f, 0.02911312f, 0.03321525f, 0.02283905f, 0.00340181f, -0.01774725f, -0.03367878f, -0.03956324f,
+                                -0.03367878f, -0.01774725f, 0.00340181f, 0.02283905f, 0.03321525f, 0.02911312f, 0.01007115f, -0.01572073f, -0.02705334f, 0.01534134f
+                               };
+    const struct {
+        int half_len;
+        int poly_order;
+        int deriv;
+        const float *ref;
+    } cases[] = {
+        {3, 2, 0, ref_7_2_0},
+        {5, 4, 0, ref_11_4_0},
+        {4, 3, 1, ref_9_3_1},
+        {10, 6, 2, ref_21_6_2},
+    };
+    for (int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        TEST_ESP_OK(dsps_savgol_gen_f32(coeffs, cases[c].half_len, cases[c].poly_order, cases[c].deriv));
+        for (int i = 0; i < 2 * cases[c].half_len + 1; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-6f, cases[c].ref[i], coeffs[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_savgol_gen_f32(coeffs, 2, 5, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_savgol_gen_f32(coeffs, 3, 2, 3));
+}
+
+TEST_CASE("dsps_savgol_f32 functionality", "[dsps]")
+{
+    // The filter keeps polynomials up to poly_order, delayed by half_len samples
+    const int half_len = 6;
+    const int poly_order = 3;
+    for (int i = 0; i < SIG_LEN; i++) {
+        float t = (float)i / SIG_LEN;
+        signal[i] = 1 - 2 * t + 3 * t * t - 4 * t * t * t;
+    }
+    for (int deriv = 0; deriv <= 1; deriv++) {
+        savgol_f32_t sg;
+        TEST_ESP_OK(dsps_savgol_init_f32(&sg, coeffs, delay, half_len, poly_order, deriv));
+        TEST_ESP_OK(dsps_savgol_f32(&sg, signal, out_test, 100));
+        TEST_ESP_OK(dsps_savgol_f32(&sg, &signal[100], &out_test[100], SIG_LEN - 100));
+        float err = 0;
+        for (int i = 2 * half_len; i < SIG_LEN; i++) {
+            float t = (float)(i - half_len) / SIG_LEN;
+            float ref = 1 - 2 * t + 3 * t * t - 4 * t * t * t;
+            if (deriv) {
+                ref = (-2 + 6 * t - 12 * t * t) / SIG_LEN;
+            }
+            float e = fabsf(out_test[i] - ref);
+            err = (e > err) ? e : err;
+        }
+        ESP_LOGI(TAG, "savgol deriv %i: error %e", deriv, err);
+        TEST_ASSERT_LESS_THAN(10, (int)(1000000 * err));
+    }
+}
+
+TEST_CASE("dsps_smooth_f32 benchmark", "[dsps]")
+{
+    const int len = 1024;
+    fill_random(signal, len);
+
+    movavg_f32_t ma;
+    TEST_ESP_OK(dsps_movavg_init_f32(&ma, delay, WIN_MAX));
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_movavg_f32(&ma, signal, out_test, len);
+    unsigned int cycles_avg = dsp_get_cpu_cycle_count() - start_b;
+
+    savgol_f32_t sg;
+    TEST_ESP_OK(dsps_savgol_init_f32(&sg, coeffs, delay, SG_HALF_MAX, 4, 0));
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_savgol_f32(&sg, signal, out_test, len);
+    unsigned int cycles_sg = dsp_get_cpu_cycle_count() - start_b;
+
+    ESP_LOGI(TAG, "%i samples: moving average (window %i) %i cycles, Savitzky-Golay (window %i) %i cycles",
+             len, WIN_MAX, cycles_avg, 2 * SG_HALF_MAX + 1, cycles_sg);
+    TEST_ASSERT_EXEC_IN_RANGE(len, 100 * len, cycles_avg);
+}
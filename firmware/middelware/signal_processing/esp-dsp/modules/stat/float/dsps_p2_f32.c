@@ -0,0 +1,136 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_stat.h"
+
+esp_err_t dsps_p2_init_f32(p2_f32_t *p2, float p)
+{
+    if (p2 == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((p < 0) || (p > 1)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    p2->p = p;
+    p2->count = 0;
+    for (int i = 0; i < 5; i++) {
+        p2->q[i] = 0;
+        p2->n[i] = i;
+    }
+    p2->np[0] = 0;
+    p2->np[1] = 2 * p;
+    p2->np[2] = 4 * p;
+    p2->np[3] = 2 + 2 * p;
+    p2->np[4] = 4;
+    p2->dn[0] = 0;
+    p2->dn[1] = p / 2;
+    p2->dn[2] = p;
+    p2->dn[3] = (1 + p) / 2;
+    p2->dn[4] = 1;
+    return ESP_OK;
+}
+
+// Insertion of the sample into the sorted heights, while less than 5 samples are received
+static void dsps_p2_insert(float *q, int count, float x)
+{
+    int i = count;
+    while ((i > 0) && (q[i - 1] > x)) {
+        q[i] = q[i - 1];
+        i--;
+    }
+    q[i] = x;
+}
+
+esp_err_t dsps_p2_f32(p2_f32_t *p2, const float *input, int len)
+{
+    if ((p2 == NULL) || (input == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    float *q = p2->q;
+    int32_t *n = p2->n;
+    for (int s = 0; s < len; s++) {
+        float x = input[s];
+        if (p2->count < 5) {
+            dsps_p2_insert(q, p2->count, x);
+            p2->count++;
+            continue;
+        }
+        p2->count++;
+        // Cell of the sample, the extreme markers follow the minimum and maximum
+        int k;
+        if (x < q[0]) {
+            q[0] = x;
+            k = 0;
+        } else if (x >= q[4]) {
+            q[4] = x;
+            k = 3;
+        } else {
+            k = 0;
+            while (x >= q[k + 1]) {
+                k++;
+            }
+        }
+        for (int i = k + 1; i < 5; i++) {
+            n[i]++;
+        }
+        for (int i = 1; i < 5; i++) {
+            p2->np[i] += p2->dn[i];
+        }
+        // Adjust the middle markers
+        for (int i = 1; i < 4; i++) {
+            float d = p2->np[i] - n[i];
+            if (((d >= 1) && (n[i + 1] - n[i] > 1)) || ((d <= -1) && (n[i - 1] - n[i] < -1))) {
+                int ds = (d > 0) ? 1 : -1;
+                float dp = n[i + 1] - n[i];
+                float dm = n[i] - n[i - 1];
+                float qp = q[i] + ds / (float)(n[i + 1] - n[i - 1]) *
+                           ((dm + ds) * (q[i + 1] - q[i]) / dp + (dp - ds) * (q[i] - q[i - 1]) / dm);
+                if ((qp <= q[i - 1]) || (qp >= q[i + 1])) {
+                    // Parabolic prediction is out of order: linear one
+                    qp = q[i] + ds * (q[i + ds] - q[i]) / (n[i + ds] - n[i]);
+                }
+                q[i] = qp;
+                n[i] += ds;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_p2_get_f32(const p2_f32_t *p2, float *quantile)
+{
+    if ((p2 == NULL) || (quantile == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (p2->count == 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (p2->count < 5) {
+        // Linear interpolation between the sorted samples
+        float pos = p2->p * (p2->count - 1);
+        int i = (int)pos;
+        i = (i >= (int)p2->count - 1) ? (int)p2->count - 2 : i;
+        if (i < 0) {
+            *quantile = p2->q[0];
+        } else {
+            *quantile = p2->q[i] + (pos - i) * (p2->q[i + 1] - p2->q[i]);
+        }
+        return ESP_OK;
+    }
+    *quantile = p2->q[2];
+    return ESP_OK;
+}
@@ -0,0 +1,176 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_stat.h"
+#include <math.h>
+
+esp_err_t dsps_stat_init_f32(stat_f32_t *st)
+{
+    if (st == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    st->count = 0;
+    st->mean = 0;
+    st->m2 = 0;
+    st->min = INFINITY;
+    st->max = -INFINITY;
+    return ESP_OK;
+}
+
+esp_err_t dsps_stat_f32(stat_f32_t *st, const float *input, int len)
+{
+    if ((st == NULL) || (input == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    uint32_t count = st->count;
+    float mean = st->mean;
+    float m2 = st->m2;
+    float min = st->min;
+    float max = st->max;
+    for (int i = 0; i < len; i++) {
+        float x = input[i];
+        count++;
+        float d = x - mean;
+        mean += d / count;
+        m2 += d * (x - mean);
+        min = (x < min) ? x : min;
+        max = (x > max) ? x : max;
+    }
+    st->count = count;
+    st->mean = mean;
+    st->m2 = m2;
+    st->min = min;
+    st->max = max;
+    return ESP_OK;
+}
+
+esp_err_t dsps_stat_merge_f32(stat_f32_t *st, const stat_f32_t *other)
+{
+    if ((st == NULL) || (other == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (other->count == 0) {
+        return ESP_OK;
+    }
+    float na = st->count;
+    float nb = other->count;
+    float n = na + nb;
+    float d = other->mean - st->mean;
+    st->mean += d * (nb / n);
+    st->m2 += other->m2 + d * d * (na * (nb / n));
+    st->count += other->count;
+    st->min = (other->min < st->min) ? other->min : st->min;
+    st->max = (other->max > st->max) ? other->max : st->max;
+    return ESP_OK;
+}
+
+esp_err_t dsps_stat_get_f32(const stat_f32_t *st, float *mean, float *std, float *rms)
+{
+    if (st == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (st->count < 2) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (mean != NULL) {
+        *mean = st->mean;
+    }
+    if (std != NULL) {
+        *std = sqrtf(st->m2 / (st->count - 1));
+    }
+    if (rms != NULL) {
+        *rms = sqrtf(st->mean * st->mean + st->m2 / st->count);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_ewstat_init_f32(ewstat_f32_t *ew, float alpha)
+{
+    if (ew == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((alpha <= 0) || (alpha > 1)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    ew->alpha = alpha;
+    ew->mean = 0;
+    ew->var = 0;
+    ew->count = 0;
+    return ESP_OK;
+}
+
+esp_err_t dsps_ewstat_f32(ewstat_f32_t *ew, const float *input, float *mean, float *var, int len)
+{
+    if ((ew == NULL) || (input == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    float alpha = ew->alpha;
+    for (int i = 0; i < len; i++) {
+        float x = input[i];
+        if (ew->count == 0) {
+            // The first sample starts the mean without the transient from 0
+            ew->mean = x;
+            ew->var = 0;
+            ew->count = 1;
+        } else {
+            float d = x - ew->mean;
+            float incr = alpha * d;
+            ew->mean += incr;
+            ew->var = (1 - alpha) * (ew->var + d * incr);
+        }
+        if (mean != NULL) {
+            mean[i] = ew->mean;
+        }
+        if (var != NULL) {
+            var[i] = ew->var;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_movrms_init_f32(movrms_f32_t *rms, float *delay, int len)
+{
+    if (rms == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    return dsps_movavg_init_f32(&rms->ma, delay, len);
+}
+
+esp_err_t dsps_movrms_f32(movrms_f32_t *rms, const float *input, float *output, int len)
+{
+    if ((rms == NULL) || (input == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    for (int i = 0; i < len; i++) {
+        output[i] = input[i] * input[i];
+    }
+    esp_err_t ret = dsps_movavg_f32(&rms->ma, output, output, len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int i = 0; i < len; i++) {
+        // The compensated running sum could be slightly negative for a window of zeros
+        output[i] = (output[i] > 0) ? sqrtf(output[i]) : 0;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,256 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_stat_H_
+#define _dsps_stat_H_
+
+#include <stdint.h>
+#include "dsp_err.h"
+#include "dsps_smooth.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 running statistics
+ *
+ * All fields of this structure are initialized by the dsps_stat_init_f32(...) function.
+ * The fields count, mean, min and max could be read directly.
+ */
+typedef struct stat_f32_s {
+    uint32_t count;     /*!< Amount of samples.*/
+    float   mean;       /*!< Mean of the samples.*/
+    float   m2;         /*!< Sum of squared deviations from the mean.*/
+    float   min;        /*!< Minimum of the samples.*/
+    float   max;        /*!< Maximum of the samples.*/
+} stat_f32_t;
+
+/**
+ * @brief Data struct of f32 exponentially weighted statistics
+ *
+ * All fields of this structure are initialized by the dsps_ewstat_init_f32(...) function.
+ */
+typedef struct ewstat_f32_s {
+    float   alpha;      /*!< Weight of the new sample.*/
+    float   mean;       /*!< Exponentially weighted mean.*/
+    float   var;        /*!< Exponentially weighted variance.*/
+    int     count;      /*!< 0 until the first sample is received.*/
+} ewstat_f32_t;
+
+/**
+ * @brief Data struct of f32 moving RMS
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_movrms_init_f32(...) function.
+ */
+typedef struct movrms_f32_s {
+    movavg_f32_t ma;    /*!< Moving average of the squared samples.*/
+} movrms_f32_t;
+
+/**
+ * @brief Data struct of f32 P2 quantile estimator
+ *
+ * Five markers: minimum, p/2, p, (1 + p)/2 quantiles and maximum. Until five samples are received,
+ * the samples are stored in the heights of the markers.
+ * This structure is used by the estimator internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_p2_init_f32(...) function.
+ */
+typedef struct p2_f32_s {
+    float   q[5];       /*!< Heights of the markers.*/
+    int32_t n[5];       /*!< Positions of the markers, from 0.*/
+    float   np[5];      /*!< Desired positions of the markers.*/
+    float   dn[5];      /*!< Increments of the desired positions.*/
+    float   p;          /*!< Quantile, 0..1.*/
+    uint32_t count;     /*!< Amount of samples.*/
+} p2_f32_t;
+
+/**
+ * @brief   initialize structure for running statistics
+ *
+ * @param st: pointer to the statistics structure, that must be preallocated
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stat_init_f32(stat_f32_t *st);
+
+/**
+ * @brief   Running statistics
+ *
+ * Single pass mean, variance, minimum and maximum by the Welford algorithm:
+ * the sum of squared deviations is updated from the deviation to the old and the new mean,
+ * so there is no cancellation for signals with a large offset, as with the sum of squares.
+ * The cost is O(1) per sample and no samples are stored.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param st: pointer to the statistics structure, that must be initialized before
+ * @param[in] input: input array
+ * @param len: length of input array
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stat_f32(stat_f32_t *st, const float *input, int len);
+
+/**
+ * @brief   Merge running statistics
+ *
+ * Function adds the statistics of other samples (for example, collected by another task
+ * or for another block) to st by the parallel algorithm of Chan et al.
+ * The result is equal to the statistics of all samples processed by one structure.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param st: pointer to the statistics structure, that is updated
+ * @param[in] other: pointer to the statistics to add
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stat_merge_f32(stat_f32_t *st, const stat_f32_t *other);
+
+/**
+ * @brief   Result of running statistics
+ *
+ * @param[in] st: pointer to the statistics structure
+ * @param mean: mean of the samples. Could be NULL
+ * @param std: sample standard deviation (normalized by count - 1). Could be NULL
+ * @param rms: root mean square of the samples. Could be NULL
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if less than 2 samples are processed
+ */
+esp_err_t dsps_stat_get_f32(const stat_f32_t *st, float *mean, float *std, float *rms);
+
+/**
+ * @brief   initialize structure for exponentially weighted statistics
+ *
+ * @param ew: pointer to the statistics structure, that must be preallocated
+ * @param alpha: weight of the new sample, 0..1. The time constant is about 1/alpha samples
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_ewstat_init_f32(ewstat_f32_t *ew, float alpha);
+
+/**
+ * @brief   Exponentially weighted mean and variance
+ *
+ * Mean and variance with exponential forgetting of the old samples:
+ * diff = x - mean, mean += alpha*diff, var = (1 - alpha)*(var + alpha*diff^2).
+ * The variance stays positive and the cost is O(1) per sample.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param ew: pointer to the statistics structure, that must be initialized before
+ * @param[in] input: input array
+ * @param mean: output mean for every sample. Could be NULL
+ * @param var: output variance for every sample. Could be NULL
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_ewstat_f32(ewstat_f32_t *ew, const float *input, float *mean, float *var, int len);
+
+/**
+ * @brief   initialize structure for moving RMS
+ *
+ * @param rms: pointer to the filter structure, that must be preallocated
+ * @param delay: buffer for the window. Length of len
+ * @param len: length of the window
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_movrms_init_f32(movrms_f32_t *rms, float *delay, int len);
+
+/**
+ * @brief   Moving RMS
+ *
+ * Root mean square of the last len samples by the moving average of the squared samples
+ * (dsps_movavg_f32), so the cost does not depend on the window length.
+ * Until len samples are received, the RMS of the received samples is returned.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param rms: pointer to the filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param output: output array. Could be the same as input
+ * @param len: length of input and output vectors
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_movrms_f32(movrms_f32_t *rms, const float *input, float *output, int len);
+
+/**
+ * @brief   initialize structure for P2 quantile estimator
+ *
+ * @param p2: pointer to the estimator structure, that must be preallocated
+ * @param p: quantile, 0..1. For example 0.5 for the median, 0.95 for 95th percentile
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_p2_init_f32(p2_f32_t *p2, float p);
+
+/**
+ * @brief   P2 quantile estimator
+ *
+ * Quantile of a stream without storing the samples by the P2 algorithm of Jain and Chlamtac:
+ * five markers are moved to the desired positions, and their heights are adjusted by
+ * piecewise parabolic interpolation. The cost is O(1) per sample.
+ * The estimators of different streams could not be merged exactly: use one estimator per quantity.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param p2: pointer to the estimator structure, that must be initialized before
+ * @param[in] input: input array
+ * @param len: length of input array
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_p2_f32(p2_f32_t *p2, const float *input, int len);
+
+/**
+ * @brief   Result of P2 quantile estimator
+ *
+ * Until five samples are received, the quantile of the received samples is calculated exactly.
+ *
+ * @param[in] p2: pointer to the estimator structure
+ * @param quantile: estimated quantile
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if no samples are processed
+ */
+esp_err_t dsps_p2_get_f32(const p2_f32_t *p2, float *quantile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_stat_H_
@@ -0,0 +1,270 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_stat.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_stat_f32";
+
+#define SIG_LEN     20000
+#define WIN_MAX     64
+
+static float signal[SIG_LEN];
+static float out_test[SIG_LEN];
+static float delay[WIN_MAX];
+
+static void fill_random(float *data, int len, float offset)
+{
+    for (int i = 0; i < len; i++) {
+        data[i] = offset + (float)rand() / RAND_MAX * 2 - 1;
+    }
+}
+
+// Two pass reference in double precision
+static void stat_ref(const float *data, int len, double *mean, double *std)
+{
+    double sum = 0;
+    for (int i = 0; i < len; i++) {
+        sum += data[i];
+    }
+    *mean = sum / len;
+    double sq = 0;
+    for (int i = 0; i < len; i++) {
+        sq += (data[i] - *mean) * (data[i] - *mean);
+    }
+    *std = sqrt(sq / (len - 1));
+}
+
+static int cmp_float(const void *a, const void *b)
+{
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+TEST_CASE("dsps_stat_f32 functionality", "[dsps]")
+{
+    srand(63);
+    // Large offset: the sum of squares in float loses all digits of the variance
+    const float offsets[] = {0, 100, 10000};
+    for (int o = 0; o < sizeof(offsets) / sizeof(float); o++) {
+        fill_random(signal, SIG_LEN, offsets[o]);
+        stat_f32_t st;
+        TEST_ESP_OK(dsps_stat_init_f32(&st));
+        TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_stat_get_f32(&st, NULL, NULL, NULL));
+        int pos = 0;
+        while (pos < SIG_LEN) {
+            int block = 1 + rand() % 500;
+            block = (block > SIG_LEN - pos) ? SIG_LEN - pos : block;
+            TEST_ESP_OK(dsps_stat_f32(&st, &signal[pos], block));
+            pos += block;
+        }
+        float mean, std, rms;
+        TEST_ESP_OK(dsps_stat_get_f32(&st, &mean, &std, &rms));
+        double mean_ref, std_ref;
+        stat_ref(signal, SIG_LEN, &mean_ref, &std_ref);
+        float min_ref = signal[0];
+        float max_ref = signal[0];
+        float naive_sum = 0;
+        float naive_sq = 0;
+        for (int i = 0; i < SIG_LEN; i++) {
+            min_ref = fminf(min_ref, signal[i]);
+            max_ref = fmaxf(max_ref, signal[i]);
+            naive_sum += signal[i];
+            naive_sq += signal[i] * signal[i];
+        }
+        float naive_var = (naive_sq - naive_sum * naive_sum / SIG_LEN) / (SIG_LEN - 1);
+        float std_err = fabs(std - std_ref) / std_ref;
+        ESP_LOGI(TAG, "offset %f: mean %f (%f), std %f (%f), error %e, naive variance %f",
+                 offsets[o], mean, mean_ref, std, std_ref, std_err, naive_var);
+        TEST_ASSERT_EQUAL(SIG_LEN, st.count);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f * (offsets[o] + 1) + 1e-4f, mean_ref, mean);
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * std_err));
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f * (offsets[o] + 1), sqrt(mean_ref * mean_ref + std_ref * std_ref), rms);
+        TEST_ASSERT_EQUAL(min_ref, st.min);
+        TEST_ASSERT_EQUAL(max_ref, st.max);
+    }
+}
+
+TEST_CASE("dsps_stat_merge_f32 functionality", "[dsps]")
+{
+    srand(64);
+    fill_random(signal, SIG_LEN, 1000);
+    // Different mean and variance in the parts
+    for (int i = SIG_LEN / 2; i < SIG_LEN; i++) {
+        signal[i] = 3 * signal[i] - 2500;
+    }
+    const int parts = 4;
+    stat_f32_t st[parts];
+    for (int p = 0; p < parts; p++) {
+        TEST_ESP_OK(dsps_stat_init_f32(&st[p]));
+    }
+    // Samples are split between the parts in blocks of random length
+    int pos = 0;
+    while (pos < SIG_LEN) {
+        int block = 1 + rand() % 1000;
+        block = (block > SIG_LEN - pos) ? SIG_LEN - pos : block;
+        TEST_ESP_OK(dsps_stat_f32(&st[rand() % parts], &signal[pos], block));
+        pos += block;
+    }
+    stat_f32_t all;
+    TEST_ESP_OK(dsps_stat_init_f32(&all));
+    for (int p = 0; p < parts; p++) {
+        TEST_ESP_OK(dsps_stat_merge_f32(&all, &st[p]));
+    }
+    stat_f32_t empty;
+    TEST_ESP_OK(dsps_stat_init_f32(&empty));
+    TEST_ESP_OK(dsps_stat_merge_f32(&all, &empty));
+
+    float mean, std;
+    TEST_ESP_OK(dsps_stat_get_f32(&all, &mean, &std, NULL));
+    double mean_ref, std_ref;
+    stat_ref(signal, SIG_LEN, &mean_ref, &std_ref);
+    ESP_LOGI(TAG, "merge: mean %f (%f), std %f (%f)", mean, mean_ref, std, std_ref);
+    TEST_ASSERT_EQUAL(SIG_LEN, all.count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, mean_ref, mean);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * fabs(std - std_ref) / std_ref));
+}
+
+TEST_CASE("dsps_ewstat_f32 functionality", "[dsps]")
+{
+    srand(65);
+    const float alpha = 0.01f;
+    ewstat_f32_t ew;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_ewstat_init_f32(&ew, 0));
+    TEST_ESP_OK(dsps_ewstat_init_f32(&ew, alpha));
+    // Step of the mean and of the variance in the middle of the signal
+    fill_random(signal, SIG_LEN, 0);
+    for (int i = 0; i < SIG_LEN; i++) {
+        signal[i] = (i < SIG_LEN / 2) ? 5000 + signal[i] : 5010 + 2 * signal[i];
+    }
+    TEST_ESP_OK(dsps_ewstat_f32(&ew, signal, out_test, NULL, SIG_LEN / 2));
+    float mean1 = ew.mean;
+    float var1 = ew.var;
+    TEST_ESP_OK(dsps_ewstat_f32(&ew, &signal[SIG_LEN / 2], NULL, out_test, SIG_LEN / 2));
+    ESP_LOGI(TAG, "ewstat: mean %f, var %f, after step mean %f, var %f", mean1, var1, ew.mean, ew.var);
+    // Variance of uniform -1..1 is 1/3
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 5000, mean1);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 1.0f / 3, var1);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 5010, ew.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.4f, 4.0f / 3, ew.var);
+    for (int i = 0; i < SIG_LEN / 2; i++) {
+        TEST_ASSERT_TRUE(out_test[i] >= 0);
+    }
+}
+
+TEST_CASE("dsps_movrms_f32 functionality", "[dsps]")
+{
+    srand(66);
+    const int win_lens[] = {1, 10, WIN_MAX};
+    for (int w = 0; w < sizeof(win_lens) / sizeof(int); w++) {
+        int n = win_lens[w];
+        fill_random(signal, SIG_LEN, 0);
+        for (int i = 0; i < SIG_LEN; i++) {
+            signal[i] += 5 * sinf(i * 0.05f);
+        }
+        // Silence in the middle
+        for (int i = SIG_LEN / 2; i < SIG_LEN / 2 + 200; i++) {
+            signal[i] = 0;
+        }
+        movrms_f32_t rms;
+        TEST_ESP_OK(dsps_movrms_init_f32(&rms, delay, n));
+        TEST_ESP_OK(dsps_movrms_f32(&rms, signal, out_test, SIG_LEN));
+        float max_err = 0;
+        for (int i = 0; i < SIG_LEN; i++) {
+            int start = (i - n + 1 < 0) ? 0 : i - n + 1;
+            double sq = 0;
+            for (int k = start; k <= i; k++) {
+                sq += (double)signal[k] * signal[k];
+            }
+            // Error of the mean square: sqrt amplifies the rounding error near zero
+            float err = fabsf(out_test[i] * out_test[i] - (float)(sq / (i - start + 1)));
+            max_err = fmaxf(max_err, err);
+        }
+        ESP_LOGI(TAG, "movrms window %i: max error of mean square %e, RMS of silence %e", n, max_err, out_test[SIG_LEN / 2 + 199]);
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * max_err));
+        // Residual of the running sum after the signal with the power of about 13
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e5f * out_test[SIG_LEN / 2 + 199] * out_test[SIG_LEN / 2 + 199]));
+    }
+}
+
+TEST_CASE("dsps_p2_f32 functionality", "[dsps]")
+{
+    srand(67);
+    const float quantiles[] = {0.05f, 0.5f, 0.9f, 0.99f};
+    for (int q = 0; q < sizeof(quantiles) / sizeof(float); q++) {
+        float p = quantiles[q];
+        // Skewed distribution: sum of uniform samples squared
+        for (int i = 0; i < SIG_LEN; i++) {
+            float u = (float)rand() / RAND_MAX + (float)rand() / RAND_MAX;
+            signal[i] = 100 + u * u;
+        }
+        p2_f32_t p2;
+        TEST_ESP_OK(dsps_p2_init_f32(&p2, p));
+        float result;
+        TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_p2_get_f32(&p2, &result));
+        // Less than five samples: exact quantile
+        TEST_ESP_OK(dsps_p2_f32(&p2, signal, 3));
+        memcpy(out_test, signal, 3 * sizeof(float));
+        qsort(out_test, 3, sizeof(float), cmp_float);
+        TEST_ESP_OK(dsps_p2_get_f32(&p2, &result));
+        float pos = p * 2;
+        int i0 = (pos >= 1) ? 1 : 0;
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, out_test[i0] + (pos - i0) * (out_test[i0 + 1] - out_test[i0]), result);
+
+        TEST_ESP_OK(dsps_p2_f32(&p2, &signal[3], SIG_LEN - 3));
+        TEST_ESP_OK(dsps_p2_get_f32(&p2, &result));
+        memcpy(out_test, signal, SIG_LEN * sizeof(float));
+        qsort(out_test, SIG_LEN, sizeof(float), cmp_float);
+        float exact = out_test[(int)(p * (SIG_LEN - 1))];
+        // Error in the rank of the estimation
+        int rank = 0;
+        while ((rank < SIG_LEN) && (out_test[rank] < result)) {
+            rank++;
+        }
+        float rank_err = fabsf((float)rank / SIG_LEN - p);
+        ESP_LOGI(TAG, "p2 quantile %f: %f, exact %f, rank error %f", p, result, exact, rank_err);
+        TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1000 * rank_err));
+        TEST_ASSERT_EQUAL(out_test[0], p2.q[0]);
+        TEST_ASSERT_EQUAL(out_test[SIG_LEN - 1], p2.q[4]);
+    }
+}
+
+TEST_CASE("dsps_stat_f32 benchmark", "[dsps]")
+{
+    fill_random(signal, SIG_LEN, 0);
+    const int len = 1000;
+    stat_f32_t st;
+    TEST_ESP_OK(dsps_stat_init_f32(&st));
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_stat_f32(&st, signal, len);
+    unsigned int cycles = (dsp_get_cpu_cycle_count() - start_b) / len;
+
+    p2_f32_t p2;
+    TEST_ESP_OK(dsps_p2_init_f32(&p2, 0.5f));
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_p2_f32(&p2, signal, len);
+    unsigned int cycles_p2 = (dsp_get_cpu_cycle_count() - start_b) / len;
+    ESP_LOGI(TAG, "cycles per sample: stat %i, p2 %i", cycles, cycles_p2);
+    TEST_ASSERT_EXEC_IN_RANGE(1, 200, cycles);
+    TEST_ASSERT_EXEC_IN_RANGE(1, 500, cycles_p2);
+}
@@ -0,0 +1,157 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_nco_H_
+#define _dsps_nco_H_
+
+#include <stdint.h>
+#include "dsp_err.h"
+#include "dsps_fastmath.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_NCO_TABLE_BITS     DSPS_SIN_TABLE_BITS /*!< Resolution of the quarter wave table, bits. The Q15 table is shared with dsps_sincos_s16(...).*/
+#define DSPS_NCO_TABLE_SIZE     (1 << DSPS_NCO_TABLE_BITS) /*!< Amount of table steps per quarter of the period.*/
+
+/**
+ * @brief Sweep of the NCO frequency
+ */
+typedef enum dsps_nco_sweep_e {
+    DSPS_NCO_TONE = 0,      /*!< Constant frequency.*/
+    DSPS_NCO_LINEAR = 1,    /*!< Linear chirp: the frequency changes by a constant per sample.*/
+    DSPS_NCO_EXP = 2,       /*!< Exponential chirp: the frequency changes by a constant ratio per sample.*/
+} dsps_nco_sweep_t;
+
+/**
+ * @brief Data struct of the numerically controlled oscillator
+ *
+ * This structure is used by the generator internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_nco_init(...) or dsps_nco_chirp_init(...) functions.
+ */
+typedef struct nco_s {
+    uint32_t    phase;      /*!< Phase accumulator, 2^32 is 2*Pi.*/
+    int64_t     step;       /*!< Phase increment per sample, 2^64 is 2*Pi. The accumulator uses the upper 32 bits.*/
+    int64_t     sweep;      /*!< Change of the increment per sample for DSPS_NCO_LINEAR.*/
+    int32_t     rate;       /*!< Relative change of the increment per sample for DSPS_NCO_EXP, Q31.*/
+    dsps_nco_sweep_t type;  /*!< Sweep of the frequency.*/
+    int         interp;     /*!< 1 - linear interpolation between the table values, 0 - nearest value.*/
+} nco_t;
+
+/**
+ * @brief   initialize structure for the NCO tone
+ *
+ * @param nco: pointer to the generator structure, that must be preallocated
+ * @param freq: frequency of the tone in range of [-1..1), where 1 is a Nyquist frequency
+ * @param phase: initial phase in range of [-1..1], where 1 is related to 2Pi and -1 to -2Pi
+ * @param interp: 1 - linear interpolation between the table values, 0 - nearest value
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_PARAM if the frequency or the phase is out of range
+ */
+esp_err_t dsps_nco_init(nco_t *nco, float freq, float phase, int interp);
+
+/**
+ * @brief   initialize structure for the NCO chirp
+ *
+ * The frequency changes from f_start to f_end in len samples and continues to change after that
+ * with the same slope (DSPS_NCO_LINEAR) or ratio (DSPS_NCO_EXP). The ratio per sample is stored
+ * in Q31, the relative error of the end frequency of DSPS_NCO_EXP is about 1e-6.
+ * The initial phase is 0.
+ *
+ * @param nco: pointer to the generator structure, that must be preallocated
+ * @param type: sweep of the frequency, DSPS_NCO_LINEAR or DSPS_NCO_EXP
+ * @param f_start: start frequency in range of [-1..1), where 1 is a Nyquist frequency
+ * @param f_end: end frequency in range of [-1..1). For DSPS_NCO_EXP f_start and f_end must be
+ *               non zero with the same sign
+ * @param len: length of the sweep in samples, at least 2
+ * @param interp: 1 - linear interpolation between the table values, 0 - nearest value
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_PARAM if the frequencies or the type are not valid
+ *      - ESP_ERR_DSP_INVALID_LENGTH if len is less than 2
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if the ratio per sample of DSPS_NCO_EXP is 2 or more
+ */
+esp_err_t dsps_nco_chirp_init(nco_t *nco, dsps_nco_sweep_t type, float f_start, float f_end, int len, int interp);
+
+/**
+ * @brief   set frequency of the NCO
+ *
+ * The phase is continuous. The sweep of a chirp stops.
+ *
+ * @param nco: pointer to the generator structure, that must be initialized before
+ * @param freq: frequency in range of [-1..1), where 1 is a Nyquist frequency
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_PARAM if the frequency is out of range
+ */
+esp_err_t dsps_nco_set_freq(nco_t *nco, float freq);
+
+/**
+ * @brief   NCO sine and cosine, f32
+ *
+ * Function generates A*sin(phase) and A*cos(phase) from a 32-bit phase accumulator and a quarter wave
+ * table of DSPS_NCO_TABLE_SIZE + 1 values. The phase does not accumulate rounding error: after any
+ * amount of samples it is exact to 2^-32 of the period.
+ * The maximum error is 7.7e-4 for the nearest value and 3.5e-7 with the interpolation.
+ * The largest spur is below -72 dBc (about -80 dBc for a typical frequency) for the nearest value
+ * and about -120 dBc with the interpolation.
+ * The cost per sample does not depend on the frequency and does not use sin() or a division.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param nco: pointer to the generator structure, that must be initialized before
+ * @param sin_out: output sine. Could be NULL
+ * @param cos_out: output cosine. Could be NULL. For the complex signal use sin_out = &out[1],
+ *                 cos_out = &out[0] and step_out = 2
+ * @param len: amount of samples
+ * @param ampl: amplitude
+ * @param step_out: step over output arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_nco_f32(nco_t *nco, float *sin_out, float *cos_out, int len, float ampl, int step_out);
+
+/**
+ * @brief   NCO sine and cosine, s16
+ *
+ * Integer only version of dsps_nco_f32(...) with Q15 table. The maximum error is 26 LSB for
+ * the nearest value and 2 LSB with the interpolation, the largest spur is about -100 dBc.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param nco: pointer to the generator structure, that must be initialized before
+ * @param sin_out: output sine. Could be NULL
+ * @param cos_out: output cosine. Could be NULL
+ * @param len: amount of samples
+ * @param ampl: amplitude, Q15. 32767 is the full scale
+ * @param step_out: step over output arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_nco_s16(nco_t *nco, int16_t *sin_out, int16_t *cos_out, int len, int16_t ampl, int step_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_nco_H_
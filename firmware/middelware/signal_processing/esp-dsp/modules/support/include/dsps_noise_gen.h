@@ -0,0 +1,125 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_noise_gen_H_
+#define _dsps_noise_gen_H_
+
+#include <stdint.h>
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of the noise generator
+ *
+ * The generators of different tasks must use different structures.
+ * All fields of this structure are initialized by the dsps_noise_init(...) function.
+ */
+typedef struct noise_gen_s {
+    uint32_t    state;      /*!< State of the xorshift32 generator, never 0.*/
+} noise_gen_t;
+
+/**
+ * @brief   initialize structure for the noise generator
+ *
+ * @param noise: pointer to the generator structure, that must be preallocated
+ * @param seed: initial state. The same seed gives the same sequence. 0 is replaced by a constant
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_noise_init(noise_gen_t *noise, uint32_t seed);
+
+/**
+ * @brief   Uniform noise, f32
+ *
+ * Function generates uniform noise in range of [-ampl..ampl) by the xorshift32 generator:
+ * three shifts and three xor operations per sample, the period is 2^32 - 1.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param noise: pointer to the generator structure, that must be initialized before
+ * @param output: output array
+ * @param len: length of the output array
+ * @param ampl: amplitude
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_noise_uniform_f32(noise_gen_t *noise, float *output, int len, float ampl);
+
+/**
+ * @brief   Uniform noise, s16
+ *
+ * Integer only version of dsps_noise_uniform_f32(...).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param noise: pointer to the generator structure, that must be initialized before
+ * @param output: output array
+ * @param len: length of the output array
+ * @param ampl: amplitude, Q15. 32767 is the full scale
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_noise_uniform_s16(noise_gen_t *noise, int16_t *output, int len, int16_t ampl);
+
+/**
+ * @brief   Gaussian noise, f32
+ *
+ * Function generates normal noise with zero mean and standard deviation sigma as the sum of four
+ * uniform values (Irwin-Hall distribution) from two outputs of the xorshift32 generator.
+ * There is no logarithm or square root as in the Box-Muller method, but the tails are limited by
+ * +-3.46*sigma (probability of larger values of the normal distribution is 5e-4) and
+ * the kurtosis is 2.7 instead of 3.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param noise: pointer to the generator structure, that must be initialized before
+ * @param output: output array
+ * @param len: length of the output array
+ * @param sigma: standard deviation
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_noise_gauss_f32(noise_gen_t *noise, float *output, int len, float sigma);
+
+/**
+ * @brief   Gaussian noise, s16
+ *
+ * Integer only version of dsps_noise_gauss_f32(...). The output is saturated to the int16_t range.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param noise: pointer to the generator structure, that must be initialized before
+ * @param output: output array
+ * @param len: length of the output array
+ * @param sigma: standard deviation, Q15
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_noise_gauss_s16(noise_gen_t *noise, int16_t *output, int len, int16_t sigma);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_noise_gen_H_
@@ -27,6 +27,7 @@ extern "C"
  *
  * The function generate a tone signal.
  * x[i]=A*sin(2*PI*i + ph/180*PI)
+ * The tone is generated by the interpolated NCO (dsps_nco_f32), so the phase is exact for any length.
  * The implementation use ANSI C and could be compiled and run on any platform
  *
  * @param output: output array.
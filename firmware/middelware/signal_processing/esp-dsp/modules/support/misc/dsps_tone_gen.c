@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dsps_tone_gen.h"
+#include "dsps_nco.h"
 #include <math.h>
 
 esp_err_t dsps_tone_gen_f32(float *output, int len, float Ampl, float freq, float phase)
@@ -23,17 +24,20 @@ esp_err_t dsps_tone_gen_f32(float *output, int len, float Ampl, float freq, floa
     if (freq <= -1) {
         return ESP_ERR_DSP_INVALID_PARAM;
     }
-    float ph = phase / 180 * M_PI;
-    float fr  = 2 * M_PI * freq;
-    for (int i = 0 ; i < len ; i++) {
-        output[i] = Ampl * sin(ph);
-        ph += fr;
-        if (ph > 2 * M_PI) {
-            ph -= 2 * M_PI;
-        }
-        if (ph < -2 * M_PI) {
-            ph += 2 * M_PI;
-        }
+    // The phase advances by 2*PI*freq per sample. The NCO frequency is relative to Nyquist,
+    // the frequencies above Nyquist are replaced by the alias, which gives the same samples
+    float fr = 2 * freq;
+    if (fr >= 1) {
+        fr -= 2;
     }
-    return ESP_OK;
+    if (fr < -1) {
+        fr += 2;
+    }
+    // Phase accumulator instead of the float phase, so the phase error does not grow with len
+    nco_t nco;
+    esp_err_t ret = dsps_nco_init(&nco, fr, fmodf(phase / 360, 1), 1);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return dsps_nco_f32(&nco, output, NULL, len, Ampl, 1);
 }
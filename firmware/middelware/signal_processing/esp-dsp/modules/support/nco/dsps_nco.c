@@ -0,0 +1,339 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_nco.h"
+#include "dsps_fastmath.h"
+#include <math.h>
+#include <string.h>
+
+// sin(pi/2*i/DSPS_NCO_TABLE_SIZE), the Q15 values are in dsps_sin_table_q15
+static const float dsps_nco_table_f32[DSPS_NCO_TABLE_SIZE + 1] = {
+    0.000000000e+00f, 1.533980132e-03f, 3.067956772e-03f, 4.601926077e-03f, 6.135884672e-03f, 7.669828832e-03f, 9.203754365e-03f, 1.073765941e-02f,
+    1.227153838e-02f, 1.380538847e-02f, 1.533920597e-02f, 1.687298715e-02f, 1.840673015e-02f, 1.994042844e-02f, 2.147408016e-02f, 2.300768159e-02f,
+    2.454122901e-02f, 2.607471868e-02f, 2.760814503e-02f, 2.914150804e-02f, 3.067480400e-02f, 3.220802546e-02f, 3.374117240e-02f, 3.527423739e-02f,
+    3.680722415e-02f, 3.834012151e-02f, 3.987292573e-02f, 4.140564054e-02f, 4.293825850e-02f, 4.447077215e-02f, 4.600318149e-02f, 4.753548279e-02f,
+    4.906767607e-02f, 5.059975013e-02f, 5.213170499e-02f, 5.366353691e-02f, 5.519524589e-02f, 5.672682077e-02f, 5.825826526e-02f, 5.978957191e-02f,
+    6.132073700e-02f, 6.285175681e-02f, 6.438262761e-02f, 6.591334939e-02f, 6.744392216e-02f, 6.897433102e-02f, 7.050457597e-02f, 7.203464955e-02f,
+    7.356456667e-02f, 7.509429753e-02f, 7.662386447e-02f, 7.815324515e-02f, 7.968243957e-02f, 8.121144772e-02f, 8.274026215e-02f, 8.426889032e-02f,
+    8.579730988e-02f, 8.732553571e-02f, 8.885355294e-02f, 9.038136154e-02f, 9.190895408e-02f, 9.343633801e-02f, 9.496349841e-02f, 9.649042785e-02f,
+    9.801714122e-02f, 9.954361618e-02f, 1.010698602e-01f, 1.025958657e-01f, 1.041216329e-01f, 1.056471542e-01f, 1.071724221e-01f, 1.086974442e-01f,
+    1.102222055e-01f, 1.117467135e-01f, 1.132709533e-01f, 1.147949249e-01f, 1.163186282e-01f, 1.178420633e-01f, 1.193652153e-01f, 1.208880842e-01f,
+    1.224106774e-01f, 1.239329726e-01f, 1.254549772e-01f, 1.269766986e-01f, 1.284981072e-01f, 1.300192177e-01f, 1.315400302e-01f, 1.330605298e-01f,
+    1.345807016e-01f, 1.361005753e-01f, 1.376201212e-01f, 1.391393393e-01f, 1.406582445e-01f, 1.421768069e-01f, 1.436950266e-01f, 1.452129185e-01f,
+    1.467304677e-01f, 1.482476741e-01f, 1.497645378e-01f, 1.512810439e-01f, 1.527971923e-01f, 1.543129683e-01f, 1.558284014e-01f, 1.573434621e-01f,
+    1.588581502e-01f, 1.603724509e-01f, 1.618863940e-01f, 1.633999497e-01f, 1.649131179e-01f, 1.664258987e-01f, 1.679382920e-01f, 1.694502980e-01f,
+    1.709618866e-01f, 1.724730879e-01f, 1.739838719e-01f, 1.754942536e-01f, 1.770042181e-01f, 1.785137653e-01f, 1.800228953e-01f, 1.815316081e-01f,
+    1.830398887e-01f, 1.845477372e-01f, 1.860551536e-01f, 1.875621229e-01f, 1.890686601e-01f, 1.905747503e-01f, 1.920803934e-01f, 1.935855895e-01f,
+    1.950903237e-01f, 1.965945959e-01f, 1.980984062e-01f, 1.996017545e-01f, 2.011046410e-01f, 2.026070356e-01f, 2.041089684e-01f, 2.056104094e-01f,
+    2.071113735e-01f, 2.086118460e-01f, 2.101118416e-01f, 2.116113305e-01f, 2.131103128e-01f, 2.146088183e-01f, 2.161068022e-01f, 2.176042795e-01f,
+    2.191012353e-01f, 2.205976844e-01f, 2.220936269e-01f, 2.235890329e-01f, 2.250839174e-01f, 2.265782654e-01f, 2.280720770e-01f, 2.295653671e-01f,
+    2.310581058e-01f, 2.325503081e-01f, 2.340419590e-01f, 2.355330586e-01f, 2.370236069e-01f, 2.385135889e-01f, 2.400030196e-01f, 2.414918840e-01f,
+    2.429801822e-01f, 2.444678992e-01f, 2.459550500e-01f, 2.474416196e-01f, 2.489276081e-01f, 2.504130006e-01f, 2.518978119e-01f, 2.533820271e-01f,
+    2.548656464e-01f, 2.563486695e-01f, 2.578310966e-01f, 2.593129277e-01f, 2.607941031e-01f, 2.622747123e-01f, 2.637546659e-01f, 2.652340233e-01f,
+    2.667127550e-01f, 2.681908607e-01f, 2.696683109e-01f, 2.711451650e-01f, 2.726213634e-01f, 2.740969062e-01f, 2.755718231e-01f, 2.770460844e-01f,
+    2.785196900e-01f, 2.799926400e-01f, 2.814649343e-01f, 2.829365730e-01f, 2.844075263e-01f, 2.858778238e-01f, 2.873474658e-01f, 2.888164222e-01f,
+    2.902846634e-01f, 2.917522490e-01f, 2.932191491e-01f, 2.946853638e-01f, 2.961508930e-01f, 2.976157069e-01f, 2.990798354e-01f, 3.005432487e-01f,
+    3.020059466e-01f, 3.034679592e-01f, 3.049292266e-01f, 3.063898087e-01f, 3.078496456e-01f, 3.093087673e-01f, 3.107671440e-01f, 3.122248054e-01f,
+    3.136817515e-01f, 3.151379228e-01f, 3.165933788e-01f, 3.180480897e-01f, 3.195020258e-01f, 3.209552467e-01f, 3.224076927e-01f, 3.238593638e-01f,
+    3.253102899e-01f, 3.267604411e-01f, 3.282098472e-01f, 3.296584487e-01f, 3.311063051e-01f, 3.325533569e-01f, 3.339996636e-01f, 3.354451358e-01f,
+    3.368898630e-01f, 3.383337557e-01f, 3.397768736e-01f, 3.412192166e-01f, 3.426607251e-01f, 3.441014290e-01f, 3.455413282e-01f, 3.469804227e-01f,
+    3.484186828e-01f, 3.498561382e-01f, 3.512927592e-01f, 3.527285457e-01f, 3.541635275e-01f, 3.555976748e-01f, 3.570309579e-01f, 3.584634066e-01f,
+    3.598950505e-01f, 3.613258004e-01f, 3.627557158e-01f, 3.641847968e-01f, 3.656129837e-01f, 3.670403361e-01f, 3.684668243e-01f, 3.698924482e-01f,
+    3.713172078e-01f, 3.727410734e-01f, 3.741640747e-01f, 3.755861819e-01f, 3.770074248e-01f, 3.784277439e-01f, 3.798471987e-01f, 3.812657595e-01f,
+    3.826834261e-01f, 3.841001987e-01f, 3.855160475e-01f, 3.869310021e-01f, 3.883450329e-01f, 3.897581697e-01f, 3.911703825e-01f, 3.925816715e-01f,
+    3.939920366e-01f, 3.954014778e-01f, 3.968099952e-01f, 3.982175589e-01f, 3.996241987e-01f, 4.010298848e-01f, 4.024346471e-01f, 4.038384557e-01f,
+    4.052413106e-01f, 4.066432118e-01f, 4.080441594e-01f, 4.094441533e-01f, 4.108431637e-01f, 4.122412205e-01f, 4.136383235e-01f, 4.150344133e-01f,
+    4.164295495e-01f, 4.178237021e-01f, 4.192169011e-01f, 4.206090868e-01f, 4.220002592e-01f, 4.233904779e-01f, 4.247796834e-01f, 4.261678755e-01f,
+    4.275550842e-01f, 4.289412796e-01f, 4.303264916e-01f, 4.317106605e-01f, 4.330938160e-01f, 4.344759583e-01f, 4.358570874e-01f, 4.372371733e-01f,
+    4.386162460e-01f, 4.399942756e-01f, 4.413712621e-01f, 4.427472353e-01f, 4.441221356e-01f, 4.454960227e-01f, 4.468688369e-01f, 4.482406080e-01f,
+    4.496113360e-01f, 4.509809911e-01f, 4.523495734e-01f, 4.537171125e-01f, 4.550835788e-01f, 4.564489722e-01f, 4.578132927e-01f, 4.591765404e-01f,
+    4.605387151e-01f, 4.618997872e-01f, 4.632597864e-01f, 4.646186829e-01f, 4.659765065e-01f, 4.673331976e-01f, 4.686888158e-01f, 4.700433314e-01f,
+    4.713967443e-01f, 4.727490246e-01f, 4.741002023e-01f, 4.754502773e-01f, 4.767992198e-01f, 4.781470597e-01f, 4.794937670e-01f, 4.808393419e-01f,
+    4.821837842e-01f, 4.835270643e-01f, 4.848692417e-01f, 4.862102866e-01f, 4.875501692e-01f, 4.888888896e-01f, 4.902264774e-01f, 4.915629029e-01f,
+    4.928981960e-01f, 4.942322969e-01f, 4.955652654e-01f, 4.968970418e-01f, 4.982276559e-01f, 4.995571077e-01f, 5.008853674e-01f, 5.022124648e-01f,
+    5.035383701e-01f, 5.048630834e-01f, 5.061866641e-01f, 5.075089931e-01f, 5.088301301e-01f, 5.101500750e-01f, 5.114688277e-01f, 5.127863884e-01f,
+    5.141027570e-01f, 5.154178739e-01f, 5.167317986e-01f, 5.180445313e-01f, 5.193560123e-01f, 5.206662416e-01f, 5.219752789e-01f, 5.232831240e-01f,
+    5.245896578e-01f, 5.258949995e-01f, 5.271991491e-01f, 5.285019875e-01f, 5.298036337e-01f, 5.311040282e-01f, 5.324031115e-01f, 5.337010026e-01f,
+    5.349976420e-01f, 5.362929702e-01f, 5.375870466e-01f, 5.388799310e-01f, 5.401714444e-01f, 5.414617658e-01f, 5.427507758e-01f, 5.440385342e-01f,
+    5.453249812e-01f, 5.466101766e-01f, 5.478940606e-01f, 5.491766334e-01f, 5.504579544e-01f, 5.517379642e-01f, 5.530167222e-01f, 5.542941093e-01f,
+    5.555702448e-01f, 5.568450093e-01f, 5.581185222e-01f, 5.593907237e-01f, 5.606615543e-01f, 5.619311333e-01f, 5.631993413e-01f, 5.644662380e-01f,
+    5.657318234e-01f, 5.669960380e-01f, 5.682589412e-01f, 5.695205331e-01f, 5.707807541e-01f, 5.720396042e-01f, 5.732971430e-01f, 5.745533705e-01f,
+    5.758081675e-01f, 5.770616531e-01f, 5.783137679e-01f, 5.795645714e-01f, 5.808139443e-01f, 5.820620060e-01f, 5.833086371e-01f, 5.845539570e-01f,
+    5.857978463e-01f, 5.870403647e-01f, 5.882815719e-01f, 5.895212889e-01f, 5.907596946e-01f, 5.919966698e-01f, 5.932322741e-01f, 5.944665074e-01f,
+    5.956993103e-01f, 5.969306827e-01f, 5.981606841e-01f, 5.993893147e-01f, 6.006164551e-01f, 6.018422246e-01f, 6.030666232e-01f, 6.042895317e-01f,
+    6.055110693e-01f, 6.067311168e-01f, 6.079497933e-01f, 6.091670394e-01f, 6.103827953e-01f, 6.115971804e-01f, 6.128100753e-01f, 6.140215397e-01f,
+    6.152315736e-01f, 6.164401770e-01f, 6.176472902e-01f, 6.188529730e-01f, 6.200572252e-01f, 6.212599874e-01f, 6.224612594e-01f, 6.236611009e-01f,
+    6.248595119e-01f, 6.260563731e-01f, 6.272518039e-01f, 6.284457445e-01f, 6.296382546e-01f, 6.308292150e-01f, 6.320187449e-01f, 6.332067847e-01f,
+    6.343932748e-01f, 6.355783343e-01f, 6.367618442e-01f, 6.379439235e-01f, 6.391244531e-01f, 6.403034925e-01f, 6.414810419e-01f, 6.426570415e-01f,
+    6.438315511e-01f, 6.450045109e-01f, 6.461760402e-01f, 6.473459601e-01f, 6.485143900e-01f, 6.496813297e-01f, 6.508466601e-01f, 6.520105600e-01f,
+    6.531728506e-01f, 6.543335915e-01f, 6.554928422e-01f, 6.566505432e-01f, 6.578066945e-01f, 6.589612961e-01f, 6.601143479e-01f, 6.612658501e-01f,
+    6.624158025e-01f, 6.635641456e-01f, 6.647109985e-01f, 6.658562422e-01f, 6.669999361e-01f, 6.681420207e-01f, 6.692826152e-01f, 6.704215407e-01f,
+    6.715589762e-01f, 6.726947427e-01f, 6.738290191e-01f, 6.749616265e-01f, 6.760926843e-01f, 6.772221923e-01f, 6.783500314e-01f, 6.794763207e-01f,
+    6.806010008e-01f, 6.817240715e-01f, 6.828455329e-01f, 6.839653850e-01f, 6.850836873e-01f, 6.862003207e-01f, 6.873153448e-01f, 6.884287596e-01f,
+    6.895405650e-01f, 6.906507015e-01f, 6.917592287e-01f, 6.928661466e-01f, 6.939714551e-01f, 6.950750947e-01f, 6.961771250e-01f, 6.972774863e-01f,
+    6.983762383e-01f, 6.994733214e-01f, 7.005687952e-01f, 7.016626000e-01f, 7.027547359e-01f, 7.038452625e-01f, 7.049340606e-01f, 7.060212493e-01f,
+    7.071067691e-01f, 7.081906199e-01f, 7.092728019e-01f, 7.103533745e-01f, 7.114322186e-01f, 7.125093937e-01f, 7.135848403e-01f, 7.146586776e-01f,
+    7.157308459e-01f, 7.168012857e-01f, 7.178700566e-01f, 7.189370990e-01f, 7.200025320e-01f, 7.210661769e-01f, 7.221282125e-01f, 7.231884599e-01f,
+    7.242470980e-01f, 7.253039479e-01f, 7.263591290e-01f, 7.274126410e-01f, 7.284643650e-01f, 7.295144200e-01f, 7.305627465e-01f, 7.316094041e-01f,
+    7.326542735e-01f, 7.336974144e-01f, 7.347388864e-01f, 7.357785702e-01f, 7.368165851e-01f, 7.378528118e-01f, 7.388873100e-01f, 7.399200797e-01f,
+    7.409511209e-01f, 7.419804335e-01f, 7.430079579e-01f, 7.440337539e-01f, 7.450577617e-01f, 7.460801005e-01f, 7.471005917e-01f, 7.481193542e-01f,
+    7.491363883e-01f, 7.501516342e-01f, 7.511651516e-01f, 7.521768212e-01f, 7.531868219e-01f, 7.541949749e-01f, 7.552013993e-01f, 7.562059760e-01f,
+    7.572088242e-01f, 7.582098842e-01f, 7.592092156e-01f, 7.602066994e-01f, 7.612023950e-01f, 7.621963024e-01f, 7.631884217e-01f, 7.641787529e-01f,
+    7.651672363e-01f, 7.661539912e-01f, 7.671388984e-01f, 7.681220174e-01f, 7.691033483e-01f, 7.700828314e-01f, 7.710605264e-01f, 7.720363736e-01f,
+    7.730104327e-01f, 7.739827037e-01f, 7.749531269e-01f, 7.759217024e-01f, 7.768884897e-01f, 7.778534293e-01f, 7.788165212e-01f, 7.797777653e-01f,
+    7.807372212e-01f, 7.816948295e-01f, 7.826505899e-01f, 7.836045027e-01f, 7.845565677e-01f, 7.855068445e-01f, 7.864552140e-01f, 7.874017358e-01f,
+    7.883464098e-01f, 7.892892361e-01f, 7.902302146e-01f, 7.911693454e-01f, 7.921065688e-01f, 7.930419445e-01f, 7.939754725e-01f, 7.949071527e-01f,
+    7.958369255e-01f, 7.967647910e-01f, 7.976908684e-01f, 7.986149788e-01f, 7.995372415e-01f, 8.004576564e-01f, 8.013761640e-01f, 8.022928238e-01f,
+    8.032075167e-01f, 8.041203618e-01f, 8.050313592e-01f, 8.059403896e-01f, 8.068475723e-01f, 8.077528477e-01f, 8.086561561e-01f, 8.095576167e-01f,
+    8.104571700e-01f, 8.113548756e-01f, 8.122506142e-01f, 8.131443858e-01f, 8.140363097e-01f, 8.149263263e-01f, 8.158144355e-01f, 8.167005777e-01f,
+    8.175848126e-01f, 8.184671402e-01f, 8.193475008e-01f, 8.202259541e-01f, 8.211025000e-01f, 8.219771385e-01f, 8.228498101e-01f, 8.237205148e-01f,
+    8.245893121e-01f, 8.254561424e-01f, 8.263210654e-01f, 8.271840215e-01f, 8.280450702e-01f, 8.289040923e-01f, 8.297612071e-01f, 8.306164145e-01f,
+    8.314695954e-01f, 8.323208690e-01f, 8.331701756e-01f, 8.340175152e-01f, 8.348628879e-01f, 8.357062936e-01f, 8.365477324e-01f, 8.373872042e-01f,
+    8.382247090e-01f, 8.390602469e-01f, 8.398938179e-01f, 8.407253623e-01f, 8.415549994e-01f, 8.423826098e-01f, 8.432082534e-01f, 8.440318704e-01f,
+    8.448535800e-01f, 8.456732631e-01f, 8.464909196e-01f, 8.473066092e-01f, 8.481203318e-01f, 8.489320278e-01f, 8.497417569e-01f, 8.505494595e-01f,
+    8.513551950e-01f, 8.521589041e-01f, 8.529605865e-01f, 8.537603021e-01f, 8.545579910e-01f, 8.553536534e-01f, 8.561473489e-01f, 8.569389582e-01f,
+    8.577286005e-01f, 8.585162163e-01f, 8.593018055e-01f, 8.600853682e-01f, 8.608669639e-01f, 8.616464734e-01f, 8.624239564e-01f, 8.631994128e-01f,
+    8.639728427e-01f, 8.647442460e-01f, 8.655136228e-01f, 8.662809730e-01f, 8.670462370e-01f, 8.678094745e-01f, 8.685706854e-01f, 8.693298697e-01f,
+    8.700869679e-01f, 8.708420396e-01f, 8.715950847e-01f, 8.723460436e-01f, 8.730949759e-01f, 8.738418221e-01f, 8.745866418e-01f, 8.753293753e-01f,
+    8.760700822e-01f, 8.768087029e-01f, 8.775452971e-01f, 8.782798052e-01f, 8.790122271e-01f, 8.797426224e-01f, 8.804708719e-01f, 8.811970949e-01f,
+    8.819212914e-01f, 8.826433420e-01f, 8.833633661e-01f, 8.840812445e-01f, 8.847970963e-01f, 8.855108619e-01f, 8.862225413e-01f, 8.869321346e-01f,
+    8.876396418e-01f, 8.883450627e-01f, 8.890483379e-01f, 8.897495866e-01f, 8.904487491e-01f, 8.911457658e-01f, 8.918406963e-01f, 8.925335407e-01f,
+    8.932242990e-01f, 8.939129710e-01f, 8.945994973e-01f, 8.952839375e-01f, 8.959662318e-01f, 8.966464996e-01f, 8.973245621e-01f, 8.980005980e-01f,
+    8.986744881e-01f, 8.993462324e-01f, 9.000158906e-01f, 9.006834030e-01f, 9.013488293e-01f, 9.020121694e-01f, 9.026733041e-01f, 9.033323526e-01f,
+    9.039893150e-01f, 9.046440721e-01f, 9.052967429e-01f, 9.059472680e-01f, 9.065957069e-01f, 9.072420001e-01f, 9.078860879e-01f, 9.085280895e-01f,
+    9.091680050e-01f, 9.098057151e-01f, 9.104412794e-01f, 9.110747576e-01f, 9.117060304e-01f, 9.123351574e-01f, 9.129621983e-01f, 9.135870337e-01f,
+    9.142097831e-01f, 9.148303270e-01f, 9.154487252e-01f, 9.160649776e-01f, 9.166790843e-01f, 9.172909856e-01f, 9.179008007e-01f, 9.185084105e-01f,
+    9.191138744e-01f, 9.197171330e-01f, 9.203183055e-01f, 9.209172130e-01f, 9.215140343e-01f, 9.221086502e-01f, 9.227011204e-01f, 9.232914448e-01f,
+    9.238795042e-01f, 9.244654775e-01f, 9.250492454e-01f, 9.256308079e-01f, 9.262102246e-01f, 9.267874956e-01f, 9.273625016e-01f, 9.279354215e-01f,
+    9.285060763e-01f, 9.290745854e-01f, 9.296408892e-01f, 9.302050471e-01f, 9.307669401e-01f, 9.313266873e-01f, 9.318842888e-01f, 9.324396253e-01f,
+    9.329928160e-01f, 9.335438013e-01f, 9.340925217e-01f, 9.346391559e-01f, 9.351835251e-01f, 9.357256889e-01f, 9.362656474e-01f, 9.368034601e-01f,
+    9.373390079e-01f, 9.378723502e-01f, 9.384035468e-01f, 9.389324784e-01f, 9.394592047e-01f, 9.399837255e-01f, 9.405060410e-01f, 9.410261512e-01f,
+    9.415440559e-01f, 9.420597553e-01f, 9.425731897e-01f, 9.430844188e-01f, 9.435934424e-01f, 9.441002607e-01f, 9.446048141e-01f, 9.451072216e-01f,
+    9.456073046e-01f, 9.461052418e-01f, 9.466009140e-01f, 9.470943809e-01f, 9.475855827e-01f, 9.480745792e-01f, 9.485613704e-01f, 9.490458965e-01f,
+    9.495281577e-01f, 9.500082731e-01f, 9.504860640e-01f, 9.509616494e-01f, 9.514350295e-01f, 9.519061446e-01f, 9.523749948e-01f, 9.528416395e-01f,
+    9.533060193e-01f, 9.537681937e-01f, 9.542281032e-01f, 9.546857476e-01f, 9.551411867e-01f, 9.555943608e-01f, 9.560452700e-01f, 9.564939141e-01f,
+    9.569403529e-01f, 9.573845267e-01f, 9.578264356e-01f, 9.582660794e-01f, 9.587034583e-01f, 9.591386318e-01f, 9.595715404e-01f, 9.600021243e-01f,
+    9.604305029e-01f, 9.608566165e-01f, 9.612804651e-01f, 9.617020488e-01f, 9.621214271e-01f, 9.625384808e-01f, 9.629532695e-01f, 9.633657932e-01f,
+    9.637760520e-01f, 9.641840458e-01f, 9.645897746e-01f, 9.649932384e-01f, 9.653944373e-01f, 9.657933712e-01f, 9.661899805e-01f, 9.665843844e-01f,
+    9.669764638e-01f, 9.673662782e-01f, 9.677538276e-01f, 9.681391120e-01f, 9.685220718e-01f, 9.689028263e-01f, 9.692812562e-01f, 9.696573615e-01f,
+    9.700312614e-01f, 9.704028368e-01f, 9.707721472e-01f, 9.711391330e-01f, 9.715039134e-01f, 9.718663096e-01f, 9.722265005e-01f, 9.725843668e-01f,
+    9.729399681e-01f, 9.732932448e-01f, 9.736442566e-01f, 9.739929438e-01f, 9.743393660e-01f, 9.746835232e-01f, 9.750253558e-01f, 9.753648639e-01f,
+    9.757021070e-01f, 9.760370851e-01f, 9.763697386e-01f, 9.767000675e-01f, 9.770281315e-01f, 9.773538709e-01f, 9.776773453e-01f, 9.779984951e-01f,
+    9.783173800e-01f, 9.786339402e-01f, 9.789481759e-01f, 9.792601466e-01f, 9.795697927e-01f, 9.798771143e-01f, 9.801821113e-01f, 9.804848433e-01f,
+    9.807852507e-01f, 9.810833931e-01f, 9.813792109e-01f, 9.816727042e-01f, 9.819638729e-01f, 9.822527170e-01f, 9.825392962e-01f, 9.828235507e-01f,
+    9.831054807e-01f, 9.833850861e-01f, 9.836624265e-01f, 9.839374423e-01f, 9.842100739e-01f, 9.844804406e-01f, 9.847484827e-01f, 9.850142598e-01f,
+    9.852776527e-01f, 9.855387211e-01f, 9.857975245e-01f, 9.860539436e-01f, 9.863080978e-01f, 9.865599275e-01f, 9.868093729e-01f, 9.870565534e-01f,
+    9.873014092e-01f, 9.875439405e-01f, 9.877841473e-01f, 9.880220294e-01f, 9.882575870e-01f, 9.884908199e-01f, 9.887216687e-01f, 9.889502525e-01f,
+    9.891765118e-01f, 9.894004464e-01f, 9.896219969e-01f, 9.898412824e-01f, 9.900581837e-01f, 9.902728200e-01f, 9.904850721e-01f, 9.906949997e-01f,
+    9.909026623e-01f, 9.911079407e-01f, 9.913108349e-01f, 9.915114641e-01f, 9.917097688e-01f, 9.919056892e-01f, 9.920992851e-01f, 9.922906160e-01f,
+    9.924795628e-01f, 9.926661253e-01f, 9.928504229e-01f, 9.930323362e-01f, 9.932119250e-01f, 9.933891892e-01f, 9.935641289e-01f, 9.937367439e-01f,
+    9.939069748e-01f, 9.940748811e-01f, 9.942404628e-01f, 9.944036603e-01f, 9.945645928e-01f, 9.947231412e-01f, 9.948793054e-01f, 9.950332046e-01f,
+    9.951847196e-01f, 9.953339100e-01f, 9.954807758e-01f, 9.956252575e-01f, 9.957674146e-01f, 9.959072471e-01f, 9.960446954e-01f, 9.961798191e-01f,
+    9.963126183e-01f, 9.964430332e-01f, 9.965711236e-01f, 9.966968894e-01f, 9.968202710e-01f, 9.969413280e-01f, 9.970600605e-01f, 9.971764088e-01f,
+    9.972904325e-01f, 9.974021316e-01f, 9.975114465e-01f, 9.976184368e-01f, 9.977230430e-01f, 9.978253245e-01f, 9.979252815e-01f, 9.980228543e-01f,
+    9.981181026e-01f, 9.982110262e-01f, 9.983015656e-01f, 9.983897209e-01f, 9.984755516e-01f, 9.985590577e-01f, 9.986402392e-01f, 9.987190366e-01f,
+    9.987954497e-01f, 9.988695383e-01f, 9.989413023e-01f, 9.990106821e-01f, 9.990777373e-01f, 9.991424084e-01f, 9.992047548e-01f, 9.992647767e-01f,
+    9.993223548e-01f, 9.993776679e-01f, 9.994305968e-01f, 9.994812012e-01f, 9.995294213e-01f, 9.995753169e-01f, 9.996188283e-01f, 9.996600151e-01f,
+    9.996988177e-01f, 9.997352958e-01f, 9.997693896e-01f, 9.998011589e-01f, 9.998306036e-01f, 9.998576641e-01f, 9.998823404e-01f, 9.999046922e-01f,
+    9.999247193e-01f, 9.999423623e-01f, 9.999576211e-01f, 9.999706149e-01f, 9.999811649e-01f, 9.999893904e-01f, 9.999952912e-01f, 9.999988079e-01f,
+    1.000000000e+00f
+};
+
+// Position inside the quarter of the period, DSPS_NCO_TABLE_BITS integer and 16 fractional bits
+#define NCO_FRAC_BITS   16
+#define NCO_POS_SHIFT   (32 - 2 - DSPS_NCO_TABLE_BITS - NCO_FRAC_BITS)
+#define NCO_POS_MASK    ((1 << (DSPS_NCO_TABLE_BITS + NCO_FRAC_BITS)) - 1)
+#define NCO_QUARTER     0x40000000
+
+static inline uint32_t dsps_nco_pos(uint32_t phase)
+{
+    uint32_t pos = (phase >> NCO_POS_SHIFT) & NCO_POS_MASK;
+    // The second and the fourth quarters are mirrored
+    if (phase & NCO_QUARTER) {
+        pos = (NCO_POS_MASK + 1) - pos;
+    }
+    return pos;
+}
+
+static inline float dsps_nco_sin_f32(uint32_t phase, int interp)
+{
+    uint32_t pos = dsps_nco_pos(phase);
+    float v;
+    if (interp) {
+        int idx = pos >> NCO_FRAC_BITS;
+        v = dsps_nco_table_f32[idx];
+        if (idx < DSPS_NCO_TABLE_SIZE) {
+            v += (dsps_nco_table_f32[idx + 1] - v) * (float)(pos & ((1 << NCO_FRAC_BITS) - 1)) * (1.0f / (1 << NCO_FRAC_BITS));
+        }
+    } else {
+        v = dsps_nco_table_f32[(pos + (1 << (NCO_FRAC_BITS - 1))) >> NCO_FRAC_BITS];
+    }
+    return (phase & 0x80000000) ? -v : v;
+}
+
+static inline int32_t dsps_nco_sin_s16(uint32_t phase, int interp)
+{
+    uint32_t pos = dsps_nco_pos(phase);
+    int32_t v;
+    if (interp) {
+        int idx = pos >> NCO_FRAC_BITS;
+        v = dsps_sin_table_q15[idx];
+        if (idx < DSPS_NCO_TABLE_SIZE) {
+            // The table is rising, the difference is positive
+            v += ((dsps_sin_table_q15[idx + 1] - v) * (int32_t)(pos & ((1 << NCO_FRAC_BITS) - 1)) + (1 << (NCO_FRAC_BITS - 1))) >> NCO_FRAC_BITS;
+        }
+    } else {
+        v = dsps_sin_table_q15[(pos + (1 << (NCO_FRAC_BITS - 1))) >> NCO_FRAC_BITS];
+    }
+    return (phase & 0x80000000) ? -v : v;
+}
+
+// Frequency (-1..1 of Nyquist) to the increment of the phase, 2^64 is 2*Pi
+static int64_t dsps_nco_step(double freq)
+{
+    return (int64_t)ldexp(freq, 63);
+}
+
+// Advance the phase and the sweep by one sample
+static inline void dsps_nco_next(nco_t *nco)
+{
+    nco->phase += (uint32_t)((uint64_t)nco->step >> 32);
+    if (nco->type == DSPS_NCO_LINEAR) {
+        nco->step += nco->sweep;
+    } else if (nco->type == DSPS_NCO_EXP) {
+        nco->step += (int64_t)(int32_t)((uint64_t)nco->step >> 32) * nco->rate * 2;
+    }
+}
+
+esp_err_t dsps_nco_init(nco_t *nco, float freq, float phase, int interp)
+{
+    if (nco == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((freq < -1) || (freq >= 1) || (phase < -1) || (phase > 1)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    memset(nco, 0, sizeof(nco_t));
+    nco->phase = (uint32_t)(int64_t)ldexp(phase, 32);
+    nco->step = dsps_nco_step(freq);
+    nco->type = DSPS_NCO_TONE;
+    nco->interp = interp;
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_chirp_init(nco_t *nco, dsps_nco_sweep_t type, float f_start, float f_end, int len, int interp)
+{
+    if (nco == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((f_start < -1) || (f_start >= 1) || (f_end < -1) || (f_end >= 1)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (len < 2) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    memset(nco, 0, sizeof(nco_t));
+    nco->step = dsps_nco_step(f_start);
+    nco->type = type;
+    nco->interp = interp;
+    if (type == DSPS_NCO_LINEAR) {
+        // |f_end - f_start| <= 2 and len >= 2, so the sweep fits
+        nco->sweep = (int64_t)(ldexp((double)f_end - f_start, 63) / len);
+    } else if (type == DSPS_NCO_EXP) {
+        if ((f_start == 0) || (f_end == 0) || ((f_start < 0) != (f_end < 0))) {
+            return ESP_ERR_DSP_INVALID_PARAM;
+        }
+        double rate = pow((double)f_end / f_start, 1.0 / len) - 1;
+        if (fabs(rate) >= 1) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        nco->rate = (int32_t)round(ldexp(rate, 31));
+    } else {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_set_freq(nco_t *nco, float freq)
+{
+    if (nco == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if ((freq < -1) || (freq >= 1)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    nco->step = dsps_nco_step(freq);
+    nco->type = DSPS_NCO_TONE;
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_f32(nco_t *nco, float *sin_out, float *cos_out, int len, float ampl, int step_out)
+{
+    if (nco == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    // The loops are separated so the check of the interpolation is out of the loop
+    if (nco->interp) {
+        for (int i = 0; i < len; i++) {
+            if (sin_out) {
+                sin_out[i * step_out] = ampl * dsps_nco_sin_f32(nco->phase, 1);
+            }
+            if (cos_out) {
+                cos_out[i * step_out] = ampl * dsps_nco_sin_f32(nco->phase + NCO_QUARTER, 1);
+            }
+            dsps_nco_next(nco);
+        }
+    } else {
+        for (int i = 0; i < len; i++) {
+            if (sin_out) {
+                sin_out[i * step_out] = ampl * dsps_nco_sin_f32(nco->phase, 0);
+            }
+            if (cos_out) {
+                cos_out[i * step_out] = ampl * dsps_nco_sin_f32(nco->phase + NCO_QUARTER, 0);
+            }
+            dsps_nco_next(nco);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_nco_s16(nco_t *nco, int16_t *sin_out, int16_t *cos_out, int len, int16_t ampl, int step_out)
+{
+    if (nco == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    int32_t round = 1 << 14;
+    if (nco->interp) {
+        for (int i = 0; i < len; i++) {
+            if (sin_out) {
+                sin_out[i * step_out] = (dsps_nco_sin_s16(nco->phase, 1) * ampl + round) >> 15;
+            }
+            if (cos_out) {
+                cos_out[i * step_out] = (dsps_nco_sin_s16(nco->phase + NCO_QUARTER, 1) * ampl + round) >> 15;
+            }
+            dsps_nco_next(nco);
+        }
+    } else {
+        for (int i = 0; i < len; i++) {
+            if (sin_out) {
+                sin_out[i * step_out] = (dsps_nco_sin_s16(nco->phase, 0) * ampl + round) >> 15;
+            }
+            if (cos_out) {
+                cos_out[i * step_out] = (dsps_nco_sin_s16(nco->phase + NCO_QUARTER, 0) * ampl + round) >> 15;
+            }
+            dsps_nco_next(nco);
+        }
+    }
+    return ESP_OK;
+}
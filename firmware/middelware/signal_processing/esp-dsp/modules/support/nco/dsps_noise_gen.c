@@ -0,0 +1,108 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_noise_gen.h"
+#include <stddef.h>
+
+// Standard deviation of the sum of four uniform int16_t values: 65536/sqrt(3)
+#define NOISE_SUM4_STD  37837.23f
+// 2^32/NOISE_SUM4_STD
+#define NOISE_SUM4_GAIN 113512
+
+static inline uint32_t dsps_noise_next(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Sum of four uniform int16_t values, zero mean
+static inline int32_t dsps_noise_sum4(uint32_t *state)
+{
+    uint32_t r1 = dsps_noise_next(state);
+    uint32_t r2 = dsps_noise_next(state);
+    // Mean of each int16_t value is -0.5
+    return (int16_t)r1 + (int16_t)(r1 >> 16) + (int16_t)r2 + (int16_t)(r2 >> 16) + 2;
+}
+
+esp_err_t dsps_noise_init(noise_gen_t *noise, uint32_t seed)
+{
+    if (noise == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    noise->state = (seed != 0) ? seed : 0x6d2b79f5;
+    return ESP_OK;
+}
+
+esp_err_t dsps_noise_uniform_f32(noise_gen_t *noise, float *output, int len, float ampl)
+{
+    if ((noise == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    uint32_t state = noise->state;
+    float scale = ampl * (1.0f / 2147483648.0f);
+    for (int i = 0; i < len; i++) {
+        output[i] = (float)(int32_t)dsps_noise_next(&state) * scale;
+    }
+    noise->state = state;
+    return ESP_OK;
+}
+
+esp_err_t dsps_noise_uniform_s16(noise_gen_t *noise, int16_t *output, int len, int16_t ampl)
+{
+    if ((noise == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    uint32_t state = noise->state;
+    for (int i = 0; i < len; i++) {
+        output[i] = ((int32_t)(int16_t)(dsps_noise_next(&state) >> 16) * ampl) >> 15;
+    }
+    noise->state = state;
+    return ESP_OK;
+}
+
+esp_err_t dsps_noise_gauss_f32(noise_gen_t *noise, float *output, int len, float sigma)
+{
+    if ((noise == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    uint32_t state = noise->state;
+    float scale = sigma / NOISE_SUM4_STD;
+    for (int i = 0; i < len; i++) {
+        output[i] = (float)dsps_noise_sum4(&state) * scale;
+    }
+    noise->state = state;
+    return ESP_OK;
+}
+
+esp_err_t dsps_noise_gauss_s16(noise_gen_t *noise, int16_t *output, int len, int16_t sigma)
+{
+    if ((noise == NULL) || (output == NULL)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    uint32_t state = noise->state;
+    // sigma/NOISE_SUM4_STD, Q32
+    int64_t gain = (int64_t)sigma * NOISE_SUM4_GAIN;
+    for (int i = 0; i < len; i++) {
+        int32_t v = (int32_t)(((int64_t)dsps_noise_sum4(&state) * gain + 0x80000000LL) >> 32);
+        v = (v > INT16_MAX) ? INT16_MAX : v;
+        v = (v < INT16_MIN) ? INT16_MIN : v;
+        output[i] = v;
+    }
+    noise->state = state;
+    return ESP_OK;
+}
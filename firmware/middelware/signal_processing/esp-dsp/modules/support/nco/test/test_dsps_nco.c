@@ -0,0 +1,191 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_nco.h"
+#include "dsps_tone_gen.h"
+#include "dsps_sfdr.h"
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_nco";
+
+#define N_SFDR      4096
+#define N_LONG      (1 << 20)
+
+static float out_sin[N_SFDR];
+static float out_cos[N_SFDR];
+static int16_t out16_sin[N_SFDR];
+static int16_t out16_cos[N_SFDR];
+
+TEST_CASE("dsps_nco accuracy", "[dsps]")
+{
+    nco_t nco;
+    const float freq = 0.0123f;
+    const float phase = 0.3f;
+    for (int interp = 0; interp < 2; interp++) {
+        TEST_ESP_OK(dsps_nco_init(&nco, freq, phase, interp));
+        uint32_t ph = nco.phase;
+        uint32_t step = (uint32_t)((uint64_t)nco.step >> 32);
+        TEST_ESP_OK(dsps_nco_f32(&nco, out_sin, out_cos, N_SFDR, 1, 1));
+        TEST_ESP_OK(dsps_nco_s16(&nco, out16_sin, out16_cos, N_SFDR, 32767, 1));
+        double err = 0;
+        double err16 = 0;
+        for (int i = 0; i < N_SFDR; i++) {
+            double a = 2 * M_PI * (double)(ph + i * step) / 4294967296.0;
+            double a16 = 2 * M_PI * (double)(ph + (i + N_SFDR) * step) / 4294967296.0;
+            err = fmax(err, fabs(out_sin[i] - sin(a)));
+            err = fmax(err, fabs(out_cos[i] - cos(a)));
+            err16 = fmax(err16, fabs(out16_sin[i] - 32767 * sin(a16)));
+            err16 = fmax(err16, fabs(out16_cos[i] - 32767 * cos(a16)));
+        }
+        ESP_LOGI(TAG, "interp %i: maximum error f32 %e, s16 %.2f LSB", interp, err, err16);
+        if (interp) {
+            TEST_ASSERT_LESS_OR_EQUAL(5, (int)(1e7 * err));
+            TEST_ASSERT_LESS_OR_EQUAL(250, (int)(100 * err16));
+        } else {
+            TEST_ASSERT_LESS_OR_EQUAL(800, (int)(1e6 * err));
+            TEST_ASSERT_LESS_OR_EQUAL(26, (int)err16);
+        }
+    }
+
+    // The phase does not drift: 205/1024 of the sample frequency is exact in the accumulator
+    float *out = (float *)malloc(N_LONG * sizeof(float));
+    TEST_ASSERT_NOT_NULL(out);
+    TEST_ESP_OK(dsps_tone_gen_f32(out, N_LONG, 1, 205.0f / 1024, 90));
+    double err = 0;
+    for (int i = N_LONG - 1024; i < N_LONG; i++) {
+        double a = 2 * M_PI * 205.0 / 1024 * (double)i + M_PI / 2;
+        err = fmax(err, fabs(out[i] - sin(a)));
+    }
+    free(out);
+    ESP_LOGI(TAG, "tone after %i samples: maximum error %e", N_LONG, err);
+    TEST_ASSERT_LESS_OR_EQUAL(5, (int)(1e7 * err));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_nco_init(&nco, 1, 0, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_nco_init(&nco, 0.1, 1.5, 1));
+}
+
+TEST_CASE("dsps_nco sfdr", "[dsps]")
+{
+    nco_t nco;
+    // Close to the bin 401, the fractional position in the table sweeps over the block
+    const float freq = 2 * (401 + 1.0f / 4096) / N_SFDR;
+    float sfdr[4];
+    // dsps_sfdr_f32 initializes the FFT table, the table of a smaller size could be left by another test
+    dsps_fft2r_deinit_fc32();
+    for (int interp = 0; interp < 2; interp++) {
+        TEST_ESP_OK(dsps_nco_init(&nco, freq, 0, interp));
+        TEST_ESP_OK(dsps_nco_f32(&nco, out_sin, NULL, N_SFDR, 1, 1));
+        sfdr[interp] = dsps_sfdr_f32(out_sin, N_SFDR, 0);
+
+        TEST_ESP_OK(dsps_nco_init(&nco, freq, 0, interp));
+        TEST_ESP_OK(dsps_nco_s16(&nco, out16_sin, NULL, N_SFDR, 32767, 1));
+        for (int i = 0; i < N_SFDR; i++) {
+            out_sin[i] = out16_sin[i] / 32768.0f;
+        }
+        sfdr[2 + interp] = dsps_sfdr_f32(out_sin, N_SFDR, 0);
+    }
+    dsps_fft2r_deinit_fc32();
+    ESP_LOGI(TAG, "SFDR f32: nearest %.1f dB, interpolated %.1f dB", sfdr[0], sfdr[1]);
+    ESP_LOGI(TAG, "SFDR s16: nearest %.1f dB, interpolated %.1f dB", sfdr[2], sfdr[3]);
+    TEST_ASSERT_GREATER_OR_EQUAL(66, (int)sfdr[0]);
+    TEST_ASSERT_GREATER_OR_EQUAL(100, (int)sfdr[1]);
+    TEST_ASSERT_GREATER_OR_EQUAL(66, (int)sfdr[2]);
+    TEST_ASSERT_GREATER_OR_EQUAL(88, (int)sfdr[3]);
+    TEST_ASSERT_GREATER_OR_EQUAL((int)sfdr[0] + 20, (int)sfdr[1]);
+}
+
+TEST_CASE("dsps_nco chirp", "[dsps]")
+{
+    nco_t nco;
+    const float f0 = 0.01f;
+    const float f1 = 0.4f;
+    const int len = N_SFDR;
+
+    // Linear: the phase is the sum of the increments f0/2 + k*(f1 - f0)/(2*len) turns
+    TEST_ESP_OK(dsps_nco_chirp_init(&nco, DSPS_NCO_LINEAR, f0, f1, len, 1));
+    TEST_ESP_OK(dsps_nco_f32(&nco, out_sin, out_cos, len, 1, 1));
+    double err = 0;
+    for (int i = 0; i < len; i++) {
+        double turns = f0 / 2.0 * i + ((double)f1 - f0) / (2.0 * len) * i * (i - 1) / 2.0;
+        err = fmax(err, fabs(out_sin[i] - sin(2 * M_PI * turns)));
+        err = fmax(err, fabs(out_cos[i] - cos(2 * M_PI * turns)));
+    }
+    double f_end = ldexp((double)nco.step, -63);
+    ESP_LOGI(TAG, "linear chirp: maximum error %e, end frequency %f", err, f_end);
+    TEST_ASSERT_LESS_OR_EQUAL(10, (int)(1e6 * err));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, f1, f_end);
+
+    // Exponential: the increments are f0/2*r^k turns, r = (f1/f0)^(1/len)
+    TEST_ESP_OK(dsps_nco_chirp_init(&nco, DSPS_NCO_EXP, f0, f1, len, 1));
+    TEST_ESP_OK(dsps_nco_f32(&nco, out_sin, NULL, len, 1, 1));
+    double r = pow((double)f1 / f0, 1.0 / len);
+    err = 0;
+    for (int i = 0; i < len; i++) {
+        double turns = f0 / 2.0 * (pow(r, i) - 1) / (r - 1);
+        err = fmax(err, fabs(out_sin[i] - sin(2 * M_PI * turns)));
+    }
+    f_end = ldexp((double)nco.step, -63);
+    ESP_LOGI(TAG, "exponential chirp: maximum error %e, end frequency %f", err, f_end);
+    TEST_ASSERT_LESS_OR_EQUAL(2000, (int)(1e6 * err));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, f1, f_end);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_nco_chirp_init(&nco, DSPS_NCO_EXP, -f0, f1, len, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_nco_chirp_init(&nco, DSPS_NCO_LINEAR, f0, f1, 1, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_nco_chirp_init(&nco, DSPS_NCO_EXP, 1e-6f, 0.9f, 2, 1));
+}
+
+TEST_CASE("dsps_nco benchmark", "[dsps]")
+{
+    nco_t nco;
+    const int len = N_SFDR;
+    const float freq = 0.0123f;
+    unsigned int cycles[4];
+    for (int interp = 0; interp < 2; interp++) {
+        dsps_nco_init(&nco, freq, 0, interp);
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_nco_f32(&nco, out_sin, NULL, len, 1, 1);
+        cycles[interp] = dsp_get_cpu_cycle_count() - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_nco_s16(&nco, out16_sin, NULL, len, 32767, 1);
+        cycles[2 + interp] = dsp_get_cpu_cycle_count() - start_b;
+    }
+    // Float phase and sin() per sample, as the tone generator before the NCO
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    float ph = 0;
+    float fr = M_PI * freq;
+    for (int i = 0; i < len; i++) {
+        out_sin[i] = sin(ph);
+        ph += fr;
+        if (ph > 2 * M_PI) {
+            ph -= 2 * M_PI;
+        }
+    }
+    unsigned int cycles_sin = dsp_get_cpu_cycle_count() - start_b;
+    ESP_LOGI(TAG, "f32: nearest %.1f, interpolated %.1f cycles per sample", (float)cycles[0] / len, (float)cycles[1] / len);
+    ESP_LOGI(TAG, "s16: nearest %.1f, interpolated %.1f cycles per sample", (float)cycles[2] / len, (float)cycles[3] / len);
+    ESP_LOGI(TAG, "sin(): %.1f cycles per sample", (float)cycles_sin / len);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EXEC_IN_RANGE(len, 100 * len, cycles[i]);
+    }
+}
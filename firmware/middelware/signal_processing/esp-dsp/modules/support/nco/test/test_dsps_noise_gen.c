@@ -0,0 +1,154 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_noise_gen.h"
+#include "dsp_common.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_noise_gen";
+
+#define N_NOISE     65536
+#define N_BLOCK     1024
+
+static float out[N_BLOCK];
+static float out2[N_BLOCK];
+static int16_t out16[N_BLOCK];
+
+// Generate N_NOISE samples by blocks of N_BLOCK: 0 - uniform f32, 1 - uniform s16, 2 - gauss f32, 3 - gauss s16.
+// Returns mean, standard deviation, kurtosis, maximum of the absolute value and lag one correlation.
+// The s16 values are divided by ampl.
+static void noise_moments(noise_gen_t *noise, int type, float ampl, double *mean, double *std, double *kurt, double *max, double *corr)
+{
+    double s1 = 0, s2 = 0, s3 = 0, s4 = 0, lag = 0;
+    float last = 0;
+    *max = 0;
+    for (int b = 0; b < N_NOISE / N_BLOCK; b++) {
+        switch (type) {
+        case 0:
+            TEST_ESP_OK(dsps_noise_uniform_f32(noise, out, N_BLOCK, ampl));
+            break;
+        case 1:
+            TEST_ESP_OK(dsps_noise_uniform_s16(noise, out16, N_BLOCK, ampl));
+            break;
+        case 2:
+            TEST_ESP_OK(dsps_noise_gauss_f32(noise, out, N_BLOCK, ampl));
+            break;
+        default:
+            TEST_ESP_OK(dsps_noise_gauss_s16(noise, out16, N_BLOCK, ampl));
+            break;
+        }
+        if (type & 1) {
+            for (int i = 0; i < N_BLOCK; i++) {
+                out[i] = out16[i] / ampl;
+            }
+        }
+        for (int i = 0; i < N_BLOCK; i++) {
+            double x = out[i];
+            s1 += x;
+            s2 += x * x;
+            s3 += x * x * x;
+            s4 += x * x * x * x;
+            lag += x * last;
+            last = out[i];
+            *max = fmax(*max, fabs(x));
+        }
+    }
+    // Central moments from the raw moments
+    double m = s1 / N_NOISE;
+    double m2 = s2 / N_NOISE - m * m;
+    double m4 = s4 / N_NOISE - 4 * m * s3 / N_NOISE + 6 * m * m * s2 / N_NOISE - 3 * m * m * m * m;
+    *mean = m;
+    *std = sqrt(m2);
+    *kurt = m4 / (m2 * m2);
+    *corr = lag / N_NOISE;
+}
+
+TEST_CASE("dsps_noise_gen statistics", "[dsps]")
+{
+    noise_gen_t noise;
+    double mean, std, kurt, max, corr;
+
+    // Uniform: std = ampl/sqrt(3), kurtosis 1.8
+    TEST_ESP_OK(dsps_noise_init(&noise, 1));
+    noise_moments(&noise, 0, 2, &mean, &std, &kurt, &max, &corr);
+    ESP_LOGI(TAG, "uniform f32: mean %f, std %f, kurtosis %f, max %f", mean, std, kurt, max);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, 0, mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 2 / sqrt(3), std);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, 1.8, kurt);
+    TEST_ASSERT_TRUE(max <= 2);
+
+    noise_moments(&noise, 1, 16384, &mean, &std, &kurt, &max, &corr);
+    ESP_LOGI(TAG, "uniform s16: mean %f, std %f, kurtosis %f, max %f", mean, std, kurt, max);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0, mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 1 / sqrt(3), std);
+    TEST_ASSERT_TRUE(max <= 1);
+
+    // Gaussian: kurtosis of the sum of four uniform values is 2.7
+    noise_moments(&noise, 2, 0.5f, &mean, &std, &kurt, &max, &corr);
+    ESP_LOGI(TAG, "gauss f32: mean %f, std %f, kurtosis %f, max %f", mean, std, kurt, max);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0, mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 0.5, std);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 2.7, kurt);
+    TEST_ASSERT_TRUE(max <= 0.5 * 2 * sqrt(3));
+
+    noise_moments(&noise, 3, 4096, &mean, &std, &kurt, &max, &corr);
+    ESP_LOGI(TAG, "gauss s16: mean %f, std %f, kurtosis %f, max %f", mean, std, kurt, max);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, 0, mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1, std);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 2.7, kurt);
+
+    // Lag one correlation of the white noise
+    noise_moments(&noise, 2, 1, &mean, &std, &kurt, &max, &corr);
+    ESP_LOGI(TAG, "gauss f32: lag one correlation %f", corr);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, 0, corr);
+
+    // The same seed gives the same sequence
+    TEST_ESP_OK(dsps_noise_init(&noise, 12345));
+    TEST_ESP_OK(dsps_noise_gauss_f32(&noise, out, N_BLOCK, 1));
+    TEST_ESP_OK(dsps_noise_init(&noise, 12345));
+    TEST_ESP_OK(dsps_noise_gauss_f32(&noise, out2, N_BLOCK, 1));
+    TEST_ASSERT_EQUAL(0, memcmp(out, out2, N_BLOCK * sizeof(float)));
+}
+
+TEST_CASE("dsps_noise_gen benchmark", "[dsps]")
+{
+    noise_gen_t noise;
+    const int len = N_BLOCK;
+    dsps_noise_init(&noise, 1);
+    unsigned int cycles[4];
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_noise_uniform_f32(&noise, out, len, 1);
+    cycles[0] = dsp_get_cpu_cycle_count() - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_noise_uniform_s16(&noise, out16, len, 32767);
+    cycles[1] = dsp_get_cpu_cycle_count() - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_noise_gauss_f32(&noise, out, len, 1);
+    cycles[2] = dsp_get_cpu_cycle_count() - start_b;
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_noise_gauss_s16(&noise, out16, len, 4096);
+    cycles[3] = dsp_get_cpu_cycle_count() - start_b;
+    ESP_LOGI(TAG, "uniform f32 %.1f, s16 %.1f, gauss f32 %.1f, s16 %.1f cycles per sample",
+             (float)cycles[0] / len, (float)cycles[1] / len, (float)cycles[2] / len, (float)cycles[3] / len);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EXEC_IN_RANGE(len / 2, 50 * len, cycles[i]);
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_wind_kaiser.h"
+#include <math.h>
+
+float dsps_bessel_i0_f32(float x)
+{
+    // Power series: sum((x/2)^(2k) / (k!)^2)
+    float sum = 1;
+    float term = 1;
+    float half_x = x / 2;
+    for (int k = 1; k < 50; k++) {
+        term *= (half_x / k) * (half_x / k);
+        sum += term;
+        if (term < sum * 1e-9f) {
+            break;
+        }
+    }
+    return sum;
+}
+
+void dsps_wind_kaiser_f32(float *window, int len, float beta)
+{
+    if (len == 1) {
+        window[0] = 1;
+        return;
+    }
+    float norm = 1 / dsps_bessel_i0_f32(beta);
+    float len_mult = 1 / (float)(len - 1);
+    for (int i = 0; i < len; i++) {
+        float r = (2 * i - (len - 1)) * len_mult;
+        float arg = 1 - r * r;
+        if (arg < 0) {
+            arg = 0;
+        }
+        window[i] = dsps_bessel_i0_f32(beta * sqrtf(arg)) * norm;
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef _dsps_wind_kaiser_H_
+#define _dsps_wind_kaiser_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief   Kaiser window
+ *
+ * The function generates Kaiser window.
+ * The beta parameter controls the trade off between main lobe width and side lobe level.
+ * For a FIR filter with stopband attenuation A dB the beta is
+ * 0.1102*(A - 8.7) for A > 50, 0.5842*(A - 21)^0.4 + 0.07886*(A - 21) for 21 <= A <= 50, and 0 otherwise.
+ *
+ * @param window: buffer to store window array.
+ * @param len: length of the window array
+ * @param beta: shape parameter of the window
+ *
+ */
+void dsps_wind_kaiser_f32(float *window, int len, float beta);
+
+/**
+ * @brief   Modified Bessel function of the first kind, order zero
+ *
+ * Used by the Kaiser window and Kaiser based filter design.
+ *
+ * @param x: argument
+ *
+ * @return I0(x)
+ */
+float dsps_bessel_i0_f32(float x);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // _dsps_wind_kaiser_H_
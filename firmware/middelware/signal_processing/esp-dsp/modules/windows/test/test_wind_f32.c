@@ -106,3 +106,19 @@ TEST_CASE("dsps_wind_flat_top_f32: test Flat-Top window for symmetry", "[dsps]")
     }
     dsps_view(data, length, 64, 10, 0, 1, '.');
 }
+
+TEST_CASE("dsps_wind_kaiser_f32: test Kaiser window for symmetry", "[dsps]")
+{
+    dsps_wind_kaiser_f32(data, length, 8.6);
+    float kaiser_diff = 0;
+    for (int i = 0 ; i < length / 2 ; i++) {
+        kaiser_diff += fabs(data[i] - data[length - 1 - i]);
+    }
+
+    if (kaiser_diff > 0) {
+        TEST_ASSERT_EQUAL(0, kaiser_diff);
+    }
+    // Peak of the window must be 1
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1, data[length / 2]);
+    dsps_view(data, length, 64, 10, 0, 1, '.');
+}
@@ -48,6 +48,19 @@ bool FFTInit(void);
  */
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
 
+/**
+ * @brief Calculates the FFT magnitude in dB of ADC samples using only integer operations
+ * 
+ * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT).
+ *        Result is in hundredths of dB of the same magnitude as FFTMagnitude (20*log10(magnitude)*100),
+ *        for chips without floating point unit
+ * 
+ * @param signal            Array with ADC samples (of lenght = signal_lenght)
+ * @param fft_db            Array to store FFT magnitude values in hundredths of dB (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal array
+ */
+void FFTMagnitudeFixed(uint16_t * signal, int16_t * fft_db, uint16_t signal_lenght);
+
 /**
  * @brief Return the FFT frequency axis vector
  * 
@@ -57,6 +70,19 @@ void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
  */
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f);
 
+/**
+ * @brief Return the frequency of the largest component of a FFT magnitude spectrum
+ * 
+ * @note  The position of the peak is interpolated between the bins, so the resolution
+ *        is better than sample_freq / signal_lenght. DC bin is not considered
+ * 
+ * @param fft               Array with FFT magnitude values calculated by FFTMagnitude (of lenght = signal_lenght / 2)
+ * @param sample_freq       Sample frequency 
+ * @param signal_lenght     Lenght of signal array
+ * @return float            Frequency of the peak (0 if there is no peak)
+ */
+float FFTPeakFrequency(float * fft, float sample_freq, uint16_t signal_lenght);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
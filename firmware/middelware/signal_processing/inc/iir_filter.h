@@ -54,6 +54,9 @@ void HiPassInit(float sample_frec, float cut_frec, filter_order_t order);
 /**
  * @brief Apply a low pass filter to a signal array
  * 
+ * @note  If the filter could not be designed with the parameters of the initialization,
+ *        the input is copied to the output
+ * 
  * @param input_signal      Input signal array
  * @param output_signal     Filtered signal array
  * @param signal_lenght     Number of samples of both signals
@@ -63,12 +66,77 @@ void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_l
 /**
  * @brief Apply a hi pass filter to a signal array
  * 
+ * @note  If the filter could not be designed with the parameters of the initialization,
+ *        the input is copied to the output
+ * 
  * @param input_signal      Input signal array
  * @param output_signal     Filtered signal array
  * @param signal_lenght     Number of samples of both signals
  */
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
+/**
+ * @brief Apply the low pass filter forward and backward (zero phase) to a signal array
+ * 
+ * @note  The signal is filtered in place. Delay lines of LowPassFilter are not modified
+ * 
+ * @param signal            Signal array (input and filtered output)
+ * @param signal_lenght     Number of samples of the signal
+ */
+void LowPassFiltFilt(float * signal, int16_t signal_lenght);
+
+/**
+ * @brief Apply the hi pass filter forward and backward (zero phase) to a signal array
+ * 
+ * @note  The signal is filtered in place. Delay lines of HiPassFilter are not modified
+ * 
+ * @param signal            Signal array (input and filtered output)
+ * @param signal_lenght     Number of samples of the signal
+ */
+void HiPassFiltFilt(float * signal, int16_t signal_lenght);
+
+/**
+ * @brief Initialize a notch filter bank for the powerline interference
+ * 
+ * @note  All notches have the same bandwidth (notch_frec / 30)
+ * 
+ * @param sample_frec   Signal's sample frequency
+ * @param notch_frec    Mains frequency (50 or 60 Hz)
+ * @param harmonics     Number of notches: fundamental and harmonics (1 to 4). 
+ *                      Harmonics above half the sample frequency are skipped
+ */
+void NotchInit(float sample_frec, float notch_frec, uint8_t harmonics);
+
+/**
+ * @brief Apply the notch filter bank to a signal array
+ * 
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array
+ * @param signal_lenght     Number of samples of both signals
+ */
+void NotchFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Initialize the adaptive (LMS) powerline interference canceller
+ * 
+ * @note  The reference sinusoids are generated internally and follow the drift of the mains frequency
+ * 
+ * @param sample_frec   Signal's sample frequency
+ * @param mains_frec    Nominal mains frequency (50 or 60 Hz)
+ * @param harmonics     Number of cancelled components: fundamental and harmonics (1 to 4). 
+ *                      Harmonics above half the sample frequency are skipped, the same way as in NotchInit
+ */
+void HumCancelInit(float sample_frec, float mains_frec, uint8_t harmonics);
+
+/**
+ * @brief Remove the powerline interference from a signal array
+ * 
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (could be the same as input)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void HumCancelFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -18,8 +18,12 @@
 /*==================[macros and definitions]=================================*/
 #define TAG "FFT Module"
 /*==================[internal data declaration]==============================*/
-static float fft_complex[2 * MAX_SIGNAL_LENGHT];
+static float fft_complex[2 * MAX_SIGNAL_LENGHT] __attribute__((aligned(16)));
 static float wind[MAX_SIGNAL_LENGHT];
+// Fixed point FFT uses the float buffer: complex data in the first half, Q15 window in the second half
+static int16_t * const fft_complex_sc16 = (int16_t *)fft_complex;
+static int16_t * const wind_sc16 = (int16_t *)&fft_complex[MAX_SIGNAL_LENGHT];
+static uint16_t wind_sc16_lenght = 0;
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -34,14 +38,19 @@ bool FFTInit(void){
     if (ret != ESP_OK){
         return false;
     }
+    ret = dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    if (ret != ESP_OK){
+        return false;
+    }
     return true;
 }
 
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
     // Generate Hann window
     dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
+    // Clear fft array, Q15 window of FFTMagnitudeFixed is overwritten
     memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
+    wind_sc16_lenght = 0;
     // Multiply input array with window and store as real part
     dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
     // Calculate FFT  
@@ -59,6 +68,30 @@ void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
     memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
 }
 
+void FFTMagnitudeFixed(uint16_t * signal, int16_t * fft_db, uint16_t signal_lenght){
+    int exp;
+    // Generate Hann window in Q15 only when lenght changes
+    if (wind_sc16_lenght != signal_lenght){
+        dsps_wind_hann_f32(wind, signal_lenght);
+        for (int j = 0; j < signal_lenght; j++){
+            wind_sc16[j] = (int16_t)(wind[j] * INT16_MAX);
+        }
+        wind_sc16_lenght = signal_lenght;
+    }
+    // Remove mean, multiply by window and scale to full range
+    dsps_spectrum_prep_sc16(signal, wind_sc16, fft_complex_sc16, signal_lenght, &exp);
+    // Calculate FFT, tables are initialized by FFTInit
+    if (dsps_fft2r_sc16(fft_complex_sc16, signal_lenght) != ESP_OK){
+        return;
+    }
+    // Bit reverse
+    dsps_bit_rev_sc16(fft_complex_sc16, signal_lenght);
+    // Calculate FFT magnitude
+    dsps_mag_sc16(fft_complex_sc16, (uint16_t *)fft_db, signal_lenght / 2, DSPS_MAG_CORDIC);
+    // Same scale as FFTMagnitude, where dsps_cplx2reC_fc32 doubles the spectrum of the real signal: 8 * |X| / signal_lenght
+    dsps_mag_db_sc16((uint16_t *)fft_db, fft_db, signal_lenght / 2, exp + 3 - dsp_power_of_two(signal_lenght));
+}
+
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
     float freq_step = sample_freq / (float)signal_lenght;
     for(uint16_t i=0; i<(signal_lenght/2); i++){
@@ -66,4 +99,13 @@ void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
     }
 }
 
+float FFTPeakFrequency(float * fft, float sample_freq, uint16_t signal_lenght){
+    dsps_peak_t peak;
+    // Gaussian interpolation fits the main lobe of the Hann window
+    if (dsps_peak_find_f32(fft, signal_lenght / 2, &peak, 1, 0, DSPS_PEAK_GAUSSIAN) == 0){
+        return 0;
+    }
+    return peak.bin * sample_freq / (float)signal_lenght;
+}
+
 /*==================[end of file]============================================*/
\ No newline at end of file
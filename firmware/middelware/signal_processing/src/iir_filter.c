@@ -11,24 +11,18 @@
 
 /*==================[inclusions]=============================================*/
 #include "iir_filter.h"
+#include <string.h>
 #include "esp_dsp.h"
 /*==================[macros and definitions]=================================*/
 #define N_SOS       5
 #define N_DELAY     2
-// 2nd order Butterworth 
-#define ORDER2_Q    (1 / 1.414)
-// 4th order Butterworth 
-#define ORDER4_Q1   (1 / 0.765)
-#define ORDER4_Q2   (1 / 1.848)
-// 6th order Butterworth 
-#define ORDER6_Q1   (1 / 0.518)
-#define ORDER6_Q2   (1 / 1.414)
-#define ORDER6_Q3   (1 / 1.932)
-// 8th order Butterworth 
-#define ORDER8_Q1   (1 / 0.390)
-#define ORDER8_Q2   (1 / 1.111)
-#define ORDER8_Q3   (1 / 1.663)
-#define ORDER8_Q4   (1 / 1.962)
+#define MAX_SECTIONS    (ORDER_8 / 2)
+#define FILTFILT_PAD    (3 * (2 * MAX_SECTIONS + 1))
+#define MAX_NOTCH       4
+#define NOTCH_Q         30
+#define NOTCH_GAIN      -200
+#define HUM_MU          0.02
+#define HUM_MU_F        0.5
 /*==================[internal data declaration]==============================*/
 static uint8_t lp_order, hp_order;
 float hp2_delay[N_DELAY] = {0, 0};  // delay
@@ -47,64 +41,86 @@ float hp2_sos_coeff[N_SOS];
 float hp4_sos_coeff[N_SOS]; 
 float hp6_sos_coeff[N_SOS]; 
 float hp8_sos_coeff[N_SOS]; 
+static float filtfilt_coeff[N_SOS * MAX_SECTIONS];
+static float filtfilt_delay[N_DELAY * MAX_SECTIONS];
+static float filtfilt_pad[2 * FILTFILT_PAD];
+static uint8_t notch_n;
+static float notch_sos_coeff[N_SOS * MAX_NOTCH];
+static float notch_delay[N_DELAY * MAX_NOTCH];
+static uint8_t hum_n;
+static lms_hum_f32_t hum_canceller;
+static biquad_design_cache_t design_cache;
 /*==================[internal functions declaration]=========================*/
+static void FiltFilt(float * sos_coeff[], uint8_t order, float * signal, int16_t signal_lenght);
+static uint8_t LimitHarmonics(float sample_frec, float mains_frec, uint8_t harmonics);
+static uint8_t DesignButterworth(dsps_biquad_band_t band, float sample_frec, float cut_frec, filter_order_t order, float * sos_coeff[]);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Limit the number of harmonics to MAX_NOTCH and to the ones below the Nyquist frequency.
+ * Returns 0 if even the fundamental is not below the Nyquist frequency.
+ */
+static uint8_t LimitHarmonics(float sample_frec, float mains_frec, uint8_t harmonics){
+    if(harmonics > MAX_NOTCH){
+        harmonics = MAX_NOTCH;
+    }
+    while((harmonics > 0) && (mains_frec * harmonics >= sample_frec / 2)){
+        harmonics--;
+    }
+    return harmonics;
+}
+
+/**
+ * @brief Apply the cascade of sections forward and backward over the signal.
+ * Uses its own delay lines, so the state of the causal filters is not modified.
+ */
+static void FiltFilt(float * sos_coeff[], uint8_t order, float * signal, int16_t signal_lenght){
+    uint8_t n_sect = order / 2;
+    int16_t pad_len = 3 * (2 * n_sect + 1);
+    if(n_sect == 0){
+        return;
+    }
+    for(uint8_t i=0; i<n_sect; i++){
+        memcpy(&filtfilt_coeff[i * N_SOS], sos_coeff[i], N_SOS * sizeof(float));
+    }
+    if(pad_len >= signal_lenght){
+        pad_len = signal_lenght - 1;
+    }
+    dsps_biquad_filtfilt_f32(signal, signal_lenght, filtfilt_coeff, filtfilt_delay, n_sect, filtfilt_pad, pad_len);
+}
+
+/**
+ * @brief Design a Butterworth filter and copy its sections to the coefficient arrays.
+ * Designs are cached, so changing back to a previous cut-off frequency is not recalculated.
+ * Returns the order of the filter or 0 if the parameters are not valid.
+ */
+static uint8_t DesignButterworth(dsps_biquad_band_t band, float sample_frec, float cut_frec, filter_order_t order, float * sos_coeff[]){
+    const float * coeff;
+    int n_sect;
+    if((order > ORDER_8) || (dsps_biquad_design_cached_f32(&design_cache, &coeff, &n_sect, DSPS_BIQUAD_BUTTER, band,
+                                                         order, cut_frec / sample_frec, 0, 0) != ESP_OK)){
+        return 0;
+    }
+    for(uint8_t i=0; i<n_sect; i++){
+        memcpy(sos_coeff[i], &coeff[i * N_SOS], N_SOS * sizeof(float));
+    }
+    return order;
+}
 
 /*==================[external functions definition]==========================*/
 
 void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    lp_order = order;
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_lpf_f32(lp8_sos_coeff, f, ORDER8_Q4);
-        break;
-    }
+    float * sos_coeff[MAX_SECTIONS] = {lp2_sos_coeff, lp4_sos_coeff, lp6_sos_coeff, lp8_sos_coeff};
+    lp_order = DesignButterworth(DSPS_BIQUAD_LPF, sample_frec, cut_frec, order, sos_coeff);
 }
 
 void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    hp_order = order;
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_hpf_f32(hp8_sos_coeff, f, ORDER8_Q4);
-        break;
-    }
+    float * sos_coeff[MAX_SECTIONS] = {hp2_sos_coeff, hp4_sos_coeff, hp6_sos_coeff, hp8_sos_coeff};
+    hp_order = DesignButterworth(DSPS_BIQUAD_HPF, sample_frec, cut_frec, order, sos_coeff);
 }
 
 void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
@@ -127,6 +143,12 @@ void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_l
             dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
             dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp8_sos_coeff, lp8_delay);
         break;
+        default:
+            // Filter is not designed: the signal is passed through
+            if(output_signal != input_signal){
+                memcpy(output_signal, input_signal, signal_lenght * sizeof(float));
+            }
+        break;
     }
 }
 
@@ -150,7 +172,70 @@ void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_le
             dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
             dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp8_sos_coeff, hp8_delay);
         break;
+        default:
+            // Filter is not designed: the signal is passed through
+            if(output_signal != input_signal){
+                memcpy(output_signal, input_signal, signal_lenght * sizeof(float));
+            }
+        break;
+    }
+}
+
+void LowPassFiltFilt(float * signal, int16_t signal_lenght){
+    float * sos_coeff[MAX_SECTIONS] = {lp2_sos_coeff, lp4_sos_coeff, lp6_sos_coeff, lp8_sos_coeff};
+    FiltFilt(sos_coeff, lp_order, signal, signal_lenght);
+}
+
+void HiPassFiltFilt(float * signal, int16_t signal_lenght){
+    float * sos_coeff[MAX_SECTIONS] = {hp2_sos_coeff, hp4_sos_coeff, hp6_sos_coeff, hp8_sos_coeff};
+    FiltFilt(sos_coeff, hp_order, signal, signal_lenght);
+}
+
+void NotchInit(float sample_frec, float notch_frec, uint8_t harmonics){
+    notch_n = 0;
+    memset(notch_delay, 0, sizeof(notch_delay));
+    // Harmonics above Nyquist frequency are skipped
+    harmonics = LimitHarmonics(sample_frec, notch_frec, harmonics);
+    if(harmonics == 0){
+        return;
+    }
+    dsps_biquad_gen_notch_bank_f32(notch_sos_coeff, notch_frec / sample_frec, harmonics, NOTCH_GAIN, NOTCH_Q);
+    notch_n = harmonics;
+}
+
+void NotchFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
+    if(notch_n == 0){
+        if(output_signal != input_signal){
+            memcpy(output_signal, input_signal, signal_lenght * sizeof(float));
+        }
+        return;
+    }
+    dsps_biquad_f32(input_signal, output_signal, signal_lenght, notch_sos_coeff, notch_delay);
+    for(uint8_t i=1; i<notch_n; i++){
+        dsps_biquad_f32(output_signal, output_signal, signal_lenght, &notch_sos_coeff[i * N_SOS], &notch_delay[i * N_DELAY]);
+    }
+}
+
+void HumCancelInit(float sample_frec, float mains_frec, uint8_t harmonics){
+    hum_n = 0;
+    // Harmonics above Nyquist frequency are skipped
+    harmonics = LimitHarmonics(sample_frec, mains_frec, harmonics);
+    if(harmonics == 0){
+        return;
+    }
+    if(dsps_lms_hum_init_f32(&hum_canceller, mains_frec / sample_frec, harmonics, HUM_MU, HUM_MU_F, 1) == ESP_OK){
+        hum_n = harmonics;
+    }
+}
+
+void HumCancelFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
+    if(hum_n == 0){
+        if(output_signal != input_signal){
+            memcpy(output_signal, input_signal, signal_lenght * sizeof(float));
+        }
+        return;
     }
+    dsps_lms_hum_f32(&hum_canceller, input_signal, output_signal, signal_lenght);
 }
 
 /*==================[end of file]============================================*/
\ No newline at end of file